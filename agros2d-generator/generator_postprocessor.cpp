@@ -40,6 +40,8 @@ void Agros2DGeneratorModule::generatePluginFilterFiles()
         }
     }
 
+    // index of expression (switch in the filter)
+    int pos = 0;
     foreach (XMLModule::localvariable lv, m_module->postprocessor().localvariables().localvariable())
     {
         foreach (XMLModule::expression expr, lv.expression())
@@ -54,26 +56,30 @@ void Agros2DGeneratorModule::generatePluginFilterFiles()
                                                analysisType,
                                                coordinateType,
                                                PhysicFieldVariableComp_Scalar,
-                                               QString::fromStdString(expr.planar().get()));
+                                               QString::fromStdString(expr.planar().get()),
+                                               pos);
                     if (lv.type() == "vector")
                     {
                         createFilterExpression(output, QString::fromStdString(lv.id()),
                                                analysisType,
                                                coordinateType,
                                                PhysicFieldVariableComp_X,
-                                               QString::fromStdString(expr.planar_x().get()));
+                                               QString::fromStdString(expr.planar_x().get()),
+                                               pos);
 
                         createFilterExpression(output, QString::fromStdString(lv.id()),
                                                analysisType,
                                                coordinateType,
                                                PhysicFieldVariableComp_Y,
-                                               QString::fromStdString(expr.planar_y().get()));
+                                               QString::fromStdString(expr.planar_y().get()),
+                                               pos);
 
                         createFilterExpression(output, QString::fromStdString(lv.id()),
                                                analysisType,
                                                coordinateType,
                                                PhysicFieldVariableComp_Magnitude,
-                                               QString("sqrt(pow((double) %1, 2) + pow((double) %2, 2))").arg(QString::fromStdString(expr.planar_x().get())).arg(QString::fromStdString(expr.planar_y().get())));
+                                               QString("sqrt(pow((double) %1, 2) + pow((double) %2, 2))").arg(QString::fromStdString(expr.planar_x().get())).arg(QString::fromStdString(expr.planar_y().get())),
+                                               pos);
 
                     }
                 }
@@ -84,26 +90,30 @@ void Agros2DGeneratorModule::generatePluginFilterFiles()
                                                analysisType,
                                                coordinateType,
                                                PhysicFieldVariableComp_Scalar,
-                                               QString::fromStdString(expr.axi().get()));
+                                               QString::fromStdString(expr.axi().get()),
+                                               pos);
                     if (lv.type() == "vector")
                     {
                         createFilterExpression(output, QString::fromStdString(lv.id()),
                                                analysisType,
                                                coordinateType,
                                                PhysicFieldVariableComp_X,
-                                               QString::fromStdString(expr.axi_r().get()));
+                                               QString::fromStdString(expr.axi_r().get()),
+                                               pos);
 
                         createFilterExpression(output, QString::fromStdString(lv.id()),
                                                analysisType,
                                                coordinateType,
                                                PhysicFieldVariableComp_Y,
-                                               QString::fromStdString(expr.axi_z().get()));
+                                               QString::fromStdString(expr.axi_z().get()),
+                                               pos);
 
                         createFilterExpression(output, QString::fromStdString(lv.id()),
                                                analysisType,
                                                coordinateType,
                                                PhysicFieldVariableComp_Magnitude,
-                                               QString("sqrt(pow((double) %1, 2) + pow((double) %2, 2))").arg(QString::fromStdString(expr.axi_r().get())).arg(QString::fromStdString(expr.axi_z().get())));
+                                               QString("sqrt(pow((double) %1, 2) + pow((double) %2, 2))").arg(QString::fromStdString(expr.axi_r().get())).arg(QString::fromStdString(expr.axi_z().get())),
+                                               pos);
                     }
                 }
 
@@ -152,10 +162,6 @@ void Agros2DGeneratorModule::generatePluginForceFiles()
 
     std::string text;
 
-    // header - expand template
-    ctemplate::ExpandTemplate(compatibleFilename(QString("%1/%2/force_h.tpl").arg(QApplication::applicationDirPath()).arg(GENERATOR_TEMPLATEROOT)).toStdString(),
-                              ctemplate::DO_NOT_STRIP, &output, &text);
-
     // force
     XMLModule::force force = m_module->postprocessor().force();
     foreach (XMLModule::quantity quantity, m_module->volume().quantity())
@@ -199,6 +205,10 @@ void Agros2DGeneratorModule::generatePluginForceFiles()
     }
 
 
+    // header - expand template (material values are members of the evaluator)
+    ctemplate::ExpandTemplate(compatibleFilename(QString("%1/%2/force_h.tpl").arg(QApplication::applicationDirPath()).arg(GENERATOR_TEMPLATEROOT)).toStdString(),
+                              ctemplate::DO_NOT_STRIP, &output, &text);
+
     // header - save to file
     writeStringContent(QString("%1/%2/%3/%3_force.h").
                        arg(QApplication::applicationDirPath()).
@@ -517,12 +527,14 @@ void Agros2DGeneratorModule::createFilterExpression(ctemplate::TemplateDictionar
                                                     AnalysisType analysisType,
                                                     CoordinateType coordinateType,
                                                     PhysicFieldVariableComp physicFieldVariableComp,
-                                                    const QString &expr)
+                                                    const QString &expr,
+                                                    int &pos)
 {
     if (!expr.isEmpty())
     {
         ctemplate::TemplateDictionary *expression = output.AddSectionDictionary("VARIABLE_SOURCE");
 
+        expression->SetValue("EXPRESSION_INDEX", QString::number(pos++).toStdString());
         expression->SetValue("VARIABLE_HASH", QString::number(qHash(variable)).toStdString());
         expression->SetValue("ANALYSIS_TYPE", Agros2DGenerator::analysisTypeStringEnum(analysisType).toStdString());
         expression->SetValue("COORDINATE_TYPE", Agros2DGenerator::coordinateTypeStringEnum(coordinateType).toStdString());
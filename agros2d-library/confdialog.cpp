@@ -71,6 +71,9 @@ void ConfigComputerDialog::load()
     // cache size
     txtCacheSize->setValue(Agros2D::configComputer()->value(Config::Config_CacheSize).toInt());
 
+    // mesh cache
+    chkMeshCache->setChecked(Agros2D::configComputer()->value(Config::Config_MeshCache).toBool());
+
     // std log
     chkLogStdOut->setChecked(Agros2D::configComputer()->value(Config::Config_LogStdOut).toBool());
 
@@ -111,6 +114,9 @@ void ConfigComputerDialog::save()
     // cache size
     Agros2D::configComputer()->setValue(Config::Config_CacheSize, txtCacheSize->value());
 
+    // mesh cache
+    Agros2D::configComputer()->setValue(Config::Config_MeshCache, chkMeshCache->isChecked());
+
     // std log
     Agros2D::configComputer()->setValue(Config::Config_LogStdOut, chkLogStdOut->isChecked());
 
@@ -275,11 +281,14 @@ QWidget *ConfigComputerDialog::createSolverWidget()
     txtNumOfThreads->setMinimum(1);
     txtNumOfThreads->setMaximum(omp_get_max_threads());
 
+    chkMeshCache = new QCheckBox(tr("Reuse cached meshes"));
+
     QGridLayout *layoutSolver = new QGridLayout();
     layoutSolver->addWidget(new QLabel(tr("Number of threads:")), 0, 0);
     layoutSolver->addWidget(txtNumOfThreads, 0, 1);
     layoutSolver->addWidget(new QLabel(tr("Number of cache slots:")), 1, 0);
     layoutSolver->addWidget(txtCacheSize, 1, 1);
+    layoutSolver->addWidget(chkMeshCache, 2, 0, 1, 2);
 
     QGroupBox *grpSolver = new QGroupBox(tr("Solver"));
     grpSolver->setLayout(layoutSolver);
@@ -63,6 +63,7 @@ private:
 
     // cache
     QSpinBox *txtCacheSize;
+    QCheckBox *chkMeshCache;
 
     // threads
     QSpinBox *txtNumOfThreads;
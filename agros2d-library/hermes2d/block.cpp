@@ -327,6 +327,19 @@ bool Block::adaptivityFinerReference() const
     return finerReference;
 }
 
+AdaptivityReferenceRetention Block::adaptivityReferenceRetention() const
+{
+    AdaptivityReferenceRetention retention = (AdaptivityReferenceRetention) m_fields.at(0)->fieldInfo()->value(FieldInfo::AdaptivityReferenceRetention).toInt();
+
+    foreach (Field *field, m_fields)
+    {
+        // todo: ensure in GUI
+        assert((AdaptivityReferenceRetention) field->fieldInfo()->value(FieldInfo::AdaptivityReferenceRetention).toInt() == retention);
+    }
+
+    return retention;
+}
+
 int Block::numSolutions() const
 {
     int num = 0;
@@ -625,6 +638,70 @@ int Block::iterLinearSolverIters() const
     return iters;
 }
 
+bool Block::iterReusePreconditioner() const
+{
+    foreach (Field* field, m_fields)
+    {
+        FieldInfo* fieldInfo = field->fieldInfo();
+        if (!fieldInfo->value(FieldInfo::LinearSolverReusePreconditioner).toBool())
+            return false;
+    }
+
+    return true;
+}
+
+bool Block::iterMixedPrecision() const
+{
+    foreach (Field* field, m_fields)
+    {
+        FieldInfo* fieldInfo = field->fieldInfo();
+        if (!fieldInfo->value(FieldInfo::LinearSolverIterMixedPrecision).toBool())
+            return false;
+    }
+
+    return true;
+}
+
+double Block::iterMixedPrecisionInnerTolerance() const
+{
+    double tolerance = 1.0;
+
+    foreach (Field* field, m_fields)
+    {
+        FieldInfo* fieldInfo = field->fieldInfo();
+        if (fieldInfo->value(FieldInfo::LinearSolverIterMixedPrecisionInnerTolerance).toDouble() < tolerance)
+            tolerance = fieldInfo->value(FieldInfo::LinearSolverIterMixedPrecisionInnerTolerance).toDouble();
+    }
+
+    return tolerance;
+}
+
+double Block::iterMixedPrecisionOuterTolerance() const
+{
+    double tolerance = 1.0;
+
+    foreach (Field* field, m_fields)
+    {
+        FieldInfo* fieldInfo = field->fieldInfo();
+        if (fieldInfo->value(FieldInfo::LinearSolverIterMixedPrecisionOuterTolerance).toDouble() < tolerance)
+            tolerance = fieldInfo->value(FieldInfo::LinearSolverIterMixedPrecisionOuterTolerance).toDouble();
+    }
+
+    return tolerance;
+}
+
+bool Block::amgNumericRefresh() const
+{
+    foreach (Field* field, m_fields)
+    {
+        FieldInfo* fieldInfo = field->fieldInfo();
+        if (fieldInfo->value(FieldInfo::LinearSolverAMGNumericRefresh).toBool())
+            return true;
+    }
+
+    return false;
+}
+
 bool Block::contains(const FieldInfo *fieldInfo) const
 {
     foreach(Field* field, m_fields)
@@ -73,6 +73,7 @@ public:
     double adaptivityThreshold() const;
     bool adaptivityUseAniso() const;
     bool adaptivityFinerReference() const;
+    AdaptivityReferenceRetention adaptivityReferenceRetention() const;
 
     // minimal nonlinear tolerance of individual fields
     double nonlinearResidualNorm() const;
@@ -116,6 +117,21 @@ public:
     double iterLinearSolverToleranceAbsolute() const;
     int iterLinearSolverIters() const;
 
+    // reuse preconditioner (AMG hierarchy) while the matrix pattern is unchanged
+    // use only if true for all fields
+    bool iterReusePreconditioner() const;
+
+    // mixed-precision defect correction (single precision inner Krylov solver)
+    // use only if true for all fields
+    bool iterMixedPrecision() const;
+    // relative tolerance of the inner solver
+    double iterMixedPrecisionInnerTolerance() const;
+    // relative tolerance of the outer defect correction
+    double iterMixedPrecisionOuterTolerance() const;
+
+    // refresh coarse operators numerically instead of reusing them
+    bool amgNumericRefresh() const;
+
     bool contains(const FieldInfo *fieldInfo) const;
     Field* field(const FieldInfo* fieldInfo) const;
 
@@ -929,12 +929,18 @@ void FieldInfo::setStringKeys()
     m_settingKey[AdaptivityFinerReference] = "AdaptivityFinerReference";
     m_settingKey[AdaptivityOrderIncrease] = "AdaptivityOrderIncrease";
     m_settingKey[AdaptivitySpaceRefinement] = "AdaptivitySpaceRefinement";
+    m_settingKey[AdaptivityReferenceRetention] = "AdaptivityReferenceRetention";
     m_settingKey[TransientTimeSkip] = "TransientTimeSkip";
     m_settingKey[TransientInitialCondition] = "TransientInitialCondition";
     m_settingKey[LinearSolverIterMethod] = "LinearSolverIterMethod";
     m_settingKey[LinearSolverIterPreconditioner] = "LinearSolverIterPreconditioner";
     m_settingKey[LinearSolverIterToleranceAbsolute] = "LinearSolverIterToleranceAbsolute";
     m_settingKey[LinearSolverIterIters] = "LinearSolverIterIters";
+    m_settingKey[LinearSolverReusePreconditioner] = "LinearSolverReusePreconditioner";
+    m_settingKey[LinearSolverIterMixedPrecision] = "LinearSolverIterMixedPrecision";
+    m_settingKey[LinearSolverIterMixedPrecisionInnerTolerance] = "LinearSolverIterMixedPrecisionInnerTolerance";
+    m_settingKey[LinearSolverIterMixedPrecisionOuterTolerance] = "LinearSolverIterMixedPrecisionOuterTolerance";
+    m_settingKey[LinearSolverAMGNumericRefresh] = "LinearSolverAMGNumericRefresh";
     m_settingKey[TimeUnit] = "TimeUnit";
 
 }
@@ -968,11 +974,17 @@ void FieldInfo::setDefaultValues()
     m_settingDefault[AdaptivityFinerReference] = false;
     m_settingDefault[AdaptivityOrderIncrease] = 1;
     m_settingDefault[AdaptivitySpaceRefinement] = true;
+    m_settingDefault[AdaptivityReferenceRetention] = AdaptivityReferenceRetention_All;
     m_settingDefault[TransientTimeSkip] = 0.0;
     m_settingDefault[TransientInitialCondition] = 0.0;
     m_settingDefault[LinearSolverIterMethod] = Hermes::Solvers::BiCGStab;
     m_settingDefault[LinearSolverIterPreconditioner] = Hermes::Solvers::ILU;
     m_settingDefault[LinearSolverIterToleranceAbsolute] = 1e-16;
     m_settingDefault[LinearSolverIterIters] = 1000;
+    m_settingDefault[LinearSolverReusePreconditioner] = false;
+    m_settingDefault[LinearSolverIterMixedPrecision] = false;
+    m_settingDefault[LinearSolverIterMixedPrecisionInnerTolerance] = 1e-3;
+    m_settingDefault[LinearSolverIterMixedPrecisionOuterTolerance] = 1e-10;
+    m_settingDefault[LinearSolverAMGNumericRefresh] = false;
     m_settingDefault[TimeUnit] = "s";
 }
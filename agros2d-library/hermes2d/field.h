@@ -90,12 +90,18 @@ public:
         AdaptivityFinerReference,
         AdaptivityOrderIncrease,
         AdaptivitySpaceRefinement,
+        AdaptivityReferenceRetention,
         TransientTimeSkip,
         TransientInitialCondition,
         LinearSolverIterMethod,
         LinearSolverIterPreconditioner,
         LinearSolverIterToleranceAbsolute,
         LinearSolverIterIters,
+        LinearSolverReusePreconditioner,
+        LinearSolverIterMixedPrecision,
+        LinearSolverIterMixedPrecisionInnerTolerance,
+        LinearSolverIterMixedPrecisionOuterTolerance,
+        LinearSolverAMGNumericRefresh,
         TimeUnit
     };
 
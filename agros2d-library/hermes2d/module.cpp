@@ -1109,20 +1109,8 @@ void Module::DialogUI::clear()
 
 AGROS_LIBRARY_API void Module::updateTimeFunctions(double time)
 {
-    // update materials
-    foreach (SceneMaterial *material, Agros2D::scene()->materials->items())
-        if (material->fieldInfo())
-            foreach (Module::MaterialTypeVariable variable, material->fieldInfo()->materialTypeVariables())
-                if (variable.isTimeDep() && material->fieldInfo()->analysisType() == AnalysisType_Transient)
-                    material->evaluate(variable.id(), time);
-
-    // update boundaries
-    foreach (SceneBoundary *boundary, Agros2D::scene()->boundaries->items())
-        if (boundary->fieldInfo())
-            foreach (Module::BoundaryType boundaryType, boundary->fieldInfo()->boundaryTypes())
-                foreach (Module::BoundaryTypeVariable variable, boundaryType.variables())
-                    if (variable.isTimeDep() && boundary->fieldInfo()->analysisType() == AnalysisType_Transient)
-                        boundary->evaluate(variable.id(), time);
+    // only time dependent variables which are not evaluated at given time
+    Agros2D::problem()->timeFunctions()->update(time);
 }
 
 Hermes::vector<Hermes::Hermes2D::MeshSharedPtr> Module::readMeshFromFileXML(const QString &fileName)
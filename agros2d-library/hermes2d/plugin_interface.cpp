@@ -1,6 +1,8 @@
 #include "plugin_interface.h"
 #include "field.h"
 #include "util/global.h"
+#include "util/conf.h"
+#include "util/constants.h"
 
 template<typename Scalar>
 FormAgrosInterface<Scalar>::FormAgrosInterface(const WeakFormAgros<Scalar>* weakFormAgros) : m_markerSource(NULL), m_markerTarget(NULL), m_table(NULL), m_wfAgros(weakFormAgros), m_markerVolume(0.0)
@@ -112,9 +114,76 @@ double AgrosSpecialExtFunction::getValue(int hermesMarker, double h) const
         return calculateValue(hermesMarker, h);
 }
 
+template<typename Scalar>
+void ErrorCalculatorAgros<Scalar>::calculateErrors(Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > coarseSolutions,
+                                                   Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > fineSolutions,
+                                                   bool sortAndStore)
+{
+    // element errors and norms are evaluated by the threads of Hermes (each element by one thread)
+    this->calculate_errors(coarseSolutions, fineSolutions, sortAndStore);
+
+    // sums accumulated by the threads depend on the order of their completion
+    reduceErrors(coarseSolutions);
+}
+
+template<typename Scalar>
+void ErrorCalculatorAgros<Scalar>::reduceErrors(Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > coarseSolutions)
+{
+    int numberOfThreads = qMax(1, Agros2D::configComputer()->value(Config::Config_NumberOfThreads).toInt());
+
+    this->errors_squared_sum = 0.0;
+    this->norms_squared_sum = 0.0;
+    for (int comp = 0; comp < coarseSolutions.size(); comp++)
+    {
+        // active elements in the order of ids
+        QVector<int> elements;
+        Hermes::Hermes2D::Element *element;
+        for_all_active_elements(element, coarseSolutions[comp]->get_mesh())
+            elements.append(element->id);
+
+        int chunks = (elements.count() + ERROR_REDUCTION_CHUNK_SIZE - 1) / ERROR_REDUCTION_CHUNK_SIZE;
+        QVector<double> chunkErrors(chunks, 0.0);
+        QVector<double> chunkNorms(chunks, 0.0);
+
+        const int *ids = elements.constData();
+        const double *errors = this->errors[comp];
+        const double *norms = this->norms[comp];
+        int count = elements.count();
+#pragma omp parallel for num_threads(numberOfThreads)
+        for (int chunk = 0; chunk < chunks; chunk++)
+        {
+            double error = 0.0;
+            double norm = 0.0;
+            for (int i = chunk * ERROR_REDUCTION_CHUNK_SIZE; i < qMin(count, (chunk + 1) * ERROR_REDUCTION_CHUNK_SIZE); i++)
+            {
+                error += errors[ids[i]];
+                norm += norms[ids[i]];
+            }
+
+            chunkErrors[chunk] = error;
+            chunkNorms[chunk] = norm;
+        }
+
+        // fixed order of partial sums
+        double componentError = 0.0;
+        double componentNorm = 0.0;
+        for (int chunk = 0; chunk < chunks; chunk++)
+        {
+            componentError += chunkErrors[chunk];
+            componentNorm += chunkNorms[chunk];
+        }
+
+        this->component_errors[comp] = componentError;
+        this->component_norms[comp] = componentNorm;
+        this->errors_squared_sum += componentError;
+        this->norms_squared_sum += componentNorm;
+    }
+}
+
 template class AGROS_LIBRARY_API FormAgrosInterface<double>;
 template class AGROS_LIBRARY_API MatrixFormVolAgros<double>;
 template class AGROS_LIBRARY_API VectorFormVolAgros<double>;
 template class AGROS_LIBRARY_API MatrixFormSurfAgros<double>;
 template class AGROS_LIBRARY_API VectorFormSurfAgros<double>;
 template class AGROS_LIBRARY_API ExactSolutionScalarAgros<double>;
+template class AGROS_LIBRARY_API ErrorCalculatorAgros<double>;
@@ -184,6 +184,8 @@ public:
 
     // variables
     inline QMap<QString, double> values() const { return m_values; }
+    // variables of each region (batched evaluation)
+    inline QList<QMap<QString, double> > regionValues() const { return m_regionValues; }
 
 protected:
     // field info
@@ -194,6 +196,40 @@ protected:
 
     // variables
     QMap<QString, double> m_values;
+    QList<QMap<QString, double> > m_regionValues;
+};
+
+// force acting on a particle, bound to one solution (field, time step and adaptivity step)
+// solutions, materials and time functions are resolved in the constructor,
+// evaluation does not allocate memory and does not access the problem or the scene
+class ForceEvaluator
+{
+public:
+    ForceEvaluator(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType)
+        : m_fieldInfo(fieldInfo), m_timeStep(timeStep), m_adaptivityStep(adaptivityStep), m_solutionType(solutionType) {}
+    virtual ~ForceEvaluator() {}
+
+    // mesh of the solution (elements passed to force)
+    inline Hermes::Hermes2D::MeshSharedPtr mesh() const { return m_mesh; }
+
+    // point has to lie in the element, zero force outside the field
+    virtual Point3 force(Hermes::Hermes2D::Element *element, const Point3 &point, const Point3 &velocity) = 0;
+
+    // batch of points
+    void forces(int count, Hermes::Hermes2D::Element * const *elements, const Point3 *points, const Point3 *velocities, Point3 *results)
+    {
+        for (int i = 0; i < count; i++)
+            results[i] = force(elements[i], points[i], velocities[i]);
+    }
+
+protected:
+    // field info
+    const FieldInfo *m_fieldInfo;
+    int m_timeStep;
+    int m_adaptivityStep;
+    SolutionMode m_solutionType;
+
+    Hermes::Hermes2D::MeshSharedPtr m_mesh;
 };
 
 const int OFFSET_NON_DEF = -100;
@@ -282,6 +318,24 @@ public:
         : Hermes::Hermes2D::ExactSolutionScalar<Scalar>(mesh), FormAgrosInterface<Scalar>(nullptr) {}
 };
 
+// error calculator with a reduction independent of the number of threads
+// element contributions are summed in chunks of fixed size in parallel,
+// partial sums are added in the order of chunks
+template<typename Scalar>
+class AGROS_LIBRARY_API ErrorCalculatorAgros : public Hermes::Hermes2D::ErrorCalculator<Scalar>
+{
+public:
+    ErrorCalculatorAgros(Hermes::Hermes2D::CalculatedErrorType errorType)
+        : Hermes::Hermes2D::ErrorCalculator<Scalar>(errorType) {}
+
+    void calculateErrors(Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > coarseSolutions,
+                         Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > fineSolutions,
+                         bool sortAndStore = true);
+
+private:
+    void reduceErrors(Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > coarseSolutions);
+};
+
 
 // plugin interface
 class AGROS_LIBRARY_API PluginInterface
@@ -307,8 +361,8 @@ public:
     virtual AgrosExtFunction *extFunction(const ProblemID problemId, QString id, bool derivative, bool linearized, const WeakFormAgros<double>* wfAgros) = 0;
 
     // error calculators
-    virtual Hermes::Hermes2D::ErrorCalculator<double> *errorCalculator(const FieldInfo *fieldInfo,
-                                                                       const QString &calculator, Hermes::Hermes2D::CalculatedErrorType errorType) = 0;
+    virtual ErrorCalculatorAgros<double> *errorCalculator(const FieldInfo *fieldInfo,
+                                                          const QString &calculator, Hermes::Hermes2D::CalculatedErrorType errorType) = 0;
 
     // postprocessor
     // filter
@@ -321,11 +375,16 @@ public:
     virtual LocalValue *localValue(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType, const Point &point) = 0;
     // surface integrals
     virtual IntegralValue *surfaceIntegral(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType) = 0;
+    // surface integrals over sets of edges (one mesh traversal, selection is not used)
+    virtual IntegralValue *surfaceIntegral(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType,
+                                           const QList<QSet<int> > &edges) = 0;
     // volume integrals
     virtual IntegralValue *volumeIntegral(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType) = 0;
+    // volume integrals over sets of labels (one mesh traversal, selection is not used)
+    virtual IntegralValue *volumeIntegral(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType,
+                                          const QList<QSet<int> > &labels) = 0;
     // force calculation
-    virtual Point3 force(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType,
-                         Hermes::Hermes2D::Element *element, SceneMaterial *material, const Point3 &point, const Point3 &velocity) = 0;
+    virtual ForceEvaluator *forceEvaluator(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType) = 0;
     virtual bool hasForce(const FieldInfo *fieldInfo) = 0;
 
     // localization
@@ -22,6 +22,7 @@
 
 #include "util/global.h"
 #include "util/constants.h"
+#include "util/profiler.h"
 
 #include "field.h"
 #include "block.h"
@@ -71,6 +72,105 @@ void CalculationThread::run()
     }
 }
 
+void TimeFunctionRegistry::update(double time)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (!isValid())
+        build();
+
+    // pending variables (markers modified after the last update have their own time)
+    foreach (Entry entry, m_entries)
+    {
+        const Value *value = entry.marker->valueNakedPtr(entry.id);
+        if (!value->isEvaluated() || (value->isTimeDependent() && value->time() != time))
+            entry.marker->evaluate(entry.id, time);
+    }
+}
+
+void TimeFunctionRegistry::clear()
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_isBuilt = false;
+    m_entries.clear();
+    m_materials.clear();
+    m_boundaries.clear();
+    m_transientFields.clear();
+}
+
+bool TimeFunctionRegistry::isValid() const
+{
+    return m_isBuilt
+            && m_materials == Agros2D::scene()->materials->items()
+            && m_boundaries == Agros2D::scene()->boundaries->items()
+            && m_transientFields == transientFields();
+}
+
+void TimeFunctionRegistry::build()
+{
+    m_entries.clear();
+    m_materials = Agros2D::scene()->materials->items();
+    m_boundaries = Agros2D::scene()->boundaries->items();
+    m_transientFields = transientFields();
+
+    foreach (FieldInfo *fieldInfo, m_transientFields)
+    {
+        // materials
+        QList<Module::MaterialTypeVariable> materialVariables;
+        foreach (Module::MaterialTypeVariable variable, fieldInfo->materialTypeVariables())
+            if (variable.isTimeDep())
+                materialVariables.append(variable);
+
+        if (!materialVariables.isEmpty())
+        {
+            foreach (SceneMaterial *material, m_materials)
+            {
+                if (material->fieldInfo() != fieldInfo)
+                    continue;
+
+                foreach (Module::MaterialTypeVariable variable, materialVariables)
+                    if (material->values().contains(variable.id()))
+                        m_entries.append(Entry(material, variable.id()));
+            }
+        }
+
+        // boundaries
+        QList<Module::BoundaryTypeVariable> boundaryVariables;
+        foreach (Module::BoundaryType boundaryType, fieldInfo->boundaryTypes())
+            foreach (Module::BoundaryTypeVariable variable, boundaryType.variables())
+                if (variable.isTimeDep())
+                    boundaryVariables.append(variable);
+
+        if (!boundaryVariables.isEmpty())
+        {
+            foreach (SceneBoundary *boundary, m_boundaries)
+            {
+                if (boundary->fieldInfo() != fieldInfo)
+                    continue;
+
+                foreach (Module::BoundaryTypeVariable variable, boundaryVariables)
+                    if (boundary->values().contains(variable.id()))
+                        m_entries.append(Entry(boundary, variable.id()));
+            }
+        }
+    }
+
+    m_isBuilt = true;
+}
+
+QList<FieldInfo *> TimeFunctionRegistry::transientFields() const
+{
+    QList<FieldInfo *> fields;
+    foreach (FieldInfo *fieldInfo, Agros2D::problem()->fieldInfos())
+        if (fieldInfo->analysisType() == AnalysisType_Transient)
+            fields.append(fieldInfo);
+
+    return fields;
+}
+
+// ***********************************************************************************************
+
 Problem::Problem()
 {
     // m_timeStep = 0;
@@ -172,6 +272,7 @@ void Problem::clearSolution()
     m_timeStepLengths.clear();
     updateActualTimeDuringCalculation();
     m_timeHistory.clear();
+    m_timeFunctions.clear();
 
     foreach (FieldInfo* fieldInfo, m_fieldInfos)
         fieldInfo->clearInitialMesh();
@@ -209,6 +310,9 @@ void Problem::clearFieldsAndConfig()
     // clear config
     m_config->clear();
     m_setting->clear();
+
+    // reuse statistics
+    ReferenceSpaceCacheInfo::clear();
 }
 
 void Problem::addField(FieldInfo *field)
@@ -352,8 +456,13 @@ bool Problem::mesh(bool emitMeshed)
 
     m_isMeshing = true;
 
+    // standalone mesh generation starts new profile
+    if (!m_isSolving)
+        Agros2D::profiler()->clear();
+
     try
     {
+        ProfilerScope profilerScope("mesh");
         result = meshAction(emitMeshed);
     }
     catch (AgrosGeometryException& e)
@@ -416,6 +525,13 @@ bool Problem::meshAction(bool emitMeshed)
         meshGenerator = QSharedPointer<MeshGenerator>(new MeshGeneratorTriangleExternal());
 #else
         meshGenerator = QSharedPointer<MeshGenerator>(new MeshGeneratorTriangle());
+#endif
+        break;
+    case MeshType_Triangle_Parallel:
+#ifdef WIN64
+        meshGenerator = QSharedPointer<MeshGenerator>(new MeshGeneratorTriangleExternal());
+#else
+        meshGenerator = QSharedPointer<MeshGenerator>(new MeshGeneratorTriangleParallel());
 #endif
         break;
     case MeshType_GMSH_Triangle:
@@ -428,15 +544,57 @@ bool Problem::meshAction(bool emitMeshed)
         break;
     }
 
+    // mesh cache (geometry and label regions are the same as in one of the previous runs)
+    QSharedPointer<MeshGenerator> cachedMeshGenerator;
+    bool meshCache = (meshGenerator && Agros2D::configComputer()->value(Config::Config_MeshCache).toBool());
+    if (meshCache)
+    {
+        QByteArray key = MeshGeneratorCache::cacheKey(meshGenerator->metaObject()->className());
+        if (MeshGeneratorCache::contains(key))
+            cachedMeshGenerator = QSharedPointer<MeshGenerator>(new MeshGeneratorCache(key));
+
+        // generated mesh is stored (or the unreadable cache file replaced)
+        meshGenerator->setCacheKey(key);
+    }
+
     // add icon to progress
     Agros2D::log()->addIcon(icon("scene-meshgen"),
         tr("Mesh generator\n%1").arg(meshTypeString(config()->meshType())));
 
-    if (meshGenerator && meshGenerator->mesh())
+    bool meshed = false;
+    if (cachedMeshGenerator)
+    {
+        ProfilerScope profilerScope("mesh cache");
+        meshed = cachedMeshGenerator->mesh();
+
+        if (meshed)
+        {
+            MeshGeneratorCache::addHit();
+            Agros2D::log()->printMessage(QObject::tr("Mesh Generator"), QObject::tr("Mesh is reused from the mesh cache"));
+
+            meshGenerator = cachedMeshGenerator;
+        }
+        else
+        {
+            Agros2D::log()->printWarning(QObject::tr("Mesh Generator"), QObject::tr("Mesh cache file cannot be used, mesh is generated"));
+        }
+    }
+
+    if (meshGenerator && !meshed)
+    {
+        if (meshCache)
+            MeshGeneratorCache::addMiss();
+
+        ProfilerScope profilerScope("mesh generator");
+        meshed = meshGenerator->mesh();
+    }
+
+    if (meshed)
     {
         // load mesh
         try
         {
+            ProfilerScope profilerScope("hermes mesh");
             readInitialMeshesFromFile(emitMeshed, meshGenerator);
             return true;
         }
@@ -659,10 +817,17 @@ void Problem::solve(bool commandLine)
 
         m_isSolving = true;
 
-        solveAction();
+        Agros2D::profiler()->clear();
+        {
+            ProfilerScope profilerScope("solve");
+            solveAction();
+        }
 
         m_lastTimeElapsed = milisecondsToTime(timeCounter.elapsed());
 
+        // performance profile (alongside run time details)
+        Agros2D::profiler()->save(QString("%1/profile.json").arg(cacheProblemDir()));
+
         // elapsed time
         Agros2D::log()->printMessage(QObject::tr("Solver"), QObject::tr("Elapsed time: %1 s").arg(m_lastTimeElapsed.toString("mm:ss.zzz")));
 
@@ -805,37 +970,50 @@ void Problem::solveAction()
                 else
                 {
                     // adaptivity
-                    int adaptStep = 1;
-                    bool doContinueAdaptivity = true;
-                    while (doContinueAdaptivity && (adaptStep <= block->adaptivitySteps()) && !m_abort)
+                    try
                     {
-                        // solve problem
-                        solvers[block]->solveReferenceAndProject(actualTimeStep(), adaptStep - 1);
-                        // create adapted space
-                        doContinueAdaptivity = solvers[block]->createAdaptedSpace(actualTimeStep(), adaptStep);
-
-                        // Python callback
-                        foreach (Field *field, block->fields())
+                        int adaptStep = 1;
+                        bool doContinueAdaptivity = true;
+                        while (doContinueAdaptivity && (adaptStep <= block->adaptivitySteps()) && !m_abort)
                         {
-                            QString command = QString("(agros2d.field(\"%1\").adaptivity_callback(%2) if (agros2d.field(\"%1\").adaptivity_callback is not None and hasattr(agros2d.field(\"%1\").adaptivity_callback, '__call__')) else True)").
-                                arg(field->fieldInfo()->fieldId()).
-                                arg(adaptStep - 1);
+                            // solve problem
+                            solvers[block]->solveReferenceAndProject(actualTimeStep(), adaptStep - 1);
+                            // create adapted space
+                            doContinueAdaptivity = solvers[block]->createAdaptedSpace(actualTimeStep(), adaptStep);
 
-                            double cont = 1.0;
-                            bool successfulRun = currentPythonEngine()->runExpression(command, &cont);
-                            if (!successfulRun)
+                            // Python callback
+                            foreach (Field *field, block->fields())
                             {
-                                ErrorResult result = currentPythonEngine()->parseError();
-                                Agros2D::log()->printError(QObject::tr("Adaptivity callback"), result.error());
+                                QString command = QString("(agros2d.field(\"%1\").adaptivity_callback(%2) if (agros2d.field(\"%1\").adaptivity_callback is not None and hasattr(agros2d.field(\"%1\").adaptivity_callback, '__call__')) else True)").
+                                    arg(field->fieldInfo()->fieldId()).
+                                    arg(adaptStep - 1);
+
+                                double cont = 1.0;
+                                ProfilerScope profilerScope("python callback");
+                                bool successfulRun = currentPythonEngine()->runExpression(command, &cont);
+                                if (!successfulRun)
+                                {
+                                    ErrorResult result = currentPythonEngine()->parseError();
+                                    Agros2D::log()->printError(QObject::tr("Adaptivity callback"), result.error());
+                                }
+
+                                if (!cont)
+                                    doContinueAdaptivity = false;
+                                break;
                             }
 
-                            if (!cont)
-                                doContinueAdaptivity = false;
-                            break;
+                            adaptStep++;
                         }
-
-                        adaptStep++;
                     }
+                    catch (...)
+                    {
+                        // keep reference solution of the last finished step and release adaptivity state also if solving fails
+                        solvers[block]->finishAdaptivity();
+                        throw;
+                    }
+
+                    // reference solution of the last step
+                    solvers[block]->finishAdaptivity();
                 }
 
                 // TODO: it should be estimated in the first step as well
@@ -871,6 +1049,7 @@ void Problem::solveAction()
                         arg(actualTimeStep());
 
                     double cont = 1.0;
+                    ProfilerScope profilerScope("python callback");
                     bool successfulRun = currentPythonEngine()->runExpression(command, &cont);
                     if (!successfulRun)
                     {
@@ -992,6 +1171,9 @@ void Problem::readInitialMeshesFromFile(bool emitMeshed, QSharedPointer<MeshGene
     {
         Hermes::Hermes2D::MeshSharedPtr mesh = meshes[fieldInfo];
 
+        // user markers of internal markers (conversion is done once per marker, not per edge)
+        QHash<int, int> userMarkers;
+
         // check that all boundary edges have a marker assigned
         for (int i = 0; i < mesh->get_max_node_id(); i++)
         {
@@ -999,7 +1181,10 @@ void Problem::readInitialMeshesFromFile(bool emitMeshed, QSharedPointer<MeshGene
 
             if ((node->used == 1 && node->ref < 2 && node->type == 1))
             {
-                int marker = atoi(mesh->get_boundary_markers_conversion().get_user_marker(node->marker).marker.c_str());
+                QHash<int, int>::const_iterator it = userMarkers.constFind(node->marker);
+                if (it == userMarkers.constEnd())
+                    it = userMarkers.insert(node->marker, atoi(mesh->get_boundary_markers_conversion().get_user_marker(node->marker).marker.c_str()));
+                int marker = it.value();
 
                 assert(marker >= 0 || marker == -999);
 
@@ -9,6 +9,9 @@
 
 class FieldInfo;
 class CouplingInfo;
+class Marker;
+class SceneMaterial;
+class SceneBoundary;
 
 class Field;
 class Problem;
@@ -47,6 +50,43 @@ private:
 };
 
 
+// time dependent variables of materials and boundaries in transient fields
+// list is built once (module DOM is not parsed at every time step) and rebuilt when markers are changed
+class TimeFunctionRegistry
+{
+public:
+    TimeFunctionRegistry() : m_isBuilt(false) {}
+
+    // evaluates variables which are not evaluated at given time
+    void update(double time);
+    void clear();
+
+    inline int count() const { return m_entries.count(); }
+
+private:
+    struct Entry
+    {
+        Entry(Marker *marker = NULL, const QString &id = "") : marker(marker), id(id) {}
+
+        Marker *marker;
+        QString id;
+    };
+
+    bool m_isBuilt;
+    QList<Entry> m_entries;
+
+    // markers and transient fields the registry was built from
+    QList<SceneMaterial *> m_materials;
+    QList<SceneBoundary *> m_boundaries;
+    QList<FieldInfo *> m_transientFields;
+
+    QMutex m_mutex;
+
+    bool isValid() const;
+    void build();
+    QList<FieldInfo *> transientFields() const;
+};
+
 /// intented as central for solution process
 /// shielded from gui and QT
 /// holds data describing individual fields, means of coupling and solutions
@@ -158,6 +198,8 @@ public:
 
     QString timeUnit();
 
+    inline TimeFunctionRegistry *timeFunctions() { return &m_timeFunctions; }
+
     void setIsPostprocessingRunning(bool pr = true) { m_isPostprocessingRunning = pr; }
 
 private:
@@ -193,6 +235,8 @@ private:
 
     QList<QPair<double, bool> > m_timeHistory;
 
+    TimeFunctionRegistry m_timeFunctions;
+
     bool skipThisTimeStep(Block* block);
 
     bool mesh(bool emitMeshed);
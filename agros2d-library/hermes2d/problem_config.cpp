@@ -146,6 +146,7 @@ void ProblemConfig::setStringKeys()
     m_settingKey[TimeOrder] = "TimeOrder";
     m_settingKey[TimeConstantTimeSteps] = "TimeSteps";
     m_settingKey[TimeTotal] = "TimeTotal";
+    m_settingKey[TimeMethodErrorEstimator] = "TimeMethodErrorEstimator";
 }
 
 void ProblemConfig::setDefaultValues()
@@ -159,6 +160,7 @@ void ProblemConfig::setDefaultValues()
     m_settingDefault[TimeOrder] = 2;
     m_settingDefault[TimeConstantTimeSteps] = 10;
     m_settingDefault[TimeTotal] = 10.0;
+    m_settingDefault[TimeMethodErrorEstimator] = TimeErrorEstimator_LowerOrder;
 }
 
 // ********************************************************************************************
@@ -49,7 +49,8 @@ public:
         TimeInitialStepSize,
         TimeOrder,
         TimeConstantTimeSteps,
-        TimeTotal
+        TimeTotal,
+        TimeMethodErrorEstimator
     };
 
     ProblemConfig(QWidget *parent = 0);
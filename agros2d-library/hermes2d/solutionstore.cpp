@@ -21,6 +21,7 @@
 
 #include "util/global.h"
 #include "util/constants.h"
+#include "util/profiler.h"
 
 #include "logview.h"
 #include "field.h"
@@ -88,6 +89,7 @@ MultiArray<double> SolutionStore::multiArray(FieldSolutionID solutionID)
     if (!m_multiSolutionCache.contains(solutionID))
     {
         //qDebug() << "Read from disk: " << solutionID.toString();
+        ProfilerScope profilerScope("read solution");
 
         const FieldInfo *fieldInfo = solutionID.group;
         const Block *block = Agros2D::problem()->blockOfField(fieldInfo);
@@ -168,6 +170,16 @@ MultiArray<double> SolutionStore::multiArray(FieldSolutionID solutionID)
             msa.append(space, sln);
         }
 
+        // read coefficient vector
+        QFile fileCoefficients(QString("%1.vec").arg(baseStoreFileName(solutionID)));
+        if (fileCoefficients.open(QIODevice::ReadOnly))
+        {
+            QByteArray data = fileCoefficients.readAll();
+            const double *coefficients = reinterpret_cast<const double *>(data.constData());
+            msa.coefficients().assign(coefficients, coefficients + data.size() / sizeof(double));
+            fileCoefficients.close();
+        }
+
         // insert to the cache
         insertMultiSolutionToCache(solutionID, msa);
 
@@ -193,6 +205,7 @@ MultiArray<double> SolutionStore::multiArray(BlockSolutionID solutionID)
     {
         MultiArray<double> maGroup = multiArray(solutionID.fieldSolutionID(field->fieldInfo()));
         ma.append(maGroup.spaces(), maGroup.solutions());
+        ma.coefficients().insert(ma.coefficients().end(), maGroup.coefficients().begin(), maGroup.coefficients().end());
     }
 
     return ma;
@@ -205,6 +218,8 @@ void SolutionStore::addSolution(FieldSolutionID solutionID, MultiArray<double> m
     assert(solutionID.timeStep >= 0);
     assert(solutionID.adaptivityStep >= 0);
 
+    ProfilerScope profilerScope("store solution");
+
     // save soloution
     QList<SolutionRunTimeDetails::FileName> fileNames;
     for (int i = 0; i < multiSolution.size(); i++)
@@ -279,6 +294,18 @@ void SolutionStore::addSolution(FieldSolutionID solutionID, MultiArray<double> m
         }
     }
 
+    // coefficient vector
+    if (!multiSolution.coefficients().empty())
+    {
+        QFile fileCoefficients(QString("%1.vec").arg(baseFN));
+        if (fileCoefficients.open(QIODevice::WriteOnly))
+        {
+            fileCoefficients.write(reinterpret_cast<const char *>(&multiSolution.coefficients()[0]),
+                                   multiSolution.coefficients().size() * sizeof(double));
+            fileCoefficients.close();
+        }
+    }
+
     runTime.setFileNames(fileNames);
 
     // append multisolution
@@ -336,6 +363,10 @@ void SolutionStore::removeSolution(FieldSolutionID solutionID, bool saveRunTime)
             if (QFile::exists(fnSolution))
                 QFile::remove(fnSolution);
         }
+
+        QString fnCoefficients = QString("%1.vec").arg(fn);
+        if (QFile::exists(fnCoefficients))
+            QFile::remove(fnCoefficients);
     }
 
     // save structure to the file
@@ -654,6 +685,24 @@ void SolutionStore::loadRunTimeDetails()
                                            data.dofs().get());
             runTime.setFileNames(fileNames);
 
+            if (data.linear_solver_iterations().present())
+                runTime.setLinearSolverIterations(data.linear_solver_iterations().get());
+            if (data.linear_solver_inner_iterations().present())
+                runTime.setLinearSolverInnerIterations(data.linear_solver_inner_iterations().get());
+            if (data.linear_solver_residual().present())
+                runTime.setLinearSolverResidual(data.linear_solver_residual().get());
+
+            if (data.profile().present())
+            {
+                QMap<QString, double> profile;
+                for (int j = 0; j < data.profile()->phase().size(); j++)
+                {
+                    XMLStructure::phase phase = data.profile()->phase().at(j);
+                    profile[QString::fromStdString(phase.path())] = phase.time();
+                }
+                runTime.setProfile(profile);
+            }
+
             // append run time details
             m_multiSolutionRunTimeDetails.insert(solutionID,
                                                  runTime);
@@ -712,6 +761,24 @@ void SolutionStore::saveRunTimeDetails()
             data.dofs().set(str.DOFs());
             data.jacobian_calculations().set(str.jacobianCalculations());
 
+            // iterative linear solver (outer and inner iterations of mixed-precision solver)
+            if (str.linearSolverIterations() > 0)
+            {
+                data.linear_solver_iterations().set(str.linearSolverIterations());
+                data.linear_solver_inner_iterations().set(str.linearSolverInnerIterations());
+                data.linear_solver_residual().set(str.linearSolverResidual());
+            }
+
+            // time spent in each phase (ms)
+            if (!str.profile().isEmpty())
+            {
+                XMLStructure::profile profile;
+                foreach (QString path, str.profile().keys())
+                    profile.phase().push_back(XMLStructure::phase(path.toStdString(), str.profile()[path]));
+
+                data.profile().set(profile);
+            }
+
             structure.element_data().push_back(data);
         }
 
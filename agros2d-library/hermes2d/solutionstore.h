@@ -50,13 +50,15 @@ public:
         };
 
         SolutionRunTimeDetails(double time_step_length = 0, double error = 0, int DOFs = 0)
-            : m_timeStepLength(time_step_length), m_adaptivityError(error), m_DOFs(DOFs) {}
+            : m_timeStepLength(time_step_length), m_adaptivityError(error), m_DOFs(DOFs),
+              m_linearSolverIterations(0), m_linearSolverInnerIterations(0), m_linearSolverResidual(0.0) {}
         ~SolutionRunTimeDetails()
         {
             m_fileNames.clear();
             m_relativeChangeOfSolutions.clear();
             m_newtonResidual.clear();
             m_nonlinearDamping.clear();
+            m_profile.clear();
         }
 
         inline double timeStepLength() const { return m_timeStepLength; }
@@ -75,6 +77,16 @@ public:
         inline void setNewtonResidual(QVector<double> value) { m_newtonResidual = value; }
         inline QVector<double> nonlinearDamping() const { return m_nonlinearDamping; }
         inline void setNonlinearDamping(QVector<double> value) { m_nonlinearDamping = value; }
+        // time (ms) spent in each phase of the step (see Profiler)
+        inline QMap<QString, double> profile() const { return m_profile; }
+        inline void setProfile(QMap<QString, double> value) { m_profile = value; }
+        // iterative linear solver (inner iterations are used by mixed-precision solver only)
+        inline int linearSolverIterations() const { return m_linearSolverIterations; }
+        inline void setLinearSolverIterations(int value) { m_linearSolverIterations = value; }
+        inline int linearSolverInnerIterations() const { return m_linearSolverInnerIterations; }
+        inline void setLinearSolverInnerIterations(int value) { m_linearSolverInnerIterations = value; }
+        inline double linearSolverResidual() const { return m_linearSolverResidual; }
+        inline void setLinearSolverResidual(double value) { m_linearSolverResidual = value; }
 
     private:
         double m_timeStepLength;
@@ -86,6 +98,10 @@ public:
         QVector<double> m_relativeChangeOfSolutions;
         QVector<double> m_newtonResidual;
         QVector<double> m_nonlinearDamping;
+        QMap<QString, double> m_profile;
+        int m_linearSolverIterations;
+        int m_linearSolverInnerIterations;
+        double m_linearSolverResidual;
     };
 
     bool contains(FieldSolutionID solutionID) const;
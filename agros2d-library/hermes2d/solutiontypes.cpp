@@ -77,6 +77,7 @@ void MultiArray<Scalar>::clear()
 {
     m_solutions.clear();
     m_spaces.clear();
+    m_coefficients.clear();
 }
 
 template <typename Scalar>
@@ -106,6 +107,18 @@ MultiArray<Scalar> MultiArray<Scalar>::fieldPart(const Block *block, const Field
     {
         msa.append(m_spaces.at(i), m_solutions.at(i));
     }
+
+    // dofs of the components are numbered consecutively
+    if (!m_coefficients.empty())
+    {
+        int firstDof = 0;
+        for (int i = 0; i < offset; i++)
+            firstDof += m_spaces.at(i)->get_num_dofs();
+        int lastDof = firstDof + Hermes::Hermes2D::Space<Scalar>::get_num_dofs(msa.spaces());
+
+        msa.coefficients().assign(m_coefficients.begin() + firstDof, m_coefficients.begin() + lastDof);
+    }
+
     return msa;
 }
 
@@ -71,7 +71,8 @@ class AGROS_LIBRARY_API MultiArray
 public:
     MultiArray();
     MultiArray(Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > spaces,
-               Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > solutions) : m_spaces(spaces), m_solutions(solutions) {}
+               Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > solutions,
+               std::vector<Scalar> coefficients = std::vector<Scalar>()) : m_spaces(spaces), m_solutions(solutions), m_coefficients(coefficients) {}
     ~MultiArray();
 
     void clear();
@@ -82,6 +83,8 @@ public:
 
     Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > &spaces() { return m_spaces; }
     Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > &solutions() { return m_solutions; }
+    // coefficient vector of all components (empty if not known, e.g. constant initial condition)
+    std::vector<Scalar> &coefficients() { return m_coefficients; }
 
     //Hermes::vector<const Hermes::Hermes2D::SpaceSharedPtr<Scalar> > spacesConst() { return m_spaces; }
 
@@ -95,6 +98,7 @@ public:
 private:
     Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > m_spaces;
     Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > m_solutions;
+    std::vector<Scalar> m_coefficients;
 };
 
 //const int LAST_ADAPTIVITY_STEP = -1;
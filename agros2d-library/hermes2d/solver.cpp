@@ -24,6 +24,7 @@
 
 #include "util.h"
 #include "util/global.h"
+#include "util/profiler.h"
 
 #include "field.h"
 #include "block.h"
@@ -44,6 +45,8 @@
 
 #include "pythonlab/pythonengine.h"
 
+#include "paralution.hpp"
+
 using namespace Hermes::Hermes2D;
 
 void SolverAgros::clearSteps()
@@ -220,6 +223,179 @@ void AgrosExternalSolverUMFPack::setSolverCommand()
     //    str += QString("load(\"%1\", \"initial\");\n").arg(fileInitial);
 }
 
+Hermes::Solvers::ExternalSolver<double>* getExternalSolverMixedPrecision(CSCMatrix<double> *m, SimpleVector<double> *rhs)
+{
+    return new AgrosExternalSolverMixedPrecision(m, rhs);
+}
+
+typedef paralution::LocalMatrix<float> ParalutionMatrixSingle;
+typedef paralution::LocalVector<float> ParalutionVectorSingle;
+
+// wraps inner solver of MixedPrecisionDC and sums its iterations over all defect corrections
+class MixedPrecisionInnerSolver : public paralution::Solver<ParalutionMatrixSingle, ParalutionVectorSingle, float>
+{
+public:
+    MixedPrecisionInnerSolver(paralution::IterativeLinearSolver<ParalutionMatrixSingle, ParalutionVectorSingle, float> *solver)
+        : m_solver(solver), m_iterations(0) {}
+
+    virtual void Print() const { m_solver->Print(); }
+
+    virtual void Build()
+    {
+        m_solver->SetOperator(*this->op_);
+        m_solver->Build();
+        this->build_ = true;
+    }
+
+    virtual void Clear()
+    {
+        m_solver->Clear();
+        this->build_ = false;
+    }
+
+    virtual void Solve(const ParalutionVectorSingle &rhs, ParalutionVectorSingle *x)
+    {
+        m_solver->Solve(rhs, x);
+        m_iterations += m_solver->GetIterationCount();
+    }
+
+    virtual void MoveToHost() { m_solver->MoveToHost(); }
+    virtual void MoveToAccelerator() { m_solver->MoveToAccelerator(); }
+
+    inline int iterations() const { return m_iterations; }
+
+protected:
+    virtual void PrintStart_() const {}
+    virtual void PrintEnd_() const {}
+    virtual void MoveToHostLocalData_() {}
+    virtual void MoveToAcceleratorLocalData_() {}
+
+private:
+    paralution::IterativeLinearSolver<ParalutionMatrixSingle, ParalutionVectorSingle, float> *m_solver;
+    int m_iterations;
+};
+
+AgrosExternalSolverMixedPrecision::AgrosExternalSolverMixedPrecision(CSCMatrix<double> *m, SimpleVector<double> *rhs)
+    : ExternalSolver<double>(m, rhs),
+      m_method(Hermes::Solvers::BiCGStab), m_preconditioner(Hermes::Solvers::ILU),
+      m_tolerance(1e-12), m_maxIterations(1000), m_innerTolerance(1e-3), m_outerTolerance(1e-10)
+{
+    clearStatistics();
+}
+
+void AgrosExternalSolverMixedPrecision::setParameters(Hermes::Solvers::IterSolverType method, Hermes::Solvers::PreconditionerType preconditioner,
+                                                      double tolerance, int maxIterations, double innerTolerance, double outerTolerance)
+{
+    m_method = method;
+    m_preconditioner = preconditioner;
+    m_tolerance = tolerance;
+    m_maxIterations = maxIterations;
+    m_innerTolerance = innerTolerance;
+    m_outerTolerance = outerTolerance;
+}
+
+void AgrosExternalSolverMixedPrecision::clearStatistics()
+{
+    m_outerIterations = 0;
+    m_innerIterations = 0;
+    m_residual = 0.0;
+}
+
+void AgrosExternalSolverMixedPrecision::solve()
+{
+    solve(NULL);
+}
+
+void AgrosExternalSolverMixedPrecision::solve(double* initial_guess)
+{
+    int size = this->m->get_size();
+    int nnz = this->m->get_nnz();
+
+    // CSC arrays of A are CSR arrays of A^T
+    paralution::LocalMatrix<double> matrix;
+    matrix.AllocateCSR("matrix", nnz, size, size);
+    matrix.CopyFromCSR(this->m->get_Ap(), this->m->get_Ai(), this->m->get_Ax());
+    matrix.Transpose();
+
+    paralution::LocalVector<double> rhs;
+    rhs.Allocate("rhs", size);
+    paralution::LocalVector<double> solution;
+    solution.Allocate("solution", size);
+    for (int i = 0; i < size; i++)
+    {
+        rhs[i] = this->rhs->get(i);
+        solution[i] = initial_guess ? initial_guess[i] : 0.0;
+    }
+
+    // inner solver (single precision)
+    paralution::IterativeLinearSolver<ParalutionMatrixSingle, ParalutionVectorSingle, float> *krylov = NULL;
+    switch (m_method)
+    {
+    case Hermes::Solvers::CG:
+        krylov = new paralution::CG<ParalutionMatrixSingle, ParalutionVectorSingle, float>();
+        break;
+    case Hermes::Solvers::GMRES:
+        krylov = new paralution::GMRES<ParalutionMatrixSingle, ParalutionVectorSingle, float>();
+        break;
+    case Hermes::Solvers::CR:
+        krylov = new paralution::CR<ParalutionMatrixSingle, ParalutionVectorSingle, float>();
+        break;
+    default:
+        krylov = new paralution::BiCGStab<ParalutionMatrixSingle, ParalutionVectorSingle, float>();
+    }
+
+    paralution::Preconditioner<ParalutionMatrixSingle, ParalutionVectorSingle, float> *preconditioner = NULL;
+    switch (m_preconditioner)
+    {
+    case Hermes::Solvers::Jacobi:
+        preconditioner = new paralution::Jacobi<ParalutionMatrixSingle, ParalutionVectorSingle, float>();
+        break;
+    case Hermes::Solvers::MultiColoredSGS:
+        preconditioner = new paralution::MultiColoredSGS<ParalutionMatrixSingle, ParalutionVectorSingle, float>();
+        break;
+    case Hermes::Solvers::MultiColoredILU:
+        preconditioner = new paralution::MultiColoredILU<ParalutionMatrixSingle, ParalutionVectorSingle, float>();
+        break;
+    case Hermes::Solvers::IC:
+        preconditioner = new paralution::IC<ParalutionMatrixSingle, ParalutionVectorSingle, float>();
+        break;
+    default:
+        // saddle point and multi-elimination need a block structure, use ILU instead
+        preconditioner = new paralution::ILU<ParalutionMatrixSingle, ParalutionVectorSingle, float>();
+    }
+
+    krylov->SetPreconditioner(*preconditioner);
+    krylov->Init(0.0, m_innerTolerance, 1e8, m_maxIterations);
+    krylov->Verbose(0);
+
+    MixedPrecisionInnerSolver inner(krylov);
+
+    // outer defect correction (double precision), stops at absolute or relative tolerance
+    paralution::MixedPrecisionDC<paralution::LocalMatrix<double>, paralution::LocalVector<double>, double,
+            ParalutionMatrixSingle, ParalutionVectorSingle, float> mixedPrecision;
+    mixedPrecision.SetOperator(matrix);
+    mixedPrecision.Init(inner);
+    mixedPrecision.InitTol(m_tolerance, m_outerTolerance, 1e8);
+    mixedPrecision.InitMaxIter(m_maxIterations);
+    mixedPrecision.Verbose(0);
+    mixedPrecision.Build();
+
+    mixedPrecision.Solve(rhs, &solution);
+
+    m_outerIterations += mixedPrecision.GetIterationCount();
+    m_innerIterations += inner.iterations();
+    m_residual = mixedPrecision.GetCurrentResidual();
+
+    delete [] this->sln;
+    this->sln = new double[size];
+    for (int i = 0; i < size; i++)
+        this->sln[i] = solution[i];
+
+    mixedPrecision.Clear();
+    delete krylov;
+    delete preconditioner;
+}
+
 template <typename Scalar>
 void HermesSolverContainer<Scalar>::setMatrixRhsOutputGen(Hermes::Algebra::Mixins::MatrixRhsOutput<Scalar>* solver, QString solverName, int adaptivityStep)
 {
@@ -251,13 +427,27 @@ QSharedPointer<HermesSolverContainer<Scalar> > HermesSolverContainer<Scalar>::fa
             solverName += ", ";
     }
 
-    Hermes::HermesCommonApi.set_integral_param_value(Hermes::matrixSolverType, block->matrixSolver());
     Agros2D::log()->printDebug(QObject::tr("Solver (%1)").arg(solverName), QObject::tr("Linear solver: %1").arg(matrixSolverTypeString(block->matrixSolver())));
 
-    if (block->matrixSolver() == Hermes::SOLVER_EXTERNAL)
+    if ((block->matrixSolver() == Hermes::SOLVER_PARALUTION_ITERATIVE) && block->iterMixedPrecision())
+    {
+        // mixed-precision solver is plugged in through the external solver interface
+        Hermes::HermesCommonApi.set_integral_param_value(Hermes::matrixSolverType, Hermes::SOLVER_EXTERNAL);
+        ExternalSolver<double>::create_external_solver = getExternalSolverMixedPrecision;
+
+        Agros2D::log()->printDebug(QObject::tr("Solver (%1)").arg(solverName), QObject::tr("Mixed-precision defect correction, inner tolerance %1, outer tolerance %2").
+                                   arg(block->iterMixedPrecisionInnerTolerance()).
+                                   arg(block->iterMixedPrecisionOuterTolerance()));
+    }
+    else
     {
-        // register external solver
-        ExternalSolver<double>::create_external_solver = getExternalSolver;
+        Hermes::HermesCommonApi.set_integral_param_value(Hermes::matrixSolverType, block->matrixSolver());
+
+        if (block->matrixSolver() == Hermes::SOLVER_EXTERNAL)
+        {
+            // register external solver
+            ExternalSolver<double>::create_external_solver = getExternalSolver;
+        }
     }
 
     QSharedPointer<HermesSolverContainer<Scalar> > solver;
@@ -293,6 +483,12 @@ QSharedPointer<HermesSolverContainer<Scalar> > HermesSolverContainer<Scalar>::fa
     {
         linearSolver->set_smoother(block->iterLinearSolverType(), block->iterPreconditionerType());
     }
+    if (AgrosExternalSolverMixedPrecision *linearSolver = dynamic_cast<AgrosExternalSolverMixedPrecision *>(solver.data()->linearSolver()))
+    {
+        linearSolver->setParameters(block->iterLinearSolverType(), block->iterPreconditionerType(),
+                                    block->iterLinearSolverToleranceAbsolute(), block->iterLinearSolverIters(),
+                                    block->iterMixedPrecisionInnerTolerance(), block->iterMixedPrecisionOuterTolerance());
+    }
 
     return solver;
 }
@@ -320,6 +516,7 @@ template <typename Scalar>
 ProblemSolver<Scalar>::~ProblemSolver()
 {
     clearActualSpaces();
+    clearReferenceSpaceCache();
 }
 
 template <typename Scalar>
@@ -420,6 +617,14 @@ Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > ProblemSolver<Scalar>:
 
         for (int comp = 0; comp < field->fieldInfo()->numberOfSolutions(); comp++)
         {
+            if (createReference)
+            {
+                newSpaces.push_back(referenceSpace(totalComp, spaces.at(totalComp), refineMesh, orderIncrease));
+
+                totalComp++;
+                continue;
+            }
+
             Hermes::Hermes2D::MeshSharedPtr mesh;
             // deep copy of mesh for each field component separately
             if (refineMesh)
@@ -445,6 +650,93 @@ Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > ProblemSolver<Scalar>:
     return newSpaces;
 }
 
+// elements (topology, markers and vertices) of the coarse mesh
+static QVector<double> coarseMeshSignature(Hermes::Hermes2D::MeshSharedPtr mesh)
+{
+    QVector<double> signature;
+    signature.reserve(8 * mesh->get_max_element_id());
+
+    for (int id = 0; id < mesh->get_max_element_id(); id++)
+    {
+        Element *e = mesh->get_element_fast(id);
+        if (!e->used)
+            continue;
+
+        signature << e->id << e->active << e->marker << e->nvert;
+        for (int i = 0; i < e->nvert; i++)
+            signature << e->vn[i]->x << e->vn[i]->y;
+    }
+
+    return signature;
+}
+
+// maximum number of reference meshes kept for one component
+const int REFERENCE_SPACE_CACHE_SIZE = 3;
+
+int ReferenceSpaceCacheInfo::m_hits = 0;
+int ReferenceSpaceCacheInfo::m_misses = 0;
+
+template <typename Scalar>
+Hermes::Hermes2D::SpaceSharedPtr<Scalar> ProblemSolver<Scalar>::referenceSpace(int component, Hermes::Hermes2D::SpaceSharedPtr<Scalar> space,
+                                                                              bool refineMesh, int orderIncrease)
+{
+    while (m_referenceSpaceCache.size() <= component)
+        m_referenceSpaceCache.append(QList<ReferenceSpaceCacheItem>());
+    QList<ReferenceSpaceCacheItem> &items = m_referenceSpaceCache[component];
+
+    QVector<double> meshSignature = coarseMeshSignature(space->get_mesh());
+
+    // reference mesh is built deterministically from the coarse mesh, reuse it if the coarse mesh is the same
+    Hermes::Hermes2D::MeshSharedPtr mesh;
+    for (int i = 0; i < items.count(); i++)
+    {
+        if ((items.at(i).refineMesh == refineMesh) && (items.at(i).meshSignature == meshSignature))
+        {
+            ReferenceSpaceCacheInfo::addHit();
+            Agros2D::log()->printDebug(m_solverID, QObject::tr("Reference mesh of component %1 reused").arg(component));
+
+            items.move(i, 0);
+            mesh = items.first().mesh;
+            break;
+        }
+    }
+
+    if (!mesh)
+    {
+        ReferenceSpaceCacheInfo::addMiss();
+
+        if (refineMesh)
+        {
+            Mesh::ReferenceMeshCreator meshCreator(space->get_mesh());
+            mesh = meshCreator.create_ref_mesh();
+        }
+        else
+        {
+            mesh = Hermes::Hermes2D::MeshSharedPtr(new Mesh());
+            mesh->copy(space->get_mesh());
+        }
+
+        ReferenceSpaceCacheItem item;
+        item.meshSignature = meshSignature;
+        item.refineMesh = refineMesh;
+        item.mesh = mesh;
+
+        items.prepend(item);
+        while (items.count() > REFERENCE_SPACE_CACHE_SIZE)
+            items.removeLast();
+    }
+
+    // new space (essential boundary conditions and dofs of the space are changed by the solver)
+    Space<double>::ReferenceSpaceCreator spaceCreator(space, mesh, orderIncrease);
+    return spaceCreator.create_ref_space();
+}
+
+template <typename Scalar>
+void ProblemSolver<Scalar>::clearReferenceSpaceCache()
+{
+    m_referenceSpaceCache.clear();
+}
+
 template <typename Scalar>
 void ProblemSolver<Scalar>::setActualSpaces(Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > spaces)
 {
@@ -458,36 +750,106 @@ void ProblemSolver<Scalar>::clearActualSpaces()
     m_actualSpaces.clear();
 }
 
+template <typename Scalar>
+bool ProblemSolver<Scalar>::isMatrixPatternUnchanged(Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > spaces)
+{
+    // space sequence number changes with every refinement or dof assignment
+    QList<int> pattern;
+    for (int i = 0; i < spaces.size(); i++)
+        pattern << spaces[i]->get_seq() << spaces[i]->get_num_dofs();
+
+    bool unchanged = (pattern == m_matrixPattern);
+    m_matrixPattern = pattern;
+
+    return unchanged;
+}
+
 template <typename Scalar>
 Scalar *ProblemSolver<Scalar>::solveOneProblem(Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > spaces,
                                                int adaptivityStep,
                                                Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > previousSolution)
 {
+    ProfilerScope profilerScope("solve");
+
     LinearMatrixSolver<Scalar> *linearSolver = m_hermesSolverContainer->linearSolver();
 
     if (m_block->isTransient())
         linearSolver->set_reuse_scheme(HERMES_REUSE_MATRIX_REORDERING);
 
+    // reuse AMG hierarchy and preconditioner while the matrix pattern is unchanged,
+    // the complete factorization only if the matrix values are unchanged as well
+    bool patternUnchanged = isMatrixPatternUnchanged(spaces);
+    if (isMatrixSolverIterative(m_block->matrixSolver()) && m_block->iterReusePreconditioner())
+    {
+        if (!patternUnchanged)
+            linearSolver->set_reuse_scheme(HERMES_CREATE_STRUCTURE_FROM_SCRATCH);
+        else if (m_hermesSolverContainer->matrixUnchanged() && !m_block->amgNumericRefresh())
+            linearSolver->set_reuse_scheme(HERMES_REUSE_MATRIX_STRUCTURE_COMPLETELY);
+        else
+            linearSolver->set_reuse_scheme(HERMES_REUSE_MATRIX_REORDERING_AND_SCALING);
+    }
+
     m_hermesSolverContainer->setMatrixRhsOutput(m_solverCode, adaptivityStep);
 
     if (LoopSolver<Scalar> *iterLinearSolver = dynamic_cast<LoopSolver<Scalar> *>(linearSolver))
     {
         // iterative solver
         Scalar *initialSolutionVector = new Scalar[Hermes::Hermes2D::Space<Scalar>::get_num_dofs(spaces)];
-        m_hermesSolverContainer->projectPreviousSolution(initialSolutionVector, spaces, previousSolution);
-        m_hermesSolverContainer->solve(initialSolutionVector);
+        {
+            ProfilerScope profilerScope("projection");
+            m_hermesSolverContainer->projectPreviousSolution(initialSolutionVector, spaces, previousSolution);
+        }
+        {
+            ProfilerScope profilerScope("assembly and solve");
+            m_hermesSolverContainer->solve(initialSolutionVector);
+        }
 
         delete [] initialSolutionVector;
 
+        m_linearSolverIterations = iterLinearSolver->get_num_iters();
+        m_linearSolverInnerIterations = 0;
+        m_linearSolverResidual = iterLinearSolver->get_residual_norm();
+
         Agros2D::log()->printDebug(QObject::tr("Solver"),
                                    QObject::tr("Iterative solver statistics: %1 iterations, residual %2")
                                    .arg(iterLinearSolver->get_num_iters())
                                    .arg(iterLinearSolver->get_residual_norm()));
     }
+    else if (AgrosExternalSolverMixedPrecision *mixedLinearSolver = dynamic_cast<AgrosExternalSolverMixedPrecision *>(linearSolver))
+    {
+        // mixed-precision iterative solver
+        Scalar *initialSolutionVector = new Scalar[Hermes::Hermes2D::Space<Scalar>::get_num_dofs(spaces)];
+        {
+            ProfilerScope profilerScope("projection");
+            m_hermesSolverContainer->projectPreviousSolution(initialSolutionVector, spaces, previousSolution);
+        }
+        mixedLinearSolver->clearStatistics();
+        {
+            ProfilerScope profilerScope("assembly and solve");
+            m_hermesSolverContainer->solve(initialSolutionVector);
+        }
+
+        delete [] initialSolutionVector;
+
+        m_linearSolverIterations = mixedLinearSolver->outerIterations();
+        m_linearSolverInnerIterations = mixedLinearSolver->innerIterations();
+        m_linearSolverResidual = mixedLinearSolver->residual();
+
+        Agros2D::log()->printDebug(QObject::tr("Solver"),
+                                   QObject::tr("Mixed-precision solver statistics: %1 outer iterations, %2 inner iterations, residual %3")
+                                   .arg(m_linearSolverIterations)
+                                   .arg(m_linearSolverInnerIterations)
+                                   .arg(m_linearSolverResidual));
+    }
     else
     {
         // direct solver
+        ProfilerScope profilerScope("assembly and solve");
         m_hermesSolverContainer->solve(nullptr);
+
+        m_linearSolverIterations = 0;
+        m_linearSolverInnerIterations = 0;
+        m_linearSolverResidual = 0.0;
     }
 
     return m_hermesSolverContainer->slnVector();
@@ -496,6 +858,9 @@ Scalar *ProblemSolver<Scalar>::solveOneProblem(Hermes::vector<Hermes::Hermes2D::
 template <typename Scalar>
 void ProblemSolver<Scalar>::solveSimple(int timeStep, int adaptivityStep)
 {
+    ProfilerScope profilerScope("step");
+    int profilerMark = Agros2D::profiler()->mark();
+
     // to be used as starting vector for the Newton solver
     MultiArray<Scalar> previousTSMultiSolutionArray;
     // if ((m_block->isTransient() && m_block->linearityType() != LinearityType_Linear) && (timeStep > 0))
@@ -539,18 +904,26 @@ void ProblemSolver<Scalar>::solveSimple(int timeStep, int adaptivityStep)
         Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > solutions = createSolutions<Scalar>(spacesMeshes(actualSpaces()));
         Solution<Scalar>::vector_to_solutions(solutionVector, actualSpaces(), solutions);
 
+        int ndof = Hermes::Hermes2D::Space<Scalar>::get_num_dofs(actualSpaces());
+
         BlockSolutionID solutionID(m_block, timeStep, adaptivityStep, SolutionMode_Normal);
         SolutionStore::SolutionRunTimeDetails runTime(Agros2D::problem()->actualTimeStepLength(),
                                                       0.0,
-                                                      Hermes::Hermes2D::Space<double>::get_num_dofs(actualSpaces()));
+                                                      ndof);
 
         SolverAgros *solver = m_hermesSolverContainer.data()->solver();
         runTime.setNewtonResidual(solver->residualNorms());
         runTime.setNonlinearDamping(solver->damping());
         runTime.setJacobianCalculations(solver->jacobianCalculations());
         runTime.setRelativeChangeOfSolutions(solver->relativeChangeOfSolutions());
-
-        Agros2D::solutionStore()->addSolution(solutionID, MultiArray<Scalar>(actualSpaces(), solutions), runTime);
+        runTime.setProfile(Agros2D::profiler()->summary(profilerMark));
+        runTime.setLinearSolverIterations(m_linearSolverIterations);
+        runTime.setLinearSolverInnerIterations(m_linearSolverInnerIterations);
+        runTime.setLinearSolverResidual(m_linearSolverResidual);
+
+        Agros2D::solutionStore()->addSolution(solutionID,
+                                              MultiArray<Scalar>(actualSpaces(), solutions, std::vector<Scalar>(solutionVector, solutionVector + ndof)),
+                                              runTime);
     }
     catch (AgrosSolverException e)
     {
@@ -558,35 +931,75 @@ void ProblemSolver<Scalar>::solveSimple(int timeStep, int adaptivityStep)
     }
 }
 
-template <typename Scalar>
-TimeStepInfo ProblemSolver<Scalar>::estimateTimeStepLength(int timeStep, int adaptivityStep)
+TimeExtrapolationFilter::TimeExtrapolationFilter(Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<double> > sln, const QVector<double> &weights)
+    : Hermes::Hermes2D::Filter<double>(sln), m_weights(weights)
 {
-    double timeTotal = Agros2D::problem()->config()->value(ProblemConfig::TimeTotal).toDouble();
+    assert(m_weights.size() == this->num);
+}
 
-    // TODO: move to some config?
-    const double relativeTimeStepLen = Agros2D::problem()->actualTimeStepLength() / timeTotal;
-    const double maxTimeStepRatio = relativeTimeStepLen > 0.02 ? 2.0 : 3.0; // small steps may rise faster
-    const double maxTimeStepLength = timeTotal / 10;
-    const double maxToleranceMultiplyToAccept = 2.5; //3.0;
+Hermes::Hermes2D::Func<double> *TimeExtrapolationFilter::get_pt_value(double x, double y, bool use_MeshHashGrid, Hermes::Hermes2D::Element* e)
+{
+    return NULL;
+}
 
-    TimeStepMethod timeStepMethod = (TimeStepMethod) Agros2D::problem()->config()->value(ProblemConfig::TimeMethod).toInt();
-    if(timeStepMethod == TimeStepMethod_Fixed)
-        return TimeStepInfo(Agros2D::problem()->config()->constantTimeStepLength());
+void TimeExtrapolationFilter::precalculate(int order, int mask)
+{
+    Hermes::Hermes2D::Quad2D* quad = this->quads[Hermes::Hermes2D::Function<double>::cur_quad];
+    int np = quad->get_num_points(order, this->get_active_element()->get_mode());
+
+    for (int i = 0; i < np; i++)
+    {
+        this->values[0][0][i] = 0.0;
+        this->values[0][1][i] = 0.0;
+        this->values[0][2][i] = 0.0;
+    }
+
+    for (int k = 0; k < this->num; k++)
+    {
+        this->sln[k]->set_quad_order(order, Hermes::Hermes2D::H2D_FN_DEFAULT);
+        const double *value = this->sln[k]->get_fn_values();
+        const double *dudx = this->sln[k]->get_dx_values();
+        const double *dudy = this->sln[k]->get_dy_values();
+
+        for (int i = 0; i < np; i++)
+        {
+            this->values[0][0][i] += m_weights[k] * value[i];
+            this->values[0][1][i] += m_weights[k] * dudx[i];
+            this->values[0][2][i] += m_weights[k] * dudy[i];
+        }
+    }
+}
+
+TimeExtrapolationFilter* TimeExtrapolationFilter::clone() const
+{
+    Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<double> > slns;
+
+    for (int i = 0; i < this->num; i++)
+        slns.push_back(this->sln[i]->clone());
 
+    return new TimeExtrapolationFilter(slns, m_weights);
+}
+
+QVector<double> TimeExtrapolationFilter::weights(const QVector<double> &times, double t)
+{
+    QVector<double> weights(times.size(), 1.0);
+    for (int j = 0; j < times.size(); j++)
+        for (int m = 0; m < times.size(); m++)
+            if (m != j)
+                weights[j] *= (t - times[m]) / (times[j] - times[m]);
+
+    return weights;
+}
+
+template <typename Scalar>
+double ProblemSolver<Scalar>::timeErrorLowerOrder(int timeStep, int adaptivityStep)
+{
     MultiArray<Scalar> referenceCalculation =
             Agros2D::solutionStore()->multiArray(Agros2D::solutionStore()->lastTimeAndAdaptiveSolution(m_block, SolutionMode_Normal));
 
     // todo: ensure this in gui
     assert(Agros2D::problem()->config()->value(ProblemConfig::TimeOrder).toInt() >= 2);
 
-    // todo: in the first step, I am acualy using order 1 and thus I am unable to decrease it!
-    // this is not good, since the second step is not calculated (and the error of the first is not being checked)
-    if (timeStep == 1)
-    {
-        m_averageErrorToLenghtRatio = 0.;
-        return TimeStepInfo(Agros2D::problem()->actualTimeStepLength());
-    }
-
     int previouslyUsedOrder = min(timeStep, Agros2D::problem()->config()->value(ProblemConfig::TimeOrder).toInt());
     bool matrixUnchanged = m_block->weakForm()->bdf2Table()->setOrderAndPreviousSteps(previouslyUsedOrder - 1, Agros2D::problem()->timeStepLengths());
     // using different order
@@ -606,10 +1019,109 @@ TimeStepInfo ProblemSolver<Scalar>::estimateTimeStepLength(int timeStep, int ada
     Solution<Scalar>::vector_to_solutions(solutionVector, actualSpaces(), solutions);
 
     // error calculation
+    ProfilerScope profilerScopeError("error estimation");
     DefaultErrorCalculator<double, HERMES_H1_NORM> errorCalculator(RelativeErrorToGlobalNorm, solutions.size());
     // calculate error the total error estimate.
     errorCalculator.calculate_errors(referenceCalculation.solutions(), solutions, false);
-    double error = errorCalculator.get_total_error_squared();
+
+    return errorCalculator.get_total_error_squared();
+}
+
+template <typename Scalar>
+double ProblemSolver<Scalar>::timeErrorEmbedded(int timeStep)
+{
+    // predictor has the same order as the corrector only if enough previous levels are stored
+    // (start-up steps are estimated by the lower order solution)
+    int usedOrder = min(timeStep, Agros2D::problem()->config()->value(ProblemConfig::TimeOrder).toInt());
+    if (timeStep - 1 - usedOrder < 0)
+        return -1.0;
+
+    ProfilerScope profilerScopeError("error estimation");
+
+    // times of levels relative to the actual time (level timeStep - 1 - j)
+    QList<double> lengths = Agros2D::problem()->timeStepLengths();
+    QVector<double> times;
+    double time = 0.0;
+    for (int j = 0; j <= usedOrder; j++)
+    {
+        time -= lengths.at(timeStep - 1 - j);
+        times.append(time);
+    }
+
+    // previous solutions (components of all levels)
+    QList<Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<double> > > previousSolutions;
+    for (int j = 0; j <= usedOrder; j++)
+    {
+        int level = timeStep - 1 - j;
+        int adaptivityStep = Agros2D::solutionStore()->lastAdaptiveStep(m_block, SolutionMode_Normal, level);
+        if (adaptivityStep < 0)
+            return -1.0;
+
+        BlockSolutionID solutionID(m_block, level, adaptivityStep, SolutionMode_Normal);
+        foreach (Field *field, m_block->fields())
+            if (!Agros2D::solutionStore()->contains(solutionID.fieldSolutionID(field->fieldInfo())))
+                return -1.0;
+
+        previousSolutions.append(Agros2D::solutionStore()->multiArray(solutionID).solutions());
+    }
+
+    MultiArray<Scalar> correctorCalculation =
+            Agros2D::solutionStore()->multiArray(Agros2D::solutionStore()->lastTimeAndAdaptiveSolution(m_block, SolutionMode_Normal));
+    Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > corrector = correctorCalculation.solutions();
+
+    // predictor (polynomial extrapolation of previous levels)
+    QVector<double> weights = TimeExtrapolationFilter::weights(times, 0.0);
+    Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > predictor;
+    for (int comp = 0; comp < (int) corrector.size(); comp++)
+    {
+        Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<double> > levels;
+        for (int j = 0; j <= usedOrder; j++)
+            levels.push_back(previousSolutions.at(j).at(comp));
+
+        predictor.push_back(Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar>(new TimeExtrapolationFilter(levels, weights)));
+    }
+
+    DefaultErrorCalculator<double, HERMES_H1_NORM> errorCalculator(RelativeErrorToGlobalNorm, corrector.size());
+    errorCalculator.calculate_errors(predictor, corrector, false);
+
+    // local error of the corrector (Milne's device for variable step BDF)
+    double factor = Agros2D::problem()->actualTimeStepLength() / (- times.last());
+    return factor * factor * errorCalculator.get_total_error_squared();
+}
+
+template <typename Scalar>
+TimeStepInfo ProblemSolver<Scalar>::estimateTimeStepLength(int timeStep, int adaptivityStep)
+{
+    double timeTotal = Agros2D::problem()->config()->value(ProblemConfig::TimeTotal).toDouble();
+
+    // TODO: move to some config?
+    const double relativeTimeStepLen = Agros2D::problem()->actualTimeStepLength() / timeTotal;
+    const double maxTimeStepRatio = relativeTimeStepLen > 0.02 ? 2.0 : 3.0; // small steps may rise faster
+    const double maxTimeStepLength = timeTotal / 10;
+    const double maxToleranceMultiplyToAccept = 2.5; //3.0;
+
+    TimeStepMethod timeStepMethod = (TimeStepMethod) Agros2D::problem()->config()->value(ProblemConfig::TimeMethod).toInt();
+    if(timeStepMethod == TimeStepMethod_Fixed)
+        return TimeStepInfo(Agros2D::problem()->config()->constantTimeStepLength());
+
+    ProfilerScope profilerScope("time step estimation");
+
+    // todo: in the first step, I am acualy using order 1 and thus I am unable to decrease it!
+    // this is not good, since the second step is not calculated (and the error of the first is not being checked)
+    if (timeStep == 1)
+    {
+        m_averageErrorToLenghtRatio = 0.;
+        m_previousTimeError = 0.;
+        return TimeStepInfo(Agros2D::problem()->actualTimeStepLength());
+    }
+
+    double error = -1.0;
+    TimeErrorEstimator errorEstimator = (TimeErrorEstimator) Agros2D::problem()->config()->value(ProblemConfig::TimeMethodErrorEstimator).toInt();
+    if (errorEstimator == TimeErrorEstimator_Embedded)
+        error = timeErrorEmbedded(timeStep);
+    // lower order solution (or fallback of the embedded estimator)
+    if (error < 0.0)
+        error = timeErrorLowerOrder(timeStep, adaptivityStep);
 
     // update
     double actualRatio = error / Agros2D::problem()->actualTimeStepLength();
@@ -643,9 +1155,15 @@ TimeStepInfo ProblemSolver<Scalar>::estimateTimeStepLength(int timeStep, int ada
     double nextTimeStepLength;
     if(error == 0)
         nextTimeStepLength = maxTimeStepLength;
+    else if ((errorEstimator == TimeErrorEstimator_Embedded) && !refuseThisStep && (m_previousTimeError > 0.0))
+        // PI controller (smoother step sequence, less refused steps)
+        nextTimeStepLength = pow(TOL / error, 0.7 / (timeOrder + 1)) * pow(m_previousTimeError / error, 0.4 / (timeOrder + 1)) * Agros2D::problem()->actualTimeStepLength();
     else
         nextTimeStepLength = pow(TOL / error, 1.0 / (timeOrder + 1)) * Agros2D::problem()->actualTimeStepLength();
 
+    if (!refuseThisStep)
+        m_previousTimeError = error;
+
     nextTimeStepLength = min(nextTimeStepLength, maxTimeStepLength);
     nextTimeStepLength = min(nextTimeStepLength, Agros2D::problem()->actualTimeStepLength() * maxTimeStepRatio);
     nextTimeStepLength = max(nextTimeStepLength, Agros2D::problem()->actualTimeStepLength() / maxTimeStepRatio);
@@ -671,7 +1189,11 @@ void ProblemSolver<Scalar>::createInitialSpace()
     if (!Agros2D::problem()->isMeshed())
         throw AgrosSolverException(QObject::tr("Problem is not meshed"));
 
+    ProfilerScope profilerScope("space");
+
     clearActualSpaces();
+    // new spaces and boundary conditions
+    clearReferenceSpaceCache();
 
     m_block->createBoundaryConditions();
 
@@ -742,6 +1264,7 @@ void ProblemSolver<Scalar>::createInitialSpace()
 
     assert(!m_hermesSolverContainer);
     m_hermesSolverContainer = HermesSolverContainer<Scalar>::factory(m_block);
+    m_matrixPattern.clear();
 
     m_hermesSolverContainer->setWeakFormulation(m_block->weakForm());
     m_hermesSolverContainer->setTableSpaces()->set_spaces(m_actualSpaces);
@@ -754,6 +1277,9 @@ void ProblemSolver<Scalar>::solveReferenceAndProject(int timeStep, int adaptivit
     //    MultiSolutionArray<Scalar> msa = Agros2D::solutionStore()->multiSolution(BlockSolutionID(m_block, timeStep, adaptivityStep, solutionMode));
     //    MultiSolutionArray<Scalar> msaRef;
 
+    ProfilerScope profilerScope("step");
+    int profilerMark = Agros2D::profiler()->mark();
+
     if (Agros2D::problem()->isTransient())
     {
         if((adaptivityStep == 0) && (timeStep > 1))
@@ -814,7 +1340,11 @@ void ProblemSolver<Scalar>::solveReferenceAndProject(int timeStep, int adaptivit
     m_block->weakForm()->updateExtField();
 
     // create reference spaces
-    Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > spacesRef = deepMeshAndSpaceCopy(actualSpaces(), true);
+    Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > spacesRef;
+    {
+        ProfilerScope profilerScope("reference space");
+        spacesRef = deepMeshAndSpaceCopy(actualSpaces(), true);
+    }
     assert(actualSpaces().size() == spacesRef.size());
 
     // todo: delete? je to vubec potreba?
@@ -823,20 +1353,36 @@ void ProblemSolver<Scalar>::solveReferenceAndProject(int timeStep, int adaptivit
     // solve reference problem
 
     // in adaptivity, in each step we use different spaces. This should be done some other way
-    m_hermesSolverContainer->setTableSpaces()->set_spaces(spacesRef);
-    Scalar *solutionVector = solveOneProblem(spacesRef, adaptivityStep,
-                                             Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> >());
+    Scalar *solutionVector = NULL;
+    {
+        ProfilerScope profilerScope("reference solution");
+        m_hermesSolverContainer->setTableSpaces()->set_spaces(spacesRef);
+        solutionVector = solveOneProblem(spacesRef, adaptivityStep,
+                                         Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> >());
+    }
 
     // output reference solution
     Hermes::vector<Hermes::Hermes2D::MeshSharedPtr> meshesRef = spacesMeshes(spacesRef);
     Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > solutionsRef = createSolutions<Scalar>(meshesRef);
     Solution<Scalar>::vector_to_solutions(solutionVector, spacesRef, solutionsRef);
 
-    BlockSolutionID referenceSolutionID(m_block, timeStep, adaptivityStep, SolutionMode_Reference);
+    int ndofRef = Hermes::Hermes2D::Space<Scalar>::get_num_dofs(spacesRef);
     SolutionStore::SolutionRunTimeDetails runTimeRef(Agros2D::problem()->actualTimeStepLength(),
                                                      0.0,
-                                                     Hermes::Hermes2D::Space<double>::get_num_dofs(spacesRef));
-    Agros2D::solutionStore()->addSolution(referenceSolutionID, MultiArray<Scalar>(spacesRef, solutionsRef), runTimeRef);
+                                                     ndofRef);
+
+    // reference solution is handed over to createAdaptedSpace in memory, the store is optional
+    m_adaptivityReferenceSolution = MultiArray<Scalar>(spacesRef, solutionsRef, std::vector<Scalar>(solutionVector, solutionVector + ndofRef));
+    m_adaptivityReferenceRunTime = runTimeRef;
+    m_adaptivityReferenceStored = false;
+
+    if (referenceRetention() == AdaptivityReferenceRetention_All)
+    {
+        ProfilerScope profilerScope("reference store");
+        BlockSolutionID referenceSolutionID(m_block, timeStep, adaptivityStep, SolutionMode_Reference);
+        Agros2D::solutionStore()->addSolution(referenceSolutionID, m_adaptivityReferenceSolution, runTimeRef);
+        m_adaptivityReferenceStored = true;
+    }
 
     // copy spaces and create empty solutions
     //Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > spacesCopy = deepMeshAndSpaceCopy(actualSpaces(), false);
@@ -844,30 +1390,56 @@ void ProblemSolver<Scalar>::solveReferenceAndProject(int timeStep, int adaptivit
     Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > solutions = createSolutions<Scalar>(meshes);
 
     // project the fine mesh solution onto the coarse mesh.
-    Hermes::Hermes2D::OGProjection<Scalar> ogProjection;
-    ogProjection.project_global(actualSpaces(), solutionsRef, solutions);
+    std::vector<Scalar> coefficients(Hermes::Hermes2D::Space<Scalar>::get_num_dofs(actualSpaces()));
+    {
+        ProfilerScope profilerScope("projection");
+        Hermes::Hermes2D::OGProjection<Scalar> ogProjection;
+        ogProjection.project_global(actualSpaces(), solutionsRef, &coefficients[0]);
+        Solution<Scalar>::vector_to_solutions(&coefficients[0], actualSpaces(), solutions);
+    }
 
     // save the solution
     BlockSolutionID solutionID(m_block, timeStep, adaptivityStep, SolutionMode_Normal);
     SolutionStore::SolutionRunTimeDetails runTime(Agros2D::problem()->actualTimeStepLength(),
                                                   0.0,
-                                                  Hermes::Hermes2D::Space<double>::get_num_dofs(actualSpaces()));
+                                                  coefficients.size());
 
     SolverAgros *solver = m_hermesSolverContainer.data()->solver();
     runTime.setNewtonResidual(solver->residualNorms());
     runTime.setNonlinearDamping(solver->damping());
     runTime.setJacobianCalculations(solver->jacobianCalculations());
     runTime.setRelativeChangeOfSolutions(solver->relativeChangeOfSolutions());
+    runTime.setProfile(Agros2D::profiler()->summary(profilerMark));
+    runTime.setLinearSolverIterations(m_linearSolverIterations);
+    runTime.setLinearSolverInnerIterations(m_linearSolverInnerIterations);
+    runTime.setLinearSolverResidual(m_linearSolverResidual);
 
-    MultiArray<Scalar> msa(actualSpaces(), solutions);
+    MultiArray<Scalar> msa(actualSpaces(), solutions, coefficients);
     Agros2D::solutionStore()->addSolution(solutionID, msa, runTime);
+
+    m_adaptivitySolution = msa;
+    m_adaptivityTimeStep = timeStep;
+    m_adaptivityStep = adaptivityStep;
 }
 
 template <typename Scalar>
 bool ProblemSolver<Scalar>::createAdaptedSpace(int timeStep, int adaptivityStep)
 {
-    MultiArray<Scalar> msa = Agros2D::solutionStore()->multiArray(BlockSolutionID(m_block, timeStep, adaptivityStep - 1, SolutionMode_Normal));
-    MultiArray<Scalar> msaRef = Agros2D::solutionStore()->multiArray(BlockSolutionID(m_block, timeStep, adaptivityStep - 1, SolutionMode_Reference));
+    ProfilerScope profilerScope("adaptivity");
+
+    MultiArray<Scalar> msa;
+    MultiArray<Scalar> msaRef;
+    if ((m_adaptivityTimeStep == timeStep) && (m_adaptivityStep == adaptivityStep - 1))
+    {
+        // solutions of the last step are still in memory
+        msa = m_adaptivitySolution;
+        msaRef = m_adaptivityReferenceSolution;
+    }
+    else
+    {
+        msa = Agros2D::solutionStore()->multiArray(BlockSolutionID(m_block, timeStep, adaptivityStep - 1, SolutionMode_Normal));
+        msaRef = Agros2D::solutionStore()->multiArray(BlockSolutionID(m_block, timeStep, adaptivityStep - 1, SolutionMode_Reference));
+    }
 
     Hermes::vector<QSharedPointer<Hermes::Hermes2D::RefinementSelectors::Selector<Scalar> > > selector;
     initSelectors(selector);
@@ -904,7 +1476,7 @@ bool ProblemSolver<Scalar>::createAdaptedSpace(int timeStep, int adaptivityStep)
     foreach (Field *field, m_block->fields())
     {
         // error calculation & adaptivity.
-        QSharedPointer<ErrorCalculator<double> > errorCalculator = QSharedPointer<ErrorCalculator<double> >(
+        QSharedPointer<ErrorCalculatorAgros<double> > errorCalculator = QSharedPointer<ErrorCalculatorAgros<double> >(
                     field->fieldInfo()->plugin()->errorCalculator(field->fieldInfo(),
                                                                   field->fieldInfo()->value(FieldInfo::AdaptivityErrorCalculator).toString(),
                                                                   Hermes::Hermes2D::RelativeErrorToGlobalNorm));
@@ -915,8 +1487,12 @@ bool ProblemSolver<Scalar>::createAdaptedSpace(int timeStep, int adaptivityStep)
         adaptivity.set_verbose_output(false);
 
         // calculate error the total error estimate.
-        errorCalculator.data()->calculate_errors(msa.solutions(), msaRef.solutions(), true);
-        double error = errorCalculator.data()->get_total_error_squared() * 100;
+        double error = 0.0;
+        {
+            ProfilerScope profilerScope("error estimation");
+            errorCalculator.data()->calculateErrors(msa.solutions(), msaRef.solutions(), true);
+            error = errorCalculator.data()->get_total_error_squared() * 100;
+        }
 
         FieldSolutionID solutionID(field->fieldInfo(), timeStep, adaptivityStep - 1, SolutionMode_Normal);
 
@@ -947,6 +1523,7 @@ bool ProblemSolver<Scalar>::createAdaptedSpace(int timeStep, int adaptivityStep)
                 foreach (QSharedPointer<Hermes::Hermes2D::RefinementSelectors::Selector<Scalar> > sel, selector)
                     vect.push_back(sel.data());
 
+                ProfilerScope profilerScope("refinement");
                 noRefinementPerformed = adaptivity.adapt(vect);
             }
             catch (Hermes::Exceptions::Exception e)
@@ -963,6 +1540,35 @@ bool ProblemSolver<Scalar>::createAdaptedSpace(int timeStep, int adaptivityStep)
     return adapt;
 }
 
+template <typename Scalar>
+void ProblemSolver<Scalar>::finishAdaptivity()
+{
+    if ((m_adaptivityStep >= 0) && !m_adaptivityReferenceStored
+            && (referenceRetention() == AdaptivityReferenceRetention_Last))
+    {
+        BlockSolutionID referenceSolutionID(m_block, m_adaptivityTimeStep, m_adaptivityStep, SolutionMode_Reference);
+        Agros2D::solutionStore()->addSolution(referenceSolutionID, m_adaptivityReferenceSolution, m_adaptivityReferenceRunTime);
+    }
+
+    m_adaptivitySolution.clear();
+    m_adaptivityReferenceSolution.clear();
+    m_adaptivityReferenceStored = false;
+    m_adaptivityTimeStep = -1;
+    m_adaptivityStep = -1;
+}
+
+template <typename Scalar>
+AdaptivityReferenceRetention ProblemSolver<Scalar>::referenceRetention() const
+{
+    AdaptivityReferenceRetention retention = m_block->adaptivityReferenceRetention();
+
+    // previous time levels of transient problems use the last reference solution (see WeakFormAgros)
+    if (m_block->isTransient() && (retention == AdaptivityReferenceRetention_None))
+        retention = AdaptivityReferenceRetention_Last;
+
+    return retention;
+}
+
 template <typename Scalar>
 void ProblemSolver<Scalar>::solveInitialTimeStep()
 {
@@ -986,13 +1592,18 @@ void ProblemSolver<Scalar>::solveInitialTimeStep()
 
     QList<SolutionStore::SolutionRunTimeDetails::FileName> fileNames;
 
+    // coefficients of the initial condition
+    std::vector<Scalar> coefficients(Hermes::Hermes2D::Space<Scalar>::get_num_dofs(actualSpaces()));
+    Hermes::Hermes2D::OGProjection<Scalar> ogProjection;
+    ogProjection.project_global(actualSpaces(), solutions, &coefficients[0]);
+
     BlockSolutionID solutionID(m_block, 0, 0, SolutionMode_Normal);
     SolutionStore::SolutionRunTimeDetails runTime(Agros2D::problem()->actualTimeStepLength(),
                                                   0.0,
-                                                  Hermes::Hermes2D::Space<double>::get_num_dofs(actualSpaces()));
+                                                  coefficients.size());
 
     Agros2D::solutionStore()->addSolution(solutionID,
-                                          MultiArray<Scalar>(actualSpaces(), solutions),
+                                          MultiArray<Scalar>(actualSpaces(), solutions, coefficients),
                                           runTime);
 }
 
@@ -1006,6 +1617,7 @@ void ProblemSolver<Scalar>::resumeAdaptivityProcess(int adaptivityStep)
 
     assert(!m_hermesSolverContainer);
     m_hermesSolverContainer = HermesSolverContainer<Scalar>::factory(m_block);
+    m_matrixPattern.clear();
 
 }
 
@@ -22,6 +22,7 @@
 
 #include "util.h"
 #include "solutiontypes.h"
+#include "solutionstore.h"
 
 class Block;
 class FieldInfo;
@@ -118,6 +119,38 @@ public:
     virtual void setSolverCommand();
 };
 
+// PARALUTION mixed-precision defect correction (double precision outer loop,
+// single precision Krylov method with preconditioner as inner solver)
+class AgrosExternalSolverMixedPrecision : public ExternalSolver<double>
+{
+public:
+    AgrosExternalSolverMixedPrecision(CSCMatrix<double> *m, SimpleVector<double> *rhs);
+
+    void solve();
+    void solve(double* initial_guess);
+
+    void setParameters(Hermes::Solvers::IterSolverType method, Hermes::Solvers::PreconditionerType preconditioner,
+                       double tolerance, int maxIterations, double innerTolerance, double outerTolerance);
+
+    // statistics accumulated since the last clearStatistics()
+    inline int outerIterations() const { return m_outerIterations; }
+    inline int innerIterations() const { return m_innerIterations; }
+    inline double residual() const { return m_residual; }
+    void clearStatistics();
+
+private:
+    Hermes::Solvers::IterSolverType m_method;
+    Hermes::Solvers::PreconditionerType m_preconditioner;
+    double m_tolerance;
+    int m_maxIterations;
+    double m_innerTolerance;
+    double m_outerTolerance;
+
+    int m_outerIterations;
+    int m_innerIterations;
+    double m_residual;
+};
+
 struct TimeStepInfo
 {
     TimeStepInfo(double len, bool ref = false) : length(len), refuse(ref) {}
@@ -125,11 +158,32 @@ struct TimeStepInfo
     bool refuse;
 };
 
+// weighted sum of solutions on previous time levels (values and derivatives)
+// used as a predictor of the embedded time error estimator
+class TimeExtrapolationFilter : public Hermes::Hermes2D::Filter<double>
+{
+public:
+    TimeExtrapolationFilter(Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<double> > sln, const QVector<double> &weights);
+
+    virtual Hermes::Hermes2D::Func<double> *get_pt_value(double x, double y, bool use_MeshHashGrid = false, Hermes::Hermes2D::Element* e = NULL);
+
+    TimeExtrapolationFilter* clone() const;
+
+    // Lagrange weights of the extrapolation to time t from levels times
+    static QVector<double> weights(const QVector<double> &times, double t);
+
+protected:
+    void precalculate(int order, int mask);
+
+private:
+    QVector<double> m_weights;
+};
+
 template <typename Scalar>
 class HermesSolverContainer
 {
 public:
-    HermesSolverContainer(Block* block) : m_block(block), m_slnVector(NULL), m_constJacobianPossible(false) {}
+    HermesSolverContainer(Block* block) : m_block(block), m_slnVector(NULL), m_constJacobianPossible(false), m_matrixUnchanged(false) {}
     virtual ~HermesSolverContainer() {}
 
     void projectPreviousSolution(Scalar* solutionVector,
@@ -144,6 +198,8 @@ public:
     void setMatrixRhsOutputGen(Hermes::Algebra::Mixins::MatrixRhsOutput<Scalar>* solver, QString solverName, int adaptivityStep);
 
     virtual void matrixUnchangedDueToBDF(bool unchanged) {}
+    // matrix values are identical to the previous solve (constant jacobian)
+    inline bool matrixUnchanged() const { return m_matrixUnchanged; }
     virtual Hermes::Algebra::LinearMatrixSolver<Scalar> *linearSolver() = 0;
 
     inline Scalar *slnVector() { return m_slnVector; }
@@ -157,6 +213,36 @@ protected:
     Scalar *m_slnVector;
 
     bool m_constJacobianPossible;
+    bool m_matrixUnchanged;
+};
+
+// reuse statistics of reference meshes (reused, created)
+class AGROS_LIBRARY_API ReferenceSpaceCacheInfo
+{
+public:
+    static inline int hits() { return m_hits; }
+    static inline int misses() { return m_misses; }
+    static inline void addHit() { m_hits++; }
+    static inline void addMiss() { m_misses++; }
+    static inline void clear() { m_hits = 0; m_misses = 0; }
+
+private:
+    static int m_hits;
+    static int m_misses;
+};
+
+// reference mesh of one solution component
+// reused when the coarse mesh is the same as in one of the recent adaptivity steps
+// (transient adaptivity starts every time step from the same coarse mesh, p-adaptivity keeps the coarse mesh)
+// the mesh is not changed by the solver, the reference space is always created again
+struct ReferenceSpaceCacheItem
+{
+    ReferenceSpaceCacheItem() : refineMesh(false) {}
+
+    QVector<double> meshSignature;
+    bool refineMesh;
+
+    Hermes::Hermes2D::MeshSharedPtr mesh;
 };
 
 // solve
@@ -164,7 +250,10 @@ template <typename Scalar>
 class ProblemSolver
 {
 public:
-    ProblemSolver() : m_hermesSolverContainer(NULL) {}
+    ProblemSolver() : m_hermesSolverContainer(NULL),
+        m_averageErrorToLenghtRatio(0.0), m_previousTimeError(0.0),
+        m_linearSolverIterations(0), m_linearSolverInnerIterations(0), m_linearSolverResidual(0.0),
+        m_adaptivityTimeStep(-1), m_adaptivityStep(-1), m_adaptivityReferenceStored(false) {}
     ~ProblemSolver();
 
     void init(Block* block);
@@ -178,6 +267,8 @@ public:
     void solveSimple(int timeStep, int adaptivityStep);
     void solveReferenceAndProject(int timeStep, int adaptivityStep);
     bool createAdaptedSpace(int timeStep, int adaptivityStep);
+    // stores reference solution of the last adaptivity step (retention "last") and releases it
+    void finishAdaptivity();
 
     // to be used in solveAdaptivityStep
     void resumeAdaptivityProcess(int adaptivityStep);
@@ -198,6 +289,32 @@ private:
 
     // to be used in advanced time step adaptivity
     double m_averageErrorToLenghtRatio;
+    // error of the last accepted time step (PI controller), zero if not known
+    double m_previousTimeError;
+
+    // time error estimators (squared relative error of the last time step)
+    // solution of the lower order method (extra solve)
+    double timeErrorLowerOrder(int timeStep, int adaptivityStep);
+    // difference between predictor (extrapolation of previous levels) and corrector, negative if not available
+    double timeErrorEmbedded(int timeStep);
+
+    // iterative linear solver statistics of the last solve
+    int m_linearSolverIterations;
+    int m_linearSolverInnerIterations;
+    double m_linearSolverResidual;
+
+    // matrix pattern of the last solve (preconditioner reuse)
+    QList<int> m_matrixPattern;
+    bool isMatrixPatternUnchanged(Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > spaces);
+
+    // coarse and reference solution of the last adaptivity step, handed over to createAdaptedSpace in memory
+    int m_adaptivityTimeStep;
+    int m_adaptivityStep;
+    MultiArray<Scalar> m_adaptivitySolution;
+    MultiArray<Scalar> m_adaptivityReferenceSolution;
+    SolutionStore::SolutionRunTimeDetails m_adaptivityReferenceRunTime;
+    bool m_adaptivityReferenceStored;
+    AdaptivityReferenceRetention referenceRetention() const;
 
     void initSelectors(Hermes::vector<QSharedPointer<Hermes::Hermes2D::RefinementSelectors::Selector<Scalar> > >& selectors);
 
@@ -207,6 +324,12 @@ private:
     void setActualSpaces(Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > spaces);
     Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > actualSpaces() { return m_actualSpaces;}
     Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > deepMeshAndSpaceCopy(Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > spaces, bool createReference);
+
+    // recently used reference meshes of each component (most recent first)
+    QList<QList<ReferenceSpaceCacheItem> > m_referenceSpaceCache;
+    Hermes::Hermes2D::SpaceSharedPtr<Scalar> referenceSpace(int component, Hermes::Hermes2D::SpaceSharedPtr<Scalar> space, bool refineMesh, int orderIncrease);
+    // cached reference meshes are valid only for the current initial meshes
+    void clearReferenceSpaceCache();
 };
 
 #endif // SOLVER_H
@@ -66,7 +66,8 @@ LinearSolverContainer<Scalar>::~LinearSolverContainer()
 template <typename Scalar>
 void LinearSolverContainer<Scalar>::matrixUnchangedDueToBDF(bool unchanged)
 {
-    m_linearSolver->set_jacobian_constant(unchanged && this->m_constJacobianPossible);
+    this->m_matrixUnchanged = unchanged && this->m_constJacobianPossible;
+    m_linearSolver->set_jacobian_constant(this->m_matrixUnchanged);
 }
 
 template <typename Scalar>
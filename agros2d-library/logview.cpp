@@ -33,20 +33,192 @@
 
 #include "qcustomplot/qcustomplot.h"
 
+LogMessageQueue::~LogMessageQueue()
+{
+    dequeueAll();
+}
+
+LogMessageQueue::Node *LogMessageQueue::push(Node *first, Node *last)
+{
+    // push to the head (Treiber stack)
+    Node *head = NULL;
+    do
+    {
+#if QT_VERSION < 0x050000
+        head = m_head;
+#else
+        head = m_head.load();
+#endif
+        last->next = head;
+    }
+    while (!m_head.testAndSetOrdered(head, first));
+
+    return head;
+}
+
+bool LogMessageQueue::enqueue(const LogMessage &message)
+{
+    Node *node = new Node();
+    node->message = message;
+
+    Node *head = push(node, node);
+
+    // consumer is blocked - the oldest messages are dropped (one producer trims at a time)
+    if ((m_count.fetchAndAddOrdered(1) + 1 >= LOG_MAXIMUM_QUEUE_COUNT) && m_busy.testAndSetOrdered(0, 1))
+    {
+        trim();
+        m_busy.fetchAndStoreOrdered(0);
+
+        return true;
+    }
+
+    return (head == NULL);
+}
+
+void LogMessageQueue::trim()
+{
+    // detached stack is owned by this producer (stack is in reverse order)
+    Node *top = m_head.fetchAndStoreOrdered(NULL);
+    if (!top)
+        return;
+
+    Node *bottom = top;
+    for (int i = 1; (i < LOG_MAXIMUM_QUEUE_COUNT / 2) && bottom->next; i++)
+        bottom = bottom->next;
+
+    // remove the oldest messages
+    int removed = 0;
+    Node *node = bottom->next;
+    bottom->next = NULL;
+    while (node)
+    {
+        Node *next = node->next;
+        delete node;
+        node = next;
+        removed++;
+    }
+
+    m_count.fetchAndAddOrdered(-removed);
+    m_dropped.fetchAndAddOrdered(removed);
+
+    // return kept messages below the messages pushed in the meantime
+    while (!m_head.testAndSetOrdered(NULL, top))
+    {
+        Node *newer = m_head.fetchAndStoreOrdered(NULL);
+        if (!newer)
+            continue;
+
+        Node *last = newer;
+        while (last->next)
+            last = last->next;
+
+        last->next = top;
+        top = newer;
+    }
+}
+
+QList<LogMessage> LogMessageQueue::dequeueAll(int *dropped)
+{
+    if (dropped)
+        *dropped = 0;
+
+    // stack is being trimmed - producer notifies the consumer again
+    if (!m_busy.testAndSetOrdered(0, 1))
+        return QList<LogMessage>();
+
+    // detach whole stack at once - consumer never competes with other consumers
+    Node *node = m_head.fetchAndStoreOrdered(NULL);
+
+    // stack is in reverse order
+    QList<LogMessage> messages;
+    while (node)
+    {
+        messages.prepend(node->message);
+
+        Node *next = node->next;
+        delete node;
+        node = next;
+    }
+
+    m_count.fetchAndAddOrdered(-messages.count());
+    if (dropped)
+        *dropped = m_dropped.fetchAndStoreOrdered(0);
+
+    m_busy.fetchAndStoreOrdered(0);
+
+    return messages;
+}
+
+// *******************************************************************************************************
+
 Log::Log()
 {
     qRegisterMetaType<QVector<double> >("QVector<double>");
     qRegisterMetaType<SolverAgros::Phase>("SolverAgros::Phase");
+    qRegisterMetaType<QList<LogMessage> >("QList<LogMessage>");
+
+    m_flushTimer = new QTimer(this);
+    m_flushTimer->setSingleShot(true);
+    connect(m_flushTimer, SIGNAL(timeout()), this, SLOT(flush()));
+
+    m_lastFlush.start();
+}
+
+void Log::enqueue(const LogMessage &message)
+{
+    // caller in the thread of log doesn't wait for the event loop
+    if (QThread::currentThread() == thread())
+    {
+        m_queue.enqueue(message);
+
+        if (m_lastFlush.elapsed() >= LOG_REFRESH_INTERVAL)
+            flush();
+        else
+            scheduleFlush();
+
+        return;
+    }
+
+    // first message of the batch schedules flush in the thread of log
+    if (m_queue.enqueue(message))
+        QMetaObject::invokeMethod(this, "scheduleFlush", Qt::QueuedConnection);
+}
+
+void Log::scheduleFlush()
+{
+    if (m_flushTimer->isActive())
+        return;
+
+    // bounded frame rate
+    m_flushTimer->start(qMax(0, LOG_REFRESH_INTERVAL - m_lastFlush.elapsed()));
+}
+
+void Log::flush()
+{
+    int dropped = 0;
+    QList<LogMessage> messages = m_queue.dequeueAll(&dropped);
+    m_lastFlush.restart();
+
+    if (messages.isEmpty() && dropped == 0)
+        return;
+
+    // ring buffer - older messages would be removed from view anyway
+    if (messages.count() > LOG_MAXIMUM_BLOCK_COUNT)
+    {
+        dropped += messages.count() - LOG_MAXIMUM_BLOCK_COUNT;
+        messages = messages.mid(messages.count() - LOG_MAXIMUM_BLOCK_COUNT);
+    }
+
+    emit messagesFlushed(messages, dropped);
 }
 
 // *******************************************************************************************************
 
-LogWidget::LogWidget(QWidget *parent) : QWidget(parent),
-    m_printCounter(0)
+LogWidget::LogWidget(QWidget *parent) : QWidget(parent)
 {
     plainLog = new QPlainTextEdit(this);
     plainLog->setReadOnly(true);
-    plainLog->setMaximumBlockCount(500);
+    plainLog->setMaximumBlockCount(LOG_MAXIMUM_BLOCK_COUNT);
     plainLog->setMinimumSize(160, 80);
 
     memoryLabel = new QLabel("                                                         ");
@@ -70,11 +242,7 @@ LogWidget::LogWidget(QWidget *parent) : QWidget(parent),
     mnuInfo->addSeparator();
     mnuInfo->addAction(actClear);
 
-    connect(Agros2D::log(), SIGNAL(headingMsg(QString)), this, SLOT(printHeading(QString)));
-    connect(Agros2D::log(), SIGNAL(messageMsg(QString, QString)), this, SLOT(printMessage(QString, QString)));
-    connect(Agros2D::log(), SIGNAL(errorMsg(QString, QString)), this, SLOT(printError(QString, QString)));
-    connect(Agros2D::log(), SIGNAL(warningMsg(QString, QString)), this, SLOT(printWarning(QString, QString)));
-    connect(Agros2D::log(), SIGNAL(debugMsg(QString, QString)), this, SLOT(printDebug(QString, QString)));
+    connect(Agros2D::log(), SIGNAL(messagesFlushed(QList<LogMessage>, int)), this, SLOT(printMessages(QList<LogMessage>, int)));
 
     plainLog->setContextMenuPolicy(Qt::CustomContextMenu);
     connect(plainLog, SIGNAL(customContextMenuRequested(const QPoint &)), this, SLOT(contextMenu(const QPoint &)));
@@ -124,44 +292,62 @@ void LogWidget::showDebug()
     settings.setValue("LogWidget/ShowDebug", actShowDebug->isChecked());
 }
 
-void LogWidget::printHeading(const QString &message)
+void LogWidget::printMessages(const QList<LogMessage> &messages, int dropped)
 {
-    print(tr("Start"), tr("%1").arg(message), "green");
-    plainLog->ensureCursorVisible();
-}
+    QString html;
 
-void LogWidget::printMessage(const QString &module, const QString &message)
-{
-    print(module, message, "black");
-}
+    if (dropped > 0)
+        html += formatMessage(tr("Log"), tr("%1 messages skipped").arg(dropped), "gray", QDateTime::currentDateTime());
 
-void LogWidget::printError(const QString &module, const QString &message)
-{
-    print(module, message, "red");
-}
-
-void LogWidget::printWarning(const QString &module, const QString &message)
-{
-    print(module, message, "blue");
-}
-
-void LogWidget::printDebug(const QString &module, const QString &message)
-{
+    bool heading = false;
+    foreach (LogMessage message, messages)
+    {
+        switch (message.type)
+        {
+        case LogMessage::Type_Heading:
+            html += formatMessage(message.module, message.message, "green", message.time);
+            heading = true;
+            break;
+        case LogMessage::Type_Message:
+            html += formatMessage(message.module, message.message, "black", message.time);
+            break;
+        case LogMessage::Type_Error:
+            html += formatMessage(message.module, message.message, "red", message.time);
+            break;
+        case LogMessage::Type_Warning:
+            html += formatMessage(message.module, message.message, "blue", message.time);
+            break;
+        case LogMessage::Type_Debug:
 #ifndef QT_NO_DEBUG_OUTPUT
-    if (actShowDebug->isChecked())
-        print(module, message, "gray");
+            if (actShowDebug->isChecked())
+                html += formatMessage(message.module, message.message, "gray", message.time);
 #endif
+            break;
+        default:
+            assert(0);
+        }
+    }
+
+    if (html.isEmpty())
+        return;
+
+    // one append and one repaint per batch
+    plainLog->appendHtml(html);
+    scrollToEnd();
+
+    if (heading)
+        plainLog->ensureCursorVisible();
 }
 
-void LogWidget::print(const QString &module, const QString &message, const QString &color)
+QString LogWidget::formatMessage(const QString &module, const QString &message, const QString &color, const QDateTime &time) const
 {
     QString strTime = "";
     if (actShowTimestamp->isChecked())
     {
 #if QT_VERSION < 0x050000
-        strTime = Qt::escape(QDateTime::currentDateTime().toString("hh:mm:ss.zzz") + ": ");
+        strTime = Qt::escape(time.toString("hh:mm:ss.zzz") + ": ");
 #else
-        strTime = QString(QDateTime::currentDateTime().toString("hh:mm:ss.zzz") + ": ").toHtmlEscaped();
+        strTime = QString(time.toString("hh:mm:ss.zzz") + ": ").toHtmlEscaped();
 #endif
     }
 #if QT_VERSION < 0x050000
@@ -170,22 +356,21 @@ void LogWidget::print(const QString &module, const QString &message, const QStri
     QString strMessage = QString(message).toHtmlEscaped();
 #endif
 
-    QString html = QString("<div><span style=\"color: gray;\">%1</span><span style=\"color: %2;\"><strong>%3</strong>: %4</span></div>").
+    return QString("<div><span style=\"color: gray;\">%1</span><span style=\"color: %2;\"><strong>%3</strong>: %4</span></div>").
             arg(strTime).
             arg(color).
             arg(module).
             arg(strMessage);
+}
 
-    plainLog->appendHtml(html);
-
-    // force run process events
-    m_printCounter++;
-    if (m_printCounter == 20)
-    {
-        // reset counter and process events
-        m_printCounter = 0;
-    }
+void LogWidget::print(const QString &module, const QString &message, const QString &color)
+{
+    plainLog->appendHtml(formatMessage(module, message, color, QDateTime::currentDateTime()));
+    scrollToEnd();
+}
 
+void LogWidget::scrollToEnd()
+{
     // ensure cursor visible
     QTextCursor cursor = plainLog->textCursor();
     cursor.movePosition(QTextCursor::End);
@@ -240,7 +425,7 @@ LogDialog::LogDialog(QWidget *parent, const QString &title) : QDialog(parent),
     m_nonlinearChart(NULL), m_nonlinearErrorGraph(NULL), m_nonlinearProgress(NULL),
     m_adaptivityChart(NULL), m_adaptivityErrorGraph(NULL), m_adaptivityDOFsGraph(NULL), m_adaptivityProgress(NULL),
     m_timeChart(NULL), m_timeTimeStepGraph(NULL), m_timeProgress(NULL),
-    m_progress(NULL)
+    m_progress(NULL), m_timeStepCount(0), m_timeStepMaximum(0.0), m_timeTotal(0.0)
 {
     setModal(true);
 
@@ -292,6 +477,12 @@ void LogDialog::createControls()
     connect(Agros2D::log(), SIGNAL(updateTransientChart(double)), this, SLOT(updateTransientChartInfo(double)));
     connect(Agros2D::log(), SIGNAL(addIconImg(QIcon, QString)), this, SLOT(addIcon(QIcon, QString)));
 
+    // charts are replotted at most once per LOG_REFRESH_INTERVAL
+    m_replotTimer = new QTimer(this);
+    m_replotTimer->setSingleShot(true);
+    m_replotTimer->setInterval(LOG_REFRESH_INTERVAL);
+    connect(m_replotTimer, SIGNAL(timeout()), this, SLOT(replotCharts()));
+
     m_logWidget = new LogWidget(this);
     m_logWidget->setMemoryLabelVisible(false);
 
@@ -521,7 +712,8 @@ void LogDialog::updateNonlinearChartInfo(SolverAgros::Phase phase, const QVector
 
     m_nonlinearErrorGraph->setData(steps, relativeChangeOfSolutions);
     m_nonlinearChart->rescaleAxes();
-    m_nonlinearChart->replot(QCustomPlot::rpImmediate);
+    if (!m_replotTimer->isActive())
+        m_replotTimer->start();
 
     // progress bar
     if (phase == SolverAgros::Phase_Finished)
@@ -540,27 +732,36 @@ void LogDialog::updateAdaptivityChartInfo(const FieldInfo *fieldInfo, int timeSt
     if (!m_adaptivityErrorGraph)
         return;
 
-    QVector<double> adaptiveSteps;
-    QVector<double> adaptiveDOFs;
-    QVector<double> adaptiveError;
+    // new adaptivity run (next time step or field)
+    int count = m_adaptivityErrorGraph->data()->count();
+    if (adaptivityStep < count)
+    {
+        m_adaptivityErrorGraph->clearData();
+        m_adaptivityDOFsGraph->clearData();
+        count = 0;
+    }
 
-    for (int i = 0; i < adaptivityStep; i++)
+    // append new steps only
+    for (int i = count; i < adaptivityStep; i++)
     {
         SolutionStore::SolutionRunTimeDetails runTime = Agros2D::solutionStore()->multiSolutionRunTimeDetail(FieldSolutionID(fieldInfo, timeStep, i, SolutionMode_Normal));
 
-        adaptiveSteps.append(i + 1);
-        adaptiveDOFs.append(runTime.DOFs());
-        adaptiveError.append(runTime.adaptivityError());
+        m_adaptivityErrorGraph->addData(i + 1, runTime.adaptivityError());
+        m_adaptivityDOFsGraph->addData(i + 1, runTime.DOFs());
     }
 
-    m_adaptivityErrorGraph->setData(adaptiveSteps, adaptiveError);
-    m_adaptivityDOFsGraph->setData(adaptiveSteps, adaptiveDOFs);
+    if (m_adaptivityErrorGraph->data()->isEmpty())
+        return;
+
     m_adaptivityChart->rescaleAxes();
-    m_adaptivityChart->replot(QCustomPlot::rpImmediate);
+    if (!m_replotTimer->isActive())
+        m_replotTimer->start();
 
     // progress bar
+    double firstError = m_adaptivityErrorGraph->data()->first().value;
+    double lastError = m_adaptivityErrorGraph->data()->last().value;
     double valueSteps = 10000.0 * (adaptivityStep / fieldInfo->value(FieldInfo::AdaptivitySteps).toInt());
-    double valueTol = pow(10000.0, (adaptiveError.first() - adaptiveError.last()) / adaptiveError.first());
+    double valueTol = pow(10000.0, (firstError - lastError) / firstError);
     m_adaptivityProgress->setValue(qMax(valueSteps, valueTol));
 }
 
@@ -569,32 +770,54 @@ void LogDialog::updateTransientChartInfo(double actualTime)
     if (!m_timeTimeStepGraph)
         return;
 
-    QVector<double> timeSteps;
-    QVector<double> timeLengths = Agros2D::problem()->timeStepLengths().toVector();
-    QVector<double> timeTotal;
-    double maximum = 0.0;
-    for (int i = 0; i < timeLengths.size(); i++)
+    int timeStep = Agros2D::problem()->actualTimeStep();
+    if (timeStep == 0)
+        return;
+
+    // rejected (or repeated) steps - drop them and recompute the maximum from the remaining points
+    if (timeStep <= m_timeStepCount)
     {
-        timeSteps.append(i + 1);
-        if (timeLengths[i] > maximum)
-            maximum = timeLengths[i];
+        m_timeTimeStepGraph->removeDataAfter(timeStep - 1);
+        m_timeTimeTotalGraph->removeDataAfter(timeStep - 1);
+
+        m_timeStepMaximum = 0.0;
+        foreach (QCPData data, m_timeTimeStepGraph->data()->values())
+            m_timeStepMaximum = qMax(m_timeStepMaximum, data.value);
 
-        timeTotal.append((timeTotal.size() == 0 ? 0.0 : timeTotal.last()) + timeLengths[i]);
+        m_timeTotal = m_timeTimeTotalGraph->data()->isEmpty() ? 0.0 : m_timeTimeTotalGraph->data()->last().value;
     }
 
-    m_timeTimeStepGraph->setData(timeSteps, timeLengths);
+    // append the actual step only
+    double timeLength = Agros2D::problem()->actualTimeStepLength();
+    m_timeStepMaximum = qMax(m_timeStepMaximum, timeLength);
+    m_timeTotal += timeLength;
+
+    m_timeTimeStepGraph->addData(timeStep, timeLength);
+    m_timeTimeTotalGraph->addData(timeStep, m_timeTotal);
+    m_timeStepCount = timeStep;
+
     m_timeChart->yAxis->setRangeLower(0.0);
-    m_timeChart->yAxis->setRangeUpper(maximum);
-    m_timeTimeTotalGraph->setData(timeSteps, timeTotal);
+    m_timeChart->yAxis->setRangeUpper(m_timeStepMaximum);
     m_timeChart->yAxis2->setRangeLower(0.0);
-    m_timeChart->yAxis2->setRangeUpper(timeTotal.last());
+    m_timeChart->yAxis2->setRangeUpper(m_timeTotal);
     m_timeTimeStepGraph->rescaleKeyAxis();
-    m_timeChart->replot(QCustomPlot::rpImmediate);
+    if (!m_replotTimer->isActive())
+        m_replotTimer->start();
 
     // progress bar
     m_timeProgress->setValue((10000.0 * actualTime / Agros2D::problem()->config()->value(ProblemConfig::TimeTotal).toDouble()));
 }
 
+void LogDialog::replotCharts()
+{
+    if (m_timeChart)
+        m_timeChart->replot(QCustomPlot::rpQueued);
+    if (m_nonlinearChart)
+        m_nonlinearChart->replot(QCustomPlot::rpQueued);
+    if (m_adaptivityChart)
+        m_adaptivityChart->replot(QCustomPlot::rpQueued);
+}
+
 void LogDialog::addIcon(const QIcon &icn, const QString &label)
 {
     static QString previousLabel;
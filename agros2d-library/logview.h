@@ -28,17 +28,71 @@ class QCPGraph;
 class FieldInfo;
 class SolverAgros;
 
+struct LogMessage
+{
+    enum Type
+    {
+        Type_Heading,
+        Type_Message,
+        Type_Error,
+        Type_Warning,
+        Type_Debug
+    };
+
+    LogMessage() : type(Type_Message) {}
+    LogMessage(Type type, const QString &module, const QString &message)
+        : type(type), module(module), message(message), time(QDateTime::currentDateTime()) {}
+
+    Type type;
+    QString module;
+    QString message;
+    QDateTime time;
+};
+
+// bounded lock-free queue (multiple producers, single consumer)
+class LogMessageQueue
+{
+public:
+    LogMessageQueue() : m_head(NULL), m_count(0), m_dropped(0), m_busy(0) {}
+    ~LogMessageQueue();
+
+    // returns true if the consumer should be notified (queue was empty before or it has been trimmed)
+    // (the oldest messages are dropped if the queue holds LOG_MAXIMUM_QUEUE_COUNT messages)
+    bool enqueue(const LogMessage &message);
+    // takes all messages in order of arrival and number of dropped messages
+    // (returns nothing while the queue is being trimmed)
+    QList<LogMessage> dequeueAll(int *dropped = NULL);
+
+private:
+    struct Node
+    {
+        LogMessage message;
+        Node *next;
+    };
+
+    QAtomicPointer<Node> m_head;
+    QAtomicInt m_count;
+    QAtomicInt m_dropped;
+    // stack is detached by the consumer or by the producer trimming it
+    QAtomicInt m_busy;
+
+    // pushes chain of nodes (first is the newest), returns previous head
+    Node *push(Node *first, Node *last);
+    // removes the oldest messages, keeps the newest half of the queue
+    void trim();
+};
+
 class AGROS_LIBRARY_API Log: public QObject
 {
     Q_OBJECT
 public:
     Log();
 
-    inline void printHeading(const QString &message) { emit headingMsg(message); }
-    inline void printMessage(const QString &module, const QString &message) { emit messageMsg(module, message); }
-    inline void printError(const QString &module, const QString &message) { emit errorMsg(module, message); }
-    inline void printWarning(const QString &module, const QString &message) { emit warningMsg(module, message); }
-    inline void printDebug(const QString &module, const QString &message) { emit debugMsg(module, message); }
+    inline void printHeading(const QString &message) { emit headingMsg(message); enqueue(LogMessage(LogMessage::Type_Heading, tr("Start"), message)); }
+    inline void printMessage(const QString &module, const QString &message) { emit messageMsg(module, message); enqueue(LogMessage(LogMessage::Type_Message, module, message)); }
+    inline void printError(const QString &module, const QString &message) { emit errorMsg(module, message); enqueue(LogMessage(LogMessage::Type_Error, module, message)); }
+    inline void printWarning(const QString &module, const QString &message) { emit warningMsg(module, message); enqueue(LogMessage(LogMessage::Type_Warning, module, message)); }
+    inline void printDebug(const QString &module, const QString &message) { emit debugMsg(module, message); enqueue(LogMessage(LogMessage::Type_Debug, module, message)); }
 
     inline void updateNonlinearChartInfo(SolverAgros::Phase phase, const QVector<double> steps, const QVector<double> relativeChangeOfSolutions) { emit updateNonlinearChart(phase, steps, relativeChangeOfSolutions); }
     inline void updateAdaptivityChartInfo(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep) { emit updateAdaptivityChart(fieldInfo, timeStep, adaptivityStep); }
@@ -58,6 +112,20 @@ signals:
     void updateTransientChart(double actualTime);
 
     void addIconImg(const QIcon &icn, const QString &label);
+
+    // coalesced messages (at most one batch per LOG_REFRESH_INTERVAL)
+    void messagesFlushed(const QList<LogMessage> &messages, int dropped);
+
+private:
+    LogMessageQueue m_queue;
+    QTimer *m_flushTimer;
+    QTime m_lastFlush;
+
+    void enqueue(const LogMessage &message);
+
+private slots:
+    void scheduleFlush();
+    void flush();
 };
 
 class AGROS_LIBRARY_API LogWidget : public QWidget
@@ -78,6 +146,8 @@ public slots:
 protected:
     void print(const QString &module, const QString &message,
                const QString &color = "");
+    QString formatMessage(const QString &module, const QString &message,
+                          const QString &color, const QDateTime &time) const;
 
 private:
     QMenu *mnuInfo;
@@ -90,18 +160,14 @@ private:
     QAction *actClear;
 
     QLabel *memoryLabel;
-    int m_printCounter;
 
     void createActions();
+    void scrollToEnd();
 
 private slots:
     void contextMenu(const QPoint &pos);
 
-    void printMessage(const QString &module, const QString &message);
-    void printError(const QString &module, const QString &message);
-    void printWarning(const QString &module, const QString &message);
-    void printDebug(const QString &module, const QString &message);
-    void printHeading(const QString &message);
+    void printMessages(const QList<LogMessage> &messages, int dropped);
 
     void showTimestamp();
     void showDebug();
@@ -153,11 +219,19 @@ private:
 
     QListWidget *m_progress;
 
+    // incremental charts
+    QTimer *m_replotTimer;
+    int m_timeStepCount;
+    double m_timeStepMaximum;
+    double m_timeTotal;
+
     void createControls();
 
 private slots:    
     void printError(const QString &module, const QString &message);
 
+    void replotCharts();
+
     void updateNonlinearChartInfo(SolverAgros::Phase phase, const QVector<double> steps, const QVector<double> relativeChangeOfSolutions);
     void updateAdaptivityChartInfo(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep);
     void updateTransientChartInfo(double actualTime);
@@ -29,6 +29,7 @@
 #include "scenelabel.h"
 #include "scenemarker.h"
 #include "logview.h"
+#include "util/profiler.h"
 
 #include "hermes2d/module.h"
 
@@ -36,6 +37,107 @@
 #include "hermes2d/problem.h"
 #include "hermes2d/problem_config.h"
 
+bool MeshFileReader::load(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    m_data = file.readAll();
+    m_pos = 0;
+    m_isValid = true;
+
+    file.close();
+
+    return true;
+}
+
+void MeshFileReader::skipWhite()
+{
+    while (m_pos < m_data.size())
+    {
+        char c = m_data.at(m_pos);
+        if (c == '#')
+            skipLine();
+        else if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+            m_pos++;
+        else
+            break;
+    }
+}
+
+bool MeshFileReader::atEnd()
+{
+    skipWhite();
+    return (m_pos >= m_data.size());
+}
+
+bool MeshFileReader::seek(const char *keyword)
+{
+    int length = qstrlen(keyword);
+    int pos = m_pos;
+    while ((pos = m_data.indexOf(keyword, pos)) != -1)
+    {
+        if (pos == 0 || m_data.at(pos - 1) == '\n')
+        {
+            m_pos = pos + length;
+            skipLine();
+            return true;
+        }
+        pos += length;
+    }
+
+    m_isValid = false;
+    return false;
+}
+
+void MeshFileReader::skipLine()
+{
+    int pos = m_data.indexOf('\n', m_pos);
+    m_pos = (pos == -1) ? m_data.size() : pos + 1;
+}
+
+int MeshFileReader::readInt()
+{
+    skipWhite();
+
+    const char *start = m_data.constData() + m_pos;
+    char *end = NULL;
+    long value = strtol(start, &end, 10);
+    if (end == start)
+    {
+        m_isValid = false;
+        return 0;
+    }
+
+    m_pos += end - start;
+    return value;
+}
+
+double MeshFileReader::readDouble()
+{
+    skipWhite();
+
+    int start = m_pos;
+    while (m_pos < m_data.size())
+    {
+        char c = m_data.at(m_pos);
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+            break;
+        m_pos++;
+    }
+
+    // QByteArray::toDouble() does not depend on the C locale (unlike strtod)
+    bool ok = false;
+    double value = QByteArray::fromRawData(m_data.constData() + start, m_pos - start).toDouble(&ok);
+    if (!ok)
+        m_isValid = false;
+
+    return value;
+}
+
+// ****************************************************************************
+
 MeshGenerator::MeshGenerator() : QObject()
 {
     Hermes::HermesCommonApi.set_integral_param_value(Hermes::checkMeshesOnLoad, false);
@@ -47,32 +149,81 @@ MeshGenerator::~MeshGenerator()
 
 using namespace Hermes::Hermes2D;
 
+void MeshGenerator::prepareArcs()
+{
+    m_arcs.clear();
+    m_arcs.resize(Agros2D::scene()->edges->length());
+
+    for (int i = 0; i < Agros2D::scene()->edges->length(); i++)
+    {
+        SceneEdge *edge = Agros2D::scene()->edges->at(i);
+
+        if (edge->angle() > 0.0 && edge->isCurvilinear())
+        {
+            m_arcs[i].isArc = true;
+            m_arcs[i].center = edge->center();
+            m_arcs[i].radius = edge->radius();
+            m_arcs[i].angle = edge->angle();
+            m_arcs[i].segments = edge->segments();
+        }
+    }
+}
+
+double MeshGenerator::edgeArcAngle(int edge_i) const
+{
+    const MeshEdge &edge = edgeList[edge_i];
+    const MeshArc &arc = m_arcs[edge.marker];
+
+    // subdivision angle and chord
+    double theta = deg2rad(arc.angle) / double(arc.segments);
+    double chord = 2 * arc.radius * sin(theta / 2.0);
+
+    // length of short chord
+    const Point &node0 = nodeList[edge.node[0]];
+    const Point &node1 = nodeList[edge.node[1]];
+    double chordShort = (node1 - node0).magnitude();
+
+    // direction
+    int direction = (((node0.x - arc.center.x)*(node1.y - arc.center.y) -
+                      (node0.y - arc.center.y)*(node1.x - arc.center.x)) > 0) ? 1 : -1;
+
+    return rad2deg(direction * theta * chordShort / chord);
+}
+
 void MeshGenerator::moveNodesOnCurvedEdges()
 {
-    // move nodes (arcs)
-    for (int i = 0; i<edgeList.count(); i++)
+    // arc of the node (the last curved edge containing the node)
+    QVector<int> nodeArcs(nodeList.count(), -1);
+    for (int i = 0; i < edgeList.count(); i++)
     {
         // assert(edgeList[i].marker >= 0); // markers changed to marker - 1, check...
-        if (edgeList[i].marker != -1)
+        if (edgeList[i].marker != -1 && m_arcs[edgeList[i].marker].isArc)
         {
-            // curve
-            if (Agros2D::scene()->edges->at(edgeList[i].marker)->angle() > 0.0 &&
-                    Agros2D::scene()->edges->at(edgeList[i].marker)->isCurvilinear())
-            {
-                // angle
-                Point center = Agros2D::scene()->edges->at(edgeList[i].marker)->center();
-                double pointAngle1 = atan2(center.y - nodeList[edgeList[i].node[0]].y,
-                        center.x - nodeList[edgeList[i].node[0]].x) - M_PI;
+            nodeArcs[edgeList[i].node[0]] = edgeList[i].marker;
+            nodeArcs[edgeList[i].node[1]] = edgeList[i].marker;
+        }
+    }
 
-                double pointAngle2 = atan2(center.y - nodeList[edgeList[i].node[1]].y,
-                        center.x - nodeList[edgeList[i].node[1]].x) - M_PI;
+    // move nodes (arcs), every node is moved once
+    const MeshArc *arcs = m_arcs.constData();
+    const int *arcOfNode = nodeArcs.constData();
+    Point *nodes = nodeList.data();
+    int count = nodeList.count();
 
-                nodeList[edgeList[i].node[0]].x = center.x + Agros2D::scene()->edges->at(edgeList[i].marker)->radius() * cos(pointAngle1);
-                nodeList[edgeList[i].node[0]].y = center.y + Agros2D::scene()->edges->at(edgeList[i].marker)->radius() * sin(pointAngle1);
+    int numberOfThreads = qMax(1, Agros2D::configComputer()->value(Config::Config_NumberOfThreads).toInt());
+#pragma omp parallel for num_threads(numberOfThreads)
+    for (int i = 0; i < count; i++)
+    {
+        if (arcOfNode[i] != -1)
+        {
+            const MeshArc &arc = arcs[arcOfNode[i]];
 
-                nodeList[edgeList[i].node[1]].x = center.x + Agros2D::scene()->edges->at(edgeList[i].marker)->radius() * cos(pointAngle2);
-                nodeList[edgeList[i].node[1]].y = center.y + Agros2D::scene()->edges->at(edgeList[i].marker)->radius() * sin(pointAngle2);
-            }
+            // angle
+            double pointAngle = atan2(arc.center.y - nodes[i].y,
+                                      arc.center.x - nodes[i].x) - M_PI;
+
+            nodes[i].x = arc.center.x + arc.radius * cos(pointAngle);
+            nodes[i].y = arc.center.y + arc.radius * sin(pointAngle);
         }
     }
 }
@@ -111,13 +262,17 @@ void MeshGenerator::writeTemporaryGlobalMeshToHermes(Hermes::Hermes2D::MeshShare
 
     global_mesh->nbase = global_mesh->nactive = global_mesh->ninitial = element_count;
 
+    // internal markers of labels (converted once per label)
+    QVector<int> labelMarkers(Agros2D::scene()->labels->length(), -1);
+
     for (int element_i = 0; element_i < elementList.count(); element_i++)
     {
         if(!elementList[element_i].isUsed)
             continue;
-        // Trim whitespaces.
-        int internal_marker =
-                global_mesh->element_markers_conversion.insert_marker(QString::number(elementList[element_i].marker).toStdString());
+
+        int &internal_marker = labelMarkers[elementList[element_i].marker];
+        if (internal_marker == -1)
+            internal_marker = global_mesh->element_markers_conversion.insert_marker(QString::number(elementList[element_i].marker).toStdString());
 
         if (elementList[element_i].isTriangle())
             global_mesh->create_triangle(internal_marker, global_mesh->get_node(elementList[element_i].node[0]), global_mesh->get_node(elementList[element_i].node[1]), global_mesh->get_node(elementList[element_i].node[2]), nullptr);
@@ -128,6 +283,9 @@ void MeshGenerator::writeTemporaryGlobalMeshToHermes(Hermes::Hermes2D::MeshShare
     // Boundaries //
     int edges_count = edgeList.count();
 
+    // internal markers of edges (converted once per edge)
+    QVector<int> edgeMarkers(Agros2D::scene()->edges->length(), -1);
+
     Node* en;
     for (int edge_i = 0; edge_i < edges_count; edge_i++)
     {
@@ -140,7 +298,9 @@ void MeshGenerator::writeTemporaryGlobalMeshToHermes(Hermes::Hermes2D::MeshShare
         if (en == nullptr)
             throw Hermes::Exceptions::MeshLoadFailureException("Boundary data #%d: edge %d-%d does not exist.", edge_i, v1, v2);
 
-        int marker = global_mesh->boundary_markers_conversion.insert_marker(QString::number(edgeList[edge_i].marker).toStdString());
+        int &marker = edgeMarkers[edgeList[edge_i].marker];
+        if (marker == -1)
+            marker = global_mesh->boundary_markers_conversion.insert_marker(QString::number(edgeList[edge_i].marker).toStdString());
 
         en->marker = marker;
     }
@@ -163,30 +323,13 @@ void MeshGenerator::writeTemporaryGlobalMeshToHermes(Hermes::Hermes2D::MeshShare
         if (edgeList[edge_i].marker != -1)
         {
             // curve
-            if (Agros2D::scene()->edges->at(edgeList[edge_i].marker)->angle() > 0.0 &&
-                    Agros2D::scene()->edges->at(edgeList[edge_i].marker)->isCurvilinear())
+            if (m_arcs[edgeList[edge_i].marker].isArc)
             {
                 // load the control points, knot vector, etc.
                 Node* en;
                 int p1 = edgeList[edge_i].node[0], p2 = edgeList[edge_i].node[1];
 
-                int segments = Agros2D::scene()->edges->at(edgeList[edge_i].marker)->segments();
-
-                // subdivision angle and chord
-                double theta = deg2rad(Agros2D::scene()->edges->at(edgeList[edge_i].marker)->angle()) / double(segments);
-                double chord = 2 * Agros2D::scene()->edges->at(edgeList[edge_i].marker)->radius() * sin(theta / 2.0);
-
-                // length of short chord
-                double chordShort = (nodeList[edgeList[edge_i].node[1]] - nodeList[edgeList[edge_i].node[0]]).magnitude();
-
-                // direction
-                Point center = Agros2D::scene()->edges->at(edgeList[edge_i].marker)->center();
-                int direction = (((nodeList[edgeList[edge_i].node[0]].x - center.x)*(nodeList[edgeList[edge_i].node[1]].y - center.y) -
-                        (nodeList[edgeList[edge_i].node[0]].y - center.y)*(nodeList[edgeList[edge_i].node[1]].x - center.x)) > 0) ? 1 : -1;
-
-                double angle = direction * theta * chordShort / chord;
-
-                Hermes::Hermes2D::Curve* curve = MeshUtil::load_arc(global_mesh, edge_i, &en, p1, p2, rad2deg(angle));
+                Hermes::Hermes2D::Curve* curve = MeshUtil::load_arc(global_mesh, edge_i, &en, p1, p2, edgeArcAngle(edge_i));
 
                 // assign the arc to the elements sharing the edge node
                 MeshUtil::assign_curve(en, curve, p1, p2);
@@ -210,34 +353,86 @@ void MeshGenerator::writeTemporaryGlobalMeshToHermes(Hermes::Hermes2D::MeshShare
 
 void MeshGenerator::fillNeighborStructures()
 {
-    QList<QSet<int> > vertexElements;
-    vertexElements.reserve(nodeList.count());
-    for (int i = 0; i < nodeList.count(); i++)
-        vertexElements.push_back(QSet<int>());
+    int nodeCount = nodeList.count();
+    int elementCount = elementList.count();
+    int edgeCount = edgeList.count();
+
+    // elements of vertices in one array (sorted by element index)
+    // elements of vertex i are vertexElements[vertexElementsStart[i]] ... vertexElements[vertexElementsStart[i + 1] - 1]
+    QVector<int> vertexElementsStart(nodeCount + 1, 0);
+    for (int i = 0; i < elementCount; i++)
+        if (elementList[i].isUsed)
+            for (int elemNode = 0; elemNode < (elementList[i].isTriangle() ? 3 : 4); elemNode++)
+                vertexElementsStart[elementList[i].node[elemNode] + 1]++;
 
-    for (int i = 0; i < elementList.count(); i++)
+    for (int i = 0; i < nodeCount; i++)
+        vertexElementsStart[i + 1] += vertexElementsStart[i];
+
+    QVector<int> vertexElements(vertexElementsStart[nodeCount]);
+    QVector<int> vertexElementsPosition(vertexElementsStart);
+    for (int i = 0; i < elementCount; i++)
         if (elementList[i].isUsed)
             for (int elemNode = 0; elemNode < (elementList[i].isTriangle() ? 3 : 4); elemNode++)
-                vertexElements[elementList[i].node[elemNode]].insert(i);
+                vertexElements[vertexElementsPosition[elementList[i].node[elemNode]]++] = i;
 
-    for (int i = 0; i < edgeList.count(); i++)
+    const int *start = vertexElementsStart.constData();
+    const int *elements = vertexElements.constData();
+    MeshEdge *edges = edgeList.data();
+
+    int numberOfThreads = qMax(1, Agros2D::configComputer()->value(Config::Config_NumberOfThreads).toInt());
+#pragma omp parallel for num_threads(numberOfThreads)
+    for (int i = 0; i < edgeCount; i++)
     {
-        if (edgeList[i].isUsed && edgeList[i].marker != -1)
+        if (edges[i].isUsed && edges[i].marker != -1)
         {
-            QSet<int> neighbours = vertexElements[edgeList[i].node[0]];
-            neighbours.intersect(vertexElements[edgeList[i].node[1]]);
-            assert((neighbours.size() > 0) && (neighbours.size() <= 2));
-            edgeList[i].neighElem[0] = neighbours.values()[0];
-            if (neighbours.size() == 2)
-                edgeList[i].neighElem[1] = neighbours.values()[1];
+            // intersection of sorted element lists of both vertices
+            int first = start[edges[i].node[0]];
+            int firstEnd = start[edges[i].node[0] + 1];
+            int second = start[edges[i].node[1]];
+            int secondEnd = start[edges[i].node[1] + 1];
+
+            int neighbours = 0;
+            while (first < firstEnd && second < secondEnd)
+            {
+                if (elements[first] < elements[second])
+                {
+                    first++;
+                }
+                else if (elements[first] > elements[second])
+                {
+                    second++;
+                }
+                else
+                {
+                    if (neighbours < 2)
+                        edges[i].neighElem[neighbours] = elements[first];
+                    neighbours++;
+
+                    first++;
+                    second++;
+                }
+            }
+
+            assert((neighbours > 0) && (neighbours <= 2));
         }
     }
 }
 
+QVector<bool> MeshGenerator::labelsInField(FieldInfo *fieldInfo) const
+{
+    QVector<bool> labels(Agros2D::scene()->labels->length());
+    for (int i = 0; i < labels.count(); i++)
+        labels[i] = (Agros2D::scene()->labels->at(i)->marker(fieldInfo) != SceneMaterialContainer::getNone(fieldInfo));
+
+    return labels;
+}
+
 void MeshGenerator::getDataCountsForSingleSubdomain(FieldInfo* fieldInfo, int& element_number_count, int& boundary_edge_number_count, int& inner_edge_number_count)
 {
+    QVector<bool> isLabelInField = labelsInField(fieldInfo);
+
     for (int i = 0; i < elementList.count(); i++)
-        if (elementList[i].isUsed && (Agros2D::scene()->labels->at(elementList[i].marker)->marker(fieldInfo) != SceneMaterialContainer::getNone(fieldInfo)))
+        if (elementList[i].isUsed && isLabelInField[elementList[i].marker])
             element_number_count++;
 
     QList<int> unassignedEdges;
@@ -249,12 +444,8 @@ void MeshGenerator::getDataCountsForSingleSubdomain(FieldInfo* fieldInfo, int& e
             for (int neigh_i = 0; neigh_i < 2; neigh_i++)
             {
                 int neigh = edgeList[i].neighElem[neigh_i];
-                if (neigh != -1)
-                {
-                    if (Agros2D::scene()->labels->at(elementList[neigh].marker)->marker(fieldInfo)
-                            != SceneMaterialContainer::getNone(fieldInfo))
-                        numNeighWithField++;
-                }
+                if (neigh != -1 && isLabelInField[elementList[neigh].marker])
+                    numNeighWithField++;
             }
 
             // edge has boundary condition prescribed for this field
@@ -290,14 +481,30 @@ void MeshGenerator::writeToHermes()
         m_meshes.push_back(mesh);
     }
 
+    ProfilerScope profilerScope("post-processing");
+
     try
     {
-        this->moveNodesOnCurvedEdges();
+        this->prepareArcs();
+
+        {
+            ProfilerScope profilerScope("curved edges");
+            this->moveNodesOnCurvedEdges();
+        }
 
         MeshSharedPtr global_mesh(new Mesh);
 
-        this->writeTemporaryGlobalMeshToHermes(global_mesh);
-        this->fillNeighborStructures();
+        {
+            ProfilerScope profilerScope("global mesh");
+            this->writeTemporaryGlobalMeshToHermes(global_mesh);
+        }
+
+        {
+            ProfilerScope profilerScope("neighbours");
+            this->fillNeighborStructures();
+        }
+
+        ProfilerScope profilerScopeSubdomains("subdomains");
 
         int subdomains_count;
         if (Agros2D::problem()->fieldInfos().isEmpty())
@@ -305,21 +512,39 @@ void MeshGenerator::writeToHermes()
         else
             subdomains_count = Agros2D::problem()->fieldInfos().size();
 
-        Element* e;
-        for (int subdomains_i = 0; subdomains_i < subdomains_count; subdomains_i++)
+        // markers in order of the first appearance (the same numbering in all subdomains)
+        QVector<int> elementMarkers;
+        QVector<bool> isElementMarker(Agros2D::scene()->labels->length(), false);
+        for (int element_i = 0; element_i < elementList.count(); element_i++)
         {
-            for (int element_i = 0; element_i < elementList.count(); element_i++)
+            if (elementList[element_i].isUsed && !isElementMarker[elementList[element_i].marker])
             {
-                if(elementList[element_i].isUsed)
-                    m_meshes[subdomains_i]->element_markers_conversion.insert_marker(QString::number(elementList[element_i].marker).toStdString());
+                isElementMarker[elementList[element_i].marker] = true;
+                elementMarkers.append(elementList[element_i].marker);
             }
+        }
 
-            for (int edge_i = 0; edge_i < edgeList.count(); edge_i++)
+        // edge marker -1 (inner edges) is stored at index 0
+        QVector<int> edgeMarkers;
+        QVector<bool> isEdgeMarker(Agros2D::scene()->edges->length() + 1, false);
+        for (int edge_i = 0; edge_i < edgeList.count(); edge_i++)
+        {
+            if (!isEdgeMarker[edgeList[edge_i].marker + 1])
             {
-                m_meshes[subdomains_i]->boundary_markers_conversion.insert_marker(QString::number(edgeList[edge_i].marker).toStdString());
+                isEdgeMarker[edgeList[edge_i].marker + 1] = true;
+                edgeMarkers.append(edgeList[edge_i].marker);
             }
         }
 
+        for (int subdomains_i = 0; subdomains_i < subdomains_count; subdomains_i++)
+        {
+            foreach (int marker, elementMarkers)
+                m_meshes[subdomains_i]->element_markers_conversion.insert_marker(QString::number(marker).toStdString());
+
+            foreach (int marker, edgeMarkers)
+                m_meshes[subdomains_i]->boundary_markers_conversion.insert_marker(QString::number(marker).toStdString());
+        }
+
         Hermes::vector<FieldInfo*> fieldInfoVector;
         foreach(FieldInfo* fieldInfo, Agros2D::problem()->fieldInfos())
         {
@@ -364,11 +589,22 @@ void MeshGenerator::writeToHermes()
                 }
                 m_meshes[subdomains_i]->ntopvert = vertex_number_count;
 
+                // labels of the field and internal markers (converted once per label and edge)
+                QVector<bool> isLabelInField = labelsInField(fieldInfo);
+
+                QVector<int> labelMarkers(Agros2D::scene()->labels->length(), -1);
+                foreach (int marker, elementMarkers)
+                    labelMarkers[marker] = m_meshes[subdomains_i]->element_markers_conversion.get_internal_marker(QString::number(marker).toStdString()).marker;
+
+                QVector<int> boundaryMarkers(Agros2D::scene()->edges->length() + 1, -1);
+                foreach (int marker, edgeMarkers)
+                    boundaryMarkers[marker + 1] = m_meshes[subdomains_i]->boundary_markers_conversion.get_internal_marker(QString::number(marker).toStdString()).marker;
+
                 for (int element_i = 0; element_i < elementList.count(); element_i++)
                 {
-                    if (elementList[element_i].isUsed && (Agros2D::scene()->labels->at(elementList[element_i].marker)->marker(fieldInfo) != SceneMaterialContainer::getNone(fieldInfo)))
+                    if (elementList[element_i].isUsed && isLabelInField[elementList[element_i].marker])
                     {
-                        int internal_marker = m_meshes[subdomains_i]->element_markers_conversion.get_internal_marker(QString::number(elementList[element_i].marker).toStdString()).marker;
+                        int internal_marker = labelMarkers[elementList[element_i].marker];
                         if (elementList[element_i].isTriangle())
                             m_meshes[subdomains_i]->create_triangle(internal_marker, m_meshes[subdomains_i]->get_node(elementList[element_i].node[0]), m_meshes[subdomains_i]->get_node(elementList[element_i].node[1]), m_meshes[subdomains_i]->get_node(elementList[element_i].node[2]), nullptr, element_i);
                         else
@@ -392,12 +628,8 @@ void MeshGenerator::writeToHermes()
                         for (int neigh_i = 0; neigh_i < 2; neigh_i++)
                         {
                             int neigh = edgeList[edge_i].neighElem[neigh_i];
-                            if (neigh != -1)
-                            {
-                                if (Agros2D::scene()->labels->at(elementList[neigh].marker)->marker(fieldInfo)
-                                        != SceneMaterialContainer::getNone(fieldInfo))
-                                    numNeighWithField++;
-                            }
+                            if (neigh != -1 && isLabelInField[elementList[neigh].marker])
+                                numNeighWithField++;
                         }
 
                         if (numNeighWithField == 1)
@@ -413,8 +645,7 @@ void MeshGenerator::writeToHermes()
                                     unassignedEdges.append(edgeList[edge_i].marker);
 
                             Node* en = m_meshes[subdomains_i]->peek_edge_node(edgeList[edge_i].node[0], edgeList[edge_i].node[1]);
-                            int marker = m_meshes[subdomains_i]->boundary_markers_conversion.insert_marker(QString::number(edgeList[edge_i].marker).toStdString());
-                            en->marker = marker;
+                            en->marker = boundaryMarkers[edgeList[edge_i].marker + 1];
                         }
 
                         else if (numNeighWithField == 2)
@@ -423,8 +654,7 @@ void MeshGenerator::writeToHermes()
                             // assert(!hasFieldBoundaryCondition);
 
                             Node* en = m_meshes[subdomains_i]->peek_edge_node(edgeList[edge_i].node[0], edgeList[edge_i].node[1]);
-                            int marker = m_meshes[subdomains_i]->boundary_markers_conversion.insert_marker(QString::number(edgeList[edge_i].marker).toStdString());
-                            en->marker = marker;
+                            en->marker = boundaryMarkers[edgeList[edge_i].marker + 1];
                         }
                     }
                 }
@@ -457,30 +687,13 @@ void MeshGenerator::writeToHermes()
                     if (edgeList[edge_i].marker != -1)
                     {
                         // curve
-                        if (Agros2D::scene()->edges->at(edgeList[edge_i].marker)->angle() > 0.0 &&
-                                Agros2D::scene()->edges->at(edgeList[edge_i].marker)->isCurvilinear())
+                        if (m_arcs[edgeList[edge_i].marker].isArc)
                         {
                             // load the control points, knot vector, etc.
                             Node* en;
                             int p1 = edgeList[edge_i].node[0], p2 = edgeList[edge_i].node[1];
 
-                            int segments = Agros2D::scene()->edges->at(edgeList[edge_i].marker)->segments();
-
-                            // subdivision angle and chord
-                            double theta = deg2rad(Agros2D::scene()->edges->at(edgeList[edge_i].marker)->angle()) / double(segments);
-                            double chord = 2 * Agros2D::scene()->edges->at(edgeList[edge_i].marker)->radius() * sin(theta / 2.0);
-
-                            // length of short chord
-                            double chordShort = (nodeList[edgeList[edge_i].node[1]] - nodeList[edgeList[edge_i].node[0]]).magnitude();
-
-                            // direction
-                            Point center = Agros2D::scene()->edges->at(edgeList[edge_i].marker)->center();
-                            int direction = (((nodeList[edgeList[edge_i].node[0]].x - center.x)*(nodeList[edgeList[edge_i].node[1]].y - center.y) -
-                                    (nodeList[edgeList[edge_i].node[0]].y - center.y)*(nodeList[edgeList[edge_i].node[1]].x - center.x)) > 0) ? 1 : -1;
-
-                            double angle = direction * theta * chordShort / chord;
-
-                            Hermes::Hermes2D::Curve* curve = MeshUtil::load_arc(m_meshes[subdomains_i], edge_i, &en, p1, p2, rad2deg(angle), true);
+                            Hermes::Hermes2D::Curve* curve = MeshUtil::load_arc(m_meshes[subdomains_i], edge_i, &en, p1, p2, edgeArcAngle(edge_i), true);
 
                             // assign the arc to the elements sharing the edge node
                             if (curve)
@@ -517,6 +730,10 @@ void MeshGenerator::writeToHermes()
             qDebug() << e.what();
             throw;
         }
+
+        // store generator structures in the mesh cache
+        if (!m_cacheKey.isEmpty())
+            writeToCache();
     }
     catch (Hermes::Exceptions::Exception& e)
     {
@@ -544,3 +761,213 @@ bool MeshGenerator::prepare()
 
     return true;
 }
+
+// mesh cache file format version (increase after any change of the format)
+const int MESH_CACHE_VERSION = 1;
+// maximum number of files in the mesh cache
+const int MESH_CACHE_SIZE = 50;
+
+bool MeshGenerator::writeToCache()
+{
+    QString fileName = MeshGeneratorCache::cacheFileName(m_cacheKey);
+
+    // write to unique temporary file first (partially written file is never read,
+    // concurrent writers of the same key do not share the temporary file)
+    QTemporaryFile file(fileName + ".XXXXXX");
+    if (!file.open())
+    {
+        Agros2D::log()->printWarning(tr("Mesh generator"), tr("Could not write mesh cache file (%1)").arg(file.errorString()));
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_4_6);
+    out.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+    out << (quint32) 0x4132444d << (qint32) MESH_CACHE_VERSION;
+
+    out << (qint32) nodeList.count();
+    foreach (Point node, nodeList)
+        out << node.x << node.y;
+
+    out << (qint32) edgeList.count();
+    foreach (MeshEdge edge, edgeList)
+        out << (qint32) edge.node[0] << (qint32) edge.node[1] << (qint32) edge.marker << edge.isUsed;
+
+    out << (qint32) elementList.count();
+    foreach (MeshElement element, elementList)
+        out << (qint32) element.node[0] << (qint32) element.node[1] << (qint32) element.node[2] << (qint32) element.node[3]
+            << (qint32) element.marker << element.isUsed;
+
+    bool ok = (out.status() == QDataStream::Ok) && file.flush();
+    file.close();
+
+    // temporary file is removed automatically on failure
+    QFile::remove(fileName);
+    if (!ok || !file.rename(fileName))
+        return false;
+    file.setAutoRemove(false);
+
+    // remove the oldest files
+    QFileInfoList cacheFiles = QFileInfo(fileName).dir().entryInfoList(QStringList() << "*.mesh", QDir::Files, QDir::Time);
+    for (int i = MESH_CACHE_SIZE; i < cacheFiles.count(); i++)
+        QFile::remove(cacheFiles.at(i).absoluteFilePath());
+
+    return true;
+}
+
+bool MeshGenerator::readFromCache()
+{
+    nodeList.clear();
+    edgeList.clear();
+    elementList.clear();
+
+    QFile file(MeshGeneratorCache::cacheFileName(m_cacheKey));
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_4_6);
+    in.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+    quint32 magic;
+    qint32 version;
+    in >> magic >> version;
+    if (magic != 0x4132444d || version != MESH_CACHE_VERSION)
+        return false;
+
+    qint32 count;
+
+    in >> count;
+    nodeList.reserve(count);
+    for (int i = 0; i < count && in.status() == QDataStream::Ok; i++)
+    {
+        double x, y;
+        in >> x >> y;
+        nodeList.append(Point(x, y));
+    }
+
+    in >> count;
+    edgeList.reserve(count);
+    for (int i = 0; i < count && in.status() == QDataStream::Ok; i++)
+    {
+        qint32 node0, node1, marker;
+        bool isUsed;
+        in >> node0 >> node1 >> marker >> isUsed;
+
+        MeshEdge edge(node0, node1, marker);
+        edge.isUsed = isUsed;
+        edgeList.append(edge);
+    }
+
+    in >> count;
+    elementList.reserve(count);
+    for (int i = 0; i < count && in.status() == QDataStream::Ok; i++)
+    {
+        qint32 node0, node1, node2, node3, marker;
+        bool isUsed;
+        in >> node0 >> node1 >> node2 >> node3 >> marker >> isUsed;
+
+        MeshElement element(node0, node1, node2, node3, marker);
+        element.isUsed = isUsed;
+        elementList.append(element);
+    }
+
+    file.close();
+
+    return (in.status() == QDataStream::Ok);
+}
+
+// ****************************************************************************
+
+int MeshGeneratorCache::m_hits = 0;
+int MeshGeneratorCache::m_misses = 0;
+
+MeshGeneratorCache::MeshGeneratorCache(const QByteArray &key) : MeshGenerator()
+{
+    m_cacheKey = key;
+}
+
+bool MeshGeneratorCache::mesh()
+{
+    m_isError = !prepare();
+
+    QTime time;
+    time.start();
+
+    if (!readFromCache())
+    {
+        // corrupted file is replaced by the mesh generator
+        QFile::remove(cacheFileName(m_cacheKey));
+        Agros2D::log()->printWarning(tr("Mesh generator"), tr("Mesh cache file is corrupted"));
+
+        nodeList.clear();
+        edgeList.clear();
+        elementList.clear();
+
+        return false;
+    }
+
+    Agros2D::log()->printDebug(tr("Mesh generator"), tr("Mesh read from cache: %1 nodes, %2 elements (%3 ms)").
+                               arg(nodeList.count()).arg(elementList.count()).arg(time.elapsed()));
+
+    // cache is not rewritten
+    QByteArray key = m_cacheKey;
+    m_cacheKey.clear();
+
+    time.start();
+    writeToHermes();
+    Agros2D::log()->printDebug(tr("Mesh generator"), tr("Mesh converted to Hermes2D (%1 ms)").arg(time.elapsed()));
+
+    m_cacheKey = key;
+
+    nodeList.clear();
+    edgeList.clear();
+    elementList.clear();
+
+    return !m_isError;
+}
+
+QByteArray MeshGeneratorCache::cacheKey(const QString &generator)
+{
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+    out << (qint32) MESH_CACHE_VERSION << generator << meshTypeToStringKey(Agros2D::problem()->config()->meshType());
+
+    // geometry
+    QHash<SceneNode *, int> nodeIndices;
+    out << (qint32) Agros2D::scene()->nodes->length();
+    for (int i = 0; i < Agros2D::scene()->nodes->length(); i++)
+    {
+        SceneNode *node = Agros2D::scene()->nodes->at(i);
+        nodeIndices.insert(node, i);
+
+        out << node->point().x << node->point().y;
+    }
+
+    out << (qint32) Agros2D::scene()->edges->length();
+    for (int i = 0; i < Agros2D::scene()->edges->length(); i++)
+    {
+        SceneEdge *edge = Agros2D::scene()->edges->at(i);
+        out << (qint32) nodeIndices.value(edge->nodeStart()) << (qint32) nodeIndices.value(edge->nodeEnd())
+            << edge->angle() << (qint32) edge->segments() << edge->isCurvilinear();
+    }
+
+    out << (qint32) Agros2D::scene()->labels->length();
+    for (int i = 0; i < Agros2D::scene()->labels->length(); i++)
+    {
+        SceneLabel *label = Agros2D::scene()->labels->at(i);
+        // holes are not meshed, assignment of markers to fields is applied in writeToHermes()
+        out << label->point().x << label->point().y << label->area() << label->isHole();
+    }
+
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex();
+}
+
+QString MeshGeneratorCache::cacheFileName(const QByteArray &key)
+{
+    return QString("%1/%2.mesh").arg(meshCacheDir()).arg(QString::fromLatin1(key));
+}
@@ -33,6 +33,49 @@ namespace XMLSubdomains
     class domain;
 };
 
+// reads mesh files of external generators from one memory block
+// (text tokens are parsed in place, binary blocks are copied directly)
+class MeshFileReader
+{
+public:
+    MeshFileReader() : m_pos(0), m_isValid(true) {}
+
+    bool load(const QString &fileName);
+
+    inline bool isValid() const { return m_isValid; }
+    bool atEnd();
+
+    // moves behind the next line starting with keyword
+    bool seek(const char *keyword);
+    void skipLine();
+
+    int readInt();
+    double readDouble();
+
+    template <typename T>
+    T readBinary()
+    {
+        T value = T();
+        if (m_pos + (int) sizeof(T) > m_data.size())
+        {
+            m_isValid = false;
+            return value;
+        }
+
+        memcpy(&value, m_data.constData() + m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return value;
+    }
+
+private:
+    QByteArray m_data;
+    int m_pos;
+    bool m_isValid;
+
+    // skips white characters and comments
+    void skipWhite();
+};
+
 class AGROS_LIBRARY_API MeshGenerator : public QObject
 {
     Q_OBJECT
@@ -45,6 +88,9 @@ public:
 
     inline Hermes::vector<Hermes::Hermes2D::MeshSharedPtr> meshes() { return m_meshes; }
 
+    // generated mesh is stored in the mesh cache under the key
+    inline void setCacheKey(const QByteArray &key) { m_cacheKey = key; }
+
 protected:
     struct MeshEdge
         {
@@ -190,9 +236,25 @@ protected:
             double area;
         };
 
-    QList<Point> nodeList;
-    QList<MeshEdge> edgeList;
-    QList<MeshElement> elementList;
+        // arc of scene edge (precomputed, scene edges are not accessed per mesh edge)
+        struct MeshArc
+        {
+            MeshArc() : isArc(false), radius(0.0), angle(0.0), segments(0) {}
+
+            bool isArc;
+            Point center;
+            double radius;
+            double angle;
+            int segments;
+        };
+
+    // flat arrays (items are stored in one block)
+    QVector<Point> nodeList;
+    QVector<MeshEdge> edgeList;
+    QVector<MeshElement> elementList;
+
+    // arcs indexed by edge marker
+    QVector<MeshArc> m_arcs;
 
     /// Complete method translating the internal generator structures into m_meshes.
     void writeToHermes();
@@ -208,14 +270,54 @@ protected:
     /// Updates vertex nodes coordinates according to curvature on edges.
     void moveNodesOnCurvedEdges();
 
+    /// Fills m_arcs from scene edges.
+    void prepareArcs();
+
+    /// Angle (in degrees) of the arc between nodes of the mesh edge.
+    double edgeArcAngle(int edge_i) const;
+
+    /// Labels with material of the field (index is element marker).
+    QVector<bool> labelsInField(FieldInfo *fieldInfo) const;
+
     /// Calculate the counts of elements, edges for a subdomain.
     void getDataCountsForSingleSubdomain(FieldInfo* fieldInfo, int& element_number_count, int& boundary_edge_number_count, int& inner_edge_number_count);
 
     bool prepare();
 
+    /// Binary mesh cache (internal generator structures).
+    bool writeToCache();
+    bool readFromCache();
+
     bool m_isError;
     QSharedPointer<QProcess> m_process;
     Hermes::vector<Hermes::Hermes2D::MeshSharedPtr> m_meshes;
+    QByteArray m_cacheKey;
+};
+
+// reads initial mesh from the mesh cache instead of running a mesh generator
+// the key is a hash of geometry, holes, mesh type and generator
+class AGROS_LIBRARY_API MeshGeneratorCache : public MeshGenerator
+{
+    Q_OBJECT
+
+public:
+    MeshGeneratorCache(const QByteArray &key);
+
+    virtual bool mesh();
+
+    static QByteArray cacheKey(const QString &generator);
+    static QString cacheFileName(const QByteArray &key);
+    static inline bool contains(const QByteArray &key) { return QFile::exists(cacheFileName(key)); }
+
+    // hit/miss statistics
+    static inline int hits() { return m_hits; }
+    static inline int misses() { return m_misses; }
+    static inline void addHit() { m_hits++; }
+    static inline void addMiss() { m_misses++; }
+
+private:
+    static int m_hits;
+    static int m_misses;
 };
 
 #endif //MESHGENERATOR_H
@@ -48,15 +48,17 @@ bool MeshGeneratorGMSH::mesh()
 {
     m_isError = !prepare();
 
+    QTime time;
+
     // create gmsh files
+    time.start();
     if (writeToGmsh())
     {
-        // exec GMSH
+        Agros2D::log()->printDebug(tr("Mesh generator"), tr("GMSH input written (%1 ms)").arg(time.elapsed()));
+
+        // exec GMSH (output channels are kept in memory)
         m_process = QSharedPointer<QProcess>(new QProcess());
-        m_process.data()->setStandardOutputFile(tempProblemFileName() + ".gmsh.out");
-        m_process.data()->setStandardErrorFile(tempProblemFileName() + ".gmsh.err");
         connect(m_process.data(), SIGNAL(error(QProcess::ProcessError)), this, SLOT(meshGmshError(QProcess::ProcessError)));
-        connect(m_process.data(), SIGNAL(finished(int)), this, SLOT(meshGmshCreated(int)));
 
         QString gmshBinary = "gmsh";
         if (QFile::exists(QApplication::applicationDirPath() + QDir::separator() + "gmsh.exe"))
@@ -64,7 +66,10 @@ bool MeshGeneratorGMSH::mesh()
         if (QFile::exists(QApplication::applicationDirPath() + QDir::separator() + "gmsh"))
             gmshBinary = QApplication::applicationDirPath() + QDir::separator() + "gmsh";
 
-        QString triangleGMSH = "%1 -2 \"%2.geo\"";
+        // binary mesh file is read without text conversion
+        // (reader supports format version 2 only, newer gmsh writes version 4 by default)
+        QString triangleGMSH = "%1 -2 -format msh2 -bin \"%2.geo\"";
+        time.start();
         m_process.data()->start(triangleGMSH.
                                 arg(gmshBinary).
                                 arg(tempProblemFileName()), QIODevice::ReadOnly);
@@ -74,6 +79,12 @@ bool MeshGeneratorGMSH::mesh()
         connect(m_process.data(), SIGNAL(finished(int)), &eventLoop, SLOT(quit()));
         connect(m_process.data(), SIGNAL(error(QProcess::ProcessError)), &eventLoop, SLOT(quit()));
         eventLoop.exec();
+
+        if (!m_isError)
+        {
+            Agros2D::log()->printDebug(tr("Mesh generator"), tr("GMSH finished (%1 ms)").arg(time.elapsed()));
+            meshGmshCreated(m_process.data()->exitCode());
+        }
     }
     else
     {
@@ -96,28 +107,21 @@ void MeshGeneratorGMSH::meshGmshCreated(int exitCode)
 {
     if (exitCode == 0)
     {
-        // Agros2D::log()->printDebug(tr("Mesh generator"), tr("Mesh files were created"));
         // convert gmsh mesh to hermes mesh
-        if (readGmshMeshFile())
-        {
-            // Agros2D::log()->printDebug(tr("Mesh generator"), tr("Mesh was converted to Hermes2D mesh file"));
-
-            //  remove gmsh temp files
-            QFile::remove(tempProblemFileName() + ".geo");
-            QFile::remove(tempProblemFileName() + ".msh");
-            QFile::remove(tempProblemFileName() + ".gmsh.out");
-            QFile::remove(tempProblemFileName() + ".gmsh.err");
-        }
-        else
+        if (!readGmshMeshFile())
         {
             m_isError = true;
             QFile::remove(Agros2D::problem()->config()->fileName() + ".msh");
         }
+
+        //  remove gmsh temp files
+        QFile::remove(tempProblemFileName() + ".geo");
+        QFile::remove(tempProblemFileName() + ".msh");
     }
     else
     {
         m_isError = true;
-        QString errorMessage = readFileContent(tempProblemFileName() + ".gmsh.err");
+        QString errorMessage = QString::fromLocal8Bit(m_process.data()->readAllStandardError());
         errorMessage.insert(0, "\n");
         errorMessage.append("\n");
         Agros2D::log()->printError(tr("Mesh generator"), errorMessage);
@@ -160,6 +164,12 @@ bool MeshGeneratorGMSH::writeToGmsh()
     out << QString("mesh_size = %1;\n").arg(qMin(rect.width(), rect.height()) / 6.0);
     //out << QString("mesh_size = 0;\n");
 
+    // node indices
+    QHash<SceneNode *, int> nodeIndices;
+    nodeIndices.reserve(Agros2D::scene()->nodes->length());
+    for (int i = 0; i < Agros2D::scene()->nodes->length(); i++)
+        nodeIndices.insert(Agros2D::scene()->nodes->at(i), i);
+
     // nodes
     QString outNodes;
     int nodesCount = 0;
@@ -182,8 +192,8 @@ bool MeshGeneratorGMSH::writeToGmsh()
             // line .. increase edge index to count from 1
             outEdges += QString("Line(%1) = {%2, %3};\n").
                     arg(edgesCount+1).
-                    arg(Agros2D::scene()->nodes->items().indexOf(Agros2D::scene()->edges->at(i)->nodeStart())).
-                    arg(Agros2D::scene()->nodes->items().indexOf(Agros2D::scene()->edges->at(i)->nodeEnd()));
+                    arg(nodeIndices.value(Agros2D::scene()->edges->at(i)->nodeStart())).
+                    arg(nodeIndices.value(Agros2D::scene()->edges->at(i)->nodeEnd()));
             edgesCount++;
         }
         else
@@ -199,9 +209,9 @@ bool MeshGeneratorGMSH::writeToGmsh()
 
             outEdges += QString("Circle(%1) = {%2, %3, %4};\n").
                     arg(edgesCount+1).
-                    arg(Agros2D::scene()->nodes->items().indexOf(Agros2D::scene()->edges->at(i)->nodeStart())).
+                    arg(nodeIndices.value(Agros2D::scene()->edges->at(i)->nodeStart())).
                     arg(nodesCount - 1).
-                    arg(Agros2D::scene()->nodes->items().indexOf(Agros2D::scene()->edges->at(i)->nodeEnd()));
+                    arg(nodeIndices.value(Agros2D::scene()->edges->at(i)->nodeEnd()));
 
             edgesCount++;
         }
@@ -372,50 +382,158 @@ bool MeshGeneratorGMSH::writeToGmsh()
     return true;
 }
 
+// number of nodes of gmsh element types (-1 for unsupported types)
+static int gmshElementNodes(int type)
+{
+    switch (type)
+    {
+    case 1: // line
+        return 2;
+    case 2: // triangle
+        return 3;
+    case 3: // quadrangle
+        return 4;
+    case 15: // point
+        return 1;
+    default:
+        return -1;
+    }
+}
+
 bool MeshGeneratorGMSH::readGmshMeshFile()
 {
     nodeList.clear();
     edgeList.clear();
     elementList.clear();
 
-    int k;
+    QTime time;
+    time.start();
 
-    QFile fileGMSH(tempProblemFileName() + ".msh");
-    if (!fileGMSH.open(QIODevice::ReadOnly | QIODevice::Text))
+    // the whole file is read at once and parsed in memory
+    MeshFileReader inGMSH;
+    if (!inGMSH.load(tempProblemFileName() + ".msh"))
     {
         Agros2D::log()->printError(tr("Mesh generator"), tr("Could not read GMSH mesh file"));
         return false;
     }
-    QTextStream inGMSH(&fileGMSH);
+
+    // format (version 2 in ascii or binary)
+    inGMSH.seek("$MeshFormat");
+    double version = inGMSH.readDouble();
+    bool isBinary = (inGMSH.readInt() == 1);
+    int dataSize = inGMSH.readInt();
+    inGMSH.skipLine();
+    if (!inGMSH.isValid() || version < 2.0 || version >= 3.0 || dataSize != sizeof(double))
+    {
+        Agros2D::log()->printError(tr("Mesh generator"), tr("Unsupported GMSH mesh file format"));
+        return false;
+    }
+    if (isBinary && inGMSH.readBinary<int>() != 1)
+    {
+        Agros2D::log()->printError(tr("Mesh generator"), tr("GMSH binary mesh file has different endianness"));
+        return false;
+    }
 
     // nodes
-    inGMSH.readLine();
-    inGMSH.readLine();
-    inGMSH.readLine();
-    inGMSH.readLine();
-    sscanf(inGMSH.readLine().toLatin1().data(), "%i", &k);
-    for (int i = 0; i < k; i++)
+    inGMSH.seek("$Nodes");
+    int numberOfNodes = inGMSH.readInt();
+    inGMSH.skipLine();
+    nodeList.reserve(numberOfNodes);
+    for (int i = 0; i < numberOfNodes; i++)
     {
-        int n;
-        double x, y, z;
+        if (isBinary)
+        {
+            inGMSH.readBinary<int>();
+            double x = inGMSH.readBinary<double>();
+            double y = inGMSH.readBinary<double>();
+            inGMSH.readBinary<double>();
 
-        sscanf(inGMSH.readLine().toLatin1().data(), "%i %lf %lf %lf", &n, &x, &y, &z);
-        nodeList.append(Point(x, y));
+            nodeList.append(Point(x, y));
+        }
+        else
+        {
+            inGMSH.readInt();
+            double x = inGMSH.readDouble();
+            double y = inGMSH.readDouble();
+            inGMSH.readDouble();
+
+            nodeList.append(Point(x, y));
+        }
     }
 
     // elements
-    inGMSH.readLine();
-    inGMSH.readLine();
-    sscanf(inGMSH.readLine().toLatin1().data(), "%i", &k);
+    inGMSH.seek("$Elements");
+    int numberOfElements = inGMSH.readInt();
+    inGMSH.skipLine();
     QSet<int> labelMarkersCheck;
-    for (int i = 0; i < k; i++)
+    int i = 0;
+    while (i < numberOfElements && inGMSH.isValid())
     {
-        int quad[4];
-        int n, type, phys, part, marker;
+        // binary elements are stored in blocks of the same type
+        int type = 0;
+        int blockCount = 1;
+        int numberOfTags = 0;
+        if (isBinary)
+        {
+            type = inGMSH.readBinary<int>();
+            blockCount = inGMSH.readBinary<int>();
+            numberOfTags = inGMSH.readBinary<int>();
+        }
 
-        if (sscanf(inGMSH.readLine().toLatin1().data(), "%i %i %i %i %i %i %i %i %i",
-                   &n, &type, &phys, &part, &marker, &quad[0], &quad[1], &quad[2], &quad[3]))
+        for (int j = 0; j < blockCount; j++)
         {
+            int tags[2] = { 0, 0 };
+            int quad[4];
+            int nodes;
+
+            if (isBinary)
+            {
+                inGMSH.readBinary<int>();
+                for (int k = 0; k < numberOfTags; k++)
+                {
+                    int tag = inGMSH.readBinary<int>();
+                    if (k < 2)
+                        tags[k] = tag;
+                }
+
+                nodes = gmshElementNodes(type);
+                for (int k = 0; k < nodes; k++)
+                {
+                    int node = inGMSH.readBinary<int>();
+                    if (k < 4)
+                        quad[k] = node;
+                }
+            }
+            else
+            {
+                inGMSH.readInt();
+                type = inGMSH.readInt();
+                numberOfTags = inGMSH.readInt();
+                for (int k = 0; k < numberOfTags; k++)
+                {
+                    int tag = inGMSH.readInt();
+                    if (k < 2)
+                        tags[k] = tag;
+                }
+
+                nodes = gmshElementNodes(type);
+                for (int k = 0; k < nodes; k++)
+                {
+                    int node = inGMSH.readInt();
+                    if (k < 4)
+                        quad[k] = node;
+                }
+            }
+
+            if (nodes == -1)
+            {
+                Agros2D::log()->printError(tr("Mesh generator"), tr("Unsupported GMSH element type (%1)").arg(type));
+                return false;
+            }
+
+            // elementary entity
+            int marker = (numberOfTags > 1) ? tags[1] : tags[0];
+
             // edge
             if (type == 1)
                 edgeList.append(MeshEdge(quad[0] - 1, quad[1] - 1, marker - 1)); // marker conversion from gmsh, where it starts from 1
@@ -425,21 +543,25 @@ bool MeshGeneratorGMSH::readGmshMeshFile()
             // quad
             if (type == 3)
                 elementList.append(MeshElement(quad[0] - 1, quad[1] - 1, quad[2] - 1, quad[3] - 1, marker - 1)); // marker conversion from gmsh, where it starts from 1
-        }
-        /*
 
-        if (marker == 0)
-        {
-            Agros2D::log()->printError(tr("Mesh generator"), tr("Some areas have no label marker"));
-            return false;
+            labelMarkersCheck.insert(marker - 1);
         }
-        */
-        labelMarkersCheck.insert(marker - 1);
+
+        i += blockCount;
+    }
+
+    if (!inGMSH.isValid())
+    {
+        Agros2D::log()->printError(tr("Mesh generator"), tr("GMSH mesh file is corrupted"));
+        return false;
     }
 
-    fileGMSH.close();
+    Agros2D::log()->printDebug(tr("Mesh generator"), tr("GMSH mesh parsed: %1 nodes, %2 elements (%3 ms)").
+                               arg(nodeList.count()).arg(elementList.count()).arg(time.elapsed()));
 
+    time.start();
     writeToHermes();
+    Agros2D::log()->printDebug(tr("Mesh generator"), tr("Mesh converted to Hermes2D (%1 ms)").arg(time.elapsed()));
 
     nodeList.clear();
     edgeList.clear();
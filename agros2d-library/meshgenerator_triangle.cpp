@@ -20,6 +20,7 @@
 #include "meshgenerator_triangle.h"
 
 #include "util/global.h"
+#include "util/conf.h"
 
 #include "scene.h"
 
@@ -51,15 +52,17 @@ bool MeshGeneratorTriangleExternal::mesh()
 {
     m_isError = !prepare();
 
+    QTime time;
+
     // create triangle files
+    time.start();
     if (writeToTriangle())
     {
-        // exec triangle
+        Agros2D::log()->printDebug(tr("Mesh generator"), tr("Triangle input written (%1 ms)").arg(time.elapsed()));
+
+        // exec triangle (output channels are kept in memory)
         m_process = QSharedPointer<QProcess>(new QProcess());
-        m_process.data()->setStandardOutputFile(tempProblemFileName() + ".triangle.out");
-        m_process.data()->setStandardErrorFile(tempProblemFileName() + ".triangle.err");
         connect(m_process.data(), SIGNAL(error(QProcess::ProcessError)), this, SLOT(meshTriangleError(QProcess::ProcessError)));
-        connect(m_process.data(), SIGNAL(finished(int)), this, SLOT(meshTriangleCreated(int)));
 
         QString triangleBinary = "triangle";
         if (QFile::exists(QApplication::applicationDirPath() + QDir::separator() + "triangle.exe"))
@@ -68,6 +71,7 @@ bool MeshGeneratorTriangleExternal::mesh()
             triangleBinary = QApplication::applicationDirPath() + QDir::separator() + "triangle";
 
         QString triangleCommand = "%1 -p -P -q31.0 -e -A -a -z -Q -I -n -o2 \"%2\"";
+        time.start();
         m_process.data()->start(triangleCommand.
                                 arg(triangleBinary).
                                 arg(tempProblemFileName()), QIODevice::ReadOnly);
@@ -77,6 +81,12 @@ bool MeshGeneratorTriangleExternal::mesh()
         connect(m_process.data(), SIGNAL(finished(int)), &eventLoop, SLOT(quit()));
         connect(m_process.data(), SIGNAL(error(QProcess::ProcessError)), &eventLoop, SLOT(quit()));
         eventLoop.exec();
+
+        if (!m_isError)
+        {
+            Agros2D::log()->printDebug(tr("Mesh generator"), tr("Triangle finished (%1 ms)").arg(time.elapsed()));
+            meshTriangleCreated(m_process.data()->exitCode());
+        }
     }
     else
     {
@@ -98,32 +108,24 @@ void MeshGeneratorTriangleExternal::meshTriangleCreated(int exitCode)
 {
     if (exitCode == 0)
     {
-        // Agros2D::log()->printDebug(tr("Mesh generator"), tr("Mesh files were created"));
-
         // convert triangle mesh to hermes mesh
-        if (readTriangleMeshFormat())
-        {
-            // Agros2D::log()->printDebug(tr("Mesh generator"), tr("Mesh was converted to Hermes2D mesh file"));
-
-            //  remove triangle temp files
-            //QFile::remove(tempProblemFileName() + ".poly");
-            //QFile::remove(tempProblemFileName() + ".node");
-            //QFile::remove(tempProblemFileName() + ".edge");
-            //QFile::remove(tempProblemFileName() + ".ele");
-            //QFile::remove(tempProblemFileName() + ".neigh");
-            //QFile::remove(tempProblemFileName() + ".triangle.out");
-            //QFile::remove(tempProblemFileName() + ".triangle.err");
-        }
-        else
+        if (!readTriangleMeshFormat())
         {
             m_isError = true;
             QFile::remove(Agros2D::problem()->config()->fileName() + ".msh");
         }
+
+        //  remove triangle temp files
+        QFile::remove(tempProblemFileName() + ".poly");
+        QFile::remove(tempProblemFileName() + ".node");
+        QFile::remove(tempProblemFileName() + ".edge");
+        QFile::remove(tempProblemFileName() + ".ele");
+        QFile::remove(tempProblemFileName() + ".neigh");
     }
     else
     {
         m_isError = true;
-        QString errorMessage = readFileContent(tempProblemFileName() + ".triangle.err");
+        QString errorMessage = QString::fromLocal8Bit(m_process.data()->readAllStandardError());
         errorMessage.insert(0, "\n");
         errorMessage.append("\n");
         Agros2D::log()->printError(tr("Mesh generator"), errorMessage);
@@ -146,61 +148,61 @@ bool MeshGeneratorTriangleExternal::writeToTriangle()
         return false;
     }
 
-    // save current locale
-    // char *plocale = setlocale (LC_NUMERIC, "");
-    // setlocale (LC_NUMERIC, "C");
-
     QDir dir;
     dir.mkdir(QDir::temp().absolutePath() + "/agros2d");
     QFile file(tempProblemFileName() + ".poly");
 
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    if (!file.open(QIODevice::WriteOnly))
     {
         Agros2D::log()->printError(tr("Mesh generator"), tr("Could not create Triangle poly mesh file (%1)").arg(file.errorString()));
         return false;
     }
-    QTextStream out(&file);
 
+    // node indices
+    QHash<SceneNode *, int> nodeIndices;
+    nodeIndices.reserve(Agros2D::scene()->nodes->length());
+    for (int i = 0; i < Agros2D::scene()->nodes->length(); i++)
+        nodeIndices.insert(Agros2D::scene()->nodes->at(i), i);
 
+    // the whole file is composed in memory (QByteArray::number() is locale independent)
     // nodes
-    QString outNodes;
+    QByteArray outNodes;
     int nodesCount = 0;
-    for (int i = 0; i<Agros2D::scene()->nodes->length(); i++)
+    for (int i = 0; i < Agros2D::scene()->nodes->length(); i++)
     {
-        outNodes += QString("%1  %2  %3  %4\n").
-                arg(i).
-                arg(Agros2D::scene()->nodes->at(i)->point().x, 0, 'f', 10).
-                arg(Agros2D::scene()->nodes->at(i)->point().y, 0, 'f', 10).
-                arg(0);
+        outNodes += QByteArray::number(i) + "  " +
+                QByteArray::number(Agros2D::scene()->nodes->at(i)->point().x, 'f', 10) + "  " +
+                QByteArray::number(Agros2D::scene()->nodes->at(i)->point().y, 'f', 10) + "  0\n";
         nodesCount++;
     }
 
     // edges
-    QString outEdges;
+    QByteArray outEdges;
     int edgesCount = 0;
-    for (int i = 0; i<Agros2D::scene()->edges->length(); i++)
+    for (int i = 0; i < Agros2D::scene()->edges->length(); i++)
     {
-        if (Agros2D::scene()->edges->at(i)->angle() == 0)
+        SceneEdge *edge = Agros2D::scene()->edges->at(i);
+
+        if (edge->angle() == 0)
         {
             // line
-            outEdges += QString("%1  %2  %3  %4\n").
-                    arg(edgesCount).
-                    arg(Agros2D::scene()->nodes->items().indexOf(Agros2D::scene()->edges->at(i)->nodeStart())).
-                    arg(Agros2D::scene()->nodes->items().indexOf(Agros2D::scene()->edges->at(i)->nodeEnd())).
-                    arg(i+1);
+            outEdges += QByteArray::number(edgesCount) + "  " +
+                    QByteArray::number(nodeIndices.value(edge->nodeStart())) + "  " +
+                    QByteArray::number(nodeIndices.value(edge->nodeEnd())) + "  " +
+                    QByteArray::number(i+1) + "\n";
             edgesCount++;
         }
         else
         {
             // arc
             // add pseudo nodes
-            Point center = Agros2D::scene()->edges->at(i)->center();
-            double radius = Agros2D::scene()->edges->at(i)->radius();
-            double startAngle = atan2(center.y - Agros2D::scene()->edges->at(i)->nodeStart()->point().y,
-                                      center.x - Agros2D::scene()->edges->at(i)->nodeStart()->point().x) - M_PI;
+            Point center = edge->center();
+            double radius = edge->radius();
+            double startAngle = atan2(center.y - edge->nodeStart()->point().y,
+                                      center.x - edge->nodeStart()->point().x) - M_PI;
 
-            int segments = Agros2D::scene()->edges->at(i)->segments();
-            double theta = deg2rad(Agros2D::scene()->edges->at(i)->angle()) / double(segments);
+            int segments = edge->segments();
+            double theta = deg2rad(edge->angle()) / double(segments);
 
             int nodeStartIndex = 0;
             int nodeEndIndex = 0;
@@ -214,89 +216,77 @@ bool MeshGeneratorTriangleExternal::writeToTriangle()
                 nodeEndIndex = nodesCount+1;
                 if (j == 0)
                 {
-                    nodeStartIndex = Agros2D::scene()->nodes->items().indexOf(Agros2D::scene()->edges->at(i)->nodeStart());
+                    nodeStartIndex = nodeIndices.value(edge->nodeStart());
                     nodeEndIndex = nodesCount;
                 }
                 if (j == segments - 1)
                 {
-                    nodeEndIndex = Agros2D::scene()->nodes->items().indexOf(Agros2D::scene()->edges->at(i)->nodeEnd());
+                    nodeEndIndex = nodeIndices.value(edge->nodeEnd());
                 }
                 if ((j > 0) && (j < segments))
                 {
-                    outNodes += QString("%1  %2  %3  %4\n").
-                            arg(nodesCount).
-                            arg(center.x + x, 0, 'f', 10).
-                            arg(center.y + y, 0, 'f', 10).
-                            arg(0);
+                    outNodes += QByteArray::number(nodesCount) + "  " +
+                            QByteArray::number(center.x + x, 'f', 10) + "  " +
+                            QByteArray::number(center.y + y, 'f', 10) + "  0\n";
                     nodesCount++;
                 }
-                outEdges += QString("%1  %2  %3  %4\n").
-                        arg(edgesCount).
-                        arg(nodeStartIndex).
-                        arg(nodeEndIndex).
-                        arg(i+1);
+                outEdges += QByteArray::number(edgesCount) + "  " +
+                        QByteArray::number(nodeStartIndex) + "  " +
+                        QByteArray::number(nodeEndIndex) + "  " +
+                        QByteArray::number(i+1) + "\n";
                 edgesCount++;
                 nodeStartIndex = nodeEndIndex;
             }
         }
     }
 
-    // holes
+    // holes and labels
+    QByteArray outHoles;
+    QByteArray outLabels;
     int holesCount = 0;
-    foreach (SceneLabel *label, Agros2D::scene()->labels->items())
-        if (label->markersCount() == 0)
-            holesCount++;
-
-    QString outHoles = QString("%1\n").arg(holesCount);
-    holesCount = 0;
-    foreach (SceneLabel *label, Agros2D::scene()->labels->items())
+    int labelsCount = 0;
+    for (int i = 0; i < Agros2D::scene()->labels->length(); i++)
     {
+        SceneLabel *label = Agros2D::scene()->labels->at(i);
+
         if (label->markersCount() == 0)
         {
-            outHoles += QString("%1  %2  %3\n").
-                    arg(holesCount).
-                    // arg(Agros2D::scene()->labels->items().indexOf(label) + 1).
-                    arg(label->point().x, 0, 'f', 10).
-                    arg(label->point().y, 0, 'f', 10);
-
+            outHoles += QByteArray::number(holesCount) + "  " +
+                    QByteArray::number(label->point().x, 'f', 10) + "  " +
+                    QByteArray::number(label->point().y, 'f', 10) + "\n";
             holesCount++;
         }
-    }
-
-    // labels
-    QString outLabels;
-    int labelsCount = 0;
-    foreach (SceneLabel *label, Agros2D::scene()->labels->items())
-    {
-        if (label->markersCount() > 0)
+        else
         {
-            outLabels += QString("%1  %2  %3  %4  %5\n").
-                    arg(labelsCount).
-                    arg(label->point().x, 0, 'f', 10).
-                    arg(label->point().y, 0, 'f', 10).
-                    // arg(labelsCount + 1). // triangle returns zero region number for areas without marker, markers must start from 1
-                    arg(Agros2D::scene()->labels->items().indexOf(label) + 1).
-                    arg(label->area());
+            // triangle returns zero region number for areas without marker, markers must start from 1
+            outLabels += QByteArray::number(labelsCount) + "  " +
+                    QByteArray::number(label->point().x, 'f', 10) + "  " +
+                    QByteArray::number(label->point().y, 'f', 10) + "  " +
+                    QByteArray::number(i + 1) + "  " +
+                    QByteArray::number(label->area()) + "\n";
             labelsCount++;
         }
     }
 
-    outNodes.insert(0, QString("%1 2 0 1\n").
-                    arg(nodesCount)); // + additional Agros2D::scene()->nodes
-    out << outNodes;
-    outEdges.insert(0, QString("%1 1\n").
-                    arg(edgesCount)); // + additional edges
-    out << outEdges;
-    out << outHoles;
-    outLabels.insert(0, QString("%1 1\n").
-                     arg(labelsCount)); // - holes
-    out << outLabels;
-
-    file.waitForBytesWritten(0);
+    QByteArray out;
+    out.reserve(outNodes.size() + outEdges.size() + outHoles.size() + outLabels.size() + 64);
+    out += QByteArray::number(nodesCount) + " 2 0 1\n";
+    out += outNodes;
+    out += QByteArray::number(edgesCount) + " 1\n";
+    out += outEdges;
+    out += QByteArray::number(holesCount) + "\n";
+    out += outHoles;
+    out += QByteArray::number(labelsCount) + " 1\n";
+    out += outLabels;
+
+    bool written = (file.write(out) == out.size());
     file.close();
 
-    // set system locale
-    // setlocale(LC_NUMERIC, plocale);
+    if (!written)
+    {
+        Agros2D::log()->printError(tr("Mesh generator"), tr("Could not create Triangle poly mesh file (%1)").arg(file.errorString()));
+        return false;
+    }
 
     return true;
 }
@@ -307,80 +297,103 @@ bool MeshGeneratorTriangleExternal::readTriangleMeshFormat()
     edgeList.clear();
     elementList.clear();
 
-    QFile fileNode(tempProblemFileName() + ".node");
-    if (!fileNode.open(QIODevice::ReadOnly | QIODevice::Text))
+    QTime time;
+    time.start();
+
+    // each file is read at once and parsed in memory
+    MeshFileReader inNode;
+    if (!inNode.load(tempProblemFileName() + ".node"))
     {
         Agros2D::log()->printError(tr("Mesh generator"), tr("Could not read Triangle node file"));
         return false;
     }
-    QTextStream inNode(&fileNode);
 
-    QFile fileEdge(tempProblemFileName() + ".edge");
-    if (!fileEdge.open(QIODevice::ReadOnly | QIODevice::Text))
+    MeshFileReader inEdge;
+    if (!inEdge.load(tempProblemFileName() + ".edge"))
     {
         Agros2D::log()->printError(tr("Mesh generator"), tr("Could not read Triangle edge file"));
         return false;
     }
-    QTextStream inEdge(&fileEdge);
 
-    QFile fileEle(tempProblemFileName() + ".ele");
-    if (!fileEle.open(QIODevice::ReadOnly | QIODevice::Text))
+    MeshFileReader inEle;
+    if (!inEle.load(tempProblemFileName() + ".ele"))
     {
         Agros2D::log()->printError(tr("Mesh generator"), tr("Could not read Triangle elements file"));
         return false;
     }
-    QTextStream inEle(&fileEle);
 
-    QFile fileNeigh(tempProblemFileName() + ".neigh");
-    if (!fileNeigh.open(QIODevice::ReadOnly | QIODevice::Text))
+    MeshFileReader inNeigh;
+    if (!inNeigh.load(tempProblemFileName() + ".neigh"))
     {
         Agros2D::log()->printError(tr("Mesh generator"), tr("Could not read Triangle neighbors elements file"));
         return false;
     }
-    QTextStream inNeigh(&fileNeigh);
-
-    // white chars
-    QRegExp whiteChar("\\s+");
 
     // triangle nodes
-    QString lineNode = inNode.readLine().trimmed();
-    int numberOfNodes = lineNode.split(whiteChar).at(0).toInt();
+    int numberOfNodes = inNode.readInt();
+    inNode.readInt(); // dimension
+    int numberOfNodeAttributes = inNode.readInt();
+    int numberOfNodeMarkers = inNode.readInt();
+    nodeList.reserve(numberOfNodes);
     for (int i = 0; i < numberOfNodes; i++)
     {
-        // suspisious code, causes the "Concave element ...." exception
-        QStringList parsedLine = inNode.readLine().trimmed().split(whiteChar);
+        inNode.readInt();
+        double x = inNode.readDouble();
+        double y = inNode.readDouble();
+        for (int j = 0; j < numberOfNodeAttributes + numberOfNodeMarkers; j++)
+            inNode.readDouble();
 
-        nodeList.append(Point(parsedLine.at(1).toDouble(),
-                              parsedLine.at(2).toDouble()));
+        nodeList.append(Point(x, y));
     }
 
     // triangle edges
-    QString lineEdge = inEdge.readLine().trimmed();
-    int numberOfEdges = lineEdge.split(whiteChar).at(0).toInt();
+    int numberOfEdges = inEdge.readInt();
+    int numberOfEdgeMarkers = inEdge.readInt();
+    edgeList.reserve(numberOfEdges);
     for (int i = 0; i < numberOfEdges; i++)
     {
-        QStringList parsedLine = inEdge.readLine().trimmed().split(whiteChar);
+        inEdge.readInt();
+        int nodeA = inEdge.readInt();
+        int nodeB = inEdge.readInt();
+        int marker = (numberOfEdgeMarkers > 0) ? inEdge.readInt() : 0;
 
         // marker conversion from triangle, where it starts from 1
-        edgeList.append(MeshEdge(parsedLine.at(1).toInt(),
-                                 parsedLine.at(2).toInt(),
-                                 parsedLine.at(3).toInt() - 1));
+        edgeList.append(MeshEdge(nodeA, nodeB, marker - 1));
     }
     int edgeCountLinear = edgeList.count();
 
     // triangle elements
-    QString lineElement = inEle.readLine().trimmed();
-    int numberOfElements = lineElement.split(whiteChar).at(0).toInt();
+    int numberOfElements = inEle.readInt();
+    int numberOfElementNodes = inEle.readInt();
+    int numberOfElementAttributes = inEle.readInt();
+    if (numberOfElementAttributes == 0)
+    {
+        Agros2D::log()->printError(tr("Mesh generator"), tr("Some areas do not have a marker"));
+        return false;
+    }
+    if (numberOfElementNodes != 6)
+    {
+        Agros2D::log()->printError(tr("Mesh generator"), tr("Triangle elements are not of the second order"));
+        return false;
+    }
+
     QSet<int> labelMarkersCheck;
     for (int i = 0; i < numberOfElements; i++)
     {
-        QStringList parsedLine = inEle.readLine().trimmed().split(whiteChar);
-        if (parsedLine.count() == 7)
-        {
-            Agros2D::log()->printError(tr("Mesh generator"), tr("Some areas do not have a marker"));
-            return false;
-        }
-        int marker = parsedLine.at(7).toInt();
+        inEle.readInt();
+
+        // vertices
+        int nodeA = inEle.readInt();
+        int nodeB = inEle.readInt();
+        int nodeC = inEle.readInt();
+        // 2nd order nodes (in the middle of edges)
+        int nodeNA = inEle.readInt();
+        int nodeNB = inEle.readInt();
+        int nodeNC = inEle.readInt();
+
+        int marker = qRound(inEle.readDouble());
+        for (int j = 1; j < numberOfElementAttributes; j++)
+            inEle.readDouble();
 
         if (marker == 0)
         {
@@ -388,16 +401,8 @@ bool MeshGeneratorTriangleExternal::readTriangleMeshFormat()
             return false;
         }
 
-        // vertices
-        int nodeA = parsedLine.at(1).toInt();
-        int nodeB = parsedLine.at(2).toInt();
-        int nodeC = parsedLine.at(3).toInt();
-        // 2nd order nodes (in the middle of edges)
-        int nodeNA = parsedLine.at(4).toInt();
-        int nodeNB = parsedLine.at(5).toInt();
-        int nodeNC = parsedLine.at(6).toInt();
-
         if (Agros2D::problem()->config()->meshType() == MeshType_Triangle ||
+                Agros2D::problem()->config()->meshType() == MeshType_Triangle_Parallel ||
                 Agros2D::problem()->config()->meshType() == MeshType_Triangle_QuadJoin ||
                 Agros2D::problem()->config()->meshType() == MeshType_Triangle_QuadRoughDivision)
         {
@@ -420,21 +425,22 @@ bool MeshGeneratorTriangleExternal::readTriangleMeshFormat()
     int elementCountLinear = elementList.count();
 
     // triangle neigh
-    QString lineNeigh = inNeigh.readLine().trimmed();
-    int numberOfNeigh = lineNeigh.split(whiteChar).at(0).toInt();
+    int numberOfNeigh = inNeigh.readInt();
+    inNeigh.readInt(); // neighbors per triangle
     for (int i = 0; i < numberOfNeigh; i++)
     {
-        QStringList parsedLine = inNeigh.readLine().trimmed().split(whiteChar);
+        inNeigh.readInt();
 
-        elementList[i].neigh[0] = parsedLine.at(1).toInt();
-        elementList[i].neigh[1] = parsedLine.at(2).toInt();
-        elementList[i].neigh[2] = parsedLine.at(3).toInt();
+        elementList[i].neigh[0] = inNeigh.readInt();
+        elementList[i].neigh[1] = inNeigh.readInt();
+        elementList[i].neigh[2] = inNeigh.readInt();
     }
 
-    fileNode.close();
-    fileEdge.close();
-    fileEle.close();
-    fileNeigh.close();
+    if (!inNode.isValid() || !inEdge.isValid() || !inEle.isValid() || !inNeigh.isValid())
+    {
+        Agros2D::log()->printError(tr("Mesh generator"), tr("Triangle mesh files are corrupted"));
+        return false;
+    }
 
     // heterogeneous mesh
     // element division
@@ -570,7 +576,12 @@ bool MeshGeneratorTriangleExternal::readTriangleMeshFormat()
         }
     }
 
+    Agros2D::log()->printDebug(tr("Mesh generator"), tr("Triangle mesh parsed: %1 nodes, %2 elements (%3 ms)").
+                               arg(nodeList.count()).arg(elementList.count()).arg(time.elapsed()));
+
+    time.start();
     writeToHermes();
+    Agros2D::log()->printDebug(tr("Mesh generator"), tr("Mesh converted to Hermes2D (%1 ms)").arg(time.elapsed()));
 
     nodeList.clear();
     edgeList.clear();
@@ -591,10 +602,13 @@ bool MeshGeneratorTriangle::mesh()
 {
     m_isError = !prepare();
 
-    // create triangle files
+    QTime time;
+
+    // create triangle structures and triangulate
+    time.start();
     if (writeToTriangle())
     {
-        // Agros2D::log()->printDebug(tr("Mesh generator"), tr("Mesh files were created"));
+        Agros2D::log()->printDebug(tr("Mesh generator"), tr("Triangle finished (%1 ms)").arg(time.elapsed()));
 
         // convert triangle mesh to hermes mesh
         if (!readTriangleMeshFormat())
@@ -627,6 +641,12 @@ bool MeshGeneratorTriangle::writeToTriangle()
 
     struct triangulateio triIn;
 
+    // node indices
+    QHash<SceneNode *, int> nodeIndices;
+    nodeIndices.reserve(Agros2D::scene()->nodes->length());
+    for (int i = 0; i < Agros2D::scene()->nodes->length(); i++)
+        nodeIndices.insert(Agros2D::scene()->nodes->at(i), i);
+
     // nodes
     QList<MeshNode> inNodes;
     int nodesCount = 0;
@@ -646,8 +666,8 @@ bool MeshGeneratorTriangle::writeToTriangle()
     {
         if (Agros2D::scene()->edges->at(i)->angle() == 0)
         {
-            inEdges.append(MeshEdge(Agros2D::scene()->nodes->items().indexOf(Agros2D::scene()->edges->at(i)->nodeStart()),
-                                    Agros2D::scene()->nodes->items().indexOf(Agros2D::scene()->edges->at(i)->nodeEnd()),
+            inEdges.append(MeshEdge(nodeIndices.value(Agros2D::scene()->edges->at(i)->nodeStart()),
+                                    nodeIndices.value(Agros2D::scene()->edges->at(i)->nodeEnd()),
                                     i+1));
 
             edgesCount++;
@@ -676,12 +696,12 @@ bool MeshGeneratorTriangle::writeToTriangle()
                 nodeEndIndex = nodesCount+1;
                 if (j == 0)
                 {
-                    nodeStartIndex = Agros2D::scene()->nodes->items().indexOf(Agros2D::scene()->edges->at(i)->nodeStart());
+                    nodeStartIndex = nodeIndices.value(Agros2D::scene()->edges->at(i)->nodeStart());
                     nodeEndIndex = nodesCount;
                 }
                 if (j == segments - 1)
                 {
-                    nodeEndIndex = Agros2D::scene()->nodes->items().indexOf(Agros2D::scene()->edges->at(i)->nodeEnd());
+                    nodeEndIndex = nodeIndices.value(Agros2D::scene()->edges->at(i)->nodeEnd());
                 }
                 if ((j > 0) && (j < segments))
                 {
@@ -851,6 +871,9 @@ bool MeshGeneratorTriangle::readTriangleMeshFormat()
     edgeList.clear();
     elementList.clear();
 
+    QTime time;
+    time.start();
+
     // triangle nodes
     int numberOfNodes = triOut.numberofpoints;
     for (int i = 0; i < numberOfNodes; i++)
@@ -891,6 +914,7 @@ bool MeshGeneratorTriangle::readTriangleMeshFormat()
         int nodeNC = triOut.trianglelist[6*i+5];
 
         if (Agros2D::problem()->config()->meshType() == MeshType_Triangle ||
+                Agros2D::problem()->config()->meshType() == MeshType_Triangle_Parallel ||
                 Agros2D::problem()->config()->meshType() == MeshType_Triangle_QuadJoin ||
                 Agros2D::problem()->config()->meshType() == MeshType_Triangle_QuadRoughDivision)
         {
@@ -1062,7 +1086,12 @@ bool MeshGeneratorTriangle::readTriangleMeshFormat()
     free(triOut.edgelist);
     free(triOut.edgemarkerlist);
 
+    Agros2D::log()->printDebug(tr("Mesh generator"), tr("Triangle mesh parsed: %1 nodes, %2 elements (%3 ms)").
+                               arg(nodeList.count()).arg(elementList.count()).arg(time.elapsed()));
+
+    time.start();
     writeToHermes();
+    Agros2D::log()->printDebug(tr("Mesh generator"), tr("Mesh converted to Hermes2D (%1 ms)").arg(time.elapsed()));
 
     nodeList.clear();
     edgeList.clear();
@@ -1071,3 +1100,392 @@ bool MeshGeneratorTriangle::readTriangleMeshFormat()
     return true;
 }
 
+// ****************************************************************************
+
+MeshGeneratorTriangleParallel::MeshGeneratorTriangleParallel()
+    : MeshGenerator()
+{
+}
+
+bool MeshGeneratorTriangleParallel::mesh()
+{
+    m_isError = !prepare();
+    if (m_isError)
+        return false;
+
+    QTime time;
+
+    time.start();
+    if (!prepareSubdomains())
+    {
+        // geometry cannot be split into label regions
+        Agros2D::log()->printDebug(tr("Mesh generator"), tr("Geometry cannot be split into subdomains, using serial mesh generator"));
+
+        MeshGeneratorTriangle meshGenerator;
+        meshGenerator.setCacheKey(m_cacheKey);
+        m_isError = !meshGenerator.mesh();
+        m_meshes = meshGenerator.meshes();
+
+        return !m_isError;
+    }
+    Agros2D::log()->printDebug(tr("Mesh generator"), tr("Shared edges discretized: %1 subdomains, %2 boundary nodes (%3 ms)").
+                               arg(m_subdomains.count()).arg(m_points.count()).arg(time.elapsed()));
+
+    // subdomains do not touch any shared data (Triangle keeps its globals in thread local storage)
+    time.start();
+    int numberOfThreads = qMax(1, Agros2D::configComputer()->value(Config::Config_NumberOfThreads).toInt());
+    Subdomain *subdomains = m_subdomains.data();
+    const QVector<Point> &points = m_points;
+#pragma omp parallel for schedule(dynamic) num_threads(numberOfThreads)
+    for (int i = 0; i < m_subdomains.count(); i++)
+        triangulateSubdomain(subdomains[i], points);
+    Agros2D::log()->printDebug(tr("Mesh generator"), tr("Subdomains meshed: %1 threads (%2 ms)").
+                               arg(numberOfThreads).arg(time.elapsed()));
+
+    time.start();
+    if (stitchSubdomains())
+    {
+        Agros2D::log()->printDebug(tr("Mesh generator"), tr("Subdomains stitched: %1 nodes, %2 elements (%3 ms)").
+                                   arg(nodeList.count()).arg(elementList.count()).arg(time.elapsed()));
+
+        time.start();
+        writeToHermes();
+        Agros2D::log()->printDebug(tr("Mesh generator"), tr("Mesh converted to Hermes2D (%1 ms)").arg(time.elapsed()));
+    }
+    else
+    {
+        m_isError = true;
+    }
+
+    nodeList.clear();
+    edgeList.clear();
+    elementList.clear();
+
+    m_points.clear();
+    m_edgePoints.clear();
+    m_subdomains.clear();
+
+    return !m_isError;
+}
+
+bool MeshGeneratorTriangleParallel::prepareSubdomains()
+{
+    m_subdomains.clear();
+
+    if (Agros2D::scene()->nodes->length() < 3 || Agros2D::scene()->edges->length() < 3)
+        return false;
+
+    QList<QList<LoopsInfo::LoopsNodeEdgeData> > loops = Agros2D::scene()->loopsInfo()->loops();
+    QMap<SceneLabel *, QList<int> > labelLoops = Agros2D::scene()->loopsInfo()->labelLoops();
+
+    // labels bounded by loops
+    QVector<QList<int> > loopLabels(loops.count());
+    for (int i = 0; i < Agros2D::scene()->labels->length(); i++)
+        foreach (int loop, labelLoops.value(Agros2D::scene()->labels->at(i)))
+            loopLabels[loop].append(i);
+
+    // target length of segments on edges (zero if no label area is prescribed)
+    QVector<double> edgeLength(Agros2D::scene()->edges->length(), 0.0);
+    QVector<bool> isEdgeUsed(Agros2D::scene()->edges->length(), false);
+    for (int i = 0; i < Agros2D::scene()->labels->length(); i++)
+    {
+        SceneLabel *label = Agros2D::scene()->labels->at(i);
+        if (label->markersCount() == 0)
+            continue;
+
+        if (labelLoops.value(label).isEmpty())
+            return false;
+
+        // side of equilateral triangle with the prescribed area
+        double length = (label->area() > 0.0) ? sqrt(4.0 * label->area() / sqrt(3.0)) : 0.0;
+
+        foreach (int loop, labelLoops.value(label))
+        {
+            for (int j = 0; j < loops[loop].count(); j++)
+            {
+                int edge = loops[loop][j].edge;
+
+                isEdgeUsed[edge] = true;
+                if ((length > 0.0) && ((edgeLength[edge] == 0.0) || (length < edgeLength[edge])))
+                    edgeLength[edge] = length;
+            }
+        }
+
+        Subdomain subdomain;
+        subdomain.label = i;
+        subdomain.point = label->point();
+        subdomain.area = label->area();
+        m_subdomains.append(subdomain);
+    }
+
+    // edges outside loops of label regions (e.g. cracks) need the serial generator
+    if (m_subdomains.count() < 2 || isEdgeUsed.contains(false))
+    {
+        m_subdomains.clear();
+        return false;
+    }
+
+    discretizeEdges(edgeLength);
+
+    // boundary of subdomains
+    for (int i = 0; i < m_subdomains.count(); i++)
+    {
+        Subdomain &subdomain = m_subdomains[i];
+
+        QList<int> edges;
+        QList<int> holes;
+        foreach (int loop, labelLoops.value(Agros2D::scene()->labels->at(subdomain.label)))
+        {
+            for (int j = 0; j < loops[loop].count(); j++)
+                if (!edges.contains(loops[loop][j].edge))
+                    edges.append(loops[loop][j].edge);
+
+            // regions of other labels bounded by the same loop are removed
+            foreach (int label, loopLabels[loop])
+                if (label != subdomain.label && !holes.contains(label))
+                    holes.append(label);
+        }
+
+        QHash<int, int> localIndices;
+        foreach (int edge, edges)
+        {
+            const QVector<int> &edgePoints = m_edgePoints[edge];
+            for (int j = 0; j < edgePoints.count(); j++)
+            {
+                if (!localIndices.contains(edgePoints[j]))
+                {
+                    localIndices.insert(edgePoints[j], subdomain.points.count());
+                    subdomain.points.append(edgePoints[j]);
+                }
+
+                if (j > 0)
+                {
+                    subdomain.segments.append(localIndices.value(edgePoints[j - 1]));
+                    subdomain.segments.append(localIndices.value(edgePoints[j]));
+                }
+            }
+        }
+
+        foreach (int label, holes)
+            subdomain.holes.append(Agros2D::scene()->labels->at(label)->point());
+    }
+
+    return true;
+}
+
+void MeshGeneratorTriangleParallel::discretizeEdges(const QVector<double> &edgeLength)
+{
+    m_points.clear();
+    m_edgePoints.clear();
+
+    // scene nodes
+    QHash<SceneNode *, int> nodeIndices;
+    nodeIndices.reserve(Agros2D::scene()->nodes->length());
+    for (int i = 0; i < Agros2D::scene()->nodes->length(); i++)
+    {
+        nodeIndices.insert(Agros2D::scene()->nodes->at(i), i);
+        m_points.append(Agros2D::scene()->nodes->at(i)->point());
+    }
+
+    // edges are discretized once and shared by both neighbouring subdomains
+    m_edgePoints.resize(Agros2D::scene()->edges->length());
+    for (int i = 0; i < Agros2D::scene()->edges->length(); i++)
+    {
+        SceneEdge *edge = Agros2D::scene()->edges->at(i);
+        QVector<int> &edgePoints = m_edgePoints[i];
+
+        Point start = edge->nodeStart()->point();
+        Point end = edge->nodeEnd()->point();
+
+        int segments = (edge->angle() == 0) ? 1 : edge->segments();
+        if (edgeLength[i] > 0.0)
+            segments = qMax(segments, (int) ceil(edge->length() / edgeLength[i]));
+
+        edgePoints.append(nodeIndices.value(edge->nodeStart()));
+        if (edge->angle() == 0)
+        {
+            // line
+            for (int j = 1; j < segments; j++)
+            {
+                edgePoints.append(m_points.count());
+                m_points.append(start + (end - start) * (double(j) / segments));
+            }
+        }
+        else
+        {
+            // arc
+            Point center = edge->center();
+            double radius = edge->radius();
+            double startAngle = atan2(center.y - start.y, center.x - start.x) - M_PI;
+            double theta = deg2rad(edge->angle()) / double(segments);
+
+            for (int j = 1; j < segments; j++)
+            {
+                double arc = startAngle + j*theta;
+
+                edgePoints.append(m_points.count());
+                m_points.append(Point(center.x + radius * cos(arc),
+                                      center.y + radius * sin(arc)));
+            }
+        }
+        edgePoints.append(nodeIndices.value(edge->nodeEnd()));
+    }
+}
+
+void MeshGeneratorTriangleParallel::triangulateSubdomain(Subdomain &subdomain, const QVector<Point> &points)
+{
+    struct triangulateio triIn;
+    struct triangulateio triOut;
+    memset(&triIn, 0, sizeof(triIn));
+    memset(&triOut, 0, sizeof(triOut));
+
+    // vertices
+    triIn.numberofpoints = subdomain.points.count();
+    triIn.pointlist = (REAL *) malloc(triIn.numberofpoints * 2 * sizeof(REAL));
+    for (int i = 0; i < subdomain.points.count(); i++)
+    {
+        triIn.pointlist[2*i] = points.at(subdomain.points.at(i)).x;
+        triIn.pointlist[2*i+1] = points.at(subdomain.points.at(i)).y;
+    }
+
+    // segments
+    triIn.numberofsegments = subdomain.segments.count() / 2;
+    triIn.segmentlist = (int *) malloc(subdomain.segments.count() * sizeof(int));
+    for (int i = 0; i < subdomain.segments.count(); i++)
+        triIn.segmentlist[i] = subdomain.segments.at(i);
+
+    // region (marker conversion to triangle, where it starts from 1)
+    triIn.numberofregions = 1;
+    triIn.regionlist = (REAL *) malloc(4 * sizeof(REAL));
+    triIn.regionlist[0] = subdomain.point.x;
+    triIn.regionlist[1] = subdomain.point.y;
+    triIn.regionlist[2] = subdomain.label + 1;
+    triIn.regionlist[3] = subdomain.area;
+
+    // holes
+    triIn.numberofholes = subdomain.holes.count();
+    triIn.holelist = (REAL *) malloc(triIn.numberofholes * 2 * sizeof(REAL));
+    for (int i = 0; i < subdomain.holes.count(); i++)
+    {
+        triIn.holelist[2*i] = subdomain.holes.at(i).x;
+        triIn.holelist[2*i+1] = subdomain.holes.at(i).y;
+    }
+
+    //    -YY Suppresses splitting of all segments (shared discretization is kept).
+    //    -P  Suppresses output of segments.
+    //    -B  Suppresses output of boundary markers.
+    char const *triSwitches = "pq31.0AazQYYPB";
+    triangulate((char *) triSwitches, &triIn, &triOut, (struct triangulateio *) NULL);
+
+    // triangles of the label region (parts of unlabeled inner loops have zero attribute)
+    for (int i = 0; i < triOut.numberoftriangles; i++)
+    {
+        if ((int) triOut.triangleattributelist[i] != subdomain.label + 1)
+            continue;
+
+        for (int j = 0; j < 3; j++)
+            subdomain.triangles.append(triOut.trianglelist[3*i+j]);
+    }
+
+    // new vertices follow the input vertices
+    for (int i = subdomain.points.count(); i < triOut.numberofpoints; i++)
+        subdomain.innerPoints.append(Point(triOut.pointlist[2*i], triOut.pointlist[2*i+1]));
+
+    subdomain.isError = subdomain.triangles.isEmpty();
+
+    free(triIn.pointlist);
+    free(triIn.segmentlist);
+    free(triIn.regionlist);
+    free(triIn.holelist);
+
+    free(triOut.pointlist);
+    free(triOut.pointattributelist);
+    free(triOut.pointmarkerlist);
+    free(triOut.trianglelist);
+    free(triOut.triangleattributelist);
+}
+
+bool MeshGeneratorTriangleParallel::stitchSubdomains()
+{
+    nodeList.clear();
+    edgeList.clear();
+    elementList.clear();
+
+    // boundary nodes are shared, inner nodes belong to one subdomain
+    QVector<int> pointIndices(m_points.count(), -1);
+    QHash<QPair<int, int>, int> edgeElements;
+
+    foreach (const Subdomain &subdomain, m_subdomains)
+    {
+        if (subdomain.isError)
+        {
+            Agros2D::log()->printError(tr("Mesh generator"), tr("Mesh of the region of label %1 was not created").arg(subdomain.label));
+            return false;
+        }
+
+        QVector<int> innerIndices(subdomain.innerPoints.count(), -1);
+        for (int i = 0; i < subdomain.triangles.count() / 3; i++)
+        {
+            int node[3];
+            for (int j = 0; j < 3; j++)
+            {
+                int local = subdomain.triangles[3*i+j];
+                if (local < subdomain.points.count())
+                {
+                    int global = subdomain.points[local];
+                    if (pointIndices[global] == -1)
+                    {
+                        pointIndices[global] = nodeList.count();
+                        nodeList.append(m_points[global]);
+                    }
+                    node[j] = pointIndices[global];
+                }
+                else
+                {
+                    int inner = local - subdomain.points.count();
+                    if (innerIndices[inner] == -1)
+                    {
+                        innerIndices[inner] = nodeList.count();
+                        nodeList.append(subdomain.innerPoints[inner]);
+                    }
+                    node[j] = innerIndices[inner];
+                }
+            }
+
+            elementList.append(MeshElement(node[0], node[1], node[2], subdomain.label));
+
+            for (int j = 0; j < 3; j++)
+                edgeElements[qMakePair(qMin(node[j], node[(j + 1) % 3]), qMax(node[j], node[(j + 1) % 3]))]++;
+        }
+    }
+
+    // boundary edges (segments of scene edges, which are not inside holes)
+    QSet<QPair<int, int> > boundaryEdges;
+    for (int i = 0; i < m_edgePoints.count(); i++)
+    {
+        for (int j = 1; j < m_edgePoints[i].count(); j++)
+        {
+            int nodeA = pointIndices[m_edgePoints[i][j - 1]];
+            int nodeB = pointIndices[m_edgePoints[i][j]];
+
+            QPair<int, int> key = qMakePair(qMin(nodeA, nodeB), qMax(nodeA, nodeB));
+            if (nodeA == -1 || nodeB == -1 || !edgeElements.contains(key))
+                continue;
+
+            edgeList.append(MeshEdge(nodeA, nodeB, i));
+            boundaryEdges.insert(key);
+        }
+    }
+
+    // conformity (edge of one element has to lie on a scene edge)
+    for (QHash<QPair<int, int>, int>::const_iterator it = edgeElements.constBegin(); it != edgeElements.constEnd(); ++it)
+    {
+        if ((it.value() > 2) || ((it.value() == 1) && !boundaryEdges.contains(it.key())))
+        {
+            Agros2D::log()->printError(tr("Mesh generator"), tr("Meshes of subdomains are not conforming"));
+            return false;
+        }
+    }
+
+    return true;
+}
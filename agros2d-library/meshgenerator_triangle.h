@@ -61,5 +61,48 @@ private:
     struct triangulateio triOut;
 };
 
+// meshes label regions independently (in parallel) and stitches them into one mesh
+// shared edges are discretized first, so the subdomain meshes are conforming
+class MeshGeneratorTriangleParallel : public MeshGenerator
+{
+    Q_OBJECT
+
+public:
+    MeshGeneratorTriangleParallel();
+
+    virtual bool mesh();
+
+private:
+    struct Subdomain
+    {
+        Subdomain() : label(-1), area(0.0), isError(false) {}
+
+        int label;
+        Point point;
+        double area;
+
+        // global indices of boundary points and segments in local indices
+        QVector<int> points;
+        QVector<int> segments;
+        QVector<Point> holes;
+
+        // triangles in local indices, new points have index >= points.size()
+        QVector<int> triangles;
+        QVector<Point> innerPoints;
+        bool isError;
+    };
+
+    // discretization of scene edges shared by subdomains
+    QVector<Point> m_points;
+    QVector<QVector<int> > m_edgePoints;
+
+    QVector<Subdomain> m_subdomains;
+
+    bool prepareSubdomains();
+    void discretizeEdges(const QVector<double> &edgeLength);
+    static void triangulateSubdomain(Subdomain &subdomain, const QVector<Point> &points);
+    bool stitchSubdomains();
+};
+
 
 #endif //MESHGENERATOR_TRIANGLE_H
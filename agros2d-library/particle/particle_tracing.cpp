@@ -41,7 +41,7 @@
 #include "hermes2d/problem_config.h"
 
 ParticleTracing::ParticleTracing(QObject *parent)
-    : QObject(parent)
+    : QObject(parent), m_forceEvaluations(0)
 {
     foreach (FieldInfo* fieldInfo, Agros2D::problem()->fieldInfos())
     {
@@ -53,16 +53,16 @@ ParticleTracing::ParticleTracing(QObject *parent)
         int adaptivityStep = Agros2D::solutionStore()->lastAdaptiveStep(fieldInfo, SolutionMode_Normal, timeStep);
         SolutionMode solutionMode = SolutionMode_Finer;
 
-        FieldSolutionID fsid(fieldInfo, timeStep, adaptivityStep, solutionMode);
-        Hermes::Hermes2D::MeshFunctionSharedPtr<double> sln = Agros2D::solutionStore()->multiArray(fsid).solutions().at(0);
-
-        m_solutionIDs[fieldInfo] = FieldSolutionID(fieldInfo, timeStep, adaptivityStep, solutionMode);
-        m_meshes[fieldInfo] = sln->get_mesh();
+        // solutions, materials and time functions are resolved once
+        m_forceEvaluators[fieldInfo] = fieldInfo->plugin()->forceEvaluator(fieldInfo, timeStep, adaptivityStep, solutionMode);
     }
 }
 
 ParticleTracing::~ParticleTracing()
 {
+    foreach (ForceEvaluator *forceEvaluator, m_forceEvaluators)
+        delete forceEvaluator;
+    m_forceEvaluators.clear();
 }
 
 void ParticleTracing::clear()
@@ -89,10 +89,10 @@ Point3 ParticleTracing::force(int particleIndex,
                               Point3 velocity)
 {
     Point3 totalFieldForce;
-    foreach (FieldInfo* fieldInfo, Agros2D::problem()->fieldInfos())
+    for (QMap<FieldInfo *, ForceEvaluator *>::const_iterator it = m_forceEvaluators.constBegin(); it != m_forceEvaluators.constEnd(); ++it)
     {
-        if (!fieldInfo->plugin()->hasForce(fieldInfo))
-            continue;
+        FieldInfo *fieldInfo = it.key();
+        ForceEvaluator *forceEvaluator = it.value();
 
         Point3 fieldForce;
 
@@ -113,23 +113,18 @@ Point3 ParticleTracing::force(int particleIndex,
 
         if (!elementIsValid)
         {
-            m_activeElement[fieldInfo] = Hermes::Hermes2D::RefMap::element_on_physical_coordinates(true, m_meshes[fieldInfo],
-                                                                                                   position.x, position.y);
+            // particle left the element, force is evaluated in the newly located one
+            activeElement = Hermes::Hermes2D::RefMap::element_on_physical_coordinates(true, forceEvaluator->mesh(),
+                                                                                      position.x, position.y);
+            m_activeElement[fieldInfo] = activeElement;
         }
 
         if (activeElement)
         {
-            // find material
-            SceneLabel *label = Agros2D::scene()->labels->at(atoi(fieldInfo->initialMesh()->get_element_markers_conversion().get_user_marker(activeElement->marker).marker.c_str()));
-            SceneMaterial* material = label->marker(fieldInfo);
-
-            assert(!material->isNone());
-
             try
             {
-                fieldForce = fieldInfo->plugin()->force(fieldInfo, m_solutionIDs[fieldInfo].timeStep, m_solutionIDs[fieldInfo].adaptivityStep, m_solutionIDs[fieldInfo].solutionMode,
-                                                        activeElement, material, position, velocity)
-                        * m_particleChargesList[particleIndex];
+                fieldForce = forceEvaluator->force(activeElement, position, velocity) * m_particleChargesList[particleIndex];
+                m_forceEvaluations++;
             }
             catch (AgrosException e)
             {
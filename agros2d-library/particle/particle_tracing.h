@@ -30,6 +30,7 @@
 
 class FieldInfo;
 class SceneMaterial;
+class ForceEvaluator;
 
 class ParticleTracing : public QObject
 {
@@ -51,6 +52,9 @@ public:
     inline double velocityMin() const { return m_velocityMin; }
     inline double velocityMax() const { return m_velocityMax; }
 
+    // number of field force evaluations
+    inline int forceEvaluations() const { return m_forceEvaluations; }
+
 private:
     // input
     QList<double> m_particleChargesList;
@@ -64,9 +68,10 @@ private:
     double m_velocityMin;
     double m_velocityMax;
 
-    QMap<FieldInfo *, FieldSolutionID> m_solutionIDs;
-    QMap<FieldInfo *, Hermes::Hermes2D::MeshSharedPtr> m_meshes;
+    // force evaluators (bound to the solution of the field)
+    QMap<FieldInfo *, ForceEvaluator *> m_forceEvaluators;
     QMap<FieldInfo *, Hermes::Hermes2D::Element *> m_activeElement;
+    int m_forceEvaluations;
 
     Point3 force(int particleIndex, Point3 position, Point3 velocity);
 
@@ -369,6 +369,10 @@ QWidget *FieldWidget::createAdaptivityWidget()
     txtAdaptivityOrderIncrease->setMinimum(1);
     txtAdaptivityOrderIncrease->setMaximum(10);
     chkAdaptivitySpaceRefinement = new QCheckBox(tr("Use space refinement for error estimation"));
+    cmbAdaptivityReferenceRetention = new QComboBox();
+    foreach (QString retention, adaptivityReferenceRetentionStringKeys())
+        cmbAdaptivityReferenceRetention->addItem(adaptivityReferenceRetentionString(adaptivityReferenceRetentionFromStringKey(retention)),
+                                                 adaptivityReferenceRetentionFromStringKey(retention));
     txtAdaptivityBackSteps = new QSpinBox(this);
     txtAdaptivityBackSteps->setMinimum(0);
     txtAdaptivityBackSteps->setMaximum(100);
@@ -402,6 +406,8 @@ QWidget *FieldWidget::createAdaptivityWidget()
     layoutAdaptivityReferenceSolution->addWidget(chkAdaptivitySpaceRefinement, 0, 2);
     layoutAdaptivityReferenceSolution->addWidget(chkAdaptivityUseAniso, 1, 2);
     layoutAdaptivityReferenceSolution->addWidget(chkAdaptivityFinerReference, 2, 2);
+    layoutAdaptivityReferenceSolution->addWidget(new QLabel(tr("Keep solutions:")), 2, 0);
+    layoutAdaptivityReferenceSolution->addWidget(cmbAdaptivityReferenceRetention, 2, 1);
     layoutAdaptivityReferenceSolution->setRowStretch(50, 1);
 
     QGroupBox *grpReferenceSolution = new QGroupBox(tr("Reference solution"), this);
@@ -462,6 +468,14 @@ QWidget *FieldWidget::createLinearSolverWidget()
     txtIterLinearSolverIters = new QSpinBox();
     txtIterLinearSolverIters->setMinimum(1);
     txtIterLinearSolverIters->setMaximum(10000);
+    chkIterLinearSolverReusePreconditioner = new QCheckBox(tr("Reuse preconditioner"));
+    chkIterLinearSolverMixedPrecision = new QCheckBox(tr("Mixed precision (single precision inner solver)"));
+    txtIterLinearSolverMixedPrecisionInnerTolerance = new LineEditDouble(1e-3);
+    txtIterLinearSolverMixedPrecisionInnerTolerance->setBottom(0.0);
+    txtIterLinearSolverMixedPrecisionOuterTolerance = new LineEditDouble(1e-10);
+    txtIterLinearSolverMixedPrecisionOuterTolerance->setBottom(0.0);
+
+    chkAMGNumericRefresh = new QCheckBox(tr("Refresh coarse operators numerically"));
 
     QGridLayout *iterSolverLayout = new QGridLayout();
     iterSolverLayout->addWidget(new QLabel(tr("Method:")), 0, 0);
@@ -472,6 +486,13 @@ QWidget *FieldWidget::createLinearSolverWidget()
     iterSolverLayout->addWidget(txtIterLinearSolverToleranceAbsolute, 2, 1);
     iterSolverLayout->addWidget(new QLabel(tr("Maximum number of iterations:")), 3, 0);
     iterSolverLayout->addWidget(txtIterLinearSolverIters, 3, 1);
+    iterSolverLayout->addWidget(chkIterLinearSolverReusePreconditioner, 4, 0, 1, 2);
+    iterSolverLayout->addWidget(chkAMGNumericRefresh, 5, 0, 1, 2);
+    iterSolverLayout->addWidget(chkIterLinearSolverMixedPrecision, 6, 0, 1, 2);
+    iterSolverLayout->addWidget(new QLabel(tr("Inner relative tolerance:")), 7, 0);
+    iterSolverLayout->addWidget(txtIterLinearSolverMixedPrecisionInnerTolerance, 7, 1);
+    iterSolverLayout->addWidget(new QLabel(tr("Outer relative tolerance:")), 8, 0);
+    iterSolverLayout->addWidget(txtIterLinearSolverMixedPrecisionOuterTolerance, 8, 1);
 
     QGroupBox *iterSolverGroup = new QGroupBox(tr("Iterative solver"));
     iterSolverGroup->setLayout(iterSolverLayout);
@@ -561,6 +582,7 @@ void FieldWidget::load()
     chkAdaptivityFinerReference->setChecked(m_fieldInfo->value(FieldInfo::AdaptivityFinerReference).toBool());
     txtAdaptivityOrderIncrease->setValue(m_fieldInfo->value(FieldInfo::AdaptivityOrderIncrease).toInt());
     chkAdaptivitySpaceRefinement->setChecked(m_fieldInfo->value(FieldInfo::AdaptivitySpaceRefinement).toBool());
+    cmbAdaptivityReferenceRetention->setCurrentIndex(cmbAdaptivityReferenceRetention->findData((AdaptivityReferenceRetention) m_fieldInfo->value(FieldInfo::AdaptivityReferenceRetention).toInt()));
     txtAdaptivityBackSteps->setValue(m_fieldInfo->value(FieldInfo::AdaptivityTransientBackSteps).toInt());
     txtAdaptivityRedoneEach->setValue(m_fieldInfo->value(FieldInfo::AdaptivityTransientRedoneEach).toInt());
     // matrix solver
@@ -592,6 +614,11 @@ void FieldWidget::load()
     cmbIterLinearSolverPreconditioner->setCurrentIndex((Hermes::Solvers::PreconditionerType) cmbIterLinearSolverPreconditioner->findData(m_fieldInfo->value(FieldInfo::LinearSolverIterPreconditioner).toInt()));
     txtIterLinearSolverToleranceAbsolute->setValue(m_fieldInfo->value(FieldInfo::LinearSolverIterToleranceAbsolute).toDouble());
     txtIterLinearSolverIters->setValue(m_fieldInfo->value(FieldInfo::LinearSolverIterIters).toInt());
+    chkIterLinearSolverReusePreconditioner->setChecked(m_fieldInfo->value(FieldInfo::LinearSolverReusePreconditioner).toBool());
+    chkIterLinearSolverMixedPrecision->setChecked(m_fieldInfo->value(FieldInfo::LinearSolverIterMixedPrecision).toBool());
+    txtIterLinearSolverMixedPrecisionInnerTolerance->setValue(m_fieldInfo->value(FieldInfo::LinearSolverIterMixedPrecisionInnerTolerance).toDouble());
+    txtIterLinearSolverMixedPrecisionOuterTolerance->setValue(m_fieldInfo->value(FieldInfo::LinearSolverIterMixedPrecisionOuterTolerance).toDouble());
+    chkAMGNumericRefresh->setChecked(m_fieldInfo->value(FieldInfo::LinearSolverAMGNumericRefresh).toBool());
 
     doAnalysisTypeChanged(cmbAnalysisType->currentIndex());
 }
@@ -611,6 +638,7 @@ bool FieldWidget::save()
     m_fieldInfo->setValue(FieldInfo::AdaptivityFinerReference, chkAdaptivityFinerReference->isChecked());
     m_fieldInfo->setValue(FieldInfo::AdaptivityOrderIncrease, txtAdaptivityOrderIncrease->value());
     m_fieldInfo->setValue(FieldInfo::AdaptivitySpaceRefinement, chkAdaptivitySpaceRefinement->isChecked());
+    m_fieldInfo->setValue(FieldInfo::AdaptivityReferenceRetention, (AdaptivityReferenceRetention) cmbAdaptivityReferenceRetention->itemData(cmbAdaptivityReferenceRetention->currentIndex()).toInt());
     m_fieldInfo->setValue(FieldInfo::AdaptivityTransientBackSteps, txtAdaptivityBackSteps->value());
     m_fieldInfo->setValue(FieldInfo::AdaptivityTransientRedoneEach, txtAdaptivityRedoneEach->value());
     // matrix solver
@@ -640,6 +668,11 @@ bool FieldWidget::save()
     m_fieldInfo->setValue(FieldInfo::LinearSolverIterPreconditioner, cmbIterLinearSolverPreconditioner->itemData(cmbIterLinearSolverPreconditioner->currentIndex()).toInt());
     m_fieldInfo->setValue(FieldInfo::LinearSolverIterToleranceAbsolute, txtIterLinearSolverToleranceAbsolute->value());
     m_fieldInfo->setValue(FieldInfo::LinearSolverIterIters, txtIterLinearSolverIters->value());
+    m_fieldInfo->setValue(FieldInfo::LinearSolverReusePreconditioner, chkIterLinearSolverReusePreconditioner->isChecked());
+    m_fieldInfo->setValue(FieldInfo::LinearSolverIterMixedPrecision, chkIterLinearSolverMixedPrecision->isChecked());
+    m_fieldInfo->setValue(FieldInfo::LinearSolverIterMixedPrecisionInnerTolerance, txtIterLinearSolverMixedPrecisionInnerTolerance->value());
+    m_fieldInfo->setValue(FieldInfo::LinearSolverIterMixedPrecisionOuterTolerance, txtIterLinearSolverMixedPrecisionOuterTolerance->value());
+    m_fieldInfo->setValue(FieldInfo::LinearSolverAMGNumericRefresh, chkAMGNumericRefresh->isChecked());
 
     return true;
 }
@@ -708,6 +741,7 @@ void FieldWidget::doAdaptivityChanged(int index)
     chkAdaptivitySpaceRefinement->setEnabled((AdaptivityType) cmbAdaptivityType->itemData(index).toInt() != AdaptivityType_None);
     txtAdaptivityOrderIncrease->setEnabled((AdaptivityType) cmbAdaptivityType->itemData(index).toInt() != AdaptivityType_None);
     chkAdaptivityFinerReference->setEnabled((AdaptivityType) cmbAdaptivityType->itemData(index).toInt() != AdaptivityType_None);
+    cmbAdaptivityReferenceRetention->setEnabled((AdaptivityType) cmbAdaptivityType->itemData(index).toInt() != AdaptivityType_None);
 
     AnalysisType analysisType = (AnalysisType) cmbAnalysisType->itemData(cmbAnalysisType->currentIndex()).toInt();
     txtAdaptivityBackSteps->setEnabled(Agros2D::problem()->isTransient() && analysisType != AnalysisType_Transient && (AdaptivityType) cmbAdaptivityType->itemData(index).toInt() != AdaptivityType_None);
@@ -744,6 +778,11 @@ void FieldWidget::doLinearSolverChanged(int index)
     cmbIterLinearSolverPreconditioner->setEnabled(isIterative);
     txtIterLinearSolverToleranceAbsolute->setEnabled(isIterative);
     txtIterLinearSolverIters->setEnabled(isIterative);
+    chkIterLinearSolverReusePreconditioner->setEnabled(isIterative);
+    chkIterLinearSolverMixedPrecision->setEnabled(solverType == Hermes::SOLVER_PARALUTION_ITERATIVE);
+    txtIterLinearSolverMixedPrecisionInnerTolerance->setEnabled(solverType == Hermes::SOLVER_PARALUTION_ITERATIVE);
+    txtIterLinearSolverMixedPrecisionOuterTolerance->setEnabled(solverType == Hermes::SOLVER_PARALUTION_ITERATIVE);
+    chkAMGNumericRefresh->setEnabled(isIterative);
 }
 
 void FieldWidget::doNonlinearDampingChanged(int index)
@@ -1168,6 +1207,7 @@ void ProblemWidget::createControls()
 
     // transient
     cmbTransientMethod = new QComboBox();
+    cmbTransientErrorEstimator = new QComboBox();
     txtTransientOrder = new QSpinBox();
     txtTransientOrder->setMinimum(1);
     txtTransientOrder->setMaximum(3);
@@ -1204,6 +1244,8 @@ void ProblemWidget::createControls()
     layoutTransientAnalysis->addWidget(txtTransientInitialStepSize, 5, 2);
     layoutTransientAnalysis->addWidget(new QLabel(tr("Constant time step:")), 6, 0, 1, 2);
     layoutTransientAnalysis->addWidget(lblTransientTimeStep, 6, 2);
+    layoutTransientAnalysis->addWidget(new QLabel(tr("Error estimator:")), 7, 0, 1, 2);
+    layoutTransientAnalysis->addWidget(cmbTransientErrorEstimator, 7, 2);
 
     grpTransientAnalysis = new QGroupBox(tr("Transient analysis"));
     grpTransientAnalysis->setLayout(layoutTransientAnalysis);
@@ -1291,6 +1333,7 @@ void ProblemWidget::fillComboBox()
     cmbMeshType->addItem(meshTypeString(MeshType_Triangle_QuadFineDivision), MeshType_Triangle_QuadFineDivision);
     cmbMeshType->addItem(meshTypeString(MeshType_Triangle_QuadRoughDivision), MeshType_Triangle_QuadRoughDivision);
     cmbMeshType->addItem(meshTypeString(MeshType_Triangle_QuadJoin), MeshType_Triangle_QuadJoin);
+    cmbMeshType->addItem(meshTypeString(MeshType_Triangle_Parallel), MeshType_Triangle_Parallel);
     // cmbMeshType->addItem(meshTypeString(MeshType_TriangleExternal), MeshType_TriangleExternal);
     // cmbMeshType->addItem(meshTypeString(MeshType_TriangleExternal_QuadFineDivision), MeshType_TriangleExternal_QuadFineDivision);
     // cmbMeshType->addItem(meshTypeString(MeshType_TriangleExternal_QuadRoughDivision), MeshType_TriangleExternal_QuadRoughDivision);
@@ -1302,6 +1345,9 @@ void ProblemWidget::fillComboBox()
     cmbTransientMethod->addItem(timeStepMethodString(TimeStepMethod_Fixed), TimeStepMethod_Fixed);
     cmbTransientMethod->addItem(timeStepMethodString(TimeStepMethod_BDFTolerance), TimeStepMethod_BDFTolerance);
     cmbTransientMethod->addItem(timeStepMethodString(TimeStepMethod_BDFNumSteps), TimeStepMethod_BDFNumSteps);
+
+    cmbTransientErrorEstimator->addItem(timeErrorEstimatorString(TimeErrorEstimator_LowerOrder), TimeErrorEstimator_LowerOrder);
+    cmbTransientErrorEstimator->addItem(timeErrorEstimatorString(TimeErrorEstimator_Embedded), TimeErrorEstimator_Embedded);
 }
 
 void ProblemWidget::updateControls()
@@ -1313,6 +1359,7 @@ void ProblemWidget::updateControls()
     txtFrequency->disconnect();
 
     cmbTransientMethod->disconnect();
+    cmbTransientErrorEstimator->disconnect();
     txtTransientOrder->disconnect();
     txtTransientTimeTotal->disconnect();
     txtTransientTolerance->disconnect();
@@ -1346,6 +1393,9 @@ void ProblemWidget::updateControls()
     cmbTransientMethod->setCurrentIndex(cmbTransientMethod->findData((TimeStepMethod) Agros2D::problem()->config()->value(ProblemConfig::TimeMethod).toInt()));
     if (cmbTransientMethod->currentIndex() == -1)
         cmbTransientMethod->setCurrentIndex(0);
+    cmbTransientErrorEstimator->setCurrentIndex(cmbTransientErrorEstimator->findData((TimeErrorEstimator) Agros2D::problem()->config()->value(ProblemConfig::TimeMethodErrorEstimator).toInt()));
+    if (cmbTransientErrorEstimator->currentIndex() == -1)
+        cmbTransientErrorEstimator->setCurrentIndex(0);
 
     lblTransientTimeTotal->setText(QString("Total time (%1)").arg(Agros2D::problem()->timeUnit()));
 
@@ -1369,6 +1419,7 @@ void ProblemWidget::updateControls()
 
     // transient
     connect(cmbTransientMethod, SIGNAL(currentIndexChanged(int)), this, SLOT(changedWithClear()));
+    connect(cmbTransientErrorEstimator, SIGNAL(currentIndexChanged(int)), this, SLOT(changedWithClear()));
     connect(txtTransientSteps, SIGNAL(valueChanged(int)), this, SLOT(changedWithClear()));
     connect(txtTransientTimeTotal, SIGNAL(textChanged(QString)), this, SLOT(changedWithClear()));
     connect(txtTransientOrder, SIGNAL(valueChanged(int)), this, SLOT(changedWithClear()));
@@ -1395,6 +1446,7 @@ void ProblemWidget::changedWithClear()
 
     Agros2D::problem()->config()->setValue(ProblemConfig::Frequency, txtFrequency->value());
     Agros2D::problem()->config()->setValue(ProblemConfig::TimeMethod, (TimeStepMethod) cmbTransientMethod->itemData(cmbTransientMethod->currentIndex()).toInt());
+    Agros2D::problem()->config()->setValue(ProblemConfig::TimeMethodErrorEstimator, (TimeErrorEstimator) cmbTransientErrorEstimator->itemData(cmbTransientErrorEstimator->currentIndex()).toInt());
     Agros2D::problem()->config()->setValue(ProblemConfig::TimeOrder, txtTransientOrder->value());
     Agros2D::problem()->config()->setValue(ProblemConfig::TimeMethodTolerance, txtTransientTolerance->value());
     Agros2D::problem()->config()->setValue(ProblemConfig::TimeConstantTimeSteps, txtTransientSteps->value());
@@ -1429,19 +1481,21 @@ void ProblemWidget::transientChanged()
         txtTransientInitialStepSize->setEnabled(false);
         txtTransientTolerance->setEnabled(false);
         txtTransientSteps->setEnabled(true);
-
+        cmbTransientErrorEstimator->setEnabled(false);
     }
     else if (((TimeStepMethod) Agros2D::problem()->config()->value(ProblemConfig::TimeMethod).toInt()) == TimeStepMethod_BDFTolerance)
     {
         chkTransientInitialStepSize->setEnabled(true);
         txtTransientTolerance->setEnabled(true);
         txtTransientSteps->setEnabled(false);
+        cmbTransientErrorEstimator->setEnabled(true);
     }
     else if (((TimeStepMethod) Agros2D::problem()->config()->value(ProblemConfig::TimeMethod).toInt()) == TimeStepMethod_BDFNumSteps)
     {
         chkTransientInitialStepSize->setEnabled(true);
         txtTransientTolerance->setEnabled(false);
         txtTransientSteps->setEnabled(true);
+        cmbTransientErrorEstimator->setEnabled(true);
     }
 
     if (((TimeStepMethod) Agros2D::problem()->config()->value(ProblemConfig::TimeMethod).toInt()) == TimeStepMethod_Fixed)
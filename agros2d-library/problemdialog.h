@@ -117,6 +117,7 @@ private:
     QCheckBox *chkAdaptivityFinerReference;
     QSpinBox *txtAdaptivityOrderIncrease;
     QCheckBox *chkAdaptivitySpaceRefinement;
+    QComboBox *cmbAdaptivityReferenceRetention;
     QSpinBox *txtAdaptivityBackSteps;
     QSpinBox *txtAdaptivityRedoneEach;
 
@@ -156,6 +157,11 @@ private:
     QComboBox *cmbIterLinearSolverPreconditioner;
     LineEditDouble *txtIterLinearSolverToleranceAbsolute;
     QSpinBox *txtIterLinearSolverIters;
+    QCheckBox *chkIterLinearSolverReusePreconditioner;
+    QCheckBox *chkIterLinearSolverMixedPrecision;
+    LineEditDouble *txtIterLinearSolverMixedPrecisionInnerTolerance;
+    LineEditDouble *txtIterLinearSolverMixedPrecisionOuterTolerance;
+    QCheckBox *chkAMGNumericRefresh;
 
     // equation
     // LaTeXViewer *equationLaTeX;
@@ -257,6 +263,7 @@ private:
     QLabel *lblTransientTimeTotal;
     QSpinBox *txtTransientOrder;
     QComboBox *cmbTransientMethod;
+    QComboBox *cmbTransientErrorEstimator;
     QLabel *lblTransientTimeStep;
 
     // couplings
@@ -169,6 +169,14 @@ void PyField::setAdaptivityStoppingCriterion(const std::string &adaptivityStoppi
         throw invalid_argument(QObject::tr("Invalid argument. Valid keys: %1").arg(stringListToString(adaptivityStoppingCriterionTypeStringKeys())).toStdString());
 }
 
+void PyField::setAdaptivityReferenceRetention(const std::string &retention)
+{
+    if (adaptivityReferenceRetentionStringKeys().contains(QString::fromStdString(retention)))
+        m_fieldInfo->setValue(FieldInfo::AdaptivityReferenceRetention, adaptivityReferenceRetentionFromStringKey(QString::fromStdString(retention)));
+    else
+        throw invalid_argument(QObject::tr("Invalid argument. Valid keys: %1").arg(stringListToString(adaptivityReferenceRetentionStringKeys())).toStdString());
+}
+
 void PyField::setAdaptivityErrorCalculator(const std::string &calculator)
 {
     QStringList calculators;
@@ -674,6 +682,117 @@ void PyField::volumeIntegrals(const vector<int> &labels, int timeStep, int adapt
     results = values;
 }
 
+void PyField::surfaceIntegrals(const vector<vector<int> > &edges, int timeStep, int adaptivityStep,
+                               const std::string &solutionType, vector<map<std::string, double> > &results) const
+{
+    if (!Agros2D::problem()->isSolved())
+        throw logic_error(QObject::tr("Problem is not solved.").toStdString());
+
+    QList<QSet<int> > sets;
+    for (vector<vector<int> >::const_iterator it = edges.begin(); it != edges.end(); ++it)
+    {
+        QSet<int> set;
+
+        // empty set means all edges
+        if (it->empty())
+        {
+            for (int i = 0; i < Agros2D::scene()->edges->length(); i++)
+                set.insert(i);
+        }
+
+        for (vector<int>::const_iterator itEdge = it->begin(); itEdge != it->end(); ++itEdge)
+        {
+            if ((*itEdge < 0) || (*itEdge >= Agros2D::scene()->edges->length()))
+                throw out_of_range(QObject::tr("Edge index must be between 0 and '%1'.").arg(Agros2D::scene()->edges->length()-1).toStdString());
+
+            set.insert(*itEdge);
+        }
+
+        sets.append(set);
+    }
+
+    SolutionMode solutionMode = getSolutionMode(QString::fromStdString(solutionType));
+
+    // set time and adaptivity step if -1 (default parameter - last steps), check steps
+    timeStep = getTimeStep(timeStep, solutionMode);
+    adaptivityStep = getAdaptivityStep(adaptivityStep, timeStep, solutionMode);
+
+    IntegralValue *integral = m_fieldInfo->plugin()->surfaceIntegral(m_fieldInfo, timeStep, adaptivityStep, solutionMode, sets);
+
+    results.clear();
+    foreach (QMap<QString, double> regionValues, integral->regionValues())
+    {
+        map<std::string, double> values;
+
+        QMapIterator<QString, double> it(regionValues);
+        while (it.hasNext())
+        {
+            it.next();
+            values[m_fieldInfo->surfaceIntegral(it.key()).shortname().toStdString()] = it.value();
+        }
+
+        results.push_back(values);
+    }
+    delete integral;
+}
+
+void PyField::volumeIntegrals(const vector<vector<int> > &labels, int timeStep, int adaptivityStep,
+                              const std::string &solutionType, vector<map<std::string, double> > &results) const
+{
+    if (!Agros2D::problem()->isSolved())
+        throw logic_error(QObject::tr("Problem is not solved.").toStdString());
+
+    QList<QSet<int> > sets;
+    for (vector<vector<int> >::const_iterator it = labels.begin(); it != labels.end(); ++it)
+    {
+        QSet<int> set;
+
+        // empty set means all labels
+        if (it->empty())
+        {
+            for (int i = 0; i < Agros2D::scene()->labels->length(); i++)
+                set.insert(i);
+        }
+
+        for (vector<int>::const_iterator itLabel = it->begin(); itLabel != it->end(); ++itLabel)
+        {
+            if ((*itLabel < 0) || (*itLabel >= Agros2D::scene()->labels->length()))
+                throw out_of_range(QObject::tr("Label index must be between 0 and '%1'.").arg(Agros2D::scene()->labels->length()-1).toStdString());
+
+            if (Agros2D::scene()->labels->at(*itLabel)->marker(m_fieldInfo) == Agros2D::scene()->materials->getNone(m_fieldInfo))
+                throw out_of_range(QObject::tr("Label with index '%1' is 'none'.").arg(*itLabel).toStdString());
+
+            set.insert(*itLabel);
+        }
+
+        sets.append(set);
+    }
+
+    SolutionMode solutionMode = getSolutionMode(QString::fromStdString(solutionType));
+
+    // set time and adaptivity step if -1 (default parameter - last steps), check steps
+    timeStep = getTimeStep(timeStep, solutionMode);
+    adaptivityStep = getAdaptivityStep(adaptivityStep, timeStep, solutionMode);
+
+    IntegralValue *integral = m_fieldInfo->plugin()->volumeIntegral(m_fieldInfo, timeStep, adaptivityStep, solutionMode, sets);
+
+    results.clear();
+    foreach (QMap<QString, double> regionValues, integral->regionValues())
+    {
+        map<std::string, double> values;
+
+        QMapIterator<QString, double> it(regionValues);
+        while (it.hasNext())
+        {
+            it.next();
+            values[m_fieldInfo->volumeIntegral(it.key()).shortname().toStdString()] = it.value();
+        }
+
+        results.push_back(values);
+    }
+    delete integral;
+}
+
 void PyField::initialMeshInfo(map<std::string, int> &info) const
 {
     if (!Agros2D::problem()->isMeshed())
@@ -710,6 +829,146 @@ void PyField::solutionMeshInfo(int timeStep, int adaptivityStep, const std::stri
     info["dofs"] = Hermes::Hermes2D::Space<double>::get_num_dofs(msa.spaces());
 }
 
+// vertices and triangles of active elements (node ids are not contiguous, quads are split into two triangles)
+static void meshArrays(Hermes::Hermes2D::MeshSharedPtr mesh, vector<double> &vertices, vector<int> &triangles)
+{
+    vertices.clear();
+    triangles.clear();
+
+    vector<int> index(mesh->get_max_node_id(), -1);
+    vertices.reserve(2 * mesh->get_num_vertex_nodes());
+
+    Hermes::Hermes2D::Node *node;
+    for_all_vertex_nodes(node, mesh)
+    {
+        index[node->id] = vertices.size() / 2;
+        vertices.push_back(node->x);
+        vertices.push_back(node->y);
+    }
+
+    triangles.reserve(6 * mesh->get_num_active_elements());
+
+    Hermes::Hermes2D::Element *element;
+    for_all_active_elements(element, mesh)
+    {
+        for (int i = 1; i < element->get_nvert() - 1; i++)
+        {
+            triangles.push_back(index[element->vn[0]->id]);
+            triangles.push_back(index[element->vn[i]->id]);
+            triangles.push_back(index[element->vn[i + 1]->id]);
+        }
+    }
+}
+
+void PyField::solutionVector(int timeStep, int adaptivityStep, const std::string &solutionType, vector<double> &values) const
+{
+    if (!Agros2D::problem()->isSolved())
+        throw logic_error(QObject::tr("Problem is not solved.").toStdString());
+
+    SolutionMode solutionMode = getSolutionMode(QString::fromStdString(solutionType));
+
+    // set time and adaptivity step if -1 (default parameter - last steps), check steps
+    timeStep = getTimeStep(timeStep, solutionMode);
+    adaptivityStep = getAdaptivityStep(adaptivityStep, timeStep, solutionMode);
+
+    FieldSolutionID solutionID(m_fieldInfo, timeStep, adaptivityStep, solutionMode);
+    if (!Agros2D::solutionStore()->contains(solutionID))
+        throw logic_error(QObject::tr("Solution does not exist.").toStdString());
+
+    // coefficient vector is stored together with the solution
+    MultiArray<double> msa = Agros2D::solutionStore()->multiArray(solutionID);
+    values = msa.coefficients();
+}
+
+void PyField::initialMeshArrays(vector<double> &vertices, vector<int> &triangles) const
+{
+    if (!Agros2D::problem()->isMeshed())
+        throw logic_error(QObject::tr("Problem is not meshed.").toStdString());
+
+    meshArrays(m_fieldInfo->initialMesh(), vertices, triangles);
+}
+
+void PyField::solutionMeshArrays(int timeStep, int adaptivityStep, const std::string &solutionType,
+                                 vector<double> &vertices, vector<int> &triangles) const
+{
+    if (!Agros2D::problem()->isSolved())
+        throw logic_error(QObject::tr("Problem is not solved.").toStdString());
+
+    SolutionMode solutionMode = getSolutionMode(QString::fromStdString(solutionType));
+
+    // set time and adaptivity step if -1 (default parameter - last steps), check steps
+    timeStep = getTimeStep(timeStep, solutionMode);
+    adaptivityStep = getAdaptivityStep(adaptivityStep, timeStep, solutionMode);
+
+    MultiArray<double> msa = Agros2D::solutionStore()->multiArray(FieldSolutionID(m_fieldInfo, timeStep, adaptivityStep, solutionMode));
+    meshArrays(msa.solutions().at(0)->get_mesh(), vertices, triangles);
+}
+
+void PyField::linearizedValues(const std::string &variable, const std::string &component,
+                               int timeStep, int adaptivityStep, const std::string &solutionType,
+                               vector<double> &vertices, vector<double> &values) const
+{
+    if (!Agros2D::problem()->isSolved())
+        throw logic_error(QObject::tr("Problem is not solved.").toStdString());
+
+    QStringList list;
+    foreach (Module::LocalVariable localVariable, m_fieldInfo->viewScalarVariables())
+        list.append(localVariable.id());
+
+    if (!list.contains(QString::fromStdString(variable)))
+        throw invalid_argument(QObject::tr("Invalid argument. Valid keys: %1").arg(stringListToString(list)).toStdString());
+
+    if (!physicFieldVariableCompTypeStringKeys().contains(QString::fromStdString(component)))
+        throw invalid_argument(QObject::tr("Invalid argument. Valid keys: %1").arg(stringListToString(physicFieldVariableCompTypeStringKeys())).toStdString());
+
+    SolutionMode solutionMode = getSolutionMode(QString::fromStdString(solutionType));
+
+    // set time and adaptivity step if -1 (default parameter - last steps), check steps
+    timeStep = getTimeStep(timeStep, solutionMode);
+    adaptivityStep = getAdaptivityStep(adaptivityStep, timeStep, solutionMode);
+
+    // update time functions
+    if (Agros2D::problem()->isTransient())
+        Module::updateTimeFunctions(Agros2D::problem()->timeStepToTotalTime(timeStep));
+
+    MultiArray<double> msa = Agros2D::solutionStore()->multiArray(FieldSolutionID(m_fieldInfo, timeStep, adaptivityStep, solutionMode));
+    Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<double> > slns;
+    for (int k = 0; k < m_fieldInfo->numberOfSolutions(); k++)
+        slns.push_back(msa.solutions().at(k));
+
+    Hermes::Hermes2D::MeshFunctionSharedPtr<double> filter = m_fieldInfo->plugin()->filter(m_fieldInfo, timeStep, adaptivityStep, solutionMode, slns,
+                                                                                           QString::fromStdString(variable),
+                                                                                           physicFieldVariableCompFromStringKey(QString::fromStdString(component)));
+
+    vertices.clear();
+    values.clear();
+
+    Hermes::Hermes2D::Views::Linearizer linearizer(Hermes::Hermes2D::OpenGL);
+    try
+    {
+        linearizer.set_criterion(Hermes::Hermes2D::Views::LinearizerCriterionFixed(1));
+        linearizer.process_solution(filter, Hermes::Hermes2D::H2D_FN_VAL_0);
+    }
+    catch (Hermes::Exceptions::Exception& e)
+    {
+        throw logic_error(QObject::tr("Linearizer processing failed: %1").arg(e.info().c_str()).toStdString());
+    }
+
+    // triangles are not connected, every triangle has its own three vertices
+    for (Hermes::Hermes2D::Views::Linearizer::Iterator<Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t>
+         it = linearizer.triangles_begin(); !it.end; ++it)
+    {
+        Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t& triangle = it.get();
+
+        for (int j = 0; j < 3; j++)
+        {
+            vertices.push_back(triangle[j][0]);
+            vertices.push_back(triangle[j][1]);
+            values.push_back(triangle[j][2]);
+        }
+    }
+}
+
 void PyField::solverInfo(int timeStep, int adaptivityStep, const std::string &solutionType,
                          vector<double> &solutionsChange, vector<double> &residual,
                          vector<double> &dampingCoeff, int &jacobianCalculations) const
@@ -737,6 +996,43 @@ void PyField::solverInfo(int timeStep, int adaptivityStep, const std::string &so
     jacobianCalculations = runTime.jacobianCalculations();
 }
 
+void PyField::linearSolverInfo(int timeStep, int adaptivityStep, const std::string &solutionType,
+                               int &iterations, int &innerIterations, double &residual) const
+{
+    if (!Agros2D::problem()->isSolved())
+        throw logic_error(QObject::tr("Problem is not solved.").toStdString());
+
+    SolutionMode solutionMode = getSolutionMode(QString::fromStdString(solutionType));
+
+    // step if -1 (default parameter - last steps)
+    timeStep = getTimeStep(timeStep, solutionMode);
+    adaptivityStep = getAdaptivityStep(adaptivityStep, timeStep, solutionMode);
+
+    SolutionStore::SolutionRunTimeDetails runTime = Agros2D::solutionStore()->multiSolutionRunTimeDetail(FieldSolutionID(m_fieldInfo, timeStep, adaptivityStep, solutionMode));
+
+    iterations = runTime.linearSolverIterations();
+    innerIterations = runTime.linearSolverInnerIterations();
+    residual = runTime.linearSolverResidual();
+}
+
+void PyField::profileInfo(int timeStep, int adaptivityStep, const std::string &solutionType,
+                          map<std::string, double> &profile) const
+{
+    if (!Agros2D::problem()->isSolved())
+        throw logic_error(QObject::tr("Problem is not solved.").toStdString());
+
+    SolutionMode solutionMode = getSolutionMode(QString::fromStdString(solutionType));
+
+    // step if -1 (default parameter - last steps)
+    timeStep = getTimeStep(timeStep, solutionMode);
+    adaptivityStep = getAdaptivityStep(adaptivityStep, timeStep, solutionMode);
+
+    SolutionStore::SolutionRunTimeDetails runTime = Agros2D::solutionStore()->multiSolutionRunTimeDetail(FieldSolutionID(m_fieldInfo, timeStep, adaptivityStep, solutionMode));
+
+    foreach (QString path, runTime.profile().keys())
+        profile[path.toStdString()] = runTime.profile()[path];
+}
+
 void PyField::adaptivityInfo(int timeStep, const std::string &solutionType, vector<double> &error, vector<int> &dofs) const
 {
     if (!Agros2D::problem()->isSolved())
@@ -753,6 +1049,10 @@ void PyField::adaptivityInfo(int timeStep, const std::string &solutionType, vect
     int adaptivitySteps = Agros2D::solutionStore()->lastAdaptiveStep(m_fieldInfo, solutionMode, timeStep) + 1;
     for (int i = 0; i < adaptivitySteps; i++)
     {
+        // reference solutions are stored according to retention policy
+        if (!Agros2D::solutionStore()->contains(FieldSolutionID(m_fieldInfo, timeStep, i, solutionMode)))
+            continue;
+
         SolutionStore::SolutionRunTimeDetails runTime = Agros2D::solutionStore()->multiSolutionRunTimeDetail(FieldSolutionID(m_fieldInfo, timeStep, i, solutionMode));
         error.push_back(runTime.adaptivityError());
         dofs.push_back(runTime.DOFs());
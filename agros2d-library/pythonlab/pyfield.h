@@ -103,6 +103,10 @@ class PyField
         inline std::string getAdaptivityErrorCalculator() const { return m_fieldInfo->value(FieldInfo::AdaptivityErrorCalculator).toString().toStdString(); }
         void setAdaptivityErrorCalculator(const std::string &calculator);
 
+        // adaptivity reference solution retention
+        inline std::string getAdaptivityReferenceRetention() const { return adaptivityReferenceRetentionToStringKey((AdaptivityReferenceRetention) m_fieldInfo->value(FieldInfo::AdaptivityReferenceRetention).toInt()).toStdString(); }
+        void setAdaptivityReferenceRetention(const std::string &retention);
+
         // initial condition
         inline double getInitialCondition() const { return m_fieldInfo->value(FieldInfo::TransientInitialCondition).toDouble(); }
         void setInitialCondition(double initialCondition);
@@ -141,15 +145,38 @@ class PyField
         void volumeIntegrals(const vector<int> &labels, int timeStep, int adaptivityStep,
                              const std::string &solutionType, map<std::string, double> &results) const;
 
+        // integrals over several sets of edges (labels), evaluated at once without changing selection
+        void surfaceIntegrals(const vector<vector<int> > &edges, int timeStep, int adaptivityStep,
+                              const std::string &solutionType, vector<map<std::string, double> > &results) const;
+        void volumeIntegrals(const vector<vector<int> > &labels, int timeStep, int adaptivityStep,
+                             const std::string &solutionType, vector<map<std::string, double> > &results) const;
+
         // mesh info
         void initialMeshInfo(map<std::string, int> &info) const;
         void solutionMeshInfo(int timeStep, int adaptivityStep, const std::string &solutionType, map<std::string, int> &info) const;
 
+        // arrays (vertices are stored as x, y pairs, triangles as triples of vertex indices)
+        void solutionVector(int timeStep, int adaptivityStep, const std::string &solutionType, vector<double> &values) const;
+        void initialMeshArrays(vector<double> &vertices, vector<int> &triangles) const;
+        void solutionMeshArrays(int timeStep, int adaptivityStep, const std::string &solutionType,
+                                vector<double> &vertices, vector<int> &triangles) const;
+        void linearizedValues(const std::string &variable, const std::string &component,
+                              int timeStep, int adaptivityStep, const std::string &solutionType,
+                              vector<double> &vertices, vector<double> &values) const;
+
         // solver info
         void solverInfo(int timeStep, int adaptivityStep, const std::string &solutionType,
                         vector<double> &solutionsChange, vector<double> &residual,
                         vector<double> &dampingCoeff, int &jacobianCalculations) const;
 
+        // linear solver info
+        void linearSolverInfo(int timeStep, int adaptivityStep, const std::string &solutionType,
+                              int &iterations, int &innerIterations, double &residual) const;
+
+        // time spent in each phase of the step (ms)
+        void profileInfo(int timeStep, int adaptivityStep, const std::string &solutionType,
+                         map<std::string, double> &profile) const;
+
         // adaptivity info
         void adaptivityInfo(int timeStep, const std::string &solutionType, vector<double> &error, vector<int> &dofs) const;
 
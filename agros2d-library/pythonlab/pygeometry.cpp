@@ -18,11 +18,70 @@
 // Email: agros2d@googlegroups.com, home page: http://hpfem.org/agros2d/
 
 #include "pygeometry.h"
+
+#include <algorithm>
+
 #include "pythonengine_agros.h"
 #include "hermes2d/problem_config.h"
 #include "sceneview_geometry.h"
 #include "scenemarker.h"
 
+// items are appended to the end of container, avoids linear search in bulk insert
+template <typename BasicType>
+static int indexOfAdded(SceneBasicContainer<BasicType> *container, BasicType *item)
+{
+    int last = container->length() - 1;
+    if ((last >= 0) && (container->at(last) == item))
+        return last;
+
+    return container->items().indexOf(item);
+}
+
+// batched parameters have one item for each entity, one item for all entities or no item (default value)
+template <typename Type>
+static void testBatchSize(const vector<Type> &values, int count, const QString &name)
+{
+    if ((values.size() > 1) && (values.size() != count))
+        throw invalid_argument(QObject::tr("Parameter '%1' has %2 items, %3 items expected.").arg(name).arg(values.size()).arg(count).toStdString());
+}
+
+template <typename Type>
+static Type batchValue(const vector<Type> &values, int index, const Type &defaultValue)
+{
+    if (values.empty())
+        return defaultValue;
+
+    return (values.size() == 1) ? values.at(0) : values.at(index);
+}
+
+// batch joins the transaction started by the caller or runs in its own transaction, which is rolled back on error
+class PyGeometryBatch
+{
+public:
+    PyGeometryBatch() : m_isOwner(!Agros2D::scene()->isTransaction()), m_isCommitted(false)
+    {
+        if (m_isOwner)
+            Agros2D::scene()->beginTransaction();
+    }
+
+    ~PyGeometryBatch()
+    {
+        if (m_isOwner && !m_isCommitted)
+            Agros2D::scene()->rollbackTransaction();
+    }
+
+    void commit()
+    {
+        if (m_isOwner)
+            Agros2D::scene()->commitTransaction();
+        m_isCommitted = true;
+    }
+
+private:
+    bool m_isOwner;
+    bool m_isCommitted;
+};
+
 void PyGeometry::activate()
 {
     if (!silentMode())
@@ -37,14 +96,11 @@ int PyGeometry::addNode(double x, double y)
     if (Agros2D::problem()->config()->coordinateType() == CoordinateType_Axisymmetric && x < 0.0)
         throw out_of_range(QObject::tr("Radial component must be greater then or equal to zero.").toStdString());
 
-    foreach (SceneNode *node, Agros2D::scene()->nodes->items())
-    {
-        if (node->point() == Point(x, y))
-            throw logic_error(QObject::tr("Node already exist.").toStdString());
-    }
+    if (Agros2D::scene()->nodes->get(Point(x, y)))
+        throw logic_error(QObject::tr("Node already exist.").toStdString());
 
     SceneNode *node = Agros2D::scene()->addNode(new SceneNode(Point(x, y)));
-    return Agros2D::scene()->nodes->items().indexOf(node);
+    return indexOfAdded<SceneNode>(Agros2D::scene()->nodes, node);
 }
 
 int PyGeometry::addEdge(double x1, double y1, double x2, double y2, double angle, int segments, int curvilinear,
@@ -59,14 +115,8 @@ int PyGeometry::addEdge(double x1, double y1, double x2, double y2, double angle
     testAngle(angle);
     testSegments(segments);
 
-    foreach (SceneEdge *edge, Agros2D::scene()->edges->items())
-    {
-        if (almostEqualRelAndAbs(edge->nodeStart()->point().x, x1, POINT_ABS_ZERO, POINT_REL_ZERO) &&
-                almostEqualRelAndAbs(edge->nodeEnd()->point().x, x2, POINT_ABS_ZERO, POINT_REL_ZERO) &&
-                almostEqualRelAndAbs(edge->nodeStart()->point().y, y1, POINT_ABS_ZERO, POINT_REL_ZERO) &&
-                almostEqualRelAndAbs(edge->nodeEnd()->point().y, y2, POINT_ABS_ZERO, POINT_REL_ZERO))
-            throw logic_error(QObject::tr("Edge already exist.").toStdString());
-    }
+    if (Agros2D::scene()->edges->get(Point(x1, y1), Point(x2, y2)))
+        throw logic_error(QObject::tr("Edge already exist.").toStdString());
 
     SceneNode *nodeStart = new SceneNode(Point(x1, y1));
     nodeStart = Agros2D::scene()->addNode(nodeStart);
@@ -87,7 +137,7 @@ int PyGeometry::addEdge(double x1, double y1, double x2, double y2, double angle
 
     Agros2D::scene()->addEdge(edge);
 
-    return Agros2D::scene()->edges->items().indexOf(edge);
+    return indexOfAdded<SceneEdge>(Agros2D::scene()->edges, edge);
 }
 
 int PyGeometry::addEdgeByNodes(int nodeStartIndex, int nodeEndIndex, double angle, int segments, int curvilinear,
@@ -110,12 +160,9 @@ int PyGeometry::addEdgeByNodes(int nodeStartIndex, int nodeEndIndex, double angl
     testAngle(angle);
     testSegments(segments);
 
-    foreach (SceneEdge *edge, Agros2D::scene()->edges->items())
-    {
-        if (Agros2D::scene()->nodes->items().indexOf(edge->nodeStart()) == nodeStartIndex &&
-                Agros2D::scene()->nodes->items().indexOf(edge->nodeEnd()) == nodeEndIndex)
-            throw logic_error(QObject::tr("Edge already exist.").toStdString());
-    }
+    if (Agros2D::scene()->edges->get(Agros2D::scene()->nodes->at(nodeStartIndex)->point(),
+                                     Agros2D::scene()->nodes->at(nodeEndIndex)->point()))
+        throw logic_error(QObject::tr("Edge already exist.").toStdString());
 
     SceneEdge *edge = new SceneEdge(Agros2D::scene()->nodes->at(nodeStartIndex), Agros2D::scene()->nodes->at(nodeEndIndex),
                                     angle, segments, curvilinear);
@@ -133,20 +180,181 @@ int PyGeometry::addEdgeByNodes(int nodeStartIndex, int nodeEndIndex, double angl
 
     Agros2D::scene()->addEdge(edge);
 
-    return Agros2D::scene()->edges->items().indexOf(edge);
+    return indexOfAdded<SceneEdge>(Agros2D::scene()->edges, edge);
 }
 
-void PyGeometry::modifyEdge(int index, double angle, int segments, int isCurvilinear, const map<std::string, int> &refinements, const map<std::string, std::string> &boundaries)
+vector<int> PyGeometry::addNodes(const vector<double> &x, const vector<double> &y)
+{
+    if (!silentMode())
+        currentPythonEngineAgros()->sceneViewPreprocessor()->actOperateOnNodes->trigger();
+
+    if (x.size() != y.size())
+        throw invalid_argument(QObject::tr("Coordinates x and y must have the same length.").toStdString());
+
+    for (int i = 0; i < x.size(); i++)
+        if (Agros2D::problem()->config()->coordinateType() == CoordinateType_Axisymmetric && x[i] < 0.0)
+            throw out_of_range(QObject::tr("Radial component must be greater then or equal to zero.").toStdString());
+
+    vector<int> indices;
+    indices.reserve(x.size());
+
+    PyGeometryBatch batch;
+    for (int i = 0; i < x.size(); i++)
+    {
+        if (Agros2D::scene()->nodes->get(Point(x[i], y[i])))
+            throw logic_error(QObject::tr("Node already exist.").toStdString());
+
+        SceneNode *node = Agros2D::scene()->addNode(new SceneNode(Point(x[i], y[i])));
+        indices.push_back(indexOfAdded<SceneNode>(Agros2D::scene()->nodes, node));
+    }
+    batch.commit();
+
+    return indices;
+}
+
+vector<int> PyGeometry::addEdges(const vector<double> &x1, const vector<double> &y1, const vector<double> &x2, const vector<double> &y2,
+                                 const vector<double> &angles, const vector<int> &segments, const vector<int> &curvilinear,
+                                 const vector<map<std::string, std::string> > &boundaries)
 {
     if (!silentMode())
         currentPythonEngineAgros()->sceneViewPreprocessor()->actOperateOnEdges->trigger();
 
-    if (Agros2D::scene()->edges->isEmpty())
-        throw out_of_range(QObject::tr("No edges are defined.").toStdString());
+    int count = x1.size();
+    if ((y1.size() != count) || (x2.size() != count) || (y2.size() != count))
+        throw invalid_argument(QObject::tr("Coordinates x1, y1, x2 and y2 must have the same length.").toStdString());
 
-    if (index < 0 || index >= Agros2D::scene()->edges->length())
-        throw out_of_range(QObject::tr("Edge index must be between 0 and '%1'.").arg(Agros2D::scene()->edges->length()-1).toStdString());
+    testBatchSize(angles, count, "angles");
+    testBatchSize(segments, count, "segments");
+    testBatchSize(curvilinear, count, "curvilinear");
+    testBatchSize(boundaries, count, "boundaries");
+
+    // validate all edges before the geometry is changed
+    for (int i = 0; i < count; i++)
+    {
+        if (Agros2D::problem()->config()->coordinateType() == CoordinateType_Axisymmetric && (x1[i] < 0.0 || x2[i] < 0.0))
+            throw out_of_range(QObject::tr("Radial component must be greater then or equal to zero.").toStdString());
 
+        testAngle(batchValue(angles, i, 0.0));
+        testSegments(batchValue(segments, i, 3));
+    }
+
+    vector<QList<SceneBoundary *> > edgeBoundaries;
+    for (int i = 0; i < boundaries.size(); i++)
+        edgeBoundaries.push_back(findBoundaries(boundaries[i]));
+
+    vector<int> indices;
+    indices.reserve(count);
+
+    PyGeometryBatch batch;
+    for (int i = 0; i < count; i++)
+    {
+        if (Agros2D::scene()->edges->get(Point(x1[i], y1[i]), Point(x2[i], y2[i])))
+            throw logic_error(QObject::tr("Edge already exist.").toStdString());
+
+        SceneNode *nodeStart = Agros2D::scene()->addNode(new SceneNode(Point(x1[i], y1[i])));
+        SceneNode *nodeEnd = Agros2D::scene()->addNode(new SceneNode(Point(x2[i], y2[i])));
+        SceneEdge *edge = new SceneEdge(nodeStart, nodeEnd, batchValue(angles, i, 0.0),
+                                        batchValue(segments, i, 3), batchValue(curvilinear, i, 1));
+
+        foreach (SceneBoundary *boundary, batchValue(edgeBoundaries, i, QList<SceneBoundary *>()))
+            edge->addMarker(boundary);
+
+        Agros2D::scene()->addEdge(edge);
+        indices.push_back(indexOfAdded<SceneEdge>(Agros2D::scene()->edges, edge));
+    }
+    batch.commit();
+
+    return indices;
+}
+
+vector<int> PyGeometry::addEdgesByNodes(const vector<int> &nodeStartIndices, const vector<int> &nodeEndIndices,
+                                        const vector<double> &angles, const vector<int> &segments, const vector<int> &curvilinear,
+                                        const vector<map<std::string, std::string> > &boundaries)
+{
+    if (!silentMode())
+        currentPythonEngineAgros()->sceneViewPreprocessor()->actOperateOnEdges->trigger();
+
+    int count = nodeStartIndices.size();
+    if (nodeEndIndices.size() != count)
+        throw invalid_argument(QObject::tr("Indexes of start and end nodes must have the same length.").toStdString());
+
+    testBatchSize(angles, count, "angles");
+    testBatchSize(segments, count, "segments");
+    testBatchSize(curvilinear, count, "curvilinear");
+    testBatchSize(boundaries, count, "boundaries");
+
+    // validate all edges before the geometry is changed
+    for (int i = 0; i < count; i++)
+    {
+        if (nodeStartIndices[i] == nodeEndIndices[i])
+            throw logic_error(QObject::tr("Start node index is the same as index of end node.").toStdString());
+
+        testNodeIndex(nodeStartIndices[i]);
+        testNodeIndex(nodeEndIndices[i]);
+        testAngle(batchValue(angles, i, 0.0));
+        testSegments(batchValue(segments, i, 3));
+    }
+
+    vector<QList<SceneBoundary *> > edgeBoundaries;
+    for (int i = 0; i < boundaries.size(); i++)
+        edgeBoundaries.push_back(findBoundaries(boundaries[i]));
+
+    vector<int> indices;
+    indices.reserve(count);
+
+    PyGeometryBatch batch;
+    for (int i = 0; i < count; i++)
+    {
+        SceneNode *nodeStart = Agros2D::scene()->nodes->at(nodeStartIndices[i]);
+        SceneNode *nodeEnd = Agros2D::scene()->nodes->at(nodeEndIndices[i]);
+
+        if (Agros2D::scene()->edges->get(nodeStart->point(), nodeEnd->point()))
+            throw logic_error(QObject::tr("Edge already exist.").toStdString());
+
+        SceneEdge *edge = new SceneEdge(nodeStart, nodeEnd, batchValue(angles, i, 0.0),
+                                        batchValue(segments, i, 3), batchValue(curvilinear, i, 1));
+
+        foreach (SceneBoundary *boundary, batchValue(edgeBoundaries, i, QList<SceneBoundary *>()))
+            edge->addMarker(boundary);
+
+        Agros2D::scene()->addEdge(edge);
+        indices.push_back(indexOfAdded<SceneEdge>(Agros2D::scene()->edges, edge));
+    }
+    batch.commit();
+
+    return indices;
+}
+
+void PyGeometry::beginTransaction()
+{
+    if (Agros2D::scene()->isTransaction())
+        throw logic_error(QObject::tr("Geometry transaction is already started.").toStdString());
+
+    Agros2D::scene()->beginTransaction();
+}
+
+void PyGeometry::commitTransaction()
+{
+    if (!Agros2D::scene()->isTransaction())
+        throw logic_error(QObject::tr("Geometry transaction is not started.").toStdString());
+
+    Agros2D::scene()->commitTransaction();
+}
+
+void PyGeometry::rollbackTransaction()
+{
+    if (!Agros2D::scene()->isTransaction())
+        throw logic_error(QObject::tr("Geometry transaction is not started.").toStdString());
+
+    Agros2D::scene()->rollbackTransaction();
+}
+
+void PyGeometry::modifyEdge(int index, double angle, int segments, int isCurvilinear, const map<std::string, int> &refinements, const map<std::string, std::string> &boundaries)
+{
+    if (!silentMode())
+        currentPythonEngineAgros()->sceneViewPreprocessor()->actOperateOnEdges->trigger();
+
+    testEdgeIndex(index);
     testAngle(angle);
     testSegments(segments);
 
@@ -159,7 +367,83 @@ void PyGeometry::modifyEdge(int index, double angle, int segments, int isCurvili
     setRefinementsOnEdge(edge, refinements);
     setBoundaries(edge, boundaries);
 
-    Agros2D::scene()->invalidate();
+    invalidate();
+}
+
+void PyGeometry::modifyEdges(const vector<int> &indices, const vector<double> &angles, const vector<int> &segments,
+                             const vector<int> &curvilinear, const vector<map<std::string, std::string> > &boundaries)
+{
+    if (!silentMode())
+        currentPythonEngineAgros()->sceneViewPreprocessor()->actOperateOnEdges->trigger();
+
+    int count = indices.size();
+    testBatchSize(angles, count, "angles");
+    testBatchSize(segments, count, "segments");
+    testBatchSize(curvilinear, count, "curvilinear");
+    testBatchSize(boundaries, count, "boundaries");
+
+    // validate all edges before the geometry is changed
+    for (int i = 0; i < count; i++)
+    {
+        testEdgeIndex(indices[i]);
+        testAngle(batchValue(angles, i, 0.0));
+        testSegments(batchValue(segments, i, 3));
+    }
+
+    vector<QList<SceneBoundary *> > edgeBoundaries;
+    for (int i = 0; i < boundaries.size(); i++)
+        edgeBoundaries.push_back(findBoundaries(boundaries[i]));
+
+    for (int i = 0; i < count; i++)
+    {
+        SceneEdge *edge = Agros2D::scene()->edges->at(indices[i]);
+
+        edge->setAngleValue(Value(batchValue(angles, i, 0.0)));
+        edge->setSegments(batchValue(segments, i, 3));
+        edge->setCurvilinear(batchValue(curvilinear, i, 1));
+
+        foreach (SceneBoundary *boundary, batchValue(edgeBoundaries, i, QList<SceneBoundary *>()))
+            edge->addMarker(boundary);
+    }
+
+    if (count > 0)
+        invalidate();
+}
+
+void PyGeometry::invalidate()
+{
+    // geometry is invalidated once at the end of transaction
+    if (Agros2D::scene()->isTransaction())
+        Agros2D::scene()->setTransactionModified();
+    else
+        Agros2D::scene()->invalidate();
+}
+
+void PyGeometry::testEdgeIndex(int index) const
+{
+    if (Agros2D::scene()->edges->isEmpty())
+        throw out_of_range(QObject::tr("No edges are defined.").toStdString());
+
+    if (index < 0 || index >= Agros2D::scene()->edges->length())
+        throw out_of_range(QObject::tr("Edge index must be between 0 and '%1'.").arg(Agros2D::scene()->edges->length()-1).toStdString());
+}
+
+void PyGeometry::testLabelIndex(int index) const
+{
+    if (Agros2D::scene()->labels->isEmpty())
+        throw out_of_range(QObject::tr("No labels are defined.").toStdString());
+
+    if (index < 0 || index >= Agros2D::scene()->labels->length())
+        throw out_of_range(QObject::tr("Label index must be between 0 and '%1'.").arg(Agros2D::scene()->labels->length()-1).toStdString());
+}
+
+void PyGeometry::testNodeIndex(int index) const
+{
+    if (Agros2D::scene()->nodes->isEmpty())
+        throw out_of_range(QObject::tr("Geometry does not contain nodes.").toStdString());
+
+    if (index > (Agros2D::scene()->nodes->length() - 1) || index < 0)
+        throw out_of_range(QObject::tr("Node with index '%1' does not exist.").arg(index).toStdString());
 }
 
 void PyGeometry::testAngle(double angle) const
@@ -176,6 +460,14 @@ void PyGeometry::testSegments(int segments) const
 
 void PyGeometry::setBoundaries(SceneEdge *edge, const map<std::string, std::string> &boundaries)
 {
+    foreach (SceneBoundary *boundary, findBoundaries(boundaries))
+        edge->addMarker(boundary);
+}
+
+QList<SceneBoundary *> PyGeometry::findBoundaries(const map<std::string, std::string> &boundaries) const
+{
+    QList<SceneBoundary *> found;
+
     for (map<std::string, std::string>::const_iterator i = boundaries.begin(); i != boundaries.end(); ++i)
     {
         QString field = QString::fromStdString((*i).first);
@@ -190,7 +482,7 @@ void PyGeometry::setBoundaries(SceneEdge *edge, const map<std::string, std::stri
             if (boundary->name() == marker)
             {
                 assigned = true;
-                edge->addMarker(boundary);
+                found.append(boundary);
                 break;
             }
         }
@@ -198,6 +490,8 @@ void PyGeometry::setBoundaries(SceneEdge *edge, const map<std::string, std::stri
         if (!assigned)
             throw invalid_argument(QObject::tr("Boundary condition '%1' doesn't exists.").arg(marker).toStdString());
     }
+
+    return found;
 }
 
 void PyGeometry::setRefinementsOnEdge(SceneEdge *edge, const map<std::string, int> &refinements)
@@ -251,7 +545,7 @@ int PyGeometry::addLabel(double x, double y, double area, const map<std::string,
 
     Agros2D::scene()->addLabel(label);
 
-    return Agros2D::scene()->labels->items().indexOf(label);
+    return indexOfAdded<SceneLabel>(Agros2D::scene()->labels, label);
 }
 
 void PyGeometry::modifyLabel(int index, double area, const map<std::string, int> &refinements,
@@ -260,11 +554,7 @@ void PyGeometry::modifyLabel(int index, double area, const map<std::string, int>
     if (!silentMode())
         currentPythonEngineAgros()->sceneViewPreprocessor()->actOperateOnLabels->trigger();
 
-    if (Agros2D::scene()->labels->isEmpty())
-        throw out_of_range(QObject::tr("No labels are defined.").toStdString());
-
-    if (index < 0 || index >= Agros2D::scene()->labels->length())
-        throw out_of_range(QObject::tr("Label index must be between 0 and '%1'.").arg(Agros2D::scene()->labels->length()-1).toStdString());
+    testLabelIndex(index);
 
     if (area < 0.0)
         throw out_of_range(QObject::tr("Area must be positive.").toStdString());
@@ -276,11 +566,104 @@ void PyGeometry::modifyLabel(int index, double area, const map<std::string, int>
     setRefinements(label, refinements);
     setPolynomialOrders(label, orders);
 
-    Agros2D::scene()->invalidate();
+    invalidate();
+}
+
+vector<int> PyGeometry::addLabels(const vector<double> &x, const vector<double> &y, const vector<double> &areas,
+                                  const vector<map<std::string, std::string> > &materials)
+{
+    if (!silentMode())
+        currentPythonEngineAgros()->sceneViewPreprocessor()->actOperateOnLabels->trigger();
+
+    int count = x.size();
+    if (y.size() != count)
+        throw invalid_argument(QObject::tr("Coordinates x and y must have the same length.").toStdString());
+
+    testBatchSize(areas, count, "areas");
+    testBatchSize(materials, count, "materials");
+
+    // validate all labels before the geometry is changed
+    for (int i = 0; i < count; i++)
+    {
+        if (Agros2D::problem()->config()->coordinateType() == CoordinateType_Axisymmetric && x[i] < 0.0)
+            throw out_of_range(QObject::tr("Radial component must be greater then or equal to zero.").toStdString());
+
+        if (batchValue(areas, i, 0.0) < 0.0)
+            throw out_of_range(QObject::tr("Area must be positive.").toStdString());
+    }
+
+    vector<QList<SceneMaterial *> > labelMaterials;
+    for (int i = 0; i < materials.size(); i++)
+        labelMaterials.push_back(findMaterials(materials[i]));
+
+    vector<int> indices;
+    indices.reserve(count);
+
+    PyGeometryBatch batch;
+    for (int i = 0; i < count; i++)
+    {
+        if (Agros2D::scene()->labels->get(Point(x[i], y[i])))
+            throw logic_error(QObject::tr("Label already exist.").toStdString());
+
+        SceneLabel *label = new SceneLabel(Point(x[i], y[i]), batchValue(areas, i, 0.0));
+
+        foreach (SceneMaterial *material, batchValue(labelMaterials, i, QList<SceneMaterial *>()))
+            label->addMarker(material);
+
+        Agros2D::scene()->addLabel(label);
+        indices.push_back(indexOfAdded<SceneLabel>(Agros2D::scene()->labels, label));
+    }
+    batch.commit();
+
+    return indices;
+}
+
+void PyGeometry::modifyLabels(const vector<int> &indices, const vector<double> &areas,
+                              const vector<map<std::string, std::string> > &materials)
+{
+    if (!silentMode())
+        currentPythonEngineAgros()->sceneViewPreprocessor()->actOperateOnLabels->trigger();
+
+    int count = indices.size();
+    testBatchSize(areas, count, "areas");
+    testBatchSize(materials, count, "materials");
+
+    // validate all labels before the geometry is changed
+    for (int i = 0; i < count; i++)
+    {
+        testLabelIndex(indices[i]);
+
+        if (batchValue(areas, i, 0.0) < 0.0)
+            throw out_of_range(QObject::tr("Area must be positive.").toStdString());
+    }
+
+    vector<QList<SceneMaterial *> > labelMaterials;
+    for (int i = 0; i < materials.size(); i++)
+        labelMaterials.push_back(findMaterials(materials[i]));
+
+    for (int i = 0; i < count; i++)
+    {
+        SceneLabel *label = Agros2D::scene()->labels->at(indices[i]);
+
+        label->setArea(batchValue(areas, i, 0.0));
+        foreach (SceneMaterial *material, batchValue(labelMaterials, i, QList<SceneMaterial *>()))
+            label->addMarker(material);
+    }
+
+    if (count > 0)
+        invalidate();
 }
 
 void PyGeometry::setMaterials(SceneLabel *label, const map<std::string, std::string> &materials)
 {
+    foreach (SceneMaterial *material, findMaterials(materials))
+        label->addMarker(material);
+}
+
+QList<SceneMaterial *> PyGeometry::findMaterials(const map<std::string, std::string> &materials) const
+{
+    QList<SceneMaterial *> found;
+
     for( map<std::string, std::string>::const_iterator i = materials.begin(); i != materials.end(); ++i)
     {
         QString field = QString::fromStdString((*i).first);
@@ -298,7 +681,7 @@ void PyGeometry::setMaterials(SceneLabel *label, const map<std::string, std::str
                 if ((material->fieldId() == field) && (material->name() == marker))
                 {
                     assigned = true;
-                    label->addMarker(material);
+                    found.append(material);
                     break;
                 }
             }
@@ -307,6 +690,8 @@ void PyGeometry::setMaterials(SceneLabel *label, const map<std::string, std::str
                 throw invalid_argument(QObject::tr("Material '%1' doesn't exists.").arg(marker).toStdString());
         }
     }
+
+    return found;
 }
 
 void PyGeometry::setRefinements(SceneLabel *label, const map<std::string, int> &refinements)
@@ -585,6 +970,42 @@ void PyGeometry::removeSelection()
         currentPythonEngineAgros()->sceneViewPreprocessor()->refresh();
 }
 
+void PyGeometry::nodePoint(int index, double &x, double &y) const
+{
+    testNodeIndex(index);
+
+    Point point = Agros2D::scene()->nodes->at(index)->point();
+    x = point.x;
+    y = point.y;
+}
+
+void PyGeometry::check(vector<int> &lyingNodes, vector<int> &endNodes, vector<int> &crossings)
+{
+    Agros2D::scene()->findGeometryErrors();
+
+    for (int i = 0; i < Agros2D::scene()->nodes->count(); i++)
+    {
+        SceneNode *node = Agros2D::scene()->nodes->at(i);
+
+        if (node->hasLyingEdges())
+            lyingNodes.push_back(i);
+        if (node->isEndNode())
+            endNodes.push_back(i);
+    }
+
+    foreach (SceneEdge *edge, Agros2D::scene()->crossings())
+        crossings.push_back(Agros2D::scene()->edges->items().indexOf(edge));
+    std::sort(crossings.begin(), crossings.end());
+}
+
+void PyGeometry::importDXF(const std::string &fileName)
+{
+    if (!QFile::exists(QString::fromStdString(fileName)))
+        throw logic_error(QObject::tr("DXF file does not exist.").toStdString());
+
+    Agros2D::scene()->readFromDxf(QString::fromStdString(fileName));
+}
+
 void PyGeometry::exportVTK(const std::string &fileName) const
 {
     Agros2D::scene()->exportVTKGeometry(QString::fromStdString(fileName));
@@ -43,16 +43,40 @@ class PyGeometry
         int addLabel(double x, double y, double area, const map<std::string, int> &refinements,
                      const map<std::string, int> &orders, const map<std::string, std::string> &materials);
 
+        // batched add operations, parameter with one item is used for all entities, empty parameter is default
+        vector<int> addNodes(const vector<double> &x, const vector<double> &y);
+        vector<int> addEdges(const vector<double> &x1, const vector<double> &y1, const vector<double> &x2, const vector<double> &y2,
+                             const vector<double> &angles, const vector<int> &segments, const vector<int> &curvilinear,
+                             const vector<map<std::string, std::string> > &boundaries);
+        vector<int> addEdgesByNodes(const vector<int> &nodeStartIndices, const vector<int> &nodeEndIndices,
+                                    const vector<double> &angles, const vector<int> &segments, const vector<int> &curvilinear,
+                                    const vector<map<std::string, std::string> > &boundaries);
+        vector<int> addLabels(const vector<double> &x, const vector<double> &y, const vector<double> &areas,
+                              const vector<map<std::string, std::string> > &materials);
+
+        // bulk insert
+        void beginTransaction();
+        void commitTransaction();
+        void rollbackTransaction();
+
         inline int nodesCount() const { return Agros2D::scene()->nodes->count(); }
         inline int edgesCount() const { return Agros2D::scene()->edges->count(); }
         inline int labelsCount() const { return Agros2D::scene()->labels->count(); }
 
+        void nodePoint(int index, double &x, double &y) const;
+
         // modify operations
         void modifyEdge(int index, double angle, int segments, int isCurvilinear, const map<std::string, int> &refinements,
                         const map<std::string, std::string> &boundaries);
         void modifyLabel(int index, double area, const map<std::string, int> &refinements,
                          const map<std::string, int> &orders, const map<std::string, std::string> &materials);
 
+        // batched modify operations
+        void modifyEdges(const vector<int> &indices, const vector<double> &angles, const vector<int> &segments,
+                         const vector<int> &curvilinear, const vector<map<std::string, std::string> > &boundaries);
+        void modifyLabels(const vector<int> &indices, const vector<double> &areas,
+                          const vector<map<std::string, std::string> > &materials);
+
         // remove operations
         void removeNodes(const vector<int> &nodes);
         void removeEdges(const vector<int> &edges);
@@ -75,14 +99,26 @@ class PyGeometry
         void scaleSelection(double x, double y, double scale, bool copy, bool withMarkers);
         void removeSelection();
 
+        // geometry check (indices of nodes lying on edges, nodes connected to one edge only and crossing edges)
+        void check(vector<int> &lyingNodes, vector<int> &endNodes, vector<int> &crossings);
+
+        // dxf (geometry is healed, see DxfInterfaceDXFRW)
+        void importDXF(const std::string &fileName);
+
         // vtk
         void exportVTK(const std::string &fileName) const;
 
 private:
         void testAngle(double angle) const;
         void testSegments(int segments) const;
+        void testEdgeIndex(int index) const;
+        void testLabelIndex(int index) const;
+        void testNodeIndex(int index) const;
+        QList<SceneBoundary *> findBoundaries(const map<std::string, std::string> &boundaries) const;
+        QList<SceneMaterial *> findMaterials(const map<std::string, std::string> &materials) const;
         void setBoundaries(SceneEdge *edge, const map<std::string, std::string> &boundaries);
         void setMaterials(SceneLabel *label, const map<std::string, std::string> &materials);
+        void invalidate();
         void setRefinementsOnEdge(SceneEdge *edge, const map<std::string, int> &refinements);
         void setRefinements(SceneLabel *label, const map<std::string, int> &refinements);
         void setPolynomialOrders(SceneLabel *label, const map<std::string, int> &orders);
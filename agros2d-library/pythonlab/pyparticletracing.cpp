@@ -103,6 +103,7 @@ void PyParticleTracing::solve(const vector<vector<double> > &initialPositions, c
     m_positions = particleTracing.positions();
     m_velocities = particleTracing.velocities();
     m_times = particleTracing.times();
+    m_forceEvaluations = particleTracing.forceEvaluations();
 }
 
 void PyParticleTracing::positions(vector<vector<double> > &x,
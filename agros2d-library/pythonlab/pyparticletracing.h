@@ -27,7 +27,7 @@
 class PyParticleTracing
 {
 public:
-    PyParticleTracing() {}
+    PyParticleTracing() : m_forceEvaluations(0) {}
     ~PyParticleTracing() {}
 
     // initial position
@@ -134,11 +134,16 @@ public:
     void velocities(vector<vector<double> > &vx, vector<vector<double> > &vy, vector<vector<double> > &vz) const;
     void times(vector<vector<double> > &t) const;
 
+    // number of field force evaluations of the last solve
+    inline int forceEvaluations() const { return m_forceEvaluations; }
+
 private:
     // position, velocity and time
     QList<QList<Point3> > m_positions;
     QList<QList<Point3> > m_velocities;
     QList<QList<double> > m_times;
+
+    int m_forceEvaluations;
 };
 
 #endif // PYTHONLABPARTICLETRACING_H
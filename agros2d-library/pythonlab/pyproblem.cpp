@@ -22,6 +22,8 @@
 #include "sceneview_geometry.h"
 #include "sceneview_post2d.h"
 #include "hermes2d/coupling.h"
+#include "hermes2d/solver.h"
+#include "util/profiler.h"
 
 PyProblem::PyProblem(bool clearProblem)
 {
@@ -100,6 +102,14 @@ void PyProblem::setTimeMethodTolerance(double timeMethodTolerance)
         throw out_of_range(QObject::tr("The time method tolerance must be positive.").toStdString());
 }
 
+void PyProblem::setTimeMethodErrorEstimator(const std::string &timeErrorEstimator)
+{
+    if (timeErrorEstimatorStringKeys().contains(QString::fromStdString(timeErrorEstimator)))
+        Agros2D::problem()->config()->setValue(ProblemConfig::TimeMethodErrorEstimator, (TimeErrorEstimator) timeErrorEstimatorFromStringKey(QString::fromStdString(timeErrorEstimator)));
+    else
+        throw invalid_argument(QObject::tr("Invalid argument. Valid keys: %1").arg(stringListToString(timeErrorEstimatorStringKeys())).toStdString());
+}
+
 void PyProblem::setTimeInitialTimeStep(double timeInitialTimeStep)
 {
     if (timeInitialTimeStep > 0.0)
@@ -199,6 +209,25 @@ double PyProblem::timeElapsed() const
     return time;
 }
 
+void PyProblem::meshCacheInfo(map<std::string, int> &info) const
+{
+    info["hits"] = MeshGeneratorCache::hits();
+    info["misses"] = MeshGeneratorCache::misses();
+}
+
+void PyProblem::valueCacheInfo(map<std::string, int> &info) const
+{
+    info["hits"] = Value::cacheHits();
+    info["misses"] = Value::cacheMisses();
+    info["evaluations"] = Value::evaluations();
+}
+
+void PyProblem::referenceSpaceCacheInfo(map<std::string, int> &info) const
+{
+    info["hits"] = ReferenceSpaceCacheInfo::hits();
+    info["misses"] = ReferenceSpaceCacheInfo::misses();
+}
+
 void PyProblem::timeStepsLength(vector<double> &steps) const
 {
     if (!Agros2D::problem()->isTransient())
@@ -210,3 +239,22 @@ void PyProblem::timeStepsLength(vector<double> &steps) const
     for (int i = 0; i < Agros2D::problem()->timeStepLengths().size(); i++)
         steps.push_back(Agros2D::problem()->timeStepLengths().at(i));
 }
+
+std::string PyProblem::profile(const std::string &format) const
+{
+    if (format == "json")
+        return Agros2D::profiler()->toJSON().toStdString();
+    else if (format == "chrome")
+        return Agros2D::profiler()->toChromeTrace().toStdString();
+    else
+        throw invalid_argument(QObject::tr("Invalid argument. Valid keys: %1").arg("json, chrome").toStdString());
+}
+
+void PyProblem::saveProfile(const std::string &fileName, const std::string &format) const
+{
+    if (format != "json" && format != "chrome")
+        throw invalid_argument(QObject::tr("Invalid argument. Valid keys: %1").arg("json, chrome").toStdString());
+
+    if (!Agros2D::profiler()->save(QString::fromStdString(fileName), QString::fromStdString(format)))
+        throw invalid_argument(QObject::tr("File '%1' cannot be written.").arg(QString::fromStdString(fileName)).toStdString());
+}
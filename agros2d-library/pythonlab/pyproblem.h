@@ -59,6 +59,10 @@ class PyProblem
         inline double getTimeMethodTolerance() const { return Agros2D::problem()->config()->value(ProblemConfig::TimeMethodTolerance).toDouble(); }
         void setTimeMethodTolerance(double timeMethodTolerance);
 
+        // time method error estimator
+        inline std::string getTimeMethodErrorEstimator() const { return timeErrorEstimatorToStringKey((TimeErrorEstimator) Agros2D::problem()->config()->value(ProblemConfig::TimeMethodErrorEstimator).toInt()).toStdString(); }
+        void setTimeMethodErrorEstimator(const std::string &timeErrorEstimator);
+
         // initial time step
         inline double getTimeInitialTimeStep() const { return Agros2D::problem()->config()->value(ProblemConfig::TimeInitialStepSize).toDouble(); }
         void setTimeInitialTimeStep(double timeInitialTimeStep);
@@ -79,12 +83,25 @@ class PyProblem
         void mesh();
         void solve();        
 
+        // mesh cache
+        void meshCacheInfo(map<std::string, int> &info) const;
+
+        // value cache
+        void valueCacheInfo(map<std::string, int> &info) const;
+
+        // reference space cache (adaptivity)
+        void referenceSpaceCacheInfo(map<std::string, int> &info) const;
+
         // time elapsed
         double timeElapsed() const;
 
         // time steps
         void timeStepsLength(vector<double> &steps) const;
 
+        // performance profile
+        std::string profile(const std::string &format) const;
+        void saveProfile(const std::string &fileName, const std::string &format) const;
+
         // solution vector
 
 
@@ -290,6 +290,8 @@ QString createPythonFromModel()
         {
             str += QString("problem.time_method_tolerance = %1\n").
                     arg(Agros2D::problem()->config()->value(ProblemConfig::TimeMethodTolerance).toDouble());
+            str += QString("problem.time_method_error_estimator = \"%1\"\n").
+                    arg(timeErrorEstimatorToStringKey((TimeErrorEstimator) Agros2D::problem()->config()->value(ProblemConfig::TimeMethodErrorEstimator).toInt()));
         }
         else
         {
@@ -403,6 +405,10 @@ QString createPythonFromModel()
                     arg(fieldInfo->fieldId()).
                     arg(fieldInfo->value(FieldInfo::AdaptivityOrderIncrease).toInt());
 
+            str += QString("%1.adaptivity_parameters['reference_retention'] = \"%2\"\n").
+                    arg(fieldInfo->fieldId()).
+                    arg(adaptivityReferenceRetentionToStringKey((AdaptivityReferenceRetention) fieldInfo->value(FieldInfo::AdaptivityReferenceRetention).toInt()));
+
             if (Agros2D::problem()->isTransient())
             {
                 str += QString("%1.adaptivity_parameters['transient_back_steps'] = %2\n").
@@ -137,6 +137,10 @@ struct PyOptions
     inline int getCacheSize() const { return Agros2D::configComputer()->value(Config::Config_CacheSize).toInt(); }
     void setCacheSize(int size);
 
+    // mesh cache
+    inline bool getMeshCache() const { return Agros2D::configComputer()->value(Config::Config_MeshCache).toBool(); }
+    inline void setMeshCache(bool meshCache) { Agros2D::configComputer()->setValue(Config::Config_MeshCache, meshCache); }
+
     // save matrix and rhs
     inline bool getSaveMatrixRHS() const { return Agros2D::configComputer()->value(Config::Config_LinearSystemSave).toBool(); }
     inline void setSaveMatrixRHS(bool save) { Agros2D::configComputer()->setValue(Config::Config_LinearSystemSave, save); }
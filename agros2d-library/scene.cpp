@@ -19,6 +19,8 @@
 
 #include "scene.h"
 
+#include <algorithm>
+
 #include "util/xml.h"
 #include "util/constants.h"
 #include "util/global.h"
@@ -141,7 +143,7 @@ void NewMarkerAction::doTriggered()
 
 // ************************************************************************************************************************
 
-Scene::Scene() : m_loopsInfo(NULL)
+Scene::Scene() : m_loopsInfo(NULL), m_isTransaction(false), m_isTransactionModified(false)
 {
     createActions();
 
@@ -252,7 +254,8 @@ void Scene::createActions()
 SceneNode *Scene::addNode(SceneNode *node)
 {
     // clear solution
-    Agros2D::problem()->clearSolution();
+    if (!m_isTransaction)
+        Agros2D::problem()->clearSolution();
 
     // check if node doesn't exists
     if (SceneNode* existing = nodes->get(node))
@@ -262,6 +265,14 @@ SceneNode *Scene::addNode(SceneNode *node)
     }
 
     nodes->add(node);
+
+    if (m_isTransaction)
+    {
+        // node closer than EPS_ZERO would have been found by nodes->get()
+        m_transactionNodes.append(node);
+        return node;
+    }
+
     if (!currentPythonEngine()->isScriptRunning() && !m_stopInvalidating)
         emit invalidated();
 
@@ -278,7 +289,8 @@ SceneNode *Scene::getNode(const Point &point)
 SceneEdge *Scene::addEdge(SceneEdge *edge)
 {
     // clear solution
-    Agros2D::problem()->clearSolution();
+    if (!m_isTransaction)
+        Agros2D::problem()->clearSolution();
 
     // check if edge doesn't exists
     if (SceneEdge* existing = edges->get(edge)){
@@ -287,6 +299,13 @@ SceneEdge *Scene::addEdge(SceneEdge *edge)
     }
 
     edges->add(edge);
+
+    if (m_isTransaction)
+    {
+        m_transactionEdges.append(edge);
+        return edge;
+    }
+
     if (!currentPythonEngine()->isScriptRunning() && !m_stopInvalidating)
         emit invalidated();
 
@@ -309,7 +328,8 @@ SceneEdge *Scene::getEdge(const Point &pointStart, const Point &pointEnd)
 SceneLabel *Scene::addLabel(SceneLabel *label)
 {
     // clear solution
-    Agros2D::problem()->clearSolution();
+    if (!m_isTransaction)
+        Agros2D::problem()->clearSolution();
 
     // check if label doesn't exists
     if(SceneLabel* existing = labels->get(label)){
@@ -318,6 +338,13 @@ SceneLabel *Scene::addLabel(SceneLabel *label)
     }
 
     labels->add(label);
+
+    if (m_isTransaction)
+    {
+        m_transactionLabels.append(label);
+        return label;
+    }
+
     if (!currentPythonEngine()->isScriptRunning() && !m_stopInvalidating)
         emit invalidated();
 
@@ -329,6 +356,91 @@ SceneLabel *Scene::getLabel(const Point &point)
     return labels->get(point);
 }
 
+void Scene::beginTransaction()
+{
+    assert(!m_isTransaction);
+
+    m_isTransaction = true;
+    m_transactionNodes.clear();
+    m_transactionEdges.clear();
+    m_transactionLabels.clear();
+
+    nodes->setIndexed(true);
+    edges->setIndexed(true);
+}
+
+void Scene::commitTransaction()
+{
+    assert(m_isTransaction);
+
+    bool isAdded = !m_transactionNodes.isEmpty() || !m_transactionEdges.isEmpty() || !m_transactionLabels.isEmpty();
+    bool isModified = m_isTransactionModified;
+    finishTransaction();
+
+    // clear solution
+    if (isAdded)
+        Agros2D::problem()->clearSolution();
+
+    // modified edges and labels are invalidated even if script is running (as in PyGeometry::modifyEdge())
+    if (isModified || (isAdded && !currentPythonEngine()->isScriptRunning() && !m_stopInvalidating))
+        emit invalidated();
+}
+
+void Scene::rollbackTransaction()
+{
+    assert(m_isTransaction);
+
+    QList<SceneNode *> nodesAdded = m_transactionNodes;
+    QList<SceneEdge *> edgesAdded = m_transactionEdges;
+    QList<SceneLabel *> labelsAdded = m_transactionLabels;
+    bool isModified = m_isTransactionModified;
+    finishTransaction();
+
+    // edges first, new nodes are not connected to any other edge
+    foreach (SceneEdge *edge, edgesAdded)
+    {
+        if (edges->remove(edge))
+        {
+            foreach (FieldInfo *fieldInfo, Agros2D::problem()->fieldInfos())
+                fieldInfo->removeEdgeRefinement(edge);
+
+            delete edge;
+        }
+    }
+    foreach (SceneLabel *label, labelsAdded)
+    {
+        if (labels->remove(label))
+        {
+            foreach (FieldInfo *fieldInfo, Agros2D::problem()->fieldInfos())
+            {
+                fieldInfo->removeLabelRefinement(label);
+                fieldInfo->removeLabelPolynomialOrder(label);
+            }
+
+            delete label;
+        }
+    }
+    foreach (SceneNode *node, nodesAdded)
+        if (nodes->remove(node))
+            delete node;
+
+    // modifications are not rolled back
+    if (isModified)
+        emit invalidated();
+}
+
+void Scene::finishTransaction()
+{
+    m_isTransaction = false;
+    m_isTransactionModified = false;
+    m_transactionNodes.clear();
+    m_transactionEdges.clear();
+    m_transactionLabels.clear();
+
+    nodes->setIndexed(false);
+    edges->setIndexed(false);
+}
+
 void Scene::addBoundary(SceneBoundary *boundary)
 {
     boundaries->add(boundary);
@@ -589,6 +701,7 @@ void Scene::clear()
     }
 
     // geometry
+    finishTransaction();
     nodes->clear();
     edges->clear();
     labels->clear();
@@ -999,7 +1112,17 @@ void Scene::doInvalidated()
     actNewEdge->setEnabled((nodes->length() >= 2) && (boundaries->length() >= 1));
     actNewLabel->setEnabled(materials->length() >= 1);
 
-    // evaluate point values
+    // values depending on changed parameters are evaluated in one batch
+    QList<Value *> values;
+    foreach (SceneNode *node, nodes->items())
+        values << &node->pointValueRef().xRef() << &node->pointValueRef().yRef();
+    foreach (SceneEdge *edge, edges->items())
+        values << &edge->angleValueRef();
+    foreach (SceneLabel *label, labels->items())
+        values << &label->pointValueRef().xRef() << &label->pointValueRef().yRef();
+    Value::evaluateChanged(values);
+
+    // evaluate point values (refresh caches of edges)
     foreach (SceneNode *node, nodes->items())
         node->setPointValue(node->pointValue());
     foreach (SceneEdge *edge, edges->items())
@@ -1008,11 +1131,7 @@ void Scene::doInvalidated()
         label->setPointValue(label->pointValue());
 
     if (currentPythonEngineAgros() && !currentPythonEngineAgros()->isScriptRunning())
-    {
-        findLyingEdgeNodes();
-        findNumberOfConnectedNodeEdges();
-        findCrossings();
-    }
+        findGeometryErrors();
 }
 
 void Scene::doNewNode(const Point &point)
@@ -2614,6 +2733,10 @@ void Scene::checkGeometryResult()
 {
     checkTwoNodesSameCoordinates();
 
+    // results of invalidation are not up to date in scripts
+    if (currentPythonEngineAgros() && currentPythonEngineAgros()->isScriptRunning())
+        findGeometryErrors();
+
     if (Agros2D::problem()->config()->coordinateType() == CoordinateType_Axisymmetric)
     {
         // check for nodes with r < 0
@@ -2661,71 +2784,202 @@ void Scene::checkGeometryResult()
     }
 }
 
-void Scene::findLyingEdgeNodes()
+// compact arrays of scene geometry, items are referenced by their index in containers
+// (checks of whole geometry run over the arrays instead of the scene objects)
+struct SceneGeometryArrays
 {
-    m_lyingEdgeNodes.clear();
-
-    foreach (SceneEdge *edge, edges->items())
+    SceneGeometryArrays(SceneNodeContainer *nodes, SceneEdgeContainer *edges)
     {
-        foreach (SceneNode *node, nodes->items())
+        // bounding boxes are enlarged by the tolerance of geometry checks
+        const double tolerance = 2.0 * sqrt(EPS_ZERO);
+
+        QList<SceneNode *> nodeItems = nodes->items();
+        QList<SceneEdge *> edgeItems = edges->items();
+
+        QHash<SceneNode *, int> nodeIndex;
+        nodeIndex.reserve(nodeItems.count());
+
+        nodeX.resize(nodeItems.count());
+        nodeY.resize(nodeItems.count());
+        nodeOrder.resize(nodeItems.count());
+        for (int i = 0; i < nodeItems.count(); i++)
         {
-            if (edge->isLyingOnNode(node))
+            Point point = nodeItems[i]->point();
+
+            nodeX[i] = point.x;
+            nodeY[i] = point.y;
+            nodeOrder[i] = i;
+            nodeIndex[nodeItems[i]] = i;
+        }
+        std::sort(nodeOrder.begin(), nodeOrder.end(), [this](int a, int b) { return nodeX[a] < nodeX[b]; });
+
+        edgeStart.resize(edgeItems.count());
+        edgeEnd.resize(edgeItems.count());
+        edgeMinX.resize(edgeItems.count());
+        edgeMaxX.resize(edgeItems.count());
+        edgeMinY.resize(edgeItems.count());
+        edgeMaxY.resize(edgeItems.count());
+        edgeOrder.resize(edgeItems.count());
+        for (int i = 0; i < edgeItems.count(); i++)
+        {
+            SceneEdge *edge = edgeItems[i];
+
+            edgeStart[i] = nodeIndex.value(edge->nodeStart(), -1);
+            edgeEnd[i] = nodeIndex.value(edge->nodeEnd(), -1);
+            edgeOrder[i] = i;
+
+            if (edge->isStraight())
             {
-                m_lyingEdgeNodes.insert(edge, node);
+                Point start = edge->nodeStart()->point();
+                Point end = edge->nodeEnd()->point();
+
+                edgeMinX[i] = qMin(start.x, end.x) - tolerance;
+                edgeMaxX[i] = qMax(start.x, end.x) + tolerance;
+                edgeMinY[i] = qMin(start.y, end.y) - tolerance;
+                edgeMaxY[i] = qMax(start.y, end.y) + tolerance;
+            }
+            else
+            {
+                // arc and its center lie in the circumscribed square
+                Point center = edge->center();
+                double radius = edge->radius();
+
+                edgeMinX[i] = center.x - radius - tolerance;
+                edgeMaxX[i] = center.x + radius + tolerance;
+                edgeMinY[i] = center.y - radius - tolerance;
+                edgeMaxY[i] = center.y + radius + tolerance;
             }
         }
+        std::sort(edgeOrder.begin(), edgeOrder.end(), [this](int a, int b) { return edgeMinX[a] < edgeMinX[b]; });
+    }
+
+    // nodes (sorted by x coordinate in nodeOrder)
+    QVector<double> nodeX;
+    QVector<double> nodeY;
+    QVector<int> nodeOrder;
+
+    // edges (indices of nodes, bounding boxes, sorted by minimal x coordinate in edgeOrder)
+    QVector<int> edgeStart;
+    QVector<int> edgeEnd;
+    QVector<double> edgeMinX;
+    QVector<double> edgeMaxX;
+    QVector<double> edgeMinY;
+    QVector<double> edgeMaxY;
+    QVector<int> edgeOrder;
+};
+
+void Scene::findGeometryErrors()
+{
+    SceneGeometryArrays arrays(nodes, edges);
+
+    findLyingEdgeNodes(arrays);
+    findNumberOfConnectedNodeEdges(arrays);
+    findCrossings(arrays);
+}
+
+void Scene::findLyingEdgeNodes(const SceneGeometryArrays &arrays)
+{
+    m_lyingEdgeNodes.clear();
+
+    QList<SceneNode *> nodeItems = nodes->items();
+    QList<SceneEdge *> edgeItems = edges->items();
+
+    for (int i = 0; i < edgeItems.count(); i++)
+    {
+        // nodes in bounding box of edge
+        QVector<int>::const_iterator it = std::lower_bound(arrays.nodeOrder.constBegin(), arrays.nodeOrder.constEnd(), arrays.edgeMinX[i],
+                                                           [&arrays](int node, double x) { return arrays.nodeX[node] < x; });
+
+        QVector<int> candidates;
+        for (; it != arrays.nodeOrder.constEnd() && arrays.nodeX[*it] <= arrays.edgeMaxX[i]; ++it)
+            if (arrays.nodeY[*it] >= arrays.edgeMinY[i] && arrays.nodeY[*it] <= arrays.edgeMaxY[i])
+                candidates.append(*it);
+
+        // original order of nodes
+        std::sort(candidates.begin(), candidates.end());
+
+        foreach (int node, candidates)
+            if (edgeItems[i]->isLyingOnNode(nodeItems[node]))
+                m_lyingEdgeNodes.insert(edgeItems[i], nodeItems[node]);
     }
 }
 
-void Scene::findNumberOfConnectedNodeEdges()
+void Scene::findNumberOfConnectedNodeEdges(const SceneGeometryArrays &arrays)
 {
     m_numberOfConnectedNodeEdges.clear();
 
-    foreach (SceneNode *node, nodes->items())
+    QVector<int> connections(arrays.nodeX.count(), 0);
+    for (int i = 0; i < arrays.edgeStart.count(); i++)
     {
-        int connections = 0;
-        foreach (SceneEdge *edge, edges->items())
-        {
-            if (edge->nodeStart() == node || edge->nodeEnd() == node)
-                connections++;
-        }
-        m_numberOfConnectedNodeEdges.insert(node, connections);
+        if (arrays.edgeStart[i] != -1)
+            connections[arrays.edgeStart[i]]++;
+        if (arrays.edgeEnd[i] != -1 && arrays.edgeEnd[i] != arrays.edgeStart[i])
+            connections[arrays.edgeEnd[i]]++;
     }
+
+    QList<SceneNode *> nodeItems = nodes->items();
+    for (int i = 0; i < nodeItems.count(); i++)
+        m_numberOfConnectedNodeEdges.insert(nodeItems[i], connections[i]);
 }
 
-void Scene::findCrossings()
+void Scene::findCrossings(const SceneGeometryArrays &arrays)
 {
     m_crossings.clear();
 
-    for (int i = 0; i < edges->count(); i++)
+    // pairs of edges with overlapping bounding boxes (sweep along x axis)
+    QVector<QPair<int, int> > pairs;
+    for (int a = 0; a < arrays.edgeOrder.count(); a++)
     {
-        SceneEdge *edge = edges->at(i);
+        int i = arrays.edgeOrder[a];
 
-        for (int j = i + 1; j < edges->count(); j++)
+        for (int b = a + 1; b < arrays.edgeOrder.count(); b++)
         {
-            SceneEdge *edgeCheck = edges->at(j);
+            int j = arrays.edgeOrder[b];
+            if (arrays.edgeMinX[j] > arrays.edgeMaxX[i])
+                break;
 
-            QList<Point> intersects;
+            if (arrays.edgeMinY[j] <= arrays.edgeMaxY[i] && arrays.edgeMaxY[j] >= arrays.edgeMinY[i])
+                pairs.append(QPair<int, int>(qMin(i, j), qMax(i, j)));
+        }
+    }
 
-            // TODO: improve - add check of crossings of two arcs
-            if (edge->isStraight())
-                intersects = intersection(edge->nodeStart()->point(), edge->nodeEnd()->point(),
-                                          edgeCheck->center(), edge->radius(), edge->angle(),
-                                          edgeCheck->nodeStart()->point(), edgeCheck->nodeEnd()->point(),
-                                          edgeCheck->center(), edgeCheck->radius(), edgeCheck->angle());
+    // original order of edges
+    std::sort(pairs.begin(), pairs.end());
 
-            else
-                intersects = intersection(edgeCheck->nodeStart()->point(), edgeCheck->nodeEnd()->point(),
-                                          edgeCheck->center(), edgeCheck->radius(), edgeCheck->angle(),
-                                          edge->nodeStart()->point(), edge->nodeEnd()->point(),
-                                          edge->center(), edge->radius(), edge->angle());
+    QList<SceneEdge *> edgeItems = edges->items();
+    QSet<SceneEdge *> crossings;
 
-            if (intersects.count() > 0)
+    for (int k = 0; k < pairs.count(); k++)
+    {
+        SceneEdge *edge = edgeItems[pairs[k].first];
+        SceneEdge *edgeCheck = edgeItems[pairs[k].second];
+
+        QList<Point> intersects;
+
+        // TODO: improve - add check of crossings of two arcs
+        if (edge->isStraight())
+            intersects = intersection(edge->nodeStart()->point(), edge->nodeEnd()->point(),
+                                      edgeCheck->center(), edge->radius(), edge->angle(),
+                                      edgeCheck->nodeStart()->point(), edgeCheck->nodeEnd()->point(),
+                                      edgeCheck->center(), edgeCheck->radius(), edgeCheck->angle());
+
+        else
+            intersects = intersection(edgeCheck->nodeStart()->point(), edgeCheck->nodeEnd()->point(),
+                                      edgeCheck->center(), edgeCheck->radius(), edgeCheck->angle(),
+                                      edge->nodeStart()->point(), edge->nodeEnd()->point(),
+                                      edge->center(), edge->radius(), edge->angle());
+
+        if (intersects.count() > 0)
+        {
+            if (!crossings.contains(edgeCheck))
+            {
+                crossings.insert(edgeCheck);
+                m_crossings.append(edgeCheck);
+            }
+            if (!crossings.contains(edge))
             {
-                if (!m_crossings.contains(edgeCheck))
-                    m_crossings.append(edgeCheck);
-                if (!m_crossings.contains((edge)))
-                    m_crossings.append(edge);
+                crossings.insert(edge);
+                m_crossings.append(edge);
             }
         }
     }
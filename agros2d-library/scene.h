@@ -37,6 +37,7 @@ class SceneBoundary;
 class SceneMaterial;
 struct SceneViewSettings;
 class LoopsInfo;
+struct SceneGeometryArrays;
 
 class SceneNodeContainer;
 class SceneEdgeContainer;
@@ -171,6 +172,10 @@ public:
     QMap<SceneNode *, int> numberOfConnectedNodeEdges() const { return m_numberOfConnectedNodeEdges; }
     QList<SceneEdge *> crossings() const { return m_crossings; }
 
+    // find lying nodes on edges, number of connected edges and crossings
+    // (done on invalidation, scripts skip it until the geometry is checked)
+    void findGeometryErrors();
+
     inline void invalidate() { emit invalidated(); }
 
     void exportVTKGeometry(const QString &fileName);
@@ -199,6 +204,16 @@ public:
 
     void stopInvalidating(bool sI) { m_stopInvalidating = sI;}
 
+    // bulk insert of geometry - hashed lookup of nodes and edges,
+    // solution is cleared and geometry invalidated once in commitTransaction()
+    void beginTransaction();
+    void commitTransaction();
+    // removes nodes, edges and labels added in transaction
+    void rollbackTransaction();
+    inline bool isTransaction() const { return m_isTransaction; }
+    // modified edges and labels are invalidated once at the end of transaction
+    inline void setTransactionModified() { m_isTransactionModified = true; }
+
 private:
     QUndoStack *m_undoStack;
 
@@ -218,13 +233,20 @@ private:
 
     void transform(QString name, SceneTransformMode mode, const Point &point, double angle, double scaleFactor, bool copy, bool withMarkers);
 
-    // find lying nodes on edges, number of connected edges and crossings
-    void findLyingEdgeNodes();
-    void findNumberOfConnectedNodeEdges();
-    void findCrossings();
+    void findLyingEdgeNodes(const SceneGeometryArrays &arrays);
+    void findNumberOfConnectedNodeEdges(const SceneGeometryArrays &arrays);
+    void findCrossings(const SceneGeometryArrays &arrays);
 
     bool m_stopInvalidating;
 
+    bool m_isTransaction;
+    bool m_isTransactionModified;
+    QList<SceneNode *> m_transactionNodes;
+    QList<SceneEdge *> m_transactionEdges;
+    QList<SceneLabel *> m_transactionLabels;
+
+    void finishTransaction();
+
 private slots:
     void doInvalidated();
 };
@@ -61,6 +61,96 @@ private:
     bool m_isHighlighted;
 };
 
+// allocates scene items in blocks, items of large geometries are stored close to each other
+// and blocks are released when the last item is deleted (cleared scene)
+template <typename T>
+class ScenePool
+{
+public:
+    ScenePool() : m_freeList(NULL), m_count(0) {}
+    ~ScenePool() { releaseBlocks(); }
+
+    void *allocate(size_t size)
+    {
+        // derived types
+        if (size != sizeof(T))
+            return ::operator new(size);
+
+        QMutexLocker locker(&m_mutex);
+
+        if (!m_freeList)
+            addBlock();
+
+        Slot *slot = m_freeList;
+        m_freeList = slot->next;
+        m_count++;
+
+        return slot;
+    }
+
+    void deallocate(void *item, size_t size)
+    {
+        if (!item)
+            return;
+
+        if (size != sizeof(T))
+        {
+            ::operator delete(item);
+            return;
+        }
+
+        QMutexLocker locker(&m_mutex);
+
+        Slot *slot = static_cast<Slot *>(item);
+        slot->next = m_freeList;
+        m_freeList = slot;
+        m_count--;
+
+        if (m_count == 0)
+            releaseBlocks();
+    }
+
+    inline int count() const { return m_count; }
+    inline int capacity() const { return m_blocks.count() * BlockSize; }
+
+private:
+    static const int BlockSize = 1024;
+
+    union Slot
+    {
+        Slot *next;
+        double alignment;
+        char data[sizeof(T)];
+    };
+
+    Slot *m_freeList;
+    QList<Slot *> m_blocks;
+    int m_count;
+    QMutex m_mutex;
+
+    void addBlock()
+    {
+        Slot *block = static_cast<Slot *>(::operator new(BlockSize * sizeof(Slot)));
+        m_blocks.append(block);
+
+        // items are allocated in the order of addresses
+        for (int i = BlockSize - 1; i >= 0; i--)
+        {
+            block[i].next = m_freeList;
+            m_freeList = &block[i];
+        }
+    }
+
+    void releaseBlocks()
+    {
+        foreach (Slot *block, m_blocks)
+            ::operator delete(block);
+
+        m_blocks.clear();
+        m_freeList = NULL;
+    }
+};
+
 template <typename BasicType>
 class AGROS_LIBRARY_API SceneBasicContainer
 {
@@ -33,6 +33,23 @@
 #include "hermes2d/problem_config.h"
 #include "hermes2d/field.h"
 
+static ScenePool<SceneEdge> *edgePool()
+{
+    // pool is never destroyed (edges can be deleted after static objects)
+    static ScenePool<SceneEdge> *pool = new ScenePool<SceneEdge>();
+    return pool;
+}
+
+void *SceneEdge::operator new(size_t size)
+{
+    return edgePool()->allocate(size);
+}
+
+void SceneEdge::operator delete(void *item, size_t size)
+{
+    edgePool()->deallocate(item, size);
+}
+
 SceneEdge::SceneEdge(SceneNode *nodeStart, SceneNode *nodeEnd, const Value &angle, int segments, bool isCurvilinear)
     : MarkedSceneBasic<SceneBoundary>(),
       m_nodeStart(nodeStart), m_nodeEnd(nodeEnd), m_angle(angle), m_segments(segments), m_isCurvilinear(isCurvilinear)
@@ -296,9 +313,62 @@ void SceneEdgeContainer::removeConnectedToNode(SceneNode *node)
 
 }
 
+bool SceneEdgeContainer::add(SceneEdge *item)
+{
+    if (m_isIndexed)
+        m_index.insert(indexKey(item->nodeStart(), item->nodeEnd()), item);
+
+    return MarkedSceneBasicContainer<SceneBoundary, SceneEdge>::add(item);
+}
+
+bool SceneEdgeContainer::remove(SceneEdge *item)
+{
+    if (m_isIndexed)
+        m_index.remove(indexKey(item->nodeStart(), item->nodeEnd()), item);
+
+    return MarkedSceneBasicContainer<SceneBoundary, SceneEdge>::remove(item);
+}
+
+void SceneEdgeContainer::setIndexed(bool indexed)
+{
+    m_isIndexed = indexed;
+    m_index.clear();
+
+    if (m_isIndexed)
+        foreach (SceneEdge *edge, m_data)
+            m_index.insert(indexKey(edge->nodeStart(), edge->nodeEnd()), edge);
+}
+
+QPair<SceneNode *, SceneNode *> SceneEdgeContainer::indexKey(SceneNode *nodeStart, SceneNode *nodeEnd)
+{
+    return (nodeStart < nodeEnd) ? qMakePair(nodeStart, nodeEnd) : qMakePair(nodeEnd, nodeStart);
+}
+
+QList<SceneEdge *> SceneEdgeContainer::candidates(SceneNode *nodeStart, SceneNode *nodeEnd) const
+{
+    if (!m_isIndexed)
+        return m_data;
+
+    return m_index.values(indexKey(nodeStart, nodeEnd));
+}
+
+QList<SceneEdge *> SceneEdgeContainer::candidates(const Point &pointStart, const Point &pointEnd) const
+{
+    if (!m_isIndexed || !Agros2D::scene()->nodes->isIndexed())
+        return m_data;
+
+    // nodes are unique, edge with given end points has to connect these nodes
+    SceneNode *nodeStart = Agros2D::scene()->nodes->get(pointStart);
+    SceneNode *nodeEnd = Agros2D::scene()->nodes->get(pointEnd);
+    if (!nodeStart || !nodeEnd)
+        return QList<SceneEdge *>();
+
+    return m_index.values(indexKey(nodeStart, nodeEnd));
+}
+
 SceneEdge* SceneEdgeContainer::get(SceneEdge* edge) const
 {
-    foreach (SceneEdge *edgeCheck, m_data)
+    foreach (SceneEdge *edgeCheck, candidates(edge->nodeStart(), edge->nodeEnd()))
     {
         if (((((edgeCheck->nodeStart() == edge->nodeStart()) && (edgeCheck->nodeEnd() == edge->nodeEnd())) &&
               (fabs(edgeCheck->angle() - edge->angle()) < EPS_ZERO)) ||
@@ -314,7 +384,7 @@ SceneEdge* SceneEdgeContainer::get(SceneEdge* edge) const
 
 SceneEdge* SceneEdgeContainer::get(const Point &pointStart, const Point &pointEnd, double angle, int segments, bool isCurvilinear) const
 {
-    foreach (SceneEdge *edgeCheck, m_data)
+    foreach (SceneEdge *edgeCheck, candidates(pointStart, pointEnd))
     {
         if (((edgeCheck->nodeStart()->point() == pointStart) && (edgeCheck->nodeEnd()->point() == pointEnd))
                 && ((edgeCheck->angle() - angle) < EPS_ZERO) && (edgeCheck->segments() == segments) && (edgeCheck->isCurvilinear() == isCurvilinear))
@@ -326,7 +396,7 @@ SceneEdge* SceneEdgeContainer::get(const Point &pointStart, const Point &pointEn
 
 SceneEdge* SceneEdgeContainer::get(const Point &pointStart, const Point &pointEnd) const
 {
-    foreach (SceneEdge *edgeCheck, m_data)
+    foreach (SceneEdge *edgeCheck, candidates(pointStart, pointEnd))
     {
         if (((edgeCheck->nodeStart()->point() == pointStart) && (edgeCheck->nodeEnd()->point() == pointEnd)))
             return edgeCheck;
@@ -32,12 +32,17 @@ class AGROS_LIBRARY_API SceneEdge : public MarkedSceneBasic<SceneBoundary>
 public:
     SceneEdge(SceneNode *nodeStart, SceneNode *nodeEnd, const Value &angle, int segments = 3, bool isCurvilinear = true);
 
+    // edges are allocated in pool
+    static void *operator new(size_t size);
+    static void operator delete(void *item, size_t size);
+
     inline SceneNode *nodeStart() const { return m_nodeStart; }
     inline void setNodeStart(SceneNode *nodeStart) { m_nodeStart = nodeStart; computeCenterAndRadius(); }
     inline SceneNode *nodeEnd() const { return m_nodeEnd; }
     inline void setNodeEnd(SceneNode *nodeEnd) { m_nodeEnd = nodeEnd; computeCenterAndRadius(); }
     inline double angle() const { return m_angle.number(); }
     inline Value angleValue() const { return m_angle; }
+    inline Value &angleValueRef() { return m_angle; }
     inline void setAngleValue(const Value &angle) { m_angle = angle; computeCenterAndRadius(); }
     void swapDirection();
 
@@ -94,8 +99,17 @@ Q_DECLARE_METATYPE(SceneEdge *)
 class SceneEdgeContainer : public MarkedSceneBasicContainer<SceneBoundary, SceneEdge>
 {
 public:
+    SceneEdgeContainer() : m_isIndexed(false) {}
+
     void removeConnectedToNode(SceneNode* node);
 
+    virtual bool add(SceneEdge *item);
+    virtual bool remove(SceneEdge *item);
+
+    /// hashed lookup of edges by their nodes (bulk insert), edges must not be reconnected while the index is used
+    void setIndexed(bool indexed);
+    inline bool isIndexed() const { return m_isIndexed; }
+
     /// if container contains the same edge, returns it. Otherwise returns NULL
     SceneEdge* get(SceneEdge* edge) const;
 
@@ -108,6 +122,15 @@ public:
     /// returns bounding box, assumes container not empty
     RectPoint boundingBox() const;
     static RectPoint boundingBox(QList<SceneEdge *> edges);
+
+private:
+    // edges keyed by unordered pair of nodes
+    bool m_isIndexed;
+    QMultiHash<QPair<SceneNode *, SceneNode *>, SceneEdge *> m_index;
+
+    static QPair<SceneNode *, SceneNode *> indexKey(SceneNode *nodeStart, SceneNode *nodeEnd);
+    QList<SceneEdge *> candidates(SceneNode *nodeStart, SceneNode *nodeEnd) const;
+    QList<SceneEdge *> candidates(const Point &pointStart, const Point &pointEnd) const;
 };
 
 // *************************************************************************************************************************************
@@ -35,6 +35,23 @@
 #include "hermes2d/problem.h"
 #include "hermes2d/problem_config.h"
 
+static ScenePool<SceneLabel> *labelPool()
+{
+    // pool is never destroyed (labels can be deleted after static objects)
+    static ScenePool<SceneLabel> *pool = new ScenePool<SceneLabel>();
+    return pool;
+}
+
+void *SceneLabel::operator new(size_t size)
+{
+    return labelPool()->allocate(size);
+}
+
+void SceneLabel::operator delete(void *item, size_t size)
+{
+    labelPool()->deallocate(item, size);
+}
+
 SceneLabel::SceneLabel(const Point &point, double area)
     : MarkedSceneBasic<SceneMaterial>(), m_point(point.x, point.y), m_area(area)
 {
@@ -34,10 +34,15 @@ public:
     SceneLabel(const Point &point, double area);
     SceneLabel(const PointValue &pointValue, double area);
 
+    // labels are allocated in pool
+    static void *operator new(size_t size);
+    static void operator delete(void *item, size_t size);
+
     inline virtual SceneMaterial* marker(const FieldInfo *fieldInfo) { return MarkedSceneBasic<SceneMaterial>::marker(fieldInfo); }
 
     inline Point point() const { return m_point.point(); }
     inline PointValue pointValue() const { return m_point; }
+    inline PointValue &pointValueRef() { return m_point; }
     void setPointValue(const PointValue &point);
 
     inline double area() const { return m_area; }
@@ -30,6 +30,23 @@
 #include "hermes2d/problem.h"
 #include "hermes2d/problem_config.h"
 
+static ScenePool<SceneNode> *nodePool()
+{
+    // pool is never destroyed (nodes can be deleted after static objects)
+    static ScenePool<SceneNode> *pool = new ScenePool<SceneNode>();
+    return pool;
+}
+
+void *SceneNode::operator new(size_t size)
+{
+    return nodePool()->allocate(size);
+}
+
+void SceneNode::operator delete(void *item, size_t size)
+{
+    nodePool()->deallocate(item, size);
+}
+
 SceneNode::SceneNode(const Point &point) : SceneBasic(), m_point(point.x, point.y)
 {
 }
@@ -86,7 +103,7 @@ SceneNode *SceneNode::findClosestNode(const Point &point)
 
 SceneNode* SceneNodeContainer::get(SceneNode *node) const
 {
-    foreach (SceneNode *nodeCheck, m_data)
+    foreach (SceneNode *nodeCheck, candidates(node->point()))
     {
         if (nodeCheck->point() == node->point())
         {
@@ -99,7 +116,7 @@ SceneNode* SceneNodeContainer::get(SceneNode *node) const
 
 SceneNode* SceneNodeContainer::get(const Point &point) const
 {
-    foreach (SceneNode *nodeCheck, m_data)
+    foreach (SceneNode *nodeCheck, candidates(point))
     {
         if (nodeCheck->point() == point)
             return nodeCheck;
@@ -108,14 +125,86 @@ SceneNode* SceneNodeContainer::get(const Point &point) const
     return NULL;
 }
 
+bool SceneNodeContainer::add(SceneNode *item)
+{
+    if (m_isIndexed && isIndexable(item->point()))
+    {
+        double magnitude = qMax(fabs(item->point().x), fabs(item->point().y));
+        if (magnitude > m_indexScale)
+            rebuildIndex(2.0 * magnitude);
+
+        m_index.insert(indexKey(item->point()), item);
+    }
+
+    return SceneBasicContainer<SceneNode>::add(item);
+}
+
 bool SceneNodeContainer::remove(SceneNode *item)
 {
     // remove all edges connected to this node
     Agros2D::scene()->edges->removeConnectedToNode(item);
 
+    if (m_isIndexed && isIndexable(item->point()))
+        m_index.remove(indexKey(item->point()), item);
+
     return SceneBasicContainer<SceneNode>::remove(item);
 }
 
+void SceneNodeContainer::setIndexed(bool indexed)
+{
+    m_isIndexed = indexed;
+    m_index.clear();
+
+    if (m_isIndexed)
+    {
+        double scale = 0.0;
+        foreach (SceneNode *node, m_data)
+            if (isIndexable(node->point()))
+                scale = qMax(scale, qMax(fabs(node->point().x), fabs(node->point().y)));
+
+        rebuildIndex(scale);
+    }
+}
+
+void SceneNodeContainer::rebuildIndex(double scale)
+{
+    // the same points have distance at most max(POINT_ABS_ZERO, POINT_REL_ZERO * scale) in each coordinate,
+    // they lie in the same or in the neighbouring cells
+    m_indexScale = scale;
+    m_indexCell = qMax(POINT_ABS_ZERO, POINT_REL_ZERO * scale);
+
+    m_index.clear();
+    foreach (SceneNode *node, m_data)
+        if (isIndexable(node->point()))
+            m_index.insert(indexKey(node->point()), node);
+}
+
+bool SceneNodeContainer::isIndexable(const Point &point) const
+{
+    return qIsFinite(point.x) && qIsFinite(point.y);
+}
+
+QPair<qint64, qint64> SceneNodeContainer::indexKey(const Point &point) const
+{
+    return qMakePair((qint64) floor(point.x / m_indexCell), (qint64) floor(point.y / m_indexCell));
+}
+
+QList<SceneNode *> SceneNodeContainer::candidates(const Point &point) const
+{
+    // linear search (no index or point outside of the indexed range)
+    if (!m_isIndexed || !isIndexable(point) || (qMax(fabs(point.x), fabs(point.y)) > m_indexScale))
+        return m_data;
+
+    QPair<qint64, qint64> key = indexKey(point);
+
+    QList<SceneNode *> list;
+    for (qint64 i = key.first - 1; i <= key.first + 1; i++)
+        for (qint64 j = key.second - 1; j <= key.second + 1; j++)
+            list.append(m_index.values(qMakePair(i, j)));
+
+    return list;
+}
+
 RectPoint SceneNodeContainer::boundingBox() const
 {
     Point min( numeric_limits<double>::max(),  numeric_limits<double>::max());
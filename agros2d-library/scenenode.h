@@ -33,8 +33,13 @@ public:
     SceneNode(const Point &point);
     SceneNode(const PointValue &pointValue);
 
+    // nodes are allocated in pool
+    static void *operator new(size_t size);
+    static void operator delete(void *item, size_t size);
+
     inline Point point() const { return m_point.point(); }
     inline PointValue pointValue() const { return m_point; }
+    inline PointValue &pointValueRef() { return m_point; }
     void setPointValue(const PointValue &point);
 
     // geometry editor
@@ -63,6 +68,8 @@ Q_DECLARE_METATYPE(SceneNode *)
 class SceneNodeContainer : public SceneBasicContainer<SceneNode>
 {
 public:
+    SceneNodeContainer() : m_isIndexed(false), m_indexScale(0.0), m_indexCell(0.0) {}
+
     /// if container contains object with the same coordinates as node, returns it. Otherwise returns NULL
     SceneNode* get(SceneNode* node) const;
 
@@ -71,14 +78,31 @@ public:
 
     SceneNode* findClosest(const Point& point) const;
 
+    virtual bool add(SceneNode *item);
     virtual bool remove(SceneNode *item);
 
+    /// hashed lookup of nodes (bulk insert), nodes must not be moved while the index is used
+    void setIndexed(bool indexed);
+    inline bool isIndexed() const { return m_isIndexed; }
+
     /// returns bounding box, assumes container not empty
     RectPoint boundingBox() const;
 
     //TODO should be in SceneBasicContainer, but I would have to cast the result....
     SceneNodeContainer selected();
     SceneNodeContainer highlighted();
+
+private:
+    // uniform grid, cell size is not smaller than the tolerance of Point::operator== for all points within scale
+    bool m_isIndexed;
+    double m_indexScale;
+    double m_indexCell;
+    QMultiHash<QPair<qint64, qint64>, SceneNode *> m_index;
+
+    void rebuildIndex(double scale);
+    bool isIndexable(const Point &point) const;
+    QPair<qint64, qint64> indexKey(const Point &point) const;
+    QList<SceneNode *> candidates(const Point &point) const;
 };
 
 
@@ -102,6 +102,7 @@ void Config::setStringKeys()
     m_settingKey[Config_LinearSystemSave] = "Config_LinearSystemSave";
     m_settingKey[Config_CacheSize] = "Config_CacheSize";
     m_settingKey[Config_NumberOfThreads] = "Config_NumberOfThreads";
+    m_settingKey[Config_MeshCache] = "Config_MeshCache";
     m_settingKey[Config_ShowGrid] = "Config_ShowGrid";
     m_settingKey[Config_ShowRulers] = "Config_ShowRulers";
     m_settingKey[Config_ShowAxes] = "Config_ShowAxes";
@@ -123,6 +124,7 @@ void Config::setDefaultValues()
     m_settingDefault[Config_LinearSystemSave] = false;
     m_settingDefault[Config_CacheSize] = 10;
     m_settingDefault[Config_NumberOfThreads] = omp_get_max_threads();
+    m_settingDefault[Config_MeshCache] = true;
     m_settingDefault[Config_ShowGrid] = true;
     m_settingDefault[Config_ShowRulers] = true;
     m_settingDefault[Config_ShowAxes] = true;
@@ -66,6 +66,14 @@ const bool USER_SOLVER_CACHE = false;
 
 const int NOT_FOUND_SO_FAR = -999;
 
+// number of elements summed in one chunk of the error reduction (independent of the number of threads)
+const int ERROR_REDUCTION_CHUNK_SIZE = 1024;
+
+// log (maximum number of lines kept in view, refresh interval in ms, maximum number of queued messages)
+const int LOG_MAXIMUM_BLOCK_COUNT = 500;
+const int LOG_REFRESH_INTERVAL = 40;
+const int LOG_MAXIMUM_QUEUE_COUNT = 10000;
+
 const int GLYPH_M = 77;
 
 const double COLORBACKGROUND[3] = { 255 / 255.0, 255 / 255.0, 255 / 255.0 };
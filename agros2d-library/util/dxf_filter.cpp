@@ -30,7 +30,8 @@
 #include "sceneedge.h"
 #include "scenelabel.h"
 
-DxfInterfaceDXFRW::DxfInterfaceDXFRW(Scene *scene, const QString &fileName) : m_isBlock(false)
+DxfInterfaceDXFRW::DxfInterfaceDXFRW(Scene *scene, const QString &fileName, double snapTolerance)
+    : m_isBlock(false), m_entities(0), m_snapTolerance(snapTolerance)
 {
     this->m_scene = scene;
     m_dxf = new dxfRW(fileName.toStdString().c_str());
@@ -39,8 +40,42 @@ DxfInterfaceDXFRW::DxfInterfaceDXFRW(Scene *scene, const QString &fileName) : m_
 void DxfInterfaceDXFRW::read()
 {
     m_isBlock = false;
+    m_entities = 0;
+    m_points.clear();
+    m_edges.clear();
 
+    QTime time;
+
+    // parse entities
+    time.start();
     m_dxf->read(this, true);
+    Agros2D::log()->printMessage(QObject::tr("DXF"), QObject::tr("Parsing: %1 entities, %2 edges (%3 ms)").
+                                 arg(m_entities).arg(m_edges.size()).arg(time.elapsed()));
+
+    // snap near-coincident endpoints
+    time.start();
+    int points = m_points.size();
+    int vertices = snapPoints();
+    Agros2D::log()->printMessage(QObject::tr("DXF"), QObject::tr("Snapping: %1 endpoints merged to %2 nodes (%3 ms)").
+                                 arg(points).arg(vertices).arg(time.elapsed()));
+
+    // heal geometry
+    time.start();
+    int degenerate = removeDegenerateEdges();
+    int merged = mergeCollinearEdges();
+    // merged chains can duplicate existing edges
+    degenerate += removeDegenerateEdges();
+    Agros2D::log()->printMessage(QObject::tr("DXF"), QObject::tr("Healing: %1 zero-length or duplicate edges removed, %2 collinear edges merged (%3 ms)").
+                                 arg(degenerate).arg(merged).arg(time.elapsed()));
+
+    // build scene
+    time.start();
+    createScene();
+    Agros2D::log()->printMessage(QObject::tr("DXF"), QObject::tr("Geometry: %1 edges (%2 ms)").
+                                 arg(m_edges.size()).arg(time.elapsed()));
+
+    m_points.clear();
+    m_edges.clear();
 }
 
 void DxfInterfaceDXFRW::write()
@@ -48,17 +83,215 @@ void DxfInterfaceDXFRW::write()
     m_dxf->write(this, DRW::AC1015, false);
 }
 
+void DxfInterfaceDXFRW::addPrimitive(const Point &start, const Point &end, double angle)
+{
+    m_edges.append(DxfEdge(m_points.size(), m_points.size() + 1, angle));
+    m_points.append(start);
+    m_points.append(end);
+}
+
+void DxfInterfaceDXFRW::addBulgePrimitive(const Point &start, const Point &end, double bulge)
+{
+    if (fabs(bulge) < EPS_ZERO)
+    {
+        addPrimitive(start, end, 0.0);
+        return;
+    }
+
+    // bulge is tangent of quarter of included angle, positive bulge is counterclockwise
+    double angle = 4.0 * atan(fabs(bulge)) / M_PI * 180.0;
+    if (bulge > 0.0)
+        addPrimitive(start, end, angle);
+    else
+        addPrimitive(end, start, angle);
+}
+
+int DxfInterfaceDXFRW::snapPoints()
+{
+    if (m_points.isEmpty())
+        return 0;
+
+    Point min( numeric_limits<double>::max(),  numeric_limits<double>::max());
+    Point max(-numeric_limits<double>::max(), -numeric_limits<double>::max());
+    foreach (Point point, m_points)
+    {
+        min.x = qMin(min.x, point.x);
+        max.x = qMax(max.x, point.x);
+        min.y = qMin(min.y, point.y);
+        max.y = qMax(max.y, point.y);
+    }
+
+    double tolerance = qMax(m_snapTolerance * (max - min).magnitude(), EPS_ZERO);
+
+    // spatial hash, cell size is equal to tolerance (neighbouring cells are checked)
+    QMultiHash<QPair<qint64, qint64>, int> grid;
+    QVector<Point> vertices;
+    QVector<int> vertexIndex(m_points.size());
+
+    for (int i = 0; i < m_points.size(); i++)
+    {
+        const Point &point = m_points.at(i);
+        qint64 cellX = (qint64) floor((point.x - min.x) / tolerance);
+        qint64 cellY = (qint64) floor((point.y - min.y) / tolerance);
+
+        int found = -1;
+        for (qint64 x = cellX - 1; (x <= cellX + 1) && (found == -1); x++)
+        {
+            for (qint64 y = cellY - 1; (y <= cellY + 1) && (found == -1); y++)
+            {
+                foreach (int vertex, grid.values(qMakePair(x, y)))
+                {
+                    if ((vertices.at(vertex) - point).magnitude() <= tolerance)
+                    {
+                        found = vertex;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (found == -1)
+        {
+            found = vertices.size();
+            vertices.append(point);
+            grid.insert(qMakePair(cellX, cellY), found);
+        }
+
+        vertexIndex[i] = found;
+    }
+
+    for (int i = 0; i < m_edges.size(); i++)
+    {
+        m_edges[i].start = vertexIndex.at(m_edges.at(i).start);
+        m_edges[i].end = vertexIndex.at(m_edges.at(i).end);
+    }
+
+    m_points = vertices;
+
+    return m_points.size();
+}
+
+int DxfInterfaceDXFRW::removeDegenerateEdges()
+{
+    QVector<DxfEdge> edges;
+    edges.reserve(m_edges.size());
+
+    // edges keyed by (ordered) pair of nodes
+    QHash<QPair<int, int>, QList<int> > edgesByNodes;
+
+    foreach (DxfEdge edge, m_edges)
+    {
+        // zero length
+        if (edge.start == edge.end)
+            continue;
+
+        // direction of straight edge is arbitrary
+        if ((fabs(edge.angle) < EPS_ZERO) && (edge.start > edge.end))
+            qSwap(edge.start, edge.end);
+
+        QPair<int, int> key(edge.start, edge.end);
+
+        bool isDuplicate = false;
+        foreach (int index, edgesByNodes.value(key))
+        {
+            if (fabs(edges.at(index).angle - edge.angle) < EPS_ZERO)
+            {
+                isDuplicate = true;
+                break;
+            }
+        }
+
+        if (!isDuplicate)
+        {
+            edgesByNodes[key].append(edges.size());
+            edges.append(edge);
+        }
+    }
+
+    int removed = m_edges.size() - edges.size();
+    m_edges = edges;
+
+    return removed;
+}
+
+int DxfInterfaceDXFRW::mergeCollinearEdges()
+{
+    // maximal sine of angle between collinear edges
+    const double collinearTolerance = 1e-6;
+
+    QVector<QList<int> > incidentEdges(m_points.size());
+    for (int i = 0; i < m_edges.size(); i++)
+    {
+        incidentEdges[m_edges.at(i).start].append(i);
+        incidentEdges[m_edges.at(i).end].append(i);
+    }
+
+    QVector<bool> isRemoved(m_edges.size(), false);
+    int merged = 0;
+
+    for (int vertex = 0; vertex < m_points.size(); vertex++)
+    {
+        // inner node of chain of two straight edges
+        if (incidentEdges.at(vertex).size() != 2)
+            continue;
+
+        int first = incidentEdges.at(vertex).at(0);
+        int second = incidentEdges.at(vertex).at(1);
+        if ((fabs(m_edges.at(first).angle) > EPS_ZERO) || (fabs(m_edges.at(second).angle) > EPS_ZERO))
+            continue;
+
+        int start = (m_edges.at(first).start == vertex) ? m_edges.at(first).end : m_edges.at(first).start;
+        int end = (m_edges.at(second).start == vertex) ? m_edges.at(second).end : m_edges.at(second).start;
+        if (start == end)
+            continue;
+
+        Point directionFirst = m_points.at(vertex) - m_points.at(start);
+        Point directionSecond = m_points.at(end) - m_points.at(vertex);
+        if ((fabs(directionFirst % directionSecond) > collinearTolerance * directionFirst.magnitude() * directionSecond.magnitude())
+                || ((directionFirst & directionSecond) <= 0.0))
+            continue;
+
+        // first edge spans the whole chain
+        m_edges[first] = DxfEdge(start, end, 0.0);
+        isRemoved[second] = true;
+        incidentEdges[end][incidentEdges.at(end).indexOf(second)] = first;
+        incidentEdges[vertex].clear();
+
+        merged++;
+    }
+
+    QVector<DxfEdge> edges;
+    edges.reserve(m_edges.size() - merged);
+    for (int i = 0; i < m_edges.size(); i++)
+        if (!isRemoved.at(i))
+            edges.append(m_edges.at(i));
+
+    m_edges = edges;
+
+    return merged;
+}
+
+void DxfInterfaceDXFRW::createScene()
+{
+    QVector<SceneNode *> nodes(m_points.size(), NULL);
+
+    foreach (DxfEdge edge, m_edges)
+    {
+        if (!nodes.at(edge.start))
+            nodes[edge.start] = m_scene->addNode(new SceneNode(m_points.at(edge.start)));
+        if (!nodes.at(edge.end))
+            nodes[edge.end] = m_scene->addNode(new SceneNode(m_points.at(edge.end)));
+
+        m_scene->addEdge(new SceneEdge(nodes.at(edge.start), nodes.at(edge.end), edge.angle));
+    }
+}
+
 void DxfInterfaceDXFRW::addLine(const DRW_Line &l)
 {
     if (!m_isBlock)
     {
-        // start node
-        SceneNode *nodeStart = m_scene->addNode(new SceneNode(Point(l.basePoint.x, l.basePoint.y)));
-        // end node
-        SceneNode *nodeEnd = m_scene->addNode(new SceneNode(Point(l.secPoint.x, l.secPoint.y)));
-
-        // edge
-        m_scene->addEdge(new SceneEdge(nodeStart, nodeEnd, 0));
+        m_entities++;
+        addPrimitive(Point(l.basePoint.x, l.basePoint.y), Point(l.secPoint.x, l.secPoint.y), 0.0);
     }
     else
     {
@@ -70,6 +303,8 @@ void DxfInterfaceDXFRW::addArc(const DRW_Arc& a)
 {
     if (!m_isBlock)
     {
+        m_entities++;
+
         double angle1 = a.staangle / M_PI * 180.0;
         double angle2 = a.endangle / M_PI * 180.0;
 
@@ -78,14 +313,11 @@ void DxfInterfaceDXFRW::addArc(const DRW_Arc& a)
         while (angle2 < 0.0) angle2 += 360.0;
         while (angle2 >= 360.0) angle2 -= 360.0;
 
-        // start node
-        SceneNode *nodeStart = m_scene->addNode(new SceneNode(Point(a.basePoint.x + a.radious*cos(angle1/180.0*M_PI),
-                                                                    a.basePoint.y + a.radious*sin(angle1/180.0*M_PI))));
-        // end node
-        SceneNode *nodeEnd = m_scene->addNode(new SceneNode(Point(a.basePoint.x + a.radious*cos(angle2/180.0*M_PI),
-                                                                  a.basePoint.y + a.radious*sin(angle2/180.0*M_PI))));
-        // edge
-        m_scene->addEdge(new SceneEdge(nodeStart, nodeEnd, (angle1 < angle2) ? angle2-angle1 : angle2+360.0-angle1));
+        addPrimitive(Point(a.basePoint.x + a.radious*cos(angle1/180.0*M_PI),
+                           a.basePoint.y + a.radious*sin(angle1/180.0*M_PI)),
+                     Point(a.basePoint.x + a.radious*cos(angle2/180.0*M_PI),
+                           a.basePoint.y + a.radious*sin(angle2/180.0*M_PI)),
+                     (angle1 < angle2) ? angle2-angle1 : angle2+360.0-angle1);
     }
     else
     {
@@ -97,75 +329,70 @@ void DxfInterfaceDXFRW::addCircle(const DRW_Circle &c)
 {
     if (!m_isBlock)
     {
-        // nodes
-        SceneNode *node1 = m_scene->addNode(new SceneNode(Point(c.basePoint.x + c.radious, c.basePoint.y)));
-        SceneNode *node2 = m_scene->addNode(new SceneNode(Point(c.basePoint.x, c.basePoint.y + c.radious)));
-        SceneNode *node3 = m_scene->addNode(new SceneNode(Point(c.basePoint.x - c.radious, c.basePoint.y)));
-        SceneNode *node4 = m_scene->addNode(new SceneNode(Point(c.basePoint.x, c.basePoint.y - c.radious)));
-
-        // edges
-        m_scene->addEdge(new SceneEdge(node1, node2, 90));
-        m_scene->addEdge(new SceneEdge(node2, node3, 90));
-        m_scene->addEdge(new SceneEdge(node3, node4, 90));
-        m_scene->addEdge(new SceneEdge(node4, node1, 90));
+        m_entities++;
+
+        Point point1(c.basePoint.x + c.radious, c.basePoint.y);
+        Point point2(c.basePoint.x, c.basePoint.y + c.radious);
+        Point point3(c.basePoint.x - c.radious, c.basePoint.y);
+        Point point4(c.basePoint.x, c.basePoint.y - c.radious);
+
+        addPrimitive(point1, point2, 90);
+        addPrimitive(point2, point3, 90);
+        addPrimitive(point3, point4, 90);
+        addPrimitive(point4, point1, 90);
     }
 }
 
 void DxfInterfaceDXFRW::addPolyline(const DRW_Polyline& data)
 {
-    for (int i = 0; i < data.vertlist.size() - 1; i++)
+    m_entities++;
+
+    // closed polyline (flag 1) connects the last vertex with the first one
+    int count = data.vertlist.size();
+    int segments = (data.flags & 1) ? count : count - 1;
+
+    for (int i = 0; i < segments; i++)
     {
         DRW_Vertex *vertStart = data.vertlist.at(i);
-        DRW_Vertex *vertEnd = data.vertlist.at(i+1);
-
-        SceneNode *nodeStart = m_scene->addNode(new SceneNode(Point(vertStart->basePoint.x, vertStart->basePoint.y)));
-        SceneNode *nodeEnd = m_scene->addNode(new SceneNode(Point(vertEnd->basePoint.x, vertEnd->basePoint.y)));
+        DRW_Vertex *vertEnd = data.vertlist.at((i + 1) % count);
 
-        m_scene->addEdge(new SceneEdge(nodeStart, nodeEnd, 0.0));
+        addBulgePrimitive(Point(vertStart->basePoint.x, vertStart->basePoint.y),
+                          Point(vertEnd->basePoint.x, vertEnd->basePoint.y), vertStart->bulge);
     }
 }
 
 void DxfInterfaceDXFRW::addLWPolyline(const DRW_LWPolyline& data)
 {
-    for (int i = 0; i < data.vertlist.size() - 1; i++)
+    m_entities++;
+
+    // closed polyline (flag 1) connects the last vertex with the first one
+    int count = data.vertlist.size();
+    int segments = (data.flags & 1) ? count : count - 1;
+
+    for (int i = 0; i < segments; i++)
     {
         DRW_Vertex2D *vertStart = data.vertlist.at(i);
-        DRW_Vertex2D *vertEnd = data.vertlist.at(i+1);
+        DRW_Vertex2D *vertEnd = data.vertlist.at((i + 1) % count);
 
-        SceneNode *nodeStart = m_scene->addNode(new SceneNode(Point(vertStart->x, vertStart->y)));
-        SceneNode *nodeEnd = m_scene->addNode(new SceneNode(Point(vertEnd->x, vertEnd->y)));
-
-        m_scene->addEdge(new SceneEdge(nodeStart, nodeEnd, 0.0));
+        addBulgePrimitive(Point(vertStart->x, vertStart->y), Point(vertEnd->x, vertEnd->y), vertStart->bulge);
     }
 }
 
 void DxfInterfaceDXFRW::addSpline(const DRW_Spline *data)
 {
-    // 1st order
-    if (data->degree == 1)
-    {
-        // first and last point
-        DRW_Coord *vertStart = data->controllist.at(0);
-        DRW_Coord *vertEnd = data->controllist.at(data->controllist.size() - 1);
+    if ((data->degree < 1) || data->controllist.empty())
+        return;
 
-        SceneNode *nodeStart = m_scene->addNode(new SceneNode(Point(vertStart->x, vertStart->y)));
-        SceneNode *nodeEnd = m_scene->addNode(new SceneNode(Point(vertEnd->x, vertEnd->y)));
+    m_entities++;
 
-        m_scene->addEdge(new SceneEdge(nodeStart, nodeEnd, 0.0));
-    }
-    else if (data->degree > 1)
-    {
+    if (data->degree > 1)
         qDebug() << "spline > 1nd order - not implemented";
 
-        // first and last point
-        DRW_Coord *vertStart = data->controllist.at(0);
-        DRW_Coord *vertEnd = data->controllist.at(data->controllist.size() - 1);
-
-        SceneNode *nodeStart = m_scene->addNode(new SceneNode(Point(vertStart->x, vertStart->y)));
-        SceneNode *nodeEnd = m_scene->addNode(new SceneNode(Point(vertEnd->x, vertEnd->y)));
+    // first and last point
+    DRW_Coord *vertStart = data->controllist.at(0);
+    DRW_Coord *vertEnd = data->controllist.at(data->controllist.size() - 1);
 
-        m_scene->addEdge(new SceneEdge(nodeStart, nodeEnd, 0.0));
-    }
+    addPrimitive(Point(vertStart->x, vertStart->y), Point(vertEnd->x, vertEnd->y), 0.0);
 }
 
 void DxfInterfaceDXFRW::addBlock(const DRW_Block& data)
@@ -311,10 +538,24 @@ void readFromDXF(const QString &fileName)
 
     Agros2D::scene()->blockSignals(true);
     Agros2D::scene()->stopInvalidating(true);
+    Agros2D::scene()->beginTransaction();
 
-    DxfInterfaceDXFRW filter(Agros2D::scene(), fileName);
-    filter.read();
+    try
+    {
+        DxfInterfaceDXFRW filter(Agros2D::scene(), fileName);
+        filter.read();
+    }
+    catch (...)
+    {
+        // partially imported geometry is removed, scene is updated again
+        Agros2D::scene()->rollbackTransaction();
+        Agros2D::scene()->stopInvalidating(false);
+        Agros2D::scene()->blockSignals(false);
+        Agros2D::scene()->invalidate();
+        throw;
+    }
 
+    Agros2D::scene()->commitTransaction();
     Agros2D::scene()->stopInvalidating(false);
     Agros2D::scene()->blockSignals(false);
     Agros2D::scene()->invalidate();
@@ -29,7 +29,8 @@ class Scene;
 class DxfInterfaceDXFRW : public DRW_Interface
 {
 public:
-    DxfInterfaceDXFRW(Scene *scene, const QString &fileName);
+    // snapTolerance - endpoints closer than snapTolerance * diagonal of bounding box are merged
+    DxfInterfaceDXFRW(Scene *scene, const QString &fileName, double snapTolerance = 1e-6);
 
     void read();
     void write();
@@ -92,6 +93,30 @@ private:
     Scene *m_scene;
     dxfRW *m_dxf;
 
+    // primitives collected by parser (edge connects two indices of m_points)
+    struct DxfEdge
+    {
+        DxfEdge(int start = -1, int end = -1, double angle = 0.0) : start(start), end(end), angle(angle) {}
+
+        int start;
+        int end;
+        double angle;
+    };
+
+    QVector<Point> m_points;
+    QVector<DxfEdge> m_edges;
+    int m_entities;
+    double m_snapTolerance;
+
+    void addPrimitive(const Point &start, const Point &end, double angle);
+    void addBulgePrimitive(const Point &start, const Point &end, double bulge);
+
+    // geometry healing, return number of points or removed edges
+    int snapPoints();
+    int removeDegenerateEdges();
+    int mergeCollinearEdges();
+    void createScene();
+
     struct DXFInsert
     {
         QString blockName;
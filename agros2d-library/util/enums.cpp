@@ -35,6 +35,7 @@ static QMap<AdaptivityType, QString> adaptivityTypeList;
 static QMap<AdaptivityStoppingCriterionType, QString> adaptivityStoppingCriterionTypeList;
 static QMap<Hermes::Hermes2D::NormType, QString> adaptivityNormTypeList;
 static QMap<TimeStepMethod, QString> timeStepMethodList;
+static QMap<TimeErrorEstimator, QString> timeErrorEstimatorList;
 static QMap<SolutionMode, QString> solutionTypeList;
 static QMap<AnalysisType, QString> analysisTypeList;
 static QMap<CouplingType, QString> couplingTypeList;
@@ -53,6 +54,7 @@ static QMap<SpecialFunctionType, QString> specialFunctionTypeList;
 static QMap<Hermes::ButcherTableType, QString> butcherTableTypeList;
 static QMap<Hermes::Solvers::IterSolverType, QString> iterLinearSolverMethodList;
 static QMap<Hermes::Solvers::PreconditionerType, QString> iterLinearSolverPreconditionerTypeList;
+static QMap<AdaptivityReferenceRetention, QString> adaptivityReferenceRetentionList;
 
 QStringList coordinateTypeStringKeys() { return coordinateTypeList.values(); }
 QString coordinateTypeToStringKey(CoordinateType coordinateType) { return coordinateTypeList[coordinateType]; }
@@ -98,6 +100,10 @@ QStringList timeStepMethodStringKeys() { return timeStepMethodList.values(); }
 QString timeStepMethodToStringKey(TimeStepMethod timeStepMethod) { return timeStepMethodList[timeStepMethod]; }
 TimeStepMethod timeStepMethodFromStringKey(const QString &timeStepMethod) { return timeStepMethodList.key(timeStepMethod); }
 
+QStringList timeErrorEstimatorStringKeys() { return timeErrorEstimatorList.values(); }
+QString timeErrorEstimatorToStringKey(TimeErrorEstimator timeErrorEstimator) { return timeErrorEstimatorList[timeErrorEstimator]; }
+TimeErrorEstimator timeErrorEstimatorFromStringKey(const QString &timeErrorEstimator) { return timeErrorEstimatorList.key(timeErrorEstimator); }
+
 QStringList solutionTypeStringKeys() { return solutionTypeList.values(); }
 QString solutionTypeToStringKey(SolutionMode solutionType) { return solutionTypeList[solutionType]; }
 SolutionMode solutionTypeFromStringKey(const QString &solutionType) { return solutionTypeList.key(solutionType); }
@@ -162,6 +168,10 @@ QStringList iterLinearSolverPreconditionerTypeStringKeys() { return iterLinearSo
 QString iterLinearSolverPreconditionerTypeToStringKey(Hermes::Solvers::PreconditionerType type) { return iterLinearSolverPreconditionerTypeList[type]; }
 Hermes::Solvers::PreconditionerType iterLinearSolverPreconditionerTypeFromStringKey(const QString &type) { return iterLinearSolverPreconditionerTypeList.key(type); }
 
+QStringList adaptivityReferenceRetentionStringKeys() { return adaptivityReferenceRetentionList.values(); }
+QString adaptivityReferenceRetentionToStringKey(AdaptivityReferenceRetention retention) { return adaptivityReferenceRetentionList[retention]; }
+AdaptivityReferenceRetention adaptivityReferenceRetentionFromStringKey(const QString &retention) { return adaptivityReferenceRetentionList.key(retention); }
+
 void initLists()
 {
     // coordinate list
@@ -194,6 +204,7 @@ void initLists()
     meshTypeList.insert(MeshType_Triangle_QuadFineDivision, "triangle_quad_fine_division");
     meshTypeList.insert(MeshType_Triangle_QuadRoughDivision, "triangle_quad_rough_division");
     meshTypeList.insert(MeshType_Triangle_QuadJoin, "triangle_quad_join");
+    meshTypeList.insert(MeshType_Triangle_Parallel, "triangle_parallel");
     meshTypeList.insert(MeshType_GMSH_Triangle, "gmsh_triangle");
     meshTypeList.insert(MeshType_GMSH_Quad, "gmsh_quad");
     meshTypeList.insert(MeshType_GMSH_QuadDelaunay_Experimental, "gmsh_quad_delaunay");
@@ -206,6 +217,9 @@ void initLists()
     //    timeStepMethodList.insert(TimeStepMethod_FixedBDF2B, "fixed_bdf2b");
     //    timeStepMethodList.insert(TimeStepMethod_FixedCombine, "fixed_combine");
 
+    timeErrorEstimatorList.insert(TimeErrorEstimator_LowerOrder, "lower_order");
+    timeErrorEstimatorList.insert(TimeErrorEstimator_Embedded, "embedded");
+
     // PHYSICFIELDVARIABLECOMP
     physicFieldVariableCompList.insert(PhysicFieldVariableComp_Scalar, "scalar");
     physicFieldVariableCompList.insert(PhysicFieldVariableComp_Magnitude, "magnitude");
@@ -353,6 +367,11 @@ void initLists()
     // iterLinearSolverPreconditionerTypeList.insert(Hermes::Solvers::AIChebyshev, "aichebyshev");
     iterLinearSolverPreconditionerTypeList.insert(Hermes::Solvers::IC, "ic");
     iterLinearSolverPreconditionerTypeList.insert(Hermes::Solvers::MultiElimination, "multielimination");
+
+    // Adaptivity
+    adaptivityReferenceRetentionList.insert(AdaptivityReferenceRetention_None, "none");
+    adaptivityReferenceRetentionList.insert(AdaptivityReferenceRetention_Last, "last");
+    adaptivityReferenceRetentionList.insert(AdaptivityReferenceRetention_All, "all");
 }
 
 QString errorNormString(Hermes::Hermes2D::NormType projNormType)
@@ -497,6 +516,20 @@ QString timeStepMethodString(TimeStepMethod timeStepMethod)
     }
 }
 
+QString timeErrorEstimatorString(TimeErrorEstimator timeErrorEstimator)
+{
+    switch (timeErrorEstimator)
+    {
+    case TimeErrorEstimator_LowerOrder:
+        return QObject::tr("Lower order solution");
+    case TimeErrorEstimator_Embedded:
+        return QObject::tr("Embedded (predictor)");
+    default:
+        std::cerr << "Time error estimator '" + QString::number(timeErrorEstimator).toStdString() + "' is not implemented. timeErrorEstimatorString(TimeErrorEstimator timeErrorEstimator)" << endl;
+        throw;
+    }
+}
+
 QString weakFormString(WeakFormKind weakForm)
 {
     switch (weakForm)
@@ -543,6 +576,8 @@ QString meshTypeString(MeshType meshType)
         return QObject::tr("Triangle - quad rough div.");
     case MeshType_Triangle_QuadJoin:
         return QObject::tr("Triangle - quad join");
+    case MeshType_Triangle_Parallel:
+        return QObject::tr("Triangle - parallel subdomains");
     case MeshType_GMSH_Triangle:
         return QObject::tr("GMSH (exp.) - triangle");
     case MeshType_GMSH_Quad:
@@ -801,3 +836,19 @@ QString iterLinearSolverPreconditionerTypeString(PreconditionerType type)
         throw;
     }
 }
+
+QString adaptivityReferenceRetentionString(AdaptivityReferenceRetention retention)
+{
+    switch (retention)
+    {
+    case AdaptivityReferenceRetention_None:
+        return QObject::tr("None");
+    case AdaptivityReferenceRetention_Last:
+        return QObject::tr("Last step");
+    case AdaptivityReferenceRetention_All:
+        return QObject::tr("All steps");
+    default:
+        std::cerr << "Reference solution retention '" + QString::number(retention).toStdString() + "' is not implemented. adaptivityReferenceRetentionString(AdaptivityReferenceRetention retention)" << endl;
+        throw;
+    }
+}
@@ -66,6 +66,13 @@ enum TimeStepMethod
     TimeStepMethod_BDFNumSteps = 2
 };
 
+enum TimeErrorEstimator
+{
+    TimeErrorEstimator_Undefined = -1,
+    TimeErrorEstimator_LowerOrder = 0,
+    TimeErrorEstimator_Embedded = 1
+};
+
 enum LinearityType
 {
     LinearityType_Undefined = -1,
@@ -82,6 +89,14 @@ enum DampingType
     DampingType_Off = 2
 };
 
+enum AdaptivityReferenceRetention
+{
+    AdaptivityReferenceRetention_Undefined = -1,
+    AdaptivityReferenceRetention_None = 0,
+    AdaptivityReferenceRetention_Last = 1,
+    AdaptivityReferenceRetention_All = 2
+};
+
 enum CouplingType
 {
     CouplingType_Undefined = -1,
@@ -99,7 +114,8 @@ enum MeshType
     MeshType_Triangle_QuadJoin = 3,
     MeshType_GMSH_Triangle = 4,
     MeshType_GMSH_Quad = 5,
-    MeshType_GMSH_QuadDelaunay_Experimental = 6
+    MeshType_GMSH_QuadDelaunay_Experimental = 6,
+    MeshType_Triangle_Parallel = 7
 };
 
 enum PhysicFieldVariableComp
@@ -317,6 +333,12 @@ AGROS_LIBRARY_API QStringList timeStepMethodStringKeys();
 AGROS_LIBRARY_API QString timeStepMethodToStringKey(TimeStepMethod timeStepMethod);
 AGROS_LIBRARY_API TimeStepMethod timeStepMethodFromStringKey(const QString &timeStepMethod);
 
+// time error estimator
+AGROS_LIBRARY_API QString timeErrorEstimatorString(TimeErrorEstimator timeErrorEstimator);
+AGROS_LIBRARY_API QStringList timeErrorEstimatorStringKeys();
+AGROS_LIBRARY_API QString timeErrorEstimatorToStringKey(TimeErrorEstimator timeErrorEstimator);
+AGROS_LIBRARY_API TimeErrorEstimator timeErrorEstimatorFromStringKey(const QString &timeErrorEstimator);
+
 // solution mode
 AGROS_LIBRARY_API QString solutionTypeString(SolutionMode solutionMode);
 AGROS_LIBRARY_API QStringList solutionTypeStringKeys();
@@ -411,4 +433,10 @@ AGROS_LIBRARY_API QStringList iterLinearSolverPreconditionerTypeStringKeys();
 AGROS_LIBRARY_API QString iterLinearSolverPreconditionerTypeToStringKey(Hermes::Solvers::PreconditionerType type);
 AGROS_LIBRARY_API Hermes::Solvers::PreconditionerType iterLinearSolverPreconditionerTypeFromStringKey(const QString &type);
 
+// adaptivity - retention of reference solutions
+AGROS_LIBRARY_API QString adaptivityReferenceRetentionString(AdaptivityReferenceRetention retention);
+AGROS_LIBRARY_API QStringList adaptivityReferenceRetentionStringKeys();
+AGROS_LIBRARY_API QString adaptivityReferenceRetentionToStringKey(AdaptivityReferenceRetention retention);
+AGROS_LIBRARY_API AdaptivityReferenceRetention adaptivityReferenceRetentionFromStringKey(const QString &retention);
+
 #endif // UTIL_ENUMS_H
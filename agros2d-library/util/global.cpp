@@ -24,6 +24,7 @@
 #include "util.h"
 #include "logview.h"
 #include "memory_monitor.h"
+#include "profiler.h"
 #include "scene.h"
 
 #include "pythonlab/pythonengine_agros.h"
@@ -152,6 +153,9 @@ Agros2D::Agros2D()
 
     // memory monitor
     m_memoryMonitor = new MemoryMonitor();
+
+    // profiler
+    m_profiler = new Profiler();
 }
 
 void Agros2D::clear()
@@ -162,6 +166,7 @@ void Agros2D::clear()
     delete m_singleton.data()->m_solutionStore;
     delete m_singleton.data()->m_log;
     delete m_singleton.data()->m_memoryMonitor;
+    delete m_singleton.data()->m_profiler;
 
     // remove temp and cache plugins
     removeDirectory(cacheProblemDir());
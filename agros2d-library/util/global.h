@@ -31,6 +31,7 @@ class Scene;
 class PluginInterface;
 class ScriptEngineRemote;
 class MemoryMonitor;
+class Profiler;
 
 class AGROS_LIBRARY_API AgrosApplication : public QApplication
 {
@@ -61,6 +62,7 @@ public:
     static inline SolutionStore *solutionStore() { return Agros2D::singleton()->m_solutionStore; }
     static inline Log *log() { return Agros2D::singleton()->m_log; }
     static inline MemoryMonitor *memoryMonitor() { return Agros2D::singleton()->m_memoryMonitor; }
+    static inline Profiler *profiler() { return Agros2D::singleton()->m_profiler; }
 
     static PluginInterface *loadPlugin(const QString &pluginName);
 
@@ -73,6 +75,7 @@ private:
     SolutionStore *m_solutionStore;
     Log *m_log;
     MemoryMonitor *m_memoryMonitor;
+    Profiler *m_profiler;
 };
 
 #endif /* GLOBAL_H */
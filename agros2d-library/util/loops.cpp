@@ -32,6 +32,8 @@
 
 #include "scene.h"
 
+#include <algorithm>
+
 const static int LOOPS_NON_EXISTING = -100000;
 const static double TOL = 0.001;
 
@@ -45,22 +47,20 @@ LoopsInfo::LoopsNodeEdgeData::LoopsNodeEdgeData() : node(LOOPS_NON_EXISTING)
 
 bool LoopsInfo::LoopsNode::hasUnvisited()
 {
-    foreach(LoopsNodeEdgeData ned, nodeEdges)
-        if(!ned.visited)
-            return true;
+    // edges are never unvisited again, the scan can continue where it stopped
+    while ((firstUnvisited < nodeEdges.size()) && nodeEdges.at(firstUnvisited).visited)
+        firstUnvisited++;
 
-    return false;
+    return (firstUnvisited < nodeEdges.size());
 }
 
 LoopsInfo::LoopsNodeEdgeData LoopsInfo::LoopsNode::startLoop()
 {
-    for (int i = 0; i < nodeEdges.size(); i++){
-        LoopsNodeEdgeData ned = nodeEdges.at(i);
-        if(!ned.visited){
-            nodeEdges[i].visited = true;
-            //qDebug() << "start loop " << i << endl;
-            return ned;
-        }
+    if (hasUnvisited())
+    {
+        nodeEdges[firstUnvisited].visited = true;
+        //qDebug() << "start loop " << firstUnvisited << endl;
+        return nodeEdges.at(firstUnvisited);
     }
 
     assert(0);
@@ -68,18 +68,12 @@ LoopsInfo::LoopsNodeEdgeData LoopsInfo::LoopsNode::startLoop()
 
 LoopsInfo::LoopsNodeEdgeData LoopsInfo::LoopsNode::continueLoop(int previousNode)
 {
-    LoopsNodeEdgeData previousNED;
-    int index;
-    for (int i = 0; i < nodeEdges.size(); i++){
-        LoopsNodeEdgeData ned = nodeEdges.at(i);
-        if(ned.node == previousNode){
-            previousNED = ned;
-            index = i;
-            break;
-        }
-    }
+    // first edge going to the previous node
+    QVector<QPair<int, int> >::const_iterator it = std::lower_bound(neighbours.constBegin(), neighbours.constEnd(),
+                                                                    QPair<int, int>(previousNode, -1));
 
-    assert(previousNED.node != LOOPS_NON_EXISTING);
+    assert((it != neighbours.constEnd()) && (it->first == previousNode));
+    int index = it->second;
     int nextIdx = (index + 1) % nodeEdges.size();
     //qDebug() << "continue loop, next node:" << nodeEdges[nextIdx].node << ", next edge:" << nodeEdges[nextIdx].edge << ", " << nodeEdges.at(nextIdx).visited;
     //assert(!data.at(nextIdx).visited);
@@ -89,20 +83,36 @@ LoopsInfo::LoopsNodeEdgeData LoopsInfo::LoopsNode::continueLoop(int previousNode
     return nodeEdges[nextIdx];
 }
 
-void LoopsInfo::LoopsNode::insertEdge(int endNode, int edgeIdx, bool reverse, double angle)
+void LoopsInfo::LoopsNode::appendEdge(int endNode, int edgeIdx, bool reverse, double angle)
 {
-    int index = 0;
+    nodeEdges.append(LoopsNodeEdgeData(endNode, edgeIdx, reverse, angle));
+}
+
+static bool edgeAngleGreater(const LoopsInfo::LoopsNodeEdgeData &ned1, const LoopsInfo::LoopsNodeEdgeData &ned2)
+{
+    return ned1.angle > ned2.angle;
+}
 
+void LoopsInfo::LoopsNode::sortEdges()
+{
+    // edges ordered by decreasing angle, edges with the same angle in reverse order of insertion
+    std::reverse(nodeEdges.begin(), nodeEdges.end());
+    std::stable_sort(nodeEdges.begin(), nodeEdges.end(), edgeAngleGreater);
+
+    neighbours.clear();
+    neighbours.reserve(nodeEdges.size());
     for (int i = 0; i < nodeEdges.size(); i++)
-        if(angle < nodeEdges[i].angle)
-            index = i+1;
-    nodeEdges.insert(index, LoopsNodeEdgeData(endNode, edgeIdx, reverse, angle));
+        neighbours.append(QPair<int, int>(nodeEdges.at(i).node, i));
+    std::sort(neighbours.begin(), neighbours.end());
+
+    firstUnvisited = 0;
 }
 
 // ***********************************************************************
 
 LoopsInfo::LoopsGraph::LoopsGraph(int numNodes)
 {
+    nodes.reserve(numNodes);
     for (int i = 0; i < numNodes; i++)
         nodes.push_back(LoopsNode());
 }
@@ -113,8 +123,14 @@ void LoopsInfo::LoopsGraph::addEdge(int startNode, int endNode, int edgeIdx, dou
     if(angle2 >= 2 * M_PI)
         angle2 -= 2 * M_PI;
 
-    nodes[startNode].insertEdge(endNode, edgeIdx, false, angle);
-    nodes[endNode].insertEdge(startNode, edgeIdx, true, angle2);
+    nodes[startNode].appendEdge(endNode, edgeIdx, false, angle);
+    nodes[endNode].appendEdge(startNode, edgeIdx, true, angle2);
+}
+
+void LoopsInfo::LoopsGraph::sortEdges()
+{
+    for (int i = 0; i < nodes.size(); i++)
+        nodes[i].sortEdges();
 }
 
 void LoopsInfo::LoopsGraph::print()
@@ -383,23 +399,53 @@ int LoopsInfo::windingNumber(Point point, QList<LoopsNodeEdgeData> loop)
     return intWinding;
 }
 
+RectPoint LoopsInfo::boundingBox(const QList<LoopsNodeEdgeData> &loop)
+{
+    double minX = numeric_limits<double>::max();
+    double maxX = -numeric_limits<double>::max();
+    double minY = numeric_limits<double>::max();
+    double maxY = -numeric_limits<double>::max();
+
+    foreach (LoopsNodeEdgeData ned, loop)
+    {
+        SceneEdge *edge = m_scene->edges->at(ned.edge);
+
+        QList<Point> points;
+        points.append(edge->nodeStart()->point());
+        points.append(edge->nodeEnd()->point());
+
+        // arc lies inside the box of its circle
+        if (!edge->isStraight())
+        {
+            points.append(edge->center() - Point(edge->radius(), edge->radius()));
+            points.append(edge->center() + Point(edge->radius(), edge->radius()));
+        }
+
+        foreach (Point point, points)
+        {
+            minX = qMin(minX, point.x);
+            maxX = qMax(maxX, point.x);
+            minY = qMin(minY, point.y);
+            maxY = qMax(maxY, point.y);
+        }
+    }
+
+    double margin = TOL * qMax(maxX - minX, maxY - minY);
+    return RectPoint(Point(minX - margin, minY - margin), Point(maxX + margin, maxY + margin));
+}
+
 bool LoopsInfo::areSameLoops(QList<LoopsNodeEdgeData> loop1, QList<LoopsNodeEdgeData> loop2)
 {
     if(loop1.size() != loop2.size())
         return false;
 
-    QList<int> nodes1;
-    nodes1.reserve(loop1.size());
-    QList<int> nodes2;
+    QSet<int> nodes2;
     nodes2.reserve(loop2.size());
 
-    foreach(LoopsNodeEdgeData ned, loop1)
-        nodes1.push_back(ned.node);
     foreach(LoopsNodeEdgeData ned, loop2)
-        nodes2.push_back(ned.node);
-
-    for (int i = 0; i < nodes1.size(); i++)
-        if(!nodes2.contains(nodes1.at(i)))
+        nodes2.insert(ned.node);
+    foreach(LoopsNodeEdgeData ned, loop1)
+        if(!nodes2.contains(ned.node))
             return false;
 
     return true;
@@ -407,20 +453,15 @@ bool LoopsInfo::areSameLoops(QList<LoopsNodeEdgeData> loop1, QList<LoopsNodeEdge
 
 bool LoopsInfo::areEdgeDuplicities(QList<LoopsNodeEdgeData> loop)
 {
-    for (int i = 0; i < loop.length(); i++)
-    {
-        LoopsNodeEdgeData data = loop.at(i);
+    QSet<int> edges;
+    edges.reserve(loop.length());
 
-        for (int j = 0; j < loop.length(); j++)
-        {
-            if (i != j)
-            {
-                LoopsNodeEdgeData dataTest = loop.at(j);
+    foreach (LoopsNodeEdgeData data, loop)
+    {
+        if (edges.contains(data.edge))
+            return true;
 
-                if (data.edge == dataTest.edge)
-                    return true;
-            }
-        }
+        edges.insert(data.edge);
     }
 
     return false;
@@ -508,14 +549,21 @@ void LoopsInfo::processLoops()
 
     m_scene->checkTwoNodesSameCoordinates();
 
+    // node indices
+    QHash<SceneNode *, int> nodeIndices;
+    nodeIndices.reserve(m_scene->nodes->length());
+    for (int nodeIdx = 0; nodeIdx < m_scene->nodes->length(); nodeIdx++)
+        if (!nodeIndices.contains(m_scene->nodes->at(nodeIdx)))
+            nodeIndices.insert(m_scene->nodes->at(nodeIdx), nodeIdx);
+
     // find loops
     LoopsGraph graph(m_scene->nodes->length());
     for (int edgeIdx = 0; edgeIdx < m_scene->edges->length(); edgeIdx++)
     {
         SceneNode* startNode = m_scene->edges->at(edgeIdx)->nodeStart();
         SceneNode* endNode = m_scene->edges->at(edgeIdx)->nodeEnd();
-        int startNodeIdx = m_scene->nodes->items().indexOf(startNode);
-        int endNodeIdx = m_scene->nodes->items().indexOf(endNode);
+        int startNodeIdx = nodeIndices.value(startNode, -1);
+        int endNodeIdx = nodeIndices.value(endNode, -1);
 
         if (startNodeIdx == endNodeIdx)
             throw AgrosGeometryException(QObject::tr("Edge %1 begins and ends in the same point %2. Remove the edge.").arg(edgeIdx).arg(startNodeIdx));
@@ -527,6 +575,7 @@ void LoopsInfo::processLoops()
 
         graph.addEdge(startNodeIdx, endNodeIdx, edgeIdx, angle);
     }
+    graph.sortEdges();
 
     //graph.print();
 
@@ -570,20 +619,42 @@ void LoopsInfo::processLoops()
 
     QMap<QPair<SceneLabel*, int>, int> windingNumbers;
 
+    // labels sorted by x coordinate
+    QVector<QPair<double, int> > labelsByX;
+    labelsByX.reserve(m_scene->labels->count());
+    for (int labelIdx = 0; labelIdx < m_scene->labels->count(); labelIdx++)
+        labelsByX.append(QPair<double, int>(m_scene->labels->at(labelIdx)->point().x, labelIdx));
+    std::sort(labelsByX.begin(), labelsByX.end());
+
     // find what labels are inside what loops
     for (int loopIdx = 0; loopIdx < m_loops.size(); loopIdx++)
     {
         labelsInsideLoop.push_back(QList<SceneLabel*>());
-        for (int labelIdx = 0; labelIdx < m_scene->labels->count(); labelIdx++)
+
+        // labels outside of the bounding box cannot lie inside the loop
+        RectPoint box = boundingBox(m_loops[loopIdx]);
+
+        QList<int> candidates;
+        QVector<QPair<double, int> >::const_iterator it = std::lower_bound(labelsByX.constBegin(), labelsByX.constEnd(),
+                                                                           QPair<double, int>(box.start.x, -1));
+        for (; (it != labelsByX.constEnd()) && (it->first <= box.end.x); ++it)
+        {
+            double y = m_scene->labels->at(it->second)->point().y;
+            if ((y >= box.start.y) && (y <= box.end.y))
+                candidates.append(it->second);
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        foreach (int labelIdx, candidates)
         {
             SceneLabel* label = m_scene->labels->at(labelIdx);
-            int wn = windingNumber(label->point(), m_loops[loopIdx]);
-            //qDebug() << "winding number " << wn << endl;
-            assert(wn < 2);
-            windingNumbers[QPair<SceneLabel*, int>(label, loopIdx)] = wn;
             int ip = intersectionsParity(label->point(), m_loops[loopIdx]);
-            // assert(abs(wn) == ip);
             if(ip == 1){
+                int wn = windingNumber(label->point(), m_loops[loopIdx]);
+                //qDebug() << "winding number " << wn << endl;
+                assert(wn < 2);
+                windingNumbers[QPair<SceneLabel*, int>(label, loopIdx)] = wn;
+
                 labelsInsideLoop[loopIdx].push_back(label);
                 if(!loopsContainingLabel.contains(label))
                     loopsContainingLabel[label] = QList<int>();
@@ -613,6 +684,7 @@ void LoopsInfo::processLoops()
 
     // outiside loops, not to be considered
     m_outsideLoops.clear();
+    QSet<int> outsideLoops;
     for (int labelIdx = 0; labelIdx < m_scene->labels->count(); labelIdx++)
     {
         SceneLabel* actualLabel = m_scene->labels->at(labelIdx);
@@ -646,8 +718,11 @@ void LoopsInfo::processLoops()
             switchOrientation(indexOfInmost);
 
         if ((labelsInsideLoop[indexOfOutmost].size() > 1) && (indexOfOutmost != indexOfInmost)
-                && shareEdge(indexOfOutmost, indexOfInmost))
+                && !outsideLoops.contains(indexOfOutmost) && shareEdge(indexOfOutmost, indexOfInmost))
+        {
+            outsideLoops.insert(indexOfOutmost);
             m_outsideLoops.append(indexOfOutmost);
+        }
 
         for (int j = 0; j < loopsWithLabel.size() -1; j++)
         {
@@ -662,13 +737,13 @@ void LoopsInfo::processLoops()
             int smallerLoop = loopsWithLabel[i];
             int biggerLoop = loopsWithLabel[i+1];
             // assert(superDomains[smallerLoop] == biggerLoop || superDomains[smallerLoop] == -1);
-            if ((superDomains[smallerLoop] == biggerLoop || superDomains[smallerLoop] == -1))
+            // smaller loop is added to the sub domains only once, together with its super domain
+            if (superDomains[smallerLoop] == -1)
             {
                 superDomains[smallerLoop] = biggerLoop;
-                if(!subDomains[biggerLoop].contains(smallerLoop))
-                    subDomains[biggerLoop].append(smallerLoop);
+                subDomains[biggerLoop].append(smallerLoop);
             }
-            else
+            else if (superDomains[smallerLoop] != biggerLoop)
             {
                 throw AgrosGeometryException(tr("Unknown error"));
             }
@@ -692,11 +767,11 @@ void LoopsInfo::processLoops()
     }
 
     // check for multiple labels
-    QList<int> usedLoops;
+    QSet<int> usedLoops;
     foreach (SceneLabel *label, principalLoopOfLabel.keys())
     {
         if (!usedLoops.contains(principalLoopOfLabel[label]))
-            usedLoops.append(principalLoopOfLabel[label]);
+            usedLoops.insert(principalLoopOfLabel[label]);
         else
             throw AgrosGeometryException(tr("There is multiple labels in the domain"));
     }
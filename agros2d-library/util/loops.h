@@ -60,13 +60,20 @@ public:
     // those edges are sorted depending on the angle
     struct LoopsNode
     {
-        void insertEdge(int endNode, int edgeIdx, bool reverse,  double angle);
+        LoopsNode() : firstUnvisited(0) {}
+
+        void appendEdge(int endNode, int edgeIdx, bool reverse,  double angle);
+        void sortEdges();
         bool hasUnvisited();
         LoopsNodeEdgeData startLoop();
         LoopsNodeEdgeData continueLoop(int previousNode);
         void setVisited(int index) {nodeEdges[index].visited = true;}
 
         QList<LoopsNodeEdgeData> nodeEdges;
+        // pairs (connected node, index in nodeEdges) sorted by node
+        QVector<QPair<int, int> > neighbours;
+        // all edges before this index are visited
+        int firstUnvisited;
     };
 
     // describes the graph
@@ -76,6 +83,7 @@ public:
     {
         LoopsGraph(int numNodes);
         void addEdge(int startNode, int endNode, int edgeIdx, double angle);
+        void sortEdges();
         void print();
 
         QList<LoopsNode> nodes;
@@ -123,6 +131,7 @@ private:
 
     QList<Triangle> triangulateLabel(const QList<Point> &polyline, const QList<QList<Point> > &holes);
     int windingNumber(Point point, QList<LoopsNodeEdgeData> loop);
+    RectPoint boundingBox(const QList<LoopsNodeEdgeData> &loop);
     bool areSameLoops(QList<LoopsNodeEdgeData> loop1, QList<LoopsNodeEdgeData> loop2);
     bool areEdgeDuplicities(QList<LoopsNodeEdgeData> loop);
     int longerLoop(int idx1, int idx2);
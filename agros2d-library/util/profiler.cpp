@@ -0,0 +1,197 @@
+// This file is part of Agros2D.
+//
+// Agros2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Agros2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Agros2D.  If not, see <http://www.gnu.org/licenses/>.
+//
+// hp-FEM group (http://hpfem.org/)
+// University of Nevada, Reno (UNR) and University of West Bohemia, Pilsen
+// Email: agros2d@googlegroups.com, home page: http://hpfem.org/agros2d/
+#include "profiler.h"
+
+#include "util/global.h"
+
+Profiler::Profiler()
+{
+    m_timer.start();
+}
+
+Profiler::~Profiler()
+{
+    clear();
+}
+
+void Profiler::begin(const QString &name)
+{
+    QMutexLocker locker(&m_mutex);
+
+    Qt::HANDLE thread = QThread::currentThreadId();
+    if (!m_threads.contains(thread))
+        m_threads[thread] = m_threads.count();
+
+    QStack<int> &stack = m_stacks[thread];
+
+    Event event;
+    event.name = name;
+    event.path = stack.isEmpty() ? name : m_events[stack.top()].path + "/" + name;
+    event.start = m_timer.nsecsElapsed() / 1000;
+    event.depth = stack.count();
+    event.thread = m_threads[thread];
+
+    stack.push(m_events.count());
+    m_events.append(event);
+}
+
+void Profiler::end()
+{
+    QMutexLocker locker(&m_mutex);
+
+    Qt::HANDLE thread = QThread::currentThreadId();
+
+    // profiler cleared inside of scope
+    if (!m_stacks.contains(thread) || m_stacks[thread].isEmpty())
+        return;
+
+    Event &event = m_events[m_stacks[thread].pop()];
+    event.duration = m_timer.nsecsElapsed() / 1000 - event.start;
+}
+
+void Profiler::clear()
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_events.clear();
+    m_stacks.clear();
+    m_threads.clear();
+    m_timer.restart();
+}
+
+int Profiler::mark() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_events.count();
+}
+
+QList<Profiler::Event> Profiler::events() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_events;
+}
+
+QMap<QString, double> Profiler::summary(int mark) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    QMap<QString, double> result;
+    for (int i = qMax(0, mark); i < m_events.count(); i++)
+    {
+        // unfinished events are skipped
+        if (m_events[i].duration < 0)
+            continue;
+
+        result[m_events[i].path] += m_events[i].duration / 1e3;
+    }
+
+    return result;
+}
+
+QString Profiler::toJSON() const
+{
+    QList<Event> list = events();
+
+    // aggregate by path (count and total time)
+    QMap<QString, int> counts;
+    QMap<QString, qint64> totals;
+    QStringList paths;
+    foreach (Event event, list)
+    {
+        if (event.duration < 0)
+            continue;
+
+        if (!counts.contains(event.path))
+            paths.append(event.path);
+
+        counts[event.path]++;
+        totals[event.path] += event.duration;
+    }
+
+    QString str = "{\n  \"phases\": [\n";
+    for (int i = 0; i < paths.count(); i++)
+    {
+        QString path = paths[i];
+        str += QString("    { \"path\": \"%1\", \"name\": \"%2\", \"depth\": %3, \"count\": %4, \"total_ms\": %5 }%6\n").
+                arg(path).
+                arg(path.section('/', -1)).
+                arg(path.count('/')).
+                arg(counts[path]).
+                arg(totals[path] / 1e3, 0, 'f', 3).
+                arg(i < paths.count() - 1 ? "," : "");
+    }
+    str += "  ]\n}\n";
+
+    return str;
+}
+
+QString Profiler::toChromeTrace() const
+{
+    QList<Event> list = events();
+
+    QString str = "{\n  \"traceEvents\": [\n";
+    for (int i = 0; i < list.count(); i++)
+    {
+        const Event &event = list[i];
+        if (event.duration < 0)
+            continue;
+
+        str += QString("    { \"name\": \"%1\", \"cat\": \"agros2d\", \"ph\": \"X\", \"ts\": %2, \"dur\": %3, \"pid\": %4, \"tid\": %5 },\n").
+                arg(event.name).
+                arg(event.start).
+                arg(event.duration).
+                arg(QCoreApplication::applicationPid()).
+                arg(event.thread);
+    }
+    // remove last comma
+    if (str.endsWith(",\n"))
+        str.chop(2);
+    str += "\n  ],\n  \"displayTimeUnit\": \"ms\"\n}\n";
+
+    return str;
+}
+
+bool Profiler::save(const QString &fileName, const QString &format) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        return false;
+
+    QTextStream out(&file);
+    if (format == "chrome")
+        out << toChromeTrace();
+    else
+        out << toJSON();
+
+    return true;
+}
+
+// *******************************************************************************************
+
+ProfilerScope::ProfilerScope(const QString &name)
+{
+    Agros2D::profiler()->begin(name);
+}
+
+ProfilerScope::~ProfilerScope()
+{
+    Agros2D::profiler()->end();
+}
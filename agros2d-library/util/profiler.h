@@ -0,0 +1,82 @@
+// This file is part of Agros2D.
+//
+// Agros2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Agros2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Agros2D.  If not, see <http://www.gnu.org/licenses/>.
+//
+// hp-FEM group (http://hpfem.org/)
+// University of Nevada, Reno (UNR) and University of West Bohemia, Pilsen
+// Email: agros2d@googlegroups.com, home page: http://hpfem.org/agros2d/
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "util.h"
+
+// hierarchical scoped timer
+// events are recorded from any thread, nesting is tracked per thread
+class AGROS_LIBRARY_API Profiler
+{
+public:
+    struct Event
+    {
+        Event() : start(0), duration(-1), depth(0), thread(0) {}
+
+        QString name;
+        // full path in the hierarchy ("solve/block/assembly")
+        QString path;
+        // time in microseconds from start of profiler
+        qint64 start;
+        qint64 duration;
+        int depth;
+        int thread;
+    };
+
+    Profiler();
+    ~Profiler();
+
+    void begin(const QString &name);
+    void end();
+
+    void clear();
+
+    // index of next event, used as a bookmark for summary()
+    int mark() const;
+
+    QList<Event> events() const;
+    // total time (ms) spent in every path, events started after mark only
+    QMap<QString, double> summary(int mark = 0) const;
+
+    // hierarchical summary
+    QString toJSON() const;
+    // Chrome trace event format (chrome://tracing)
+    QString toChromeTrace() const;
+
+    bool save(const QString &fileName, const QString &format = "json") const;
+
+private:
+    mutable QMutex m_mutex;
+    QElapsedTimer m_timer;
+
+    QList<Event> m_events;
+    // open events (indices to m_events) for each thread
+    QMap<Qt::HANDLE, QStack<int> > m_stacks;
+    QMap<Qt::HANDLE, int> m_threads;
+};
+
+class AGROS_LIBRARY_API ProfilerScope
+{
+public:
+    ProfilerScope(const QString &name);
+    ~ProfilerScope();
+};
+
+#endif // PROFILER_H
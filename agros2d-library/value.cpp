@@ -25,15 +25,22 @@
 #include "hermes2d/problem_config.h"
 #include "parser/lex.h"
 
+// maximum number of cached values of one expression
+const int VALUE_CACHE_MAX_SIZE = 100000;
+
+QAtomicInt Value::m_cacheHits(0);
+QAtomicInt Value::m_cacheMisses(0);
+QAtomicInt Value::m_evaluations(0);
+
 Value::Value(double value)
-    : m_isEvaluated(true), m_isTimeDependent(false), m_isCoordinateDependent(false), m_time(0.0), m_point(Point()), m_table(DataTable()), m_problem(Agros2D::problem())
+    : m_isEvaluated(true), m_isTimeDependent(false), m_isCoordinateDependent(false), m_time(0.0), m_point(Point()), m_table(DataTable()), m_problem(Agros2D::problem()), m_cacheTime(0.0), m_isTracked(true)
 {
     m_text = QString::number(value);
     m_number = value;      
 }
 
 Value::Value(double value, std::vector<double> x, std::vector<double> y, DataTableType type, bool splineFirstDerivatives, bool extrapolateConstant)
-    : m_isEvaluated(true), m_isTimeDependent(false), m_isCoordinateDependent(false), m_time(0.0), m_point(Point()), m_table(DataTable()), m_problem(Agros2D::problem())
+    : m_isEvaluated(true), m_isTimeDependent(false), m_isCoordinateDependent(false), m_time(0.0), m_point(Point()), m_table(DataTable()), m_problem(Agros2D::problem()), m_cacheTime(0.0), m_isTracked(true)
 {
     assert(x.size() == y.size());
 
@@ -46,14 +53,14 @@ Value::Value(double value, std::vector<double> x, std::vector<double> y, DataTab
 }
 
 Value::Value(const QString &value)
-    : m_isEvaluated(false), m_isTimeDependent(false), m_isCoordinateDependent(false), m_time(0.0), m_point(Point()), m_table(DataTable()), m_problem(Agros2D::problem())
+    : m_isEvaluated(false), m_isTimeDependent(false), m_isCoordinateDependent(false), m_time(0.0), m_point(Point()), m_table(DataTable()), m_problem(Agros2D::problem()), m_cacheTime(0.0), m_isTracked(true)
 {
     parseFromString(value.isEmpty() ? "0" : value);
     evaluateAndSave();
 }
 
 Value::Value(const QString &value, std::vector<double> x, std::vector<double> y, DataTableType type, bool splineFirstDerivatives, bool extrapolateConstant)
-    : m_isEvaluated(false), m_isTimeDependent(false), m_isCoordinateDependent(false), m_time(0.0), m_point(Point()), m_table(DataTable()), m_problem(Agros2D::problem())
+    : m_isEvaluated(false), m_isTimeDependent(false), m_isCoordinateDependent(false), m_time(0.0), m_point(Point()), m_table(DataTable()), m_problem(Agros2D::problem()), m_cacheTime(0.0), m_isTracked(true)
 {
     assert(x.size() == y.size());
 
@@ -66,15 +73,15 @@ Value::Value(const QString &value, std::vector<double> x, std::vector<double> y,
 }
 
 Value::Value(const QString &value, const DataTable &table)
-    : m_isEvaluated(false), m_isTimeDependent(false), m_isCoordinateDependent(false), m_time(0.0), m_point(Point()), m_table(table), m_problem(Agros2D::problem())
+    : m_isEvaluated(false), m_isTimeDependent(false), m_isCoordinateDependent(false), m_time(0.0), m_point(Point()), m_table(table), m_problem(Agros2D::problem()), m_cacheTime(0.0), m_isTracked(true)
 {
     parseFromString(value.isEmpty() ? "0" : value);
 }
 
 Value::Value(const Value &origin)
+    : m_cacheTime(0.0), m_isTracked(true)
 {
     *this = origin;
-    evaluateAndSave();
 //    qDebug() << "Copy Value" << this->m_text << ", " << this->m_number;
 }
 
@@ -89,7 +96,25 @@ Value& Value::operator =(const Value &origin)
     m_isCoordinateDependent = origin.m_isCoordinateDependent;
     m_table = origin.m_table;
 
-    evaluateAndSave();
+    m_number = origin.m_number;
+    m_isEvaluated = origin.m_isEvaluated;
+    m_isTracked = origin.m_isTracked;
+    m_dependencies = origin.m_dependencies;
+    m_parameters = origin.m_parameters;
+
+    clearCache();
+
+    // evaluate only if parameters of expression were changed
+    if (m_dependencies.isEmpty())
+    {
+        if (isChanged(QMap<QString, double>()))
+            evaluateAndSave();
+    }
+    else
+    {
+        if (isChanged(currentPythonEngineAgros()->numberVariables(m_dependencies)))
+            evaluateAndSave();
+    }
 
     return *this;
 //    qDebug() << "operator= Value" << this->m_text << ", " << this->m_number;
@@ -153,12 +178,7 @@ double Value::number() const
 
 double Value::numberAtPoint(const Point &point) const
 {
-    double result;
-
-    // force evaluate
-    evaluate(0, point, result);
-
-    return result;
+    return cachedNumber(0, point);
 }
 
 double Value::numberAtTime(double time) const
@@ -173,14 +193,152 @@ double Value::numberAtTime(double time) const
 
 double Value::numberAtTimeAndPoint(double time, const Point &point) const
 {
+    return cachedNumber(time, point);
+}
+
+double Value::cachedNumber(double time, const Point &point) const
+{
+    // constant expression
+    if (!m_isTimeDependent && !m_isCoordinateDependent && m_isEvaluated)
+        return m_number;
+
+    ValueCacheKey key(point);
+
+    {
+        QMutexLocker locker(&m_cacheMutex);
+
+        if (m_cacheTime != time)
+        {
+            m_cache.clear();
+            m_cacheTime = time;
+        }
+
+        QHash<ValueCacheKey, double>::const_iterator it = m_cache.constFind(key);
+        if (it != m_cache.constEnd())
+        {
+            m_cacheHits.fetchAndAddRelaxed(1);
+            return it.value();
+        }
+    }
+
+    m_cacheMisses.fetchAndAddRelaxed(1);
+
     double result;
 
     // force evaluate
-    evaluate(time, point, result);
+    if (evaluate(time, point, result))
+    {
+        QMutexLocker locker(&m_cacheMutex);
+
+        if (m_cacheTime == time)
+        {
+            if (m_cache.size() >= VALUE_CACHE_MAX_SIZE)
+                m_cache.clear();
+
+            m_cache.insert(key, result);
+        }
+    }
 
     return result;
 }
 
+void Value::clearCache()
+{
+    QMutexLocker locker(&m_cacheMutex);
+
+    m_cache.clear();
+    m_cacheTime = 0.0;
+}
+
+bool Value::isChanged(const QMap<QString, double> &parameters) const
+{
+    if (!m_isEvaluated || !m_isTracked)
+        return true;
+
+    foreach (QString name, m_dependencies)
+    {
+        // not a number (user function, list, undefined variable, ...)
+        QMap<QString, double>::const_iterator it = parameters.constFind(name);
+        if (it == parameters.constEnd())
+            return true;
+
+        QMap<QString, double>::const_iterator itSaved = m_parameters.constFind(name);
+        if (itSaved == m_parameters.constEnd() || itSaved.value() != it.value())
+            return true;
+    }
+
+    return false;
+}
+
+void Value::evaluateChanged(const QList<Value *> &values)
+{
+    QStringList names;
+    foreach (Value *value, values)
+        names.append(value->m_dependencies);
+    names.removeDuplicates();
+
+    // actual values of parameters (read once for all values)
+    QMap<QString, double> parameters;
+    if (!names.isEmpty())
+        parameters = currentPythonEngineAgros()->numberVariables(names);
+
+    QList<Value *> changed;
+    QStringList expressions;
+    foreach (Value *value, values)
+    {
+        if (!value->isChanged(parameters))
+            continue;
+
+        // time and coordinate dependent expressions need their own variables
+        if (value->m_isTimeDependent || value->m_isCoordinateDependent)
+        {
+            value->evaluateAndSave();
+            continue;
+        }
+
+        changed.append(value);
+        expressions.append(value->m_text);
+    }
+
+    if (changed.isEmpty())
+        return;
+
+    bool signalBlocked = currentPythonEngineAgros()->signalsBlocked();
+    currentPythonEngineAgros()->blockSignals(true);
+
+    QList<double> results;
+    m_evaluations.fetchAndAddRelaxed(1);
+    if (currentPythonEngineAgros()->runExpressions(expressions, results))
+    {
+        for (int i = 0; i < changed.count(); i++)
+        {
+            Value *value = changed[i];
+
+            value->m_number = results[i];
+            value->m_isEvaluated = true;
+            value->m_parameters.clear();
+            foreach (QString name, value->m_dependencies)
+                value->m_parameters[name] = parameters[name];
+            value->clearCache();
+        }
+    }
+    else
+    {
+        // evaluate one by one (failed expressions are not evaluated)
+        foreach (Value *value, changed)
+            value->evaluateAndSave();
+    }
+
+    if (!signalBlocked)
+        currentPythonEngineAgros()->blockSignals(false);
+}
+
+void Value::resetCacheStatistics()
+{
+    m_cacheHits.fetchAndStoreRelaxed(0);
+    m_cacheMisses.fetchAndStoreRelaxed(0);
+}
+
 double Value::numberFromTable(double key) const
 {
     if (m_problem->isNonlinear() && hasTable())
@@ -212,9 +370,15 @@ void Value::setText(const QString &str)
     m_isEvaluated = false;
     m_text = str;
 
+    clearCache();
+
     m_isTimeDependent = false;
     m_isCoordinateDependent = false;
 
+    m_isTracked = true;
+    m_dependencies.clear();
+    m_parameters.clear();
+
     LexicalAnalyser lex;
 
     // ToDo: Improve
@@ -225,7 +389,8 @@ void Value::setText(const QString &str)
 
     catch(ParserException e)
     {
-        // Nothing to do at this point.
+        // dependencies are not known
+        m_isTracked = false;
     }
 
     foreach (Token token, lex.tokens())
@@ -233,18 +398,31 @@ void Value::setText(const QString &str)
         if (token.type() == ParserTokenType_VARIABLE)
         {
             if (token.toString() == "time")
+            {
                 m_isTimeDependent = true;
+                continue;
+            }
             if (m_problem->config()->coordinateType() == CoordinateType_Planar)
             {
                 if (token.toString() == "x" || token.toString() == "y")
+                {
                     m_isCoordinateDependent = true;
+                    continue;
+                }
             }
             else
             {
                 if (token.toString() == "r" || token.toString() == "z")
+                {
                     m_isCoordinateDependent = true;
+                    continue;
+                }
             }
         }
+
+        if (token.type() == ParserTokenType_VARIABLE || token.type() == ParserTokenType_FUNCTION)
+            if (!m_dependencies.contains(token.toString()))
+                m_dependencies.append(token.toString());
     }
 
     evaluateAndSave();
@@ -292,8 +470,20 @@ bool Value::evaluate(double time, const Point &point, double& result) const
 
 bool Value::evaluateAndSave()
 {
+    QMap<QString, double> parameters = m_parameters;
+
     m_isEvaluated = false;
     m_isEvaluated = evaluateExpression(m_text, m_time, m_point, m_number);
+
+    // parameters used in evaluation
+    if (m_isEvaluated && !m_dependencies.isEmpty())
+        m_parameters = currentPythonEngineAgros()->numberVariables(m_dependencies);
+
+    // values cached at points were evaluated with the previous parameters
+    // (dependencies which are not numbers, e.g. user functions, can not be compared)
+    if (!m_isEvaluated || !m_isTracked || (m_parameters != parameters) || (m_parameters.size() != m_dependencies.size()))
+        clearCache();
+
     return m_isEvaluated;
 }
 
@@ -317,6 +507,8 @@ bool Value::evaluateExpression(const QString &expression, double time, const Poi
         return true;
     }
 
+    m_evaluations.fetchAndAddRelaxed(1);
+
     bool signalBlocked = currentPythonEngineAgros()->signalsBlocked();
     currentPythonEngineAgros()->blockSignals(true);
 
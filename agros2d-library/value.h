@@ -30,6 +30,26 @@ class DataTable;
 class FieldInfo;
 class Problem;
 
+// key of value cache (coordinates of quadrature point)
+struct ValueCacheKey
+{
+    ValueCacheKey(const Point &point) : x(point.x), y(point.y) {}
+
+    inline bool operator==(const ValueCacheKey &other) const { return (x == other.x) && (y == other.y); }
+
+    double x;
+    double y;
+};
+
+inline uint qHash(const ValueCacheKey &key)
+{
+    quint64 x, y;
+    memcpy(&x, &key.x, sizeof(double));
+    memcpy(&y, &key.y, sizeof(double));
+
+    return qHash(x ^ (y * Q_UINT64_C(0x9e3779b97f4a7c15)));
+}
+
 class AGROS_LIBRARY_API Value
 {
 public:
@@ -62,6 +82,7 @@ public:
     bool evaluateAtTime(double time);
     bool evaluateAtTimeAndPoint(double time, const Point &point);
     inline bool isEvaluated() const { return m_isEvaluated; }
+    inline double time() const { return m_time; }
 
     // table
     double numberFromTable(double key) const;
@@ -79,6 +100,21 @@ public:
 
     inline DataTable table() const { return m_table; }
 
+    // cache of values at points (hit/miss statistics)
+    static inline int cacheHits() { return m_cacheHits.fetchAndAddRelaxed(0); }
+    static inline int cacheMisses() { return m_cacheMisses.fetchAndAddRelaxed(0); }
+    static void resetCacheStatistics();
+    // number of expression evaluations in Python engine
+    static inline int evaluations() { return m_evaluations.fetchAndAddRelaxed(0); }
+
+    // global variables and functions used in expression
+    inline QStringList dependencies() const { return m_dependencies; }
+    // parameters contain actual values of dependencies (see PythonEngine::numberVariables)
+    bool isChanged(const QMap<QString, double> &parameters) const;
+
+    // re-evaluates values which depend on changed parameters (expressions are evaluated in one batch)
+    static void evaluateChanged(const QList<Value *> &values);
+
 protected:
 
 private:
@@ -96,6 +132,26 @@ private:
     // table
     DataTable m_table;
 
+    // values of coordinate and time dependent expression at points (quadrature points are the same
+    // in all assemblies of the time step), cleared when time or expression is changed
+    mutable QHash<ValueCacheKey, double> m_cache;
+    mutable double m_cacheTime;
+    mutable QMutex m_cacheMutex;
+
+    static QAtomicInt m_cacheHits;
+    static QAtomicInt m_cacheMisses;
+
+    double cachedNumber(double time, const Point &point) const;
+    void clearCache();
+
+    // dependencies and their values used in the last evaluation
+    // (untracked expressions - not parsed by lexical analyser - are always evaluated)
+    bool m_isTracked;
+    QStringList m_dependencies;
+    QMap<QString, double> m_parameters;
+
+    static QAtomicInt m_evaluations;
+
     // evaluate
     bool evaluate(double time, const Point &point, double& result) const;
     bool evaluateAndSave();
@@ -121,6 +177,8 @@ public:
     inline Point point() const { return Point(m_x.number(), m_y.number()); }
     inline Value x() const { return m_x; }
     inline Value y() const { return m_y; }
+    inline Value &xRef() { return m_x; }
+    inline Value &yRef() { return m_y; }
 
     inline double numberX() const { return m_x.number(); }
     inline double numberY() const { return m_y.number(); }
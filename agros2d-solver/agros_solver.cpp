@@ -18,9 +18,11 @@
 // Email: agros2d@googlegroups.com, home page: http://hpfem.org/agros2d/
 
 #include "agros_solver.h"
+#include "agros_sweep.h"
 
 #include "util/global.h"
 #include "util/checkversion.h"
+#include "util/profiler.h"
 
 #include "scenenode.h"
 #include "logview.h"
@@ -29,7 +31,7 @@
 #include "hermes2d.h"
 
 AgrosSolver::AgrosSolver(int &argc, char **argv)
-    : AgrosApplication(argc, argv), m_log(NULL), m_enableLog(false)
+    : AgrosApplication(argc, argv), m_log(NULL), m_enableLog(false), m_sweepWorkers(1)
 {    
     createPythonEngine(new PythonEngineAgros());
 
@@ -92,6 +94,8 @@ void AgrosSolver::solveProblem()
         Agros2D::problem()->solve(true);
         // save solution
         Agros2D::scene()->writeSolutionToFile(m_fileName);
+        // save profile
+        saveProfile();
 
         Agros2D::log()->printMessage(tr("Solver"), tr("Problem was solved in %1").arg(milisecondsToTime(time.elapsed()).toString("mm:ss.zzz")));
 
@@ -107,6 +111,65 @@ void AgrosSolver::solveProblem()
     }
 }
 
+void AgrosSolver::setSweep(const QString &tableFileName, const QString &outputFileName, const QString &cacheDir,
+                           const QStringList &results, int workers, const QString &variants)
+{
+    m_sweepTableFileName = tableFileName;
+    m_sweepOutputFileName = outputFileName;
+    m_sweepCacheDir = cacheDir;
+    m_sweepResults = results;
+    m_sweepWorkers = qMax(1, workers);
+    m_sweepVariants = variants;
+}
+
+void AgrosSolver::runSweep()
+{
+    // log stdout
+    if (m_enableLog)
+        m_log = new LogStdOut();
+
+    QTime time;
+    time.start();
+
+    try
+    {
+        ParameterSweep sweep(m_fileName, m_sweepTableFileName);
+        sweep.setOutputFileName(m_sweepOutputFileName);
+        sweep.setCacheDir(m_sweepCacheDir);
+        sweep.setResults(m_sweepResults);
+        sweep.setEnableLog(m_enableLog);
+
+        if (!m_sweepVariants.isEmpty())
+        {
+            // worker process started by sweep
+            QList<int> variants;
+            foreach (QString item, m_sweepVariants.split(",", QString::SkipEmptyParts))
+            {
+                bool ok = false;
+                variants.append(item.toInt(&ok));
+                if (!ok)
+                    throw AgrosException(tr("Wrong variant '%1'.").arg(item));
+            }
+
+            sweep.runWorker(variants);
+        }
+        else
+        {
+            sweep.run(m_sweepWorkers);
+
+            Agros2D::log()->printMessage(tr("Solver"), tr("Sweep of %1 variants was finished in %2").arg(sweep.count()).
+                                         arg(milisecondsToTime(time.elapsed()).toString("mm:ss.zzz")));
+        }
+
+        QApplication::exit(0);
+    }
+    catch (AgrosException &e)
+    {
+        Agros2D::log()->printError(tr("Sweep"), e.toString());
+        QApplication::exit(-1);
+    }
+}
+
 void AgrosSolver::runScript()
 {
     // log stdout
@@ -134,6 +197,9 @@ void AgrosSolver::runScript()
     {
         Agros2D::log()->printMessage(tr("Solver"), tr("Problem was solved in %1").arg(milisecondsToTime(time.elapsed()).toString("mm:ss.zzz")));
 
+        // save profile
+        saveProfile();
+
         Agros2D::scene()->clear();
         Agros2D::clear();
         QApplication::exit(0);
@@ -196,6 +262,17 @@ void AgrosSolver::printTestSuites()
     QApplication::exit(0);
 }
 
+void AgrosSolver::saveProfile()
+{
+    if (m_profileFileName.isEmpty())
+        return;
+
+    if (Agros2D::profiler()->save(m_profileFileName, m_profileFormat))
+        Agros2D::log()->printMessage(tr("Solver"), tr("Profile saved to '%1'").arg(m_profileFileName));
+    else
+        Agros2D::log()->printError(tr("Solver"), tr("Profile cannot be saved to '%1'").arg(m_profileFileName));
+}
+
 void AgrosSolver::stdOut(const QString &str)
 {
     std::cout << str.toStdString();
@@ -39,10 +39,14 @@ public:
     inline void setFileName(const QString &fileName) { m_fileName = fileName; }
     inline void setEnableLog(bool enableLog = true) { m_enableLog = enableLog; }
     inline void setScriptSuite(const QString &name) { m_suiteName = name; }
+    inline void setProfile(const QString &fileName, const QString &format) { m_profileFileName = fileName; m_profileFormat = format; }
+    void setSweep(const QString &tableFileName, const QString &outputFileName, const QString &cacheDir,
+                  const QStringList &results, int workers, const QString &variants = QString());
 
 public slots:
     void solveProblem();
     void runScript();
+    void runSweep();
     void runSuite();
     void printTestSuites();
 
@@ -50,9 +54,22 @@ private slots:
     void stdOut(const QString &str);
     void stdHtml(const QString &str);
 
+private:
+    void saveProfile();
+
 private:
     QString m_fileName;
     QString m_suiteName;
+    QString m_profileFileName;
+    QString m_profileFormat;
+    // parameter sweep
+    QString m_sweepTableFileName;
+    QString m_sweepOutputFileName;
+    QString m_sweepCacheDir;
+    QStringList m_sweepResults;
+    int m_sweepWorkers;
+    // variants assigned to worker process (comma separated)
+    QString m_sweepVariants;
     bool m_enableLog;
     LogStdOut *m_log;
 };
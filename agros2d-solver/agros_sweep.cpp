@@ -0,0 +1,610 @@
+// This file is part of Agros2D.
+//
+// Agros2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Agros2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Agros2D.  If not, see <http://www.gnu.org/licenses/>.
+//
+// hp-FEM group (http://hpfem.org/)
+// University of Nevada, Reno (UNR) and University of West Bohemia, Pilsen
+// Email: agros2d@googlegroups.com, home page: http://hpfem.org/agros2d/
+
+
+#include "agros_sweep.h"
+
+#include "util/global.h"
+
+#include "scene.h"
+#include "sceneedge.h"
+#include "scenelabel.h"
+#include "scenemarkerdialog.h"
+#include "logview.h"
+
+#include "hermes2d/problem.h"
+#include "hermes2d/problem_config.h"
+#include "hermes2d/field.h"
+#include "hermes2d/plugin_interface.h"
+#include "hermes2d/solutionstore.h"
+
+SweepResultRequest::SweepResultRequest(const QString &spec, int index)
+{
+    QStringList items = spec.split(":");
+    if (items.count() < 2)
+        throw AgrosException(QObject::tr("Wrong result specification '%1'.").arg(spec));
+
+    QString kind = items.at(0).trimmed();
+    fieldId = items.at(1).trimmed();
+
+    if (kind == "local")
+    {
+        if (items.count() != 4)
+            throw AgrosException(QObject::tr("Local value '%1' must be in form local:field:x:y.").arg(spec));
+
+        bool okX = false;
+        bool okY = false;
+        point = Point(items.at(2).toDouble(&okX), items.at(3).toDouble(&okY));
+        if (!okX || !okY)
+            throw AgrosException(QObject::tr("Wrong coordinates in local value '%1'.").arg(spec));
+
+        type = Type_LocalValue;
+    }
+    else if (kind == "surface" || kind == "volume")
+    {
+        if (items.count() > 3)
+            throw AgrosException(QObject::tr("Integral '%1' must be in form %2:field:indices.").arg(spec).arg(kind));
+
+        if (items.count() == 3)
+        {
+            foreach (QString item, items.at(2).split(",", QString::SkipEmptyParts))
+            {
+                bool ok = false;
+                indices.append(item.toInt(&ok));
+                if (!ok)
+                    throw AgrosException(QObject::tr("Wrong index '%1' in integral '%2'.").arg(item).arg(spec));
+            }
+        }
+
+        type = (kind == "surface") ? Type_SurfaceIntegral : Type_VolumeIntegral;
+    }
+    else
+    {
+        throw AgrosException(QObject::tr("Unknown result type '%1' (local, surface or volume).").arg(kind));
+    }
+
+    name = QString("%1%2").arg(kind).arg(index + 1);
+}
+
+// ********************************************************************************************
+
+static Marker *sweepMarker(const QString &parameter, QString &variable)
+{
+    QStringList items = parameter.split(":");
+    if (items.count() != 4)
+        throw AgrosException(QObject::tr("Marker parameter '%1' must be in form %2:field:name:variable.").arg(parameter).arg(items.at(0)));
+
+    if (!Agros2D::problem()->hasField(items.at(1)))
+        throw AgrosException(QObject::tr("Field '%1' is not defined.").arg(items.at(1)));
+
+    FieldInfo *fieldInfo = Agros2D::problem()->fieldInfo(items.at(1));
+
+    Marker *marker = NULL;
+    if (items.at(0) == "boundary")
+        marker = Agros2D::scene()->getBoundary(fieldInfo, items.at(2));
+    else
+        marker = Agros2D::scene()->getMaterial(fieldInfo, items.at(2));
+
+    if (!marker)
+        throw AgrosException(QObject::tr("Marker '%1' doesn't exists.").arg(items.at(2)));
+
+    variable = items.at(3);
+    if (!marker->values().contains(variable))
+        throw AgrosException(QObject::tr("Marker '%1' has no variable '%2'.").arg(items.at(2)).arg(variable));
+
+    return marker;
+}
+
+static bool isMarkerParameter(const QString &parameter)
+{
+    return parameter.startsWith("boundary:") || parameter.startsWith("material:");
+}
+
+ParameterSweep::ParameterSweep(const QString &problemFileName, const QString &tableFileName)
+    : m_problemFileName(problemFileName), m_tableFileName(tableFileName), m_enableLog(false)
+{
+    QFile file(m_problemFileName);
+    if (!file.open(QIODevice::ReadOnly))
+        throw AgrosException(tr("Problem file '%1' cannot be read.").arg(m_problemFileName));
+
+    m_problemHash = QCryptographicHash::hash(file.readAll(), QCryptographicHash::Sha1);
+    file.close();
+
+    readTable();
+}
+
+void ParameterSweep::readTable()
+{
+    if (!QFile::exists(m_tableFileName))
+        throw AgrosException(tr("Parameter table '%1' not found.").arg(m_tableFileName));
+
+    QString content = readFileContent(m_tableFileName);
+
+    if (QFileInfo(m_tableFileName).suffix().toLower() == "json")
+        readTableJSON(content);
+    else
+        readTableCSV(content);
+
+    if (m_variants.isEmpty())
+        throw AgrosException(tr("Parameter table '%1' is empty.").arg(m_tableFileName));
+}
+
+void ParameterSweep::readTableCSV(const QString &content)
+{
+    QStringList lines;
+    foreach (QString line, content.split("\n"))
+    {
+        line = line.trimmed();
+        if (!line.isEmpty() && !line.startsWith("#"))
+            lines.append(line);
+    }
+
+    if (lines.isEmpty())
+        return;
+
+    QString separator = (!lines.first().contains(",") && lines.first().contains(";")) ? ";" : ",";
+
+    foreach (QString item, lines.first().split(separator))
+        m_parameters.append(item.trimmed().remove("\""));
+
+    for (int i = 1; i < lines.count(); i++)
+    {
+        QStringList items = lines.at(i).split(separator);
+        if (items.count() != m_parameters.count())
+            throw AgrosException(tr("Row %1 of parameter table has %2 columns (expected %3).").arg(i).arg(items.count()).arg(m_parameters.count()));
+
+        QMap<QString, QString> variant;
+        for (int j = 0; j < items.count(); j++)
+            variant[m_parameters.at(j)] = items.at(j).trimmed().remove("\"");
+
+        m_variants.append(variant);
+    }
+}
+
+void ParameterSweep::readTableJSON(const QString &content)
+{
+#if QT_VERSION >= 0x050000
+    QJsonParseError error;
+    QJsonDocument document = QJsonDocument::fromJson(content.toUtf8(), &error);
+    if (error.error != QJsonParseError::NoError || !document.isArray())
+        throw AgrosException(tr("Parameter table must be a JSON array of objects (%1).").arg(error.errorString()));
+
+    foreach (QJsonValue row, document.array())
+    {
+        QJsonObject object = row.toObject();
+
+        QMap<QString, QString> variant;
+        foreach (QString key, object.keys())
+        {
+            if (!m_parameters.contains(key))
+                m_parameters.append(key);
+
+            QJsonValue value = object.value(key);
+            if (value.isDouble())
+                variant[key] = QString::number(value.toDouble(), 'g', 16);
+            else if (value.isBool())
+                variant[key] = value.toBool() ? "1" : "0";
+            else
+                variant[key] = value.toString();
+        }
+
+        m_variants.append(variant);
+    }
+
+    // missing keys keep values from problem file
+    for (int i = 0; i < m_variants.count(); i++)
+        foreach (QString parameter, m_parameters)
+            if (!m_variants[i].contains(parameter))
+                m_variants[i][parameter] = "";
+#else
+    Q_UNUSED(content);
+    throw AgrosException(tr("JSON parameter tables are not supported, use CSV."));
+#endif
+}
+
+QString ParameterSweep::cacheDir() const
+{
+    if (!m_cacheDir.isEmpty())
+        return m_cacheDir;
+
+    return m_outputFileName + ".cache";
+}
+
+QString ParameterSweep::variantKey(const QMap<QString, QString> &variant) const
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(m_problemHash);
+    foreach (QString result, m_results)
+        hash.addData(QString("result:%1\n").arg(result).toUtf8());
+    // QMap is sorted by key, order of columns doesn't matter
+    foreach (QString parameter, variant.keys())
+        hash.addData(QString("%1=%2\n").arg(parameter).arg(variant[parameter]).toUtf8());
+
+    return QString(hash.result().toHex());
+}
+
+bool ParameterSweep::readCache(const QString &key, QList<QPair<QString, double> > &results) const
+{
+    QFile file(QString("%1/%2.txt").arg(cacheDir()).arg(key));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return false;
+
+    results.clear();
+    QTextStream stream(&file);
+    while (!stream.atEnd())
+    {
+        QString line = stream.readLine();
+        int pos = line.lastIndexOf("=");
+        if (pos > 0)
+            results.append(QPair<QString, double>(line.left(pos), line.mid(pos + 1).toDouble()));
+    }
+
+    return true;
+}
+
+void ParameterSweep::writeCache(const QString &key, const QList<QPair<QString, double> > &results) const
+{
+    QString content;
+    for (int i = 0; i < results.count(); i++)
+        content += QString("%1=%2\n").arg(results.at(i).first).arg(QString::number(results.at(i).second, 'g', 16));
+
+    // write to temporary file first, readers never see partial entry
+    QString fileName = QString("%1/%2.txt").arg(cacheDir()).arg(key);
+    writeStringContent(fileName + ".tmp", content);
+    QFile::remove(fileName);
+    QFile::rename(fileName + ".tmp", fileName);
+}
+
+QList<int> ParameterSweep::pendingVariants() const
+{
+    QList<int> pending;
+    for (int i = 0; i < m_variants.count(); i++)
+        if (!QFile::exists(QString("%1/%2.txt").arg(cacheDir()).arg(variantKey(m_variants.at(i)))))
+            pending.append(i);
+
+    return pending;
+}
+
+void ParameterSweep::storeParameter(const QString &parameter)
+{
+    if (isMarkerParameter(parameter))
+    {
+        QString variable;
+        Marker *marker = sweepMarker(parameter, variable);
+        m_originalMarker[parameter] = *marker->value(variable).data();
+    }
+    else
+    {
+        ProblemConfig::Type type = Agros2D::problem()->config()->stringKeyToType(parameter);
+        if (type == ProblemConfig::Unknown)
+            throw AgrosException(tr("Unknown problem parameter '%1'.").arg(parameter));
+
+        m_originalConfig[parameter] = Agros2D::problem()->config()->value(type);
+    }
+}
+
+void ParameterSweep::applyParameter(const QString &parameter, const QString &value)
+{
+    if (isMarkerParameter(parameter))
+    {
+        QString variable;
+        Marker *marker = sweepMarker(parameter, variable);
+
+        if (value.isEmpty())
+        {
+            marker->modifyValue(variable, m_originalMarker[parameter]);
+        }
+        else
+        {
+            bool ok = false;
+            double number = value.toDouble(&ok);
+            marker->modifyValue(variable, ok ? Value(number) : Value(value));
+        }
+    }
+    else
+    {
+        ProblemConfig *config = Agros2D::problem()->config();
+        ProblemConfig::Type type = config->stringKeyToType(parameter);
+
+        QVariant original = m_originalConfig[parameter];
+
+        bool ok = true;
+        switch (config->defaultValue(type).type())
+        {
+        case QVariant::Int:
+            config->setValue(type, value.isEmpty() ? original.toInt() : value.toInt(&ok), false);
+            break;
+        case QVariant::Double:
+            config->setValue(type, value.isEmpty() ? original.toDouble() : value.toDouble(&ok), false);
+            break;
+        case QVariant::Bool:
+            config->setValue(type, value.isEmpty() ? original.toBool() : (value == "1" || value.toLower() == "true"), false);
+            break;
+        default:
+            config->setValue(type, value.isEmpty() ? original.toString() : value, false);
+        }
+
+        if (!ok)
+            throw AgrosException(tr("Wrong value '%1' of parameter '%2'.").arg(value).arg(parameter));
+    }
+}
+
+QList<QPair<QString, double> > ParameterSweep::evaluateResults(const QList<SweepResultRequest> &requests) const
+{
+    QList<QPair<QString, double> > results;
+
+    foreach (SweepResultRequest request, requests)
+    {
+        FieldInfo *fieldInfo = Agros2D::problem()->fieldInfo(request.fieldId);
+
+        int timeStep = Agros2D::solutionStore()->lastTimeStep(fieldInfo, SolutionMode_Normal);
+        int adaptivityStep = Agros2D::solutionStore()->lastAdaptiveStep(fieldInfo, SolutionMode_Normal, timeStep);
+
+        if (request.type == SweepResultRequest::Type_LocalValue)
+        {
+            LocalValue *value = fieldInfo->plugin()->localValue(fieldInfo, timeStep, adaptivityStep, SolutionMode_Normal, request.point);
+            QMapIterator<QString, LocalPointValue> it(value->values());
+            while (it.hasNext())
+            {
+                it.next();
+
+                Module::LocalVariable variable = fieldInfo->localVariable(it.key());
+                QString name = QString("%1_%2").arg(request.name).arg(variable.shortname());
+
+                if (variable.isScalar())
+                {
+                    results.append(QPair<QString, double>(name, it.value().scalar));
+                }
+                else
+                {
+                    results.append(QPair<QString, double>(name, it.value().vector.magnitude()));
+                    results.append(QPair<QString, double>(name + Agros2D::problem()->config()->labelX().toLower(), it.value().vector.x));
+                    results.append(QPair<QString, double>(name + Agros2D::problem()->config()->labelY().toLower(), it.value().vector.y));
+                }
+            }
+            delete value;
+        }
+        else
+        {
+            bool surface = (request.type == SweepResultRequest::Type_SurfaceIntegral);
+
+            Agros2D::scene()->selectNone();
+            if (request.indices.isEmpty())
+            {
+                Agros2D::scene()->selectAll(surface ? SceneGeometryMode_OperateOnEdges : SceneGeometryMode_OperateOnLabels);
+            }
+            else
+            {
+                foreach (int index, request.indices)
+                {
+                    int count = surface ? Agros2D::scene()->edges->length() : Agros2D::scene()->labels->length();
+                    if (index < 0 || index >= count)
+                        throw AgrosException(tr("Index '%1' of '%2' must be between 0 and '%3'.").arg(index).arg(request.name).arg(count - 1));
+
+                    if (surface)
+                        Agros2D::scene()->edges->at(index)->setSelected(true);
+                    else
+                        Agros2D::scene()->labels->at(index)->setSelected(true);
+                }
+            }
+
+            IntegralValue *integral = surface
+                    ? fieldInfo->plugin()->surfaceIntegral(fieldInfo, timeStep, adaptivityStep, SolutionMode_Normal)
+                    : fieldInfo->plugin()->volumeIntegral(fieldInfo, timeStep, adaptivityStep, SolutionMode_Normal);
+            QMapIterator<QString, double> it(integral->values());
+            while (it.hasNext())
+            {
+                it.next();
+
+                Module::Integral variable = surface ? fieldInfo->surfaceIntegral(it.key()) : fieldInfo->volumeIntegral(it.key());
+                results.append(QPair<QString, double>(QString("%1_%2").arg(request.name).arg(variable.shortname()), it.value()));
+            }
+            delete integral;
+
+            Agros2D::scene()->selectNone();
+        }
+    }
+
+    return results;
+}
+
+void ParameterSweep::runWorker(const QList<int> &variants)
+{
+    QDir().mkpath(cacheDir());
+
+    if (variants.isEmpty())
+        return;
+
+    foreach (int variantIndex, variants)
+        if (variantIndex < 0 || variantIndex >= m_variants.count())
+            throw AgrosException(tr("Variant %1 is not in parameter table.").arg(variantIndex));
+
+    // problem (and its plugins) is loaded only once per process
+    Agros2D::scene()->readFromFile(m_problemFileName);
+
+    QList<SweepResultRequest> requests;
+    for (int i = 0; i < m_results.count(); i++)
+    {
+        SweepResultRequest request(m_results.at(i), i);
+        if (!Agros2D::problem()->hasField(request.fieldId))
+            throw AgrosException(tr("Field '%1' is not defined.").arg(request.fieldId));
+
+        requests.append(request);
+    }
+
+    foreach (QString parameter, m_parameters)
+        storeParameter(parameter);
+
+    foreach (int variantIndex, variants)
+    {
+        const QMap<QString, QString> &variant = m_variants.at(variantIndex);
+
+        QTime time;
+        time.start();
+
+        try
+        {
+            foreach (QString parameter, m_parameters)
+                applyParameter(parameter, variant[parameter]);
+            Agros2D::scene()->invalidate();
+
+            Agros2D::problem()->solve(true);
+            if (!Agros2D::problem()->isSolved())
+            {
+                Agros2D::log()->printError(tr("Sweep"), tr("Variant %1 was not solved").arg(variantIndex));
+                continue;
+            }
+
+            writeCache(variantKey(variant), evaluateResults(requests));
+
+            Agros2D::log()->printMessage(tr("Sweep"), tr("Variant %1 was solved in %2").arg(variantIndex).
+                                         arg(milisecondsToTime(time.elapsed()).toString("mm:ss.zzz")));
+        }
+        catch (AgrosException &e)
+        {
+            Agros2D::log()->printError(tr("Sweep"), tr("Variant %1: %2").arg(variantIndex).arg(e.toString()));
+        }
+    }
+
+    Agros2D::problem()->clearFieldsAndConfig();
+}
+
+void ParameterSweep::run(int workers)
+{
+    QDir().mkpath(cacheDir());
+
+    QList<int> pending = pendingVariants();
+    Agros2D::log()->printMessage(tr("Sweep"), tr("%1 variants, %2 found in cache").
+                                 arg(m_variants.count()).arg(m_variants.count() - pending.count()));
+
+    workers = qMin(workers, pending.count());
+    if (workers == 1)
+    {
+        runWorker(pending);
+    }
+    else if (workers > 1)
+    {
+        // pending variants are split once, workers get fixed assignments
+        QList<QStringList> assigned;
+        for (int i = 0; i < workers; i++)
+            assigned.append(QStringList());
+        for (int i = 0; i < pending.count(); i++)
+            assigned[i % workers].append(QString::number(pending.at(i)));
+
+        QList<QProcess *> processes;
+        for (int i = 0; i < workers; i++)
+        {
+            QStringList arguments;
+            arguments << "--problem" << m_problemFileName
+                      << "--sweep" << m_tableFileName
+                      << "--sweep-cache" << cacheDir()
+                      << "--sweep-variants" << assigned.at(i).join(",");
+            foreach (QString result, m_results)
+                arguments << "--sweep-result" << result;
+            if (m_enableLog)
+                arguments << "--enable-log";
+
+            QProcess *process = new QProcess();
+            process->setProcessChannelMode(QProcess::ForwardedChannels);
+            process->start(QCoreApplication::applicationFilePath(), arguments);
+            processes.append(process);
+        }
+
+        foreach (QProcess *process, processes)
+        {
+            process->waitForFinished(-1);
+            if (process->exitStatus() != QProcess::NormalExit || process->exitCode() != 0)
+                Agros2D::log()->printWarning(tr("Sweep"), tr("Worker process failed (exit code %1)").arg(process->exitCode()));
+
+            delete process;
+        }
+    }
+
+    writeOutput();
+}
+
+void ParameterSweep::writeOutput() const
+{
+    QList<bool> solved;
+    QList<QList<QPair<QString, double> > > results;
+    QStringList columns;
+
+    foreach (const QMap<QString, QString> &variant, m_variants)
+    {
+        QList<QPair<QString, double> > values;
+        solved.append(readCache(variantKey(variant), values));
+        results.append(values);
+
+        for (int i = 0; i < values.count(); i++)
+            if (!columns.contains(values.at(i).first))
+                columns.append(values.at(i).first);
+    }
+
+#if QT_VERSION >= 0x050000
+    if (QFileInfo(m_outputFileName).suffix().toLower() == "json")
+    {
+        QJsonArray array;
+        for (int i = 0; i < m_variants.count(); i++)
+        {
+            QJsonObject parameters;
+            foreach (QString parameter, m_parameters)
+                parameters.insert(parameter, m_variants.at(i)[parameter]);
+
+            QJsonObject values;
+            for (int j = 0; j < results.at(i).count(); j++)
+                values.insert(results.at(i).at(j).first, results.at(i).at(j).second);
+
+            QJsonObject row;
+            row.insert("variant", i);
+            row.insert("status", solved.at(i) ? QString("solved") : QString("failed"));
+            row.insert("parameters", parameters);
+            row.insert("results", values);
+            array.append(row);
+        }
+
+        writeStringContentByteArray(m_outputFileName, QJsonDocument(array).toJson());
+        Agros2D::log()->printMessage(tr("Sweep"), tr("Results saved to '%1'").arg(m_outputFileName));
+        return;
+    }
+#endif
+
+    QString content = "variant";
+    foreach (QString parameter, m_parameters)
+        content += "," + parameter;
+    foreach (QString column, columns)
+        content += "," + column;
+    content += ",status\n";
+
+    for (int i = 0; i < m_variants.count(); i++)
+    {
+        QMap<QString, double> values;
+        for (int j = 0; j < results.at(i).count(); j++)
+            values[results.at(i).at(j).first] = results.at(i).at(j).second;
+
+        content += QString::number(i);
+        foreach (QString parameter, m_parameters)
+            content += "," + m_variants.at(i)[parameter];
+        foreach (QString column, columns)
+            content += "," + (values.contains(column) ? QString::number(values[column], 'g', 16) : QString());
+        content += solved.at(i) ? ",solved\n" : ",failed\n";
+    }
+
+    writeStringContent(m_outputFileName, content);
+    Agros2D::log()->printMessage(tr("Sweep"), tr("Results saved to '%1'").arg(m_outputFileName));
+}
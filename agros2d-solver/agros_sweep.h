@@ -0,0 +1,109 @@
+// This file is part of Agros2D.
+//
+// Agros2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Agros2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Agros2D.  If not, see <http://www.gnu.org/licenses/>.
+//
+// hp-FEM group (http://hpfem.org/)
+// University of Nevada, Reno (UNR) and University of West Bohemia, Pilsen
+// Email: agros2d@googlegroups.com, home page: http://hpfem.org/agros2d/
+
+
+#ifndef AGROS_SWEEP_H
+#define AGROS_SWEEP_H
+
+#include "util.h"
+#include "util/point.h"
+#include "value.h"
+
+// requested output of one variant
+struct SweepResultRequest
+{
+    enum Type
+    {
+        Type_LocalValue,
+        Type_SurfaceIntegral,
+        Type_VolumeIntegral
+    };
+
+    // local:<field>:<x>:<y>, surface:<field>:<edges>, volume:<field>:<labels>
+    // (indices are separated by commas, empty list means whole domain)
+    SweepResultRequest(const QString &spec, int index);
+
+    Type type;
+    QString fieldId;
+    Point point;
+    QList<int> indices;
+    // prefix of result columns (e.g. "local1")
+    QString name;
+};
+
+// parameter sweep: one problem file solved for every row of a parameter table
+//
+// columns of the table:
+//   <ProblemConfig key>                      (e.g. Frequency, TimeTotal)
+//   boundary:<field>:<boundary>:<variable>   (e.g. boundary:electrostatic:Source:es_potential)
+//   material:<field>:<material>:<variable>   (e.g. material:electrostatic:Air:es_permittivity)
+// empty cell keeps the value stored in the problem file
+class ParameterSweep : public QObject
+{
+    Q_OBJECT
+
+public:
+    ParameterSweep(const QString &problemFileName, const QString &tableFileName);
+
+    inline void setOutputFileName(const QString &fileName) { m_outputFileName = fileName; }
+    inline void setCacheDir(const QString &cacheDir) { m_cacheDir = cacheDir; }
+    inline void setResults(const QStringList &results) { m_results = results; }
+    inline void setEnableLog(bool enableLog = true) { m_enableLog = enableLog; }
+
+    inline int count() const { return m_variants.count(); }
+
+    // spawns worker processes (solves in this process for one worker) and writes the result file
+    void run(int workers);
+    // solves variants assigned by master and stores them in the result cache
+    void runWorker(const QList<int> &variants);
+
+private:
+    QString m_problemFileName;
+    QString m_tableFileName;
+    QString m_outputFileName;
+    QString m_cacheDir;
+    QStringList m_results;
+    bool m_enableLog;
+
+    QByteArray m_problemHash;
+    QStringList m_parameters;
+    QList<QMap<QString, QString> > m_variants;
+
+    // values stored in the problem file (used for empty cells)
+    QMap<QString, QVariant> m_originalConfig;
+    QMap<QString, Value> m_originalMarker;
+
+    void readTable();
+    void readTableCSV(const QString &content);
+    void readTableJSON(const QString &content);
+
+    QString cacheDir() const;
+    QString variantKey(const QMap<QString, QString> &variant) const;
+    bool readCache(const QString &key, QList<QPair<QString, double> > &results) const;
+    void writeCache(const QString &key, const QList<QPair<QString, double> > &results) const;
+    QList<int> pendingVariants() const;
+
+    void storeParameter(const QString &parameter);
+    void applyParameter(const QString &parameter, const QString &value);
+    QList<QPair<QString, double> > evaluateResults(const QList<SweepResultRequest> &requests) const;
+
+    void writeOutput() const;
+};
+
+#endif // AGROS_SWEEP_H
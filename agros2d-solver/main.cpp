@@ -28,6 +28,7 @@
 #include "util/system_utils.h"
 
 #include "../3rdparty/tclap/CmdLine.h"
+#include "../3rdparty/tclap/ValuesConstraint.h"
 
 int main(int argc, char *argv[])
 {
@@ -41,12 +42,32 @@ int main(int argc, char *argv[])
         TCLAP::ValueArg<std::string> problemArg("p", "problem", "Solve problem", false, "", "string");
         TCLAP::ValueArg<std::string> scriptArg("s", "script", "Solve script", false, "", "string");
         TCLAP::ValueArg<std::string> testArg("t", "test", "Run tests", false, "list", "string");
+        TCLAP::ValueArg<std::string> profileArg("", "profile", "Save performance profile", false, "", "string");
+        std::vector<std::string> profileFormats;
+        profileFormats.push_back("json");
+        profileFormats.push_back("chrome");
+        TCLAP::ValuesConstraint<std::string> profileFormatConstraint(profileFormats);
+        TCLAP::ValueArg<std::string> profileFormatArg("", "profile-format", "Format of performance profile", false, "json", &profileFormatConstraint);
+        TCLAP::ValueArg<std::string> sweepArg("", "sweep", "Solve problem for every row of parameter table (CSV or JSON)", false, "", "string");
+        TCLAP::ValueArg<std::string> sweepOutputArg("", "sweep-output", "Result file of parameter sweep (CSV or JSON)", false, "", "string");
+        TCLAP::ValueArg<std::string> sweepCacheArg("", "sweep-cache", "Result cache of parameter sweep (default <sweep-output>.cache)", false, "", "string");
+        TCLAP::MultiArg<std::string> sweepResultArg("", "sweep-result", "Requested result (local:field:x:y, surface:field:edges, volume:field:labels)", false, "string");
+        TCLAP::ValueArg<int> sweepWorkersArg("", "sweep-workers", "Number of worker processes", false, 1, "int");
+        TCLAP::ValueArg<std::string> sweepVariantsArg("", "sweep-variants", "Variants solved by worker process (internal)", false, "", "string");
 
         cmd.add(logArg);
         cmd.add(remoteArg);
         cmd.add(problemArg);
         cmd.add(scriptArg);
         cmd.add(testArg);
+        cmd.add(profileArg);
+        cmd.add(profileFormatArg);
+        cmd.add(sweepArg);
+        cmd.add(sweepOutputArg);
+        cmd.add(sweepCacheArg);
+        cmd.add(sweepResultArg);
+        cmd.add(sweepWorkersArg);
+        cmd.add(sweepVariantsArg);
 
         // parse the argv array.
         cmd.parse(argc, argv);
@@ -56,6 +77,9 @@ int main(int argc, char *argv[])
 
         // enable log
         a.setEnableLog(logArg.getValue());
+        // performance profile
+        a.setProfile(QString::fromStdString(profileArg.getValue()),
+                     QString::fromStdString(profileFormatArg.getValue()));
 
         // run remote server
         if (remoteArg.getValue())
@@ -72,7 +96,29 @@ int main(int argc, char *argv[])
                 if (info.suffix() == "a2d")
                 {
                     a.setFileName(QString::fromStdString(problemArg.getValue()));
-                    QTimer::singleShot(0, &a, SLOT(solveProblem()));
+
+                    if (!sweepArg.getValue().empty())
+                    {
+                        QString outputFileName = QString::fromStdString(sweepOutputArg.getValue());
+                        if (outputFileName.isEmpty())
+                            outputFileName = QString("%1/%2_sweep.csv").arg(info.absolutePath()).arg(info.baseName());
+
+                        QStringList results;
+                        for (std::vector<std::string>::const_iterator it = sweepResultArg.getValue().begin(); it != sweepResultArg.getValue().end(); ++it)
+                            results.append(QString::fromStdString(*it));
+
+                        a.setSweep(QString::fromStdString(sweepArg.getValue()),
+                                   outputFileName,
+                                   QString::fromStdString(sweepCacheArg.getValue()),
+                                   results,
+                                   sweepWorkersArg.getValue(),
+                                   QString::fromStdString(sweepVariantsArg.getValue()));
+                        QTimer::singleShot(0, &a, SLOT(runSweep()));
+                    }
+                    else
+                    {
+                        QTimer::singleShot(0, &a, SLOT(solveProblem()));
+                    }
                     return a.exec();
                 }
                 else
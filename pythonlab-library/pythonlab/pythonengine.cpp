@@ -496,6 +496,67 @@ bool PythonEngine::runExpression(const QString &expression, double *value, const
     return successfulRun;
 }
 
+bool PythonEngine::runExpressions(const QStringList &expressions, QList<double> &values)
+{
+    values.clear();
+    if (expressions.isEmpty())
+        return true;
+
+    bool successfulRun = false;
+
+    PyObject *output = NULL;
+    runPythonHeader();
+
+    QString exp = QString("result_pythonlab = [(%1)]").arg(expressions.join("), ("));
+
+#pragma omp critical(expression)
+    {
+        output = PyRun_String(exp.toLatin1().data(), Py_single_input, dict(), dict());
+    }
+
+    if (output)
+    {
+        // parse result
+        PyObject *result = PyDict_GetItemString(dict(), "result_pythonlab");
+
+        if (result && PyList_Check(result) && (PyList_Size(result) == expressions.count()))
+        {
+            successfulRun = true;
+
+            for (int i = 0; i < expressions.count(); i++)
+            {
+                PyObject *item = PyList_GetItem(result, i);
+
+                if (PyFloat_Check(item) || PyInt_Check(item) || PyLong_Check(item))
+                {
+                    double value = PyFloat_AsDouble(item);
+                    if (fabs(value) < EPS_ZERO)
+                        value = 0.0;
+
+                    values.append(value);
+                }
+                else
+                {
+                    successfulRun = false;
+                    break;
+                }
+            }
+        }
+    }
+    else
+    {
+        // error is reported by evaluation of individual expressions
+        PyErr_Clear();
+    }
+
+    Py_XDECREF(output);
+
+    if (!successfulRun)
+        values.clear();
+
+    return successfulRun;
+}
+
 bool PythonEngine::runExpressionConsole(const QString &expression)
 {
     bool successfulRun = runExpression(expression);
@@ -702,6 +763,31 @@ void PythonEngine::addCustomExtensions()
     initpythonlab();
 }
 
+QMap<QString, double> PythonEngine::numberVariables(const QStringList &names)
+{
+    QMap<QString, double> values;
+
+    PyObject *builtins = PyImport_AddModule("__builtin__");
+    PyObject *dictBuiltins = builtins ? PyModule_GetDict(builtins) : NULL;
+
+    foreach (QString name, names)
+    {
+        PyObject *value = PyDict_GetItemString(dict(), name.toLatin1().data());
+        if (!value && dictBuiltins)
+            value = PyDict_GetItemString(dictBuiltins, name.toLatin1().data());
+
+        if (!value)
+            continue;
+
+        if (PyFloat_Check(value) || PyInt_Check(value) || PyLong_Check(value))
+            values[name] = PyFloat_AsDouble(value);
+        else if (PyCFunction_Check(value))
+            values[name] = 0.0;
+    }
+
+    return values;
+}
+
 QList<PythonVariable> PythonEngine::variableList()
 {
     QStringList filter_name;
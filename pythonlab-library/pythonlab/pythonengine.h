@@ -112,6 +112,8 @@ public:
     bool runScript(const QString &script, const QString &fileName = "");
     bool runExpression(const QString &expression, double *value = NULL, const QString &command = QString());
     bool runExpressionConsole(const QString &expression);
+    // evaluates all expressions in one run (fails if any of them fails or is not a number)
+    bool runExpressions(const QStringList &expressions, QList<double> &values);
     ErrorResult parseError();
     inline bool isScriptRunning() { return m_isScriptRunning; }
 
@@ -121,6 +123,8 @@ public:
     QStringList codeCompletion(const QString& command);
     QStringList codePyFlakes(const QString& fileName);
     QList<PythonVariable> variableList();
+    // values of global numbers (built-in functions are included with zero value, other objects are omitted)
+    QMap<QString, double> numberVariables(const QStringList &names);
 
     inline void useProfiler(bool use = true) { m_useProfiler = use; }
     inline bool isProfiler() const { return m_useProfiler; }
@@ -53,7 +53,7 @@ public:
     virtual AgrosExtFunction *extFunction(const ProblemID problemId, QString id, bool derivative, bool linearize, const WeakFormAgros<double>* wfAgros) {  return NULL; }
 
     // error calculators
-    virtual Hermes::Hermes2D::ErrorCalculator<double> *errorCalculator(const FieldInfo *fieldInfo, const QString &calculator, Hermes::Hermes2D::CalculatedErrorType errorType) { assert(0); return NULL; }
+    virtual ErrorCalculatorAgros<double> *errorCalculator(const FieldInfo *fieldInfo, const QString &calculator, Hermes::Hermes2D::CalculatedErrorType errorType) { assert(0); return NULL; }
 
     // postprocessor
     // filter
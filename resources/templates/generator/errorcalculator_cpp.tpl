@@ -35,15 +35,30 @@ class {{CLASS}}ErrorCalculatorNorm_{{COORDINATE_TYPE}}_{{LINEARITY_TYPE}}_{{ANAL
 {
 public:
     {{CLASS}}ErrorCalculatorNorm_{{COORDINATE_TYPE}}_{{LINEARITY_TYPE}}_{{ANALYSIS_TYPE}}_{{ID_CALCULATOR}}<Scalar>(const FieldInfo *fieldInfo, int i, int j)
-        : Hermes::Hermes2D::NormFormVol<Scalar>(i, j), m_fieldInfo(fieldInfo) {}
+        : Hermes::Hermes2D::NormFormVol<Scalar>(i, j), m_fieldInfo(fieldInfo)
+    {
+        // element marker -> material values
+        // filled once, value() is called concurrently from the threads of the error calculator
+        int num = Agros2D::scene()->labels->count();
+        {{#VARIABLE_SOURCE}}
+        m_{{VARIABLE_SHORT}}.fill(NULL, num + 1);{{/VARIABLE_SOURCE}}
+
+        for (int marker = 0; marker < num + 1; marker++)
+        {
+            int labelIndex = m_fieldInfo->hermesMarkerToAgrosLabel(marker);
+            if (labelIndex == LABEL_OUTSIDE_FIELD)
+                continue;
+
+            SceneMaterial *material = Agros2D::scene()->labels->at(labelIndex)->marker(m_fieldInfo);
+            {{#VARIABLE_SOURCE}}
+            m_{{VARIABLE_SHORT}}[marker] = material->valueNakedPtr(QLatin1String("{{VARIABLE}}"));{{/VARIABLE_SOURCE}}
+        }
+    }
 
     virtual Scalar value(int n, double *wt, Hermes::Hermes2D::Func<Scalar> *u, Hermes::Hermes2D::Func<Scalar> *v, Hermes::Hermes2D::Geom<double> *e) const
     {
-        SceneLabel *label = Agros2D::scene()->labels->at(atoi(m_fieldInfo->initialMesh()->get_element_markers_conversion().get_user_marker(e->elem_marker).marker.c_str()));
-        SceneMaterial *material = label->marker(m_fieldInfo);
-
         {{#VARIABLE_SOURCE}}
-        const Value *{{VARIABLE_SHORT}} = material->valueNakedPtr(QLatin1String("{{VARIABLE}}"));{{/VARIABLE_SOURCE}}
+        const Value *{{VARIABLE_SHORT}} = m_{{VARIABLE_SHORT}}.at(e->elem_marker);{{/VARIABLE_SOURCE}}
 
         Scalar result = Scalar(0);
         for (int i = 0; i < n; i++)
@@ -53,6 +68,10 @@ public:
     }
 
     const FieldInfo *m_fieldInfo;
+
+private:
+    {{#VARIABLE_SOURCE}}
+    QVector<const Value *> m_{{VARIABLE_SHORT}};{{/VARIABLE_SOURCE}}
 };
 
 template class {{CLASS}}ErrorCalculatorNorm_{{COORDINATE_TYPE}}_{{LINEARITY_TYPE}}_{{ANALYSIS_TYPE}}_{{ID_CALCULATOR}}<double>;
@@ -60,7 +79,7 @@ template class {{CLASS}}ErrorCalculatorNorm_{{COORDINATE_TYPE}}_{{LINEARITY_TYPE
 
 template<typename Scalar>
 {{CLASS}}ErrorCalculator<Scalar>::{{CLASS}}ErrorCalculator(const FieldInfo *fieldInfo, const QString &calculator, Hermes::Hermes2D::CalculatedErrorType errorType)
-    : Hermes::Hermes2D::ErrorCalculator<Scalar>(errorType), m_fieldInfo(fieldInfo), m_calculator(calculator)
+    : ErrorCalculatorAgros<Scalar>(errorType), m_fieldInfo(fieldInfo), m_calculator(calculator)
 {
     for(int i = 0; i < m_fieldInfo->numberOfSolutions(); i++)
     {
@@ -25,9 +25,10 @@
 #include "util.h"
 #include "hermes2d/field.h"
 #include "hermes2d.h"
+#include "hermes2d/plugin_interface.h"
 
 template<typename Scalar>
-class {{CLASS}}ErrorCalculator : public Hermes::Hermes2D::ErrorCalculator<Scalar>
+class {{CLASS}}ErrorCalculator : public ErrorCalculatorAgros<Scalar>
 {
 public:
     {{CLASS}}ErrorCalculator(const FieldInfo *fieldInfo, const QString &calculator, Hermes::Hermes2D::CalculatedErrorType errorType);
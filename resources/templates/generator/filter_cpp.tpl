@@ -48,7 +48,32 @@
     dudy = new double*[this->num];
 
     m_coordinateType = Agros2D::problem()->config()->coordinateType();
-    m_labels = Agros2D::scene()->labels;
+
+    // expression
+    m_expression = -1;
+    {{#VARIABLE_SOURCE}}
+    if ((m_variableHash == {{VARIABLE_HASH}})
+            && (m_coordinateType == {{COORDINATE_TYPE}})
+            && (m_fieldInfo->analysisType() == {{ANALYSIS_TYPE}})
+            && (m_physicFieldVariableComp == {{PHYSICFIELDVARIABLECOMP_TYPE}}))
+        m_expression = {{EXPRESSION_INDEX}};
+    {{/VARIABLE_SOURCE}}
+
+    // materials
+    m_materials.resize(Agros2D::scene()->labels->count() + 1);
+    for (int labelIndex = 0; labelIndex < Agros2D::scene()->labels->count(); labelIndex++)
+    {
+        SceneMaterial *material = Agros2D::scene()->labels->at(labelIndex)->marker(m_fieldInfo);
+        if (material->isNone())
+            continue;
+
+        Hermes::Hermes2D::Mesh::MarkersConversion::IntValid marker = m_fieldInfo->initialMesh()->get_element_markers_conversion().get_internal_marker(QString::number(labelIndex).toStdString());
+        if (!marker.valid)
+            continue;
+
+        {{#VARIABLE_MATERIAL}}m_materials[marker.marker].material_{{MATERIAL_VARIABLE}} = material->valueNakedPtr(QLatin1String("{{MATERIAL_VARIABLE}}"));
+        {{/VARIABLE_MATERIAL}}
+    }
 }
 
 {{CLASS}}ViewScalarFilter::~{{CLASS}}ViewScalarFilter()
@@ -84,21 +109,22 @@ void {{CLASS}}ViewScalarFilter::precalculate(int order, int mask)
     Hermes::Hermes2D::Element *e = this->refmap->get_active_element();
 
     // set material
-    SceneMaterial *material = m_labels->at(atoi(m_fieldInfo->initialMesh()->get_element_markers_conversion().
-                                           get_user_marker(e->marker).marker.c_str()))->marker(m_fieldInfo);
-
     int elementMarker = e->marker;
+    const MaterialValues &materialValues = m_materials.at(elementMarker);
 
-    {{#VARIABLE_MATERIAL}}const Value *material_{{MATERIAL_VARIABLE}} = material->valueNakedPtr(QLatin1String("{{MATERIAL_VARIABLE}}"));
-    {{/VARIABLE_MATERIAL}}    
+    {{#VARIABLE_MATERIAL}}const Value *material_{{MATERIAL_VARIABLE}} = materialValues.material_{{MATERIAL_VARIABLE}};
+    {{/VARIABLE_MATERIAL}}
+    switch (m_expression)
+    {
     {{#VARIABLE_SOURCE}}
-    if ((m_variableHash == {{VARIABLE_HASH}})
-            && (m_coordinateType == {{COORDINATE_TYPE}})
-            && (m_fieldInfo->analysisType() == {{ANALYSIS_TYPE}})
-            && (m_physicFieldVariableComp == {{PHYSICFIELDVARIABLECOMP_TYPE}}))
+    case {{EXPRESSION_INDEX}}:
         for (int i = 0; i < np; i++)
             this->values[0][0][i] = {{EXPRESSION}};
+        break;
     {{/VARIABLE_SOURCE}}
+    default:
+        break;
+    }
 }
 
 {{CLASS}}ViewScalarFilter* {{CLASS}}ViewScalarFilter::clone() const
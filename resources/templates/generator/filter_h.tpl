@@ -29,7 +29,7 @@
 
 #include "{{ID}}_interface.h"
 
-class SceneLabelContainer;
+class Value;
 
 class {{CLASS}}ViewScalarFilter : public Hermes::Hermes2D::Filter<double>
 {
@@ -54,13 +54,28 @@ private:
     int m_adaptivityStep;
     SolutionMode m_solutionType;
 
-    SceneLabelContainer *m_labels;
-
     QString m_variable;
     uint m_variableHash;
     PhysicFieldVariableComp m_physicFieldVariableComp;
     CoordinateType m_coordinateType;
 
+    // expression resolved in constructor (index of switch in precalculate, -1 if not found)
+    int m_expression;
+
+    // material values indexed by element marker
+    struct MaterialValues
+    {
+        MaterialValues()
+        {
+            {{#VARIABLE_MATERIAL}}material_{{MATERIAL_VARIABLE}} = NULL;
+            {{/VARIABLE_MATERIAL}}
+        }
+
+        {{#VARIABLE_MATERIAL}}const Value *material_{{MATERIAL_VARIABLE}};
+        {{/VARIABLE_MATERIAL}}
+    };
+    QVector<MaterialValues> m_materials;
+
     {{#SPECIAL_FUNCTION_SOURCE}}
     QSharedPointer<{{SPECIAL_EXT_FUNCTION_FULL_NAME}}> {{SPECIAL_FUNCTION_NAME}};{{/SPECIAL_FUNCTION_SOURCE}}
 
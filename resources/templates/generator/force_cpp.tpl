@@ -43,83 +43,120 @@ bool hasForce{{CLASS}}(const FieldInfo *fieldInfo)
     return false;
 }
 
-Point3 force{{CLASS}}(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType,
-                      Hermes::Hermes2D::Element *element, SceneMaterial *material, const Point3 &point, const Point3 &velocity)
+{{CLASS}}ForceEvaluator::{{CLASS}}ForceEvaluator(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType)
+    : ForceEvaluator(fieldInfo, timeStep, adaptivityStep, solutionType),
+      m_analysisType(fieldInfo->analysisType()), m_coordinateType(Agros2D::problem()->config()->coordinateType()),
+      m_isInitialCondition(false), m_initialCondition(0.0)
 {
-    int numberOfSolutions = fieldInfo->numberOfSolutions();
+    if (!Agros2D::problem()->isSolved())
+        return;
 
+    // solutions
     FieldSolutionID fsid(fieldInfo, timeStep, adaptivityStep, solutionType);
-    MultiArray<double> ma = Agros2D::solutionStore()->multiArray(fsid);
+    m_solutionsPtr = Agros2D::solutionStore()->multiArray(fsid).solutions();
+    for (int k = 0; k < fieldInfo->numberOfSolutions(); k++)
+        m_solutions.append(dynamic_cast<Hermes::Hermes2D::Solution<double> *>(m_solutionsPtr.at(k).get()));
+    m_mesh = m_solutionsPtr.at(0)->get_mesh();
+
+    m_value.resize(fieldInfo->numberOfSolutions());
+    m_dudx.resize(fieldInfo->numberOfSolutions());
+    m_dudy.resize(fieldInfo->numberOfSolutions());
+
+    // time of the solution
+    double time = 0.0;
+    if (m_analysisType == AnalysisType_Transient)
+    {
+        time = Agros2D::problem()->timeStepToTotalTime(timeStep);
 
-    {{#VARIABLE_MATERIAL}}const Value *material_{{MATERIAL_VARIABLE}} = material->valueNakedPtr(QLatin1String("{{MATERIAL_VARIABLE}}"));
-    {{/VARIABLE_MATERIAL}}
+        if (timeStep == 0)
+        {
+            m_isInitialCondition = true;
+            m_initialCondition = fieldInfo->value(FieldInfo::TransientInitialCondition).toDouble();
+        }
+    }
+
+    // materials (time dependent values are evaluated in the time of the solution)
+    m_materials.resize(Agros2D::scene()->labels->count() + 1);
+    for (int labelIndex = 0; labelIndex < Agros2D::scene()->labels->count(); labelIndex++)
+    {
+        SceneMaterial *material = Agros2D::scene()->labels->at(labelIndex)->marker(fieldInfo);
+        if (material->isNone())
+            continue;
+
+        Hermes::Hermes2D::Mesh::MarkersConversion::IntValid marker = fieldInfo->initialMesh()->get_element_markers_conversion().get_internal_marker(QString::number(labelIndex).toStdString());
+        if (!marker.valid)
+            continue;
 
+        MaterialValues &values = m_materials[marker.marker];
+        values.isValid = true;
+
+        {{#VARIABLE_MATERIAL}}values.material_{{MATERIAL_VARIABLE}} = *material->valueNakedPtr(QLatin1String("{{MATERIAL_VARIABLE}}"));
+        if ((m_analysisType == AnalysisType_Transient) && values.material_{{MATERIAL_VARIABLE}}.isTimeDependent())
+            values.material_{{MATERIAL_VARIABLE}}.evaluateAtTime(time);
+        {{/VARIABLE_MATERIAL}}
+    }
+}
+
+Point3 {{CLASS}}ForceEvaluator::force(Hermes::Hermes2D::Element *element, const Point3 &point, const Point3 &velocity)
+{
     Point3 res;
 
-    if (Agros2D::problem()->isSolved())
-    {
-        // update time functions
-        if (fieldInfo->analysisType() == AnalysisType_Transient)
-        {
-            QList<double> timeLevels = Agros2D::solutionStore()->timeLevels(fieldInfo);
-            Module::updateTimeFunctions(timeLevels[timeStep]);
-        }
+    if (m_solutions.isEmpty() || !element || (element->marker >= m_materials.size()) || !m_materials.at(element->marker).isValid)
+        return res;
 
-        // set variables
-        double x = point.x;
-        double y = point.y;
+    const MaterialValues &materialValues = m_materials.at(element->marker);
+    {{#VARIABLE_MATERIAL}}const Value *material_{{MATERIAL_VARIABLE}} = &materialValues.material_{{MATERIAL_VARIABLE}};
+    {{/VARIABLE_MATERIAL}}
+
+    // set variables
+    double x = point.x;
+    double y = point.y;
 
-        double *value = new double[numberOfSolutions];
-        double *dudx = new double[numberOfSolutions];
-        double *dudy = new double[numberOfSolutions];
+    double *value = m_value.data();
+    double *dudx = m_dudx.data();
+    double *dudy = m_dudy.data();
 
-        for (int k = 0; k < numberOfSolutions; k++)
+    double xi1, xi2;
+    if (!Hermes::Hermes2D::RefMap::is_element_on_physical_coordinates(element, x, y, &xi1, &xi2))
+        throw AgrosException(QObject::tr("Point [%1, %2] does not lie in any element").arg(x).arg(y));
+
+    for (int k = 0; k < m_solutions.size(); k++)
+    {
+        if (m_solutions.at(k))
         {
-            // point values
-            // point values
-            Hermes::Hermes2D::Func<double> *values = ma.solutions().at(k)->get_pt_value(point.x, point.y, true, element);
+            // values in reference coordinates (without allocation)
+            value[k] = m_solutions.at(k)->get_ref_value_transformed(element, xi1, xi2, 0, 0);
+            dudx[k] = m_solutions.at(k)->get_ref_value_transformed(element, xi1, xi2, 0, 1);
+            dudy[k] = m_solutions.at(k)->get_ref_value_transformed(element, xi1, xi2, 0, 2);
+        }
+        else
+        {
+            // general mesh function
+            Hermes::Hermes2D::Func<double> *values = m_solutionsPtr.at(k)->get_pt_value(x, y, true, element);
             if (!values)
-            {
                 throw AgrosException(QObject::tr("Point [%1, %2] does not lie in any element").arg(x).arg(y));
 
-                delete [] value;
-                delete [] dudx;
-                delete [] dudy;
-
-                return res;
-            }
-
-            double val;
-            if ((fieldInfo->analysisType() == AnalysisType_Transient) && timeStep == 0)
-                // const solution at first time step
-                val = fieldInfo->value(FieldInfo::TransientInitialCondition).toDouble();
-            else
-                val = values->val[0];
-
-            // set variables
-            value[k] = val;
+            value[k] = values->val[0];
             dudx[k] = values->dx[0];
             dudy[k] = values->dy[0];
 
-            // values->free_fn();
-            // values->free_ord();
             delete values;
         }
 
-        {{#VARIABLE_SOURCE}}
-        if ((fieldInfo->analysisType() == {{ANALYSIS_TYPE}})
-         && (Agros2D::problem()->config()->coordinateType() == {{COORDINATE_TYPE}}))
-        {
-            res.x = {{EXPRESSION_X}};
-            res.y = {{EXPRESSION_Y}};
-            res.z = {{EXPRESSION_Z}};
-        }
-        {{/VARIABLE_SOURCE}}
+        // const solution at first time step
+        if (m_isInitialCondition)
+            value[k] = m_initialCondition;
+    }
 
-        delete [] value;
-        delete [] dudx;
-        delete [] dudy;
+    {{#VARIABLE_SOURCE}}
+    if ((m_analysisType == {{ANALYSIS_TYPE}})
+     && (m_coordinateType == {{COORDINATE_TYPE}}))
+    {
+        res.x = {{EXPRESSION_X}};
+        res.y = {{EXPRESSION_Y}};
+        res.z = {{EXPRESSION_Z}};
     }
+    {{/VARIABLE_SOURCE}}
 
     return res;
 }
@@ -23,13 +23,50 @@
 #include <QObject>
 
 #include "util.h"
+#include "value.h"
 #include "hermes2d/field.h"
 #include "hermes2d.h"
 
+#include "hermes2d/plugin_interface.h"
+
 bool hasForce{{CLASS}}(const FieldInfo *fieldInfo);
 
-Point3 force{{CLASS}}(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType,
-                      Hermes::Hermes2D::Element *element, SceneMaterial *material, const Point3 &point, const Point3 &velocity = Point3());
+class {{CLASS}}ForceEvaluator : public ForceEvaluator
+{
+public:
+    {{CLASS}}ForceEvaluator(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType);
+
+    virtual Point3 force(Hermes::Hermes2D::Element *element, const Point3 &point, const Point3 &velocity);
+
+private:
+    // material values (evaluated in time of the solution)
+    struct MaterialValues
+    {
+        MaterialValues() : isValid(false) {}
+
+        bool isValid;
+        {{#VARIABLE_MATERIAL}}Value material_{{MATERIAL_VARIABLE}};
+        {{/VARIABLE_MATERIAL}}
+    };
+
+    AnalysisType m_analysisType;
+    CoordinateType m_coordinateType;
+
+    // solutions of components
+    QVector<Hermes::Hermes2D::Solution<double> *> m_solutions;
+    Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<double> > m_solutionsPtr;
+
+    // point values (preallocated)
+    QVector<double> m_value;
+    QVector<double> m_dudx;
+    QVector<double> m_dudy;
+
+    // const solution at first time step
+    bool m_isInitialCondition;
+    double m_initialCondition;
 
+    // indexed by element marker
+    QVector<MaterialValues> m_materials;
+};
 
 #endif // {{ID}}_FORCE_H
@@ -141,8 +141,8 @@ ExactSolutionScalarAgros<double> *{{CLASS}}Interface::exactSolution(const Proble
     return NULL;
 }
 
-Hermes::Hermes2D::ErrorCalculator<double> *{{CLASS}}Interface::errorCalculator(const FieldInfo *fieldInfo,
-                                                                               const QString &calculator, Hermes::Hermes2D::CalculatedErrorType errorType)
+ErrorCalculatorAgros<double> *{{CLASS}}Interface::errorCalculator(const FieldInfo *fieldInfo,
+                                                                  const QString &calculator, Hermes::Hermes2D::CalculatedErrorType errorType)
 {
     return new {{CLASS}}ErrorCalculator<double>(fieldInfo, calculator, errorType);
 }
@@ -165,16 +165,26 @@ IntegralValue *{{CLASS}}Interface::surfaceIntegral(const FieldInfo *fieldInfo, i
     return new {{CLASS}}SurfaceIntegral(fieldInfo, timeStep, adaptivityStep, solutionType);
 }
 
+IntegralValue *{{CLASS}}Interface::surfaceIntegral(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType,
+                                                   const QList<QSet<int> > &edges)
+{
+    return new {{CLASS}}SurfaceIntegral(fieldInfo, timeStep, adaptivityStep, solutionType, edges);
+}
+
 IntegralValue *{{CLASS}}Interface::volumeIntegral(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType)
 {
     return new {{CLASS}}VolumeIntegral(fieldInfo, timeStep, adaptivityStep, solutionType);
 }
 
-Point3 {{CLASS}}Interface::force(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType,
-                                 Hermes::Hermes2D::Element *element, SceneMaterial *material,
-                                 const Point3 &point, const Point3 &velocity)
+IntegralValue *{{CLASS}}Interface::volumeIntegral(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType,
+                                                  const QList<QSet<int> > &labels)
+{
+    return new {{CLASS}}VolumeIntegral(fieldInfo, timeStep, adaptivityStep, solutionType, labels);
+}
+
+ForceEvaluator *{{CLASS}}Interface::forceEvaluator(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType)
 {
-    return force{{CLASS}}(fieldInfo, timeStep, adaptivityStep, solutionType, element, material, point, velocity);
+    return new {{CLASS}}ForceEvaluator(fieldInfo, timeStep, adaptivityStep, solutionType);
 }
 
 bool {{CLASS}}Interface::hasForce(const FieldInfo *fieldInfo)
@@ -61,20 +61,22 @@ public:
                                                  PhysicFieldVariableComp physicFieldVariableComp);
 
     // error calculators
-    virtual Hermes::Hermes2D::ErrorCalculator<double> *errorCalculator(const FieldInfo *fieldInfo,
-                                                                       const QString &calculator, Hermes::Hermes2D::CalculatedErrorType errorType);
+    virtual ErrorCalculatorAgros<double> *errorCalculator(const FieldInfo *fieldInfo,
+                                                          const QString &calculator, Hermes::Hermes2D::CalculatedErrorType errorType);
 
     // local values
     virtual LocalValue *localValue(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType, const Point &point);
     // surface integrals
     virtual IntegralValue *surfaceIntegral(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType);
+    virtual IntegralValue *surfaceIntegral(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType,
+                                           const QList<QSet<int> > &edges);
     // volume integrals
     virtual IntegralValue *volumeIntegral(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType);
+    virtual IntegralValue *volumeIntegral(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType,
+                                          const QList<QSet<int> > &labels);
 
     // force calculation
-    virtual Point3 force(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType,
-                         Hermes::Hermes2D::Element *element, SceneMaterial *material,
-                         const Point3 &point, const Point3 &velocity);
+    virtual ForceEvaluator *forceEvaluator(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType);
     virtual bool hasForce(const FieldInfo *fieldInfo);
 
 
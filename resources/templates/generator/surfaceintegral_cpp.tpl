@@ -36,12 +36,18 @@ class {{CLASS}}SurfaceIntegralCalculator : public Hermes::Hermes2D::PostProcessi
 {
 public:
     {{CLASS}}SurfaceIntegralCalculator(const FieldInfo *fieldInfo, Hermes::Hermes2D::MeshFunctionSharedPtr<double> source_function, int number_of_integrals)
-        : Hermes::Hermes2D::PostProcessing::SurfaceIntegralCalculator<double>(source_function, number_of_integrals), m_fieldInfo(fieldInfo)
+        : Hermes::Hermes2D::PostProcessing::SurfaceIntegralCalculator<double>(source_function, number_of_integrals), m_fieldInfo(fieldInfo), m_slotCount(1)
     {
     }
 
     {{CLASS}}SurfaceIntegralCalculator(const FieldInfo *fieldInfo, Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<double> > source_functions, int number_of_integrals)
-        : Hermes::Hermes2D::PostProcessing::SurfaceIntegralCalculator<double>(source_functions, number_of_integrals), m_fieldInfo(fieldInfo)
+        : Hermes::Hermes2D::PostProcessing::SurfaceIntegralCalculator<double>(source_functions, number_of_integrals), m_fieldInfo(fieldInfo), m_slotCount(1)
+    {
+    }
+
+    // every edge accumulates into its own slot of integrals (slots are indexed by edge)
+    {{CLASS}}SurfaceIntegralCalculator(const FieldInfo *fieldInfo, Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<double> > source_functions, const QVector<int> &slots, int slotCount)
+        : Hermes::Hermes2D::PostProcessing::SurfaceIntegralCalculator<double>(source_functions, {{INTEGRAL_COUNT}} * slotCount), m_fieldInfo(fieldInfo), m_slots(slots), m_slotCount(slotCount)
     {
     }
 
@@ -50,6 +56,9 @@ public:
         SceneLabel *label = Agros2D::scene()->labels->at(atoi(m_fieldInfo->initialMesh()->get_element_markers_conversion().get_user_marker(e->elem_marker).marker.c_str()));
         SceneMaterial *material = label->marker(m_fieldInfo);
 
+        if (!m_slots.isEmpty())
+            result += m_slots[atoi(m_fieldInfo->initialMesh()->get_boundary_markers_conversion().get_user_marker(e->edge_marker).marker.c_str())] * {{INTEGRAL_COUNT}};
+
         double *x = e->x;
         double *y = e->y;
 
@@ -83,15 +92,22 @@ public:
 
     virtual void order(Hermes::Hermes2D::Func<Hermes::Ord> **fns, Hermes::Ord* result)
     {
-        {{#VARIABLE_SOURCE}}
-        if ((m_fieldInfo->analysisType() == {{ANALYSIS_TYPE}}) && (Agros2D::problem()->config()->coordinateType() == {{COORDINATE_TYPE}}))
-            result[{{POSITION}}] = Hermes::Ord(20);
-        {{/VARIABLE_SOURCE}}
+        for (int slot = 0; slot < m_slotCount; slot++)
+        {
+            {{#VARIABLE_SOURCE}}
+            if ((m_fieldInfo->analysisType() == {{ANALYSIS_TYPE}}) && (Agros2D::problem()->config()->coordinateType() == {{COORDINATE_TYPE}}))
+                result[slot * {{INTEGRAL_COUNT}} + {{POSITION}}] = Hermes::Ord(20);
+            {{/VARIABLE_SOURCE}}
+        }
     }
 
 private:
     // field info
     const FieldInfo *m_fieldInfo;
+
+    // slots of edges (batched evaluation)
+    QVector<int> m_slots;
+    int m_slotCount;
 };
 
 {{CLASS}}SurfaceIntegral::{{CLASS}}SurfaceIntegral(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType)
@@ -100,6 +116,13 @@ private:
     calculate();
 }
 
+{{CLASS}}SurfaceIntegral::{{CLASS}}SurfaceIntegral(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType,
+                                                   const QList<QSet<int> > &edges)
+    : IntegralValue(fieldInfo, timeStep, adaptivityStep, solutionType)
+{
+    calculate(edges);
+}
+
 void {{CLASS}}SurfaceIntegral::calculate()
 {
     m_values.clear();
@@ -150,3 +173,66 @@ void {{CLASS}}SurfaceIntegral::calculate()
         }
     }
 }
+
+void {{CLASS}}SurfaceIntegral::calculate(const QList<QSet<int> > &edges)
+{
+    m_values.clear();
+    m_regionValues.clear();
+    for (int i = 0; i < edges.count(); i++)
+        m_regionValues.append(QMap<QString, double>());
+
+    FieldSolutionID fsid(m_fieldInfo, m_timeStep, m_adaptivityStep, m_solutionType);
+    // check existence
+    if (!Agros2D::solutionStore()->contains(fsid))
+        return;
+
+    MultiArray<double> ma = Agros2D::solutionStore()->multiArray(fsid);
+
+    if (Agros2D::problem()->isSolved())
+    {
+        // update time functions
+        if (!Agros2D::problem()->isSolving() && m_fieldInfo->analysisType() == AnalysisType_Transient)
+        {
+            QList<double> timeLevels = Agros2D::solutionStore()->timeLevels(m_fieldInfo);
+            Module::updateTimeFunctions(timeLevels[m_timeStep]);
+        }
+
+        // every edge used in any set gets one slot, all sets are integrated in one mesh traversal
+        QVector<int> slots(Agros2D::scene()->edges->count(), -1);
+        Hermes::vector<std::string> markers;
+        foreach (QSet<int> set, edges)
+        {
+            foreach (int index, set)
+            {
+                if (slots[index] == -1)
+                {
+                    slots[index] = markers.size();
+                    markers.push_back(QString::number(index).toStdString());
+                }
+            }
+        }
+
+        if (markers.size() > 0)
+        {
+            {{CLASS}}SurfaceIntegralCalculator calc(m_fieldInfo, ma.solutions(), slots, markers.size());
+            double *values = calc.calculate(markers);
+
+            for (int i = 0; i < edges.count(); i++)
+            {
+                foreach (int index, edges[i])
+                {
+                    // internal edges are integrated from both sides
+                    double coefficient = Agros2D::scene()->edges->at(index)->marker(m_fieldInfo)->isNone() ? 0.5 : 1.0;
+                    double *slotValues = values + slots[index] * {{INTEGRAL_COUNT}};
+
+                    {{#VARIABLE_SOURCE}}
+                    if ((m_fieldInfo->analysisType() == {{ANALYSIS_TYPE}}) && (Agros2D::problem()->config()->coordinateType() == {{COORDINATE_TYPE}}))
+                        m_regionValues[i][QLatin1String("{{VARIABLE}}")] += coefficient * slotValues[{{POSITION}}];
+                    {{/VARIABLE_SOURCE}}
+                }
+            }
+
+            ::free(values);
+        }
+    }
+}
@@ -33,8 +33,11 @@ class {{CLASS}}SurfaceIntegral : public IntegralValue
 {
 public:
     {{CLASS}}SurfaceIntegral(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType);
+    {{CLASS}}SurfaceIntegral(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType,
+                             const QList<QSet<int> > &edges);
 
     void calculate();
+    void calculate(const QList<QSet<int> > &edges);
 };
 
 #endif // {{ID}}_SURFACEINTEGRAL_H
@@ -110,14 +110,22 @@ class {{CLASS}}VolumetricIntegralCalculator : public Hermes::Hermes2D::PostProce
 {
 public:
     {{CLASS}}VolumetricIntegralCalculator(const FieldInfo *fieldInfo, Hermes::Hermes2D::MeshFunctionSharedPtr<double> source_function, int number_of_integrals)
-        : Hermes::Hermes2D::PostProcessing::VolumetricIntegralCalculator<double>(source_function, number_of_integrals), m_fieldInfo(fieldInfo)
+        : Hermes::Hermes2D::PostProcessing::VolumetricIntegralCalculator<double>(source_function, number_of_integrals), m_fieldInfo(fieldInfo), m_slotCount(1)
     {
         {{#SPECIAL_FUNCTION_SOURCE}}
         {{SPECIAL_FUNCTION_NAME}} = QSharedPointer<{{SPECIAL_EXT_FUNCTION_FULL_NAME}}>(new {{SPECIAL_EXT_FUNCTION_FULL_NAME}}(m_fieldInfo, 0));{{/SPECIAL_FUNCTION_SOURCE}}
     }
 
     {{CLASS}}VolumetricIntegralCalculator(const FieldInfo *fieldInfo, Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<double> > source_functions, int number_of_integrals)
-        : Hermes::Hermes2D::PostProcessing::VolumetricIntegralCalculator<double>(source_functions, number_of_integrals), m_fieldInfo(fieldInfo)
+        : Hermes::Hermes2D::PostProcessing::VolumetricIntegralCalculator<double>(source_functions, number_of_integrals), m_fieldInfo(fieldInfo), m_slotCount(1)
+    {
+        {{#SPECIAL_FUNCTION_SOURCE}}
+        {{SPECIAL_FUNCTION_NAME}} = QSharedPointer<{{SPECIAL_EXT_FUNCTION_FULL_NAME}}>(new {{SPECIAL_EXT_FUNCTION_FULL_NAME}}(m_fieldInfo, 0));{{/SPECIAL_FUNCTION_SOURCE}}
+    }
+
+    // every label accumulates into its own slot of integrals (slots are indexed by label)
+    {{CLASS}}VolumetricIntegralCalculator(const FieldInfo *fieldInfo, Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<double> > source_functions, const QVector<int> &slots, int slotCount)
+        : Hermes::Hermes2D::PostProcessing::VolumetricIntegralCalculator<double>(source_functions, {{INTEGRAL_COUNT}} * slotCount), m_fieldInfo(fieldInfo), m_slots(slots), m_slotCount(slotCount)
     {
         {{#SPECIAL_FUNCTION_SOURCE}}
         {{SPECIAL_FUNCTION_NAME}} = QSharedPointer<{{SPECIAL_EXT_FUNCTION_FULL_NAME}}>(new {{SPECIAL_EXT_FUNCTION_FULL_NAME}}(m_fieldInfo, 0));{{/SPECIAL_FUNCTION_SOURCE}}
@@ -125,9 +133,13 @@ public:
 
     virtual void integral(int n, double* wt, Hermes::Hermes2D::Func<double> **fns, Hermes::Hermes2D::Geom<double> *e, double* result)
     {
-        SceneLabel *label = Agros2D::scene()->labels->at(atoi(m_fieldInfo->initialMesh()->get_element_markers_conversion().get_user_marker(e->elem_marker).marker.c_str()));
+        int labelIndex = atoi(m_fieldInfo->initialMesh()->get_element_markers_conversion().get_user_marker(e->elem_marker).marker.c_str());
+        SceneLabel *label = Agros2D::scene()->labels->at(labelIndex);
         SceneMaterial *material = label->marker(m_fieldInfo);
 
+        if (!m_slots.isEmpty())
+            result += m_slots[labelIndex] * {{INTEGRAL_COUNT}};
+
         double *x = e->x;
         double *y = e->y;
         int elementMarker = e->elem_marker;
@@ -167,16 +179,23 @@ public:
 
     virtual void order(Hermes::Hermes2D::Func<Hermes::Ord> **fns, Hermes::Ord* result)
     {
-        {{#VARIABLE_SOURCE}}
-        if ((m_fieldInfo->analysisType() == {{ANALYSIS_TYPE}}) && (Agros2D::problem()->config()->coordinateType() == {{COORDINATE_TYPE}}))
-            result[{{POSITION}}] = Hermes::Ord(20);
-        {{/VARIABLE_SOURCE}}
+        for (int slot = 0; slot < m_slotCount; slot++)
+        {
+            {{#VARIABLE_SOURCE}}
+            if ((m_fieldInfo->analysisType() == {{ANALYSIS_TYPE}}) && (Agros2D::problem()->config()->coordinateType() == {{COORDINATE_TYPE}}))
+                result[slot * {{INTEGRAL_COUNT}} + {{POSITION}}] = Hermes::Ord(20);
+            {{/VARIABLE_SOURCE}}
+        }
     }
 
 private:
     // field info
     const FieldInfo *m_fieldInfo;
 
+    // slots of labels (batched evaluation)
+    QVector<int> m_slots;
+    int m_slotCount;
+
     {{#SPECIAL_FUNCTION_SOURCE}}
     QSharedPointer<{{SPECIAL_EXT_FUNCTION_FULL_NAME}}> {{SPECIAL_FUNCTION_NAME}};{{/SPECIAL_FUNCTION_SOURCE}}
 };
@@ -187,6 +206,13 @@ private:
     calculate();
 }
 
+{{CLASS}}VolumeIntegral::{{CLASS}}VolumeIntegral(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType,
+                                                 const QList<QSet<int> > &labels)
+    : IntegralValue(fieldInfo, timeStep, adaptivityStep, solutionType)
+{
+    calculate(labels);
+}
+
 void {{CLASS}}VolumeIntegral::calculate()
 {
     m_values.clear();
@@ -229,37 +255,118 @@ void {{CLASS}}VolumeIntegral::calculate()
         }
 
         if ({{INTEGRAL_COUNT_EGGSHELL}} > 0)
+            calculateEggShell(ma.solutions(), markers, m_values);
+    }
+}
+
+void {{CLASS}}VolumeIntegral::calculate(const QList<QSet<int> > &labels)
+{
+    m_values.clear();
+    m_regionValues.clear();
+    for (int i = 0; i < labels.count(); i++)
+        m_regionValues.append(QMap<QString, double>());
+
+    FieldSolutionID fsid(m_fieldInfo, m_timeStep, m_adaptivityStep, m_solutionType);
+    // check existence
+    if (!Agros2D::solutionStore()->contains(fsid))
+        return;
+
+    MultiArray<double> ma = Agros2D::solutionStore()->multiArray(fsid);
+
+    if (Agros2D::problem()->isSolved())
+    {
+        // update time functions
+        if (!Agros2D::problem()->isSolving() && m_fieldInfo->analysisType() == AnalysisType_Transient)
+        {
+            QList<double> timeLevels = Agros2D::solutionStore()->timeLevels(m_fieldInfo);
+            Module::updateTimeFunctions(timeLevels[m_timeStep]);
+        }
+
+        // every label used in any set gets one slot, all sets are integrated in one mesh traversal
+        QVector<int> slots(Agros2D::scene()->labels->count(), -1);
+        Hermes::vector<std::string> markers;
+        foreach (QSet<int> set, labels)
         {
-            Hermes::vector<std::string> markersInverted;
-            for (int i = 0; i < Agros2D::scene()->labels->count(); i++)
+            foreach (int index, set)
             {
-                SceneLabel *label = Agros2D::scene()->labels->at(i);
-                if (!label->isSelected())
-                    markersInverted.push_back(QString::number(i).toStdString());
+                if (slots[index] == -1)
+                {
+                    slots[index] = markers.size();
+                    markers.push_back(QString::number(index).toStdString());
+                }
             }
+        }
 
-            if (markers.size() > 0 && markersInverted.size() > 0)
-            {
-                Hermes::Hermes2D::MeshSharedPtr eggShellMesh = Hermes::Hermes2D::EggShell::get_egg_shell(ma.solutions().at(0)->get_mesh(), markers, 3);
-                if(eggShellMesh->get_num_active_elements() == 0)
-                  return;
-                Hermes::Hermes2D::MeshFunctionSharedPtr<double> eggShell(new Hermes::Hermes2D::ExactSolutionEggShell(eggShellMesh, 3));
+        if (markers.size() > 0)
+        {
+            {{CLASS}}VolumetricIntegralCalculator calc(m_fieldInfo, ma.solutions(), slots, markers.size());
+            double *values = calc.calculate(markers);
 
-                Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<double> > slns;
-                for (int i = 0; i < ma.solutions().size(); i++)
-                    slns.push_back(ma.solutions().at(i));
-                slns.push_back(eggShell);
+            for (int i = 0; i < labels.count(); i++)
+            {
+                foreach (int index, labels[i])
+                {
+                    double *slotValues = values + slots[index] * {{INTEGRAL_COUNT}};
+
+                    {{#VARIABLE_SOURCE}}
+                    if ((m_fieldInfo->analysisType() == {{ANALYSIS_TYPE}}) && (Agros2D::problem()->config()->coordinateType() == {{COORDINATE_TYPE}}))
+                        m_regionValues[i][QLatin1String("{{VARIABLE}}")] += slotValues[{{POSITION}}];
+                    {{/VARIABLE_SOURCE}}
+                }
+            }
 
-                {{CLASS}}VolumetricIntegralEggShellCalculator calcEggShell(m_fieldInfo, slns, {{INTEGRAL_COUNT_EGGSHELL}});
-                double *valuesEggShell = calcEggShell.calculate(markersInverted);
+            ::free(values);
+        }
 
-                {{#VARIABLE_SOURCE_EGGSHELL}}
-                if ((m_fieldInfo->analysisType() == {{ANALYSIS_TYPE}}) && (Agros2D::problem()->config()->coordinateType() == {{COORDINATE_TYPE}}))
-                    m_values[QLatin1String("{{VARIABLE}}")] = valuesEggShell[{{POSITION}}];
-                {{/VARIABLE_SOURCE_EGGSHELL}}
+        // egg shell depends on the whole set, it is evaluated for each set separately
+        if ({{INTEGRAL_COUNT_EGGSHELL}} > 0)
+        {
+            for (int i = 0; i < labels.count(); i++)
+            {
+                Hermes::vector<std::string> setMarkers;
+                foreach (int index, labels[i])
+                    setMarkers.push_back(QString::number(index).toStdString());
 
-                ::free(valuesEggShell);
+                calculateEggShell(ma.solutions(), setMarkers, m_regionValues[i]);
             }
         }
     }
 }
+
+void {{CLASS}}VolumeIntegral::calculateEggShell(Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<double> > solutions,
+                                                const Hermes::vector<std::string> &markers, QMap<QString, double> &values)
+{
+    QSet<QString> markersSet;
+    for (int i = 0; i < markers.size(); i++)
+        markersSet.insert(QString::fromStdString(markers.at(i)));
+
+    Hermes::vector<std::string> markersInverted;
+    for (int i = 0; i < Agros2D::scene()->labels->count(); i++)
+    {
+        if (!markersSet.contains(QString::number(i)))
+            markersInverted.push_back(QString::number(i).toStdString());
+    }
+
+    if (markers.size() > 0 && markersInverted.size() > 0)
+    {
+        Hermes::Hermes2D::MeshSharedPtr eggShellMesh = Hermes::Hermes2D::EggShell::get_egg_shell(solutions.at(0)->get_mesh(), markers, 3);
+        if(eggShellMesh->get_num_active_elements() == 0)
+          return;
+        Hermes::Hermes2D::MeshFunctionSharedPtr<double> eggShell(new Hermes::Hermes2D::ExactSolutionEggShell(eggShellMesh, 3));
+
+        Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<double> > slns;
+        for (int i = 0; i < solutions.size(); i++)
+            slns.push_back(solutions.at(i));
+        slns.push_back(eggShell);
+
+        {{CLASS}}VolumetricIntegralEggShellCalculator calcEggShell(m_fieldInfo, slns, {{INTEGRAL_COUNT_EGGSHELL}});
+        double *valuesEggShell = calcEggShell.calculate(markersInverted);
+
+        {{#VARIABLE_SOURCE_EGGSHELL}}
+        if ((m_fieldInfo->analysisType() == {{ANALYSIS_TYPE}}) && (Agros2D::problem()->config()->coordinateType() == {{COORDINATE_TYPE}}))
+            values[QLatin1String("{{VARIABLE}}")] = valuesEggShell[{{POSITION}}];
+        {{/VARIABLE_SOURCE_EGGSHELL}}
+
+        ::free(valuesEggShell);
+    }
+}
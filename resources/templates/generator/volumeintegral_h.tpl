@@ -33,8 +33,15 @@ class {{CLASS}}VolumeIntegral : public IntegralValue
 {
 public:
     {{CLASS}}VolumeIntegral(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType);
+    {{CLASS}}VolumeIntegral(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep, SolutionMode solutionType,
+                            const QList<QSet<int> > &labels);
 
     void calculate();
+    void calculate(const QList<QSet<int> > &labels);
+
+private:
+    void calculateEggShell(Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<double> > solutions,
+                           const Hermes::vector<std::string> &markers, QMap<QString, double> &values);
 };
 
 #endif // {{CLASS}}_VOLUMEINTEGRAL_H
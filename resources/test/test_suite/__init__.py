@@ -132,6 +132,7 @@ adaptivity.adaptivity.TestAdaptivityMagneticProfileConductor,
 adaptivity.adaptivity.TestAdaptivityRF_TE,
 adaptivity.adaptivity.TestAdaptivityHLenses,
 adaptivity.adaptivity.TestAdaptivityPAndHCoupled,
+adaptivity.adaptivity.TestAdaptivityReferenceSpaceReuse,
 # particle tracing
 particle_tracing.particle_tracing.TestParticleTracingPlanar,
 particle_tracing.particle_tracing.TestParticleTracingAxisymmetric,
@@ -483,6 +483,69 @@ class TestAdaptivityPAndHCoupled(Agros2DTestCase):
         point_mag = self.magnetic.local_values(2.920e-01, 1.333e-01)
         self.value_test("Flux density", point_mag["Br"], 5.893e-01, 0.025)
         
+class TestAdaptivityReferenceSpaceReuse(Agros2DTestCase):
+    # single component p-adaptivity keeps the coarse mesh, reference mesh is reused
+    def setUp(self):  
+        # problem
+        self.problem = agros2d.problem(clear = True)
+        self.problem.coordinate_type = "axisymmetric"
+        self.problem.mesh_type = "triangle"
+        
+        # disable view
+        agros2d.view.mesh.disable()
+        agros2d.view.post2d.disable()
+        
+        # fields
+        # electrostatic
+        self.electrostatic = agros2d.field("electrostatic")
+        self.electrostatic.analysis_type = "steadystate"
+        self.electrostatic.polynomial_order = 1
+        
+        self.electrostatic.adaptivity_type = "p-adaptivity"
+        self.electrostatic.adaptivity_parameters['steps'] = 5
+        self.electrostatic.adaptivity_parameters['tolerance'] = 0
+        self.electrostatic.adaptivity_parameters['error_calculator'] = "h1"
+        self.electrostatic.solver = "linear"
+        
+        # boundaries
+        self.electrostatic.add_boundary("Source", "electrostatic_potential", {"electrostatic_potential" : 1000})
+        self.electrostatic.add_boundary("Ground", "electrostatic_potential", {"electrostatic_potential" : 0})
+        self.electrostatic.add_boundary("Border", "electrostatic_surface_charge_density", {"electrostatic_surface_charge_density" : 0})
+        
+        # materials
+        self.electrostatic.add_material("Air", {"electrostatic_permittivity" : 1, "electrostatic_charge_density" : 0})
+        
+        # geometry
+        geometry = agros2d.geometry
+        geometry.add_edge(0.2, 1, 0, 0.5, boundaries = {"electrostatic" : "Source"})
+        geometry.add_edge(0, 0.5, 0, 0.25, boundaries = {"electrostatic" : "Border"})
+        geometry.add_edge(0, -0.25, 0, -1, boundaries = {"electrostatic" : "Border"})
+        geometry.add_edge(0, -1, 1.5, 0.5, angle = 90, boundaries = {"electrostatic" : "Border"})
+        geometry.add_edge(1.5, 0.5, 0, 2, angle = 90, boundaries = {"electrostatic" : "Border"})
+        geometry.add_edge(0, 1, 0.2, 1, boundaries = {"electrostatic" : "Source"})
+        geometry.add_edge(0, 2, 0, 1, boundaries = {"electrostatic" : "Border"})
+        geometry.add_edge(0, -0.25, 0.25, 0, angle = 90, boundaries = {"electrostatic" : "Ground"})
+        geometry.add_edge(0.25, 0, 0, 0.25, angle = 90, boundaries = {"electrostatic" : "Ground"})
+        
+        geometry.add_label(0.879551, 0.764057, area = 0.06, materials = {"electrostatic" : "Air"})
+        agros2d.view.zoom_best_fit()
+
+    def test_reuse(self):
+        # statistics are cleared with the problem
+        info = self.problem.reference_space_cache_info()
+        self.assertEqual(info['hits'], 0)
+        self.assertEqual(info['misses'], 0)
+
+        self.problem.solve()
+        
+        # reference meshes of later steps are not created again
+        self.assertTrue(len(self.electrostatic.adaptivity_info()['dofs']) > 1)
+        self.assertTrue(self.problem.reference_space_cache_info()['hits'] > 0)
+        
+        # solution on reused reference meshes (see TestAdaptivityElectrostatic)
+        point = self.electrostatic.local_values(3.278e-2, 4.624e-1)
+        self.value_test("Electrostatic potential", point["V"], 5.569e2)
+        
 if __name__ == '__main__':        
     import unittest as ut
     
@@ -495,5 +558,6 @@ if __name__ == '__main__':
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestAdaptivityRF_TE))  
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestAdaptivityHLenses))  
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestAdaptivityPAndHCoupled))  
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestAdaptivityReferenceSpaceReuse))  
       
     suite.run(result)
\ No newline at end of file
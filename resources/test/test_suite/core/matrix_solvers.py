@@ -161,10 +161,151 @@ class TestInternalMatrixSolvers(Agros2DTestCase):
         self.assertTrue(np.allclose(self.reference_rhs, external_rhs, rtol=1e-15, atol=1e-10), 
                         "EXTERNAL rhs failed.")        
 
+class TestMixedPrecisionMatrixSolver(Agros2DTestCase):
+    @classmethod
+    def model(self, mixed_precision, outer_tolerance = 1e-10):
+        problem = agros2d.problem(clear = True)
+        problem.coordinate_type = "planar"
+        problem.mesh_type = "triangle"
+
+        electrostatic = agros2d.field("electrostatic")
+        electrostatic.analysis_type = "steadystate"
+        electrostatic.matrix_solver = "paralution_iterative"
+        electrostatic.matrix_solver_parameters['method'] = "bicgstab"
+        electrostatic.matrix_solver_parameters['preconditioner'] = "ilu"
+        electrostatic.matrix_solver_parameters['tolerance'] = 1e-12
+        electrostatic.matrix_solver_parameters['mixed_precision'] = mixed_precision
+        electrostatic.matrix_solver_parameters['mixed_precision_inner_tolerance'] = 1e-3
+        electrostatic.matrix_solver_parameters['mixed_precision_outer_tolerance'] = outer_tolerance
+        electrostatic.number_of_refinements = 2
+        electrostatic.polynomial_order = 2
+        electrostatic.adaptivity_type = "disabled"
+        electrostatic.solver = "linear"
+
+        electrostatic.add_boundary("Source", "electrostatic_potential", {"electrostatic_potential" : 1000})
+        electrostatic.add_boundary("Ground", "electrostatic_potential", {"electrostatic_potential" : 0})
+        electrostatic.add_boundary("Neumann", "electrostatic_surface_charge_density", {"electrostatic_surface_charge_density" : 0})
+
+        electrostatic.add_material("Air", {"electrostatic_permittivity" : 1, "electrostatic_charge_density" : 0})
+        electrostatic.add_material("Dielectric", {"electrostatic_permittivity" : 5, "electrostatic_charge_density" : 1e-6})
+
+        geometry = agros2d.geometry
+        geometry.add_edge(0, 0, 0.1, 0, boundaries = {"electrostatic" : "Ground"})
+        geometry.add_edge(0.1, 0, 0.1, 0.1, boundaries = {"electrostatic" : "Neumann"})
+        geometry.add_edge(0.1, 0.1, 0, 0.1, boundaries = {"electrostatic" : "Source"})
+        geometry.add_edge(0, 0.1, 0, 0, boundaries = {"electrostatic" : "Neumann"})
+        geometry.add_edge(0.03, 0.03, 0.07, 0.03)
+        geometry.add_edge(0.07, 0.03, 0.07, 0.07)
+        geometry.add_edge(0.07, 0.07, 0.03, 0.07)
+        geometry.add_edge(0.03, 0.07, 0.03, 0.03)
+
+        geometry.add_label(0.01, 0.01, materials = {"electrostatic" : "Air"})
+        geometry.add_label(0.05, 0.05, materials = {"electrostatic" : "Dielectric"})
+
+        problem.solve()
+
+        return electrostatic
+
+    def test_mixed_precision(self):
+        # double precision
+        electrostatic = self.model(False)
+        double_info = electrostatic.linear_solver_info()
+        double_value = electrostatic.local_values(0.05, 0.05)["V"]
+
+        # mixed precision
+        electrostatic = self.model(True)
+        mixed_info = electrostatic.linear_solver_info()
+        mixed_value = electrostatic.local_values(0.05, 0.05)["V"]
+
+        self.assertTrue(mixed_info['iterations'] > 0, "Mixed precision solver did not iterate.")
+        self.assertTrue(mixed_info['inner_iterations'] >= mixed_info['iterations'], "Inner iterations are not counted.")
+        self.assertTrue(mixed_info['residual'] <= max(1e-12, 10.0 * double_info['residual']),
+                        "Final residual of mixed precision solver ({0}) does not match double precision ({1}).".format(mixed_info['residual'], double_info['residual']))
+        self.value_test("Potential", mixed_value, double_value, 1e-6)
+
+    def test_outer_tolerance(self):
+        # absolute tolerance (1e-12) is not reached, outer loop stops at relative tolerance
+        loose_info = self.model(True, 1e-3).linear_solver_info()
+        tight_info = self.model(True, 1e-10).linear_solver_info()
+
+        self.assertTrue(loose_info['iterations'] < tight_info['iterations'],
+                        "Outer relative tolerance is not used ({0} and {1} iterations).".format(loose_info['iterations'], tight_info['iterations']))
+        self.assertTrue(loose_info['residual'] > tight_info['residual'])
+
+    def test_persisted_statistics(self):
+        import tempfile
+        import os
+
+        info = self.model(True).linear_solver_info()
+
+        file_name = tempfile.mktemp(suffix = ".a2d")
+        agros2d.save_file(file_name, True)
+        agros2d.open_file(file_name, True)
+        os.remove(file_name)
+
+        persisted_info = agros2d.field("electrostatic").linear_solver_info()
+        self.assertEqual(persisted_info['iterations'], info['iterations'])
+        self.assertEqual(persisted_info['inner_iterations'], info['inner_iterations'])
+        self.assertAlmostEqual(persisted_info['residual'], info['residual'])
+
+class TestIterativeMatrixSolverParameters(Agros2DTestCase):
+    def model(self, solver, iterations):
+        problem = agros2d.problem(clear = True)
+        problem.coordinate_type = "planar"
+        problem.mesh_type = "triangle"
+
+        electrostatic = agros2d.field("electrostatic")
+        electrostatic.analysis_type = "steadystate"
+        electrostatic.matrix_solver = solver
+        electrostatic.matrix_solver_parameters['method'] = "cg"
+        electrostatic.matrix_solver_parameters['preconditioner'] = "jacobi"
+        electrostatic.matrix_solver_parameters['tolerance'] = 1e-15
+        electrostatic.matrix_solver_parameters['iterations'] = iterations
+        electrostatic.number_of_refinements = 2
+        electrostatic.polynomial_order = 2
+        electrostatic.adaptivity_type = "disabled"
+        electrostatic.solver = "linear"
+
+        electrostatic.add_boundary("Source", "electrostatic_potential", {"electrostatic_potential" : 1000})
+        electrostatic.add_boundary("Ground", "electrostatic_potential", {"electrostatic_potential" : 0})
+
+        electrostatic.add_material("Air", {"electrostatic_permittivity" : 1, "electrostatic_charge_density" : 0})
+
+        geometry = agros2d.geometry
+        geometry.add_edge(0, 0, 0.1, 0, boundaries = {"electrostatic" : "Ground"})
+        geometry.add_edge(0.1, 0, 0.1, 0.1)
+        geometry.add_edge(0.1, 0.1, 0, 0.1, boundaries = {"electrostatic" : "Source"})
+        geometry.add_edge(0, 0.1, 0, 0)
+        geometry.add_label(0.05, 0.05, materials = {"electrostatic" : "Air"})
+
+        problem.solve()
+
+        return electrostatic.linear_solver_info()
+
+    def check_iterations(self, solver):
+        # the unreachable tolerance makes the solver run until the iteration limit
+        limited = self.model(solver, 3)
+        self.assertTrue(0 < limited['iterations'] <= 3,
+                        "Solver '{0}' did not receive the iteration limit ({1} iterations).".format(solver, limited['iterations']))
+
+        unlimited = self.model(solver, 1000)
+        self.assertTrue(unlimited['iterations'] > 3,
+                        "Solver '{0}' did not receive the iteration limit ({1} iterations).".format(solver, unlimited['iterations']))
+        self.assertTrue(unlimited['residual'] < limited['residual'],
+                        "Solver '{0}' did not converge further with more iterations.".format(solver))
+
+    def test_paralution_iterative(self):
+        self.check_iterations("paralution_iterative")
+
+    def test_paralution_amg(self):
+        self.check_iterations("paralution_amg")
+
 if __name__ == '__main__':        
     import unittest as ut
     
     suite = ut.TestSuite()
     result = Agros2DTestResult()
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestInternalMatrixSolvers))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestMixedPrecisionMatrixSolver))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestIterativeMatrixSolverParameters))
     suite.run(result)
\ No newline at end of file
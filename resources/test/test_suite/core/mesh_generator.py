@@ -62,6 +62,10 @@ class TestMeshGenerator(Agros2DTestCase):
         self.problem.mesh_type = "triangle_quad_join"
         self.solution_test_values()
 
+    def test_triangle_parallel(self):
+        self.problem.mesh_type = "triangle_parallel"
+        self.solution_test_values()
+
     def test_gmsh_triangle(self):
         self.problem.mesh_type = "gmsh_triangle"
         self.solution_test_values()
@@ -95,11 +99,158 @@ class TestMeshGenerator(Agros2DTestCase):
        surface = self.heat.surface_integrals([0, 6, 7])
        self.value_test("Heat flux", surface["f"], -85.821798)
     
+class TestMeshGeneratorParallel(Agros2DTestCase):
+    def setUp(self):
+        # model
+        self.problem = agros2d.problem(clear = True)
+        self.problem.coordinate_type = "planar"
+        self.problem.mesh_type = "triangle_parallel"
+
+        # disable view
+        agros2d.view.mesh.disable()
+        agros2d.view.post2d.disable()
+
+        # fields
+        self.heat = agros2d.field("heat")
+        self.heat.analysis_type = "steadystate"
+        self.heat.number_of_refinements = 0
+        self.heat.polynomial_order = 1
+        self.heat.solver = "linear"
+
+        self.heat.add_boundary("T left", "heat_temperature", {"heat_temperature" : 0})
+        self.heat.add_boundary("T right", "heat_temperature", {"heat_temperature" : 1})
+        self.heat.add_boundary("Neumann", "heat_heat_flux", {"heat_heat_flux" : 0, "heat_convection_heat_transfer_coefficient" : 0, "heat_convection_external_temperature" : 0})
+
+        self.heat.add_material("Material", {"heat_volume_heat" : 0, "heat_conductivity" : 1, "heat_density" : 0, "heat_velocity_x" : 0, "heat_velocity_y" : 0, "heat_specific_heat" : 0, "heat_velocity_angular" : 0})
+
+        # geometry (unit square divided into n x n labels with different areas)
+        self.n = 4
+        geometry = agros2d.geometry
+        for i in range(self.n):
+            for j in range(self.n):
+                x = float(i) / self.n
+                y = float(j) / self.n
+                h = 1.0 / self.n
+
+                geometry.add_edge(x, y, x + h, y, boundaries = {"heat" : "Neumann"} if j == 0 else {})
+                geometry.add_edge(x, y, x, y + h, boundaries = {"heat" : "T left"} if i == 0 else {})
+                if (j == self.n - 1):
+                    geometry.add_edge(x, y + h, x + h, y + h, boundaries = {"heat" : "Neumann"})
+                if (i == self.n - 1):
+                    geometry.add_edge(x + h, y, x + h, y + h, boundaries = {"heat" : "T right"})
+
+                geometry.add_label(x + h / 2.0, y + h / 2.0, materials = {"heat" : "Material"}, area = 1e-4 if (i + j) % 2 else 1e-3)
+
+    def test_conformity(self):
+        # linear solution is reproduced exactly on a conforming mesh only
+        # (disconnected subdomains would behave as insulated regions)
+        self.problem.solve()
+
+        for x, y in [(0.1, 0.1), (0.25, 0.4), (0.5, 0.5), (0.6, 0.75), (0.875, 0.3)]:
+            point = self.heat.local_values(x, y)
+            self.value_test("Temperature ({0}, {1})".format(x, y), point["T"], x, 1e-3)
+
+        volume = self.heat.volume_integrals(list(range(self.n * self.n)))
+        self.value_test("Temperature", volume["T"], 0.5, 1e-3)
+
+    def test_serial(self):
+        self.problem.mesh_type = "triangle"
+        self.problem.mesh()
+        serial = self.heat.initial_mesh_info()
+
+        self.problem.mesh_type = "triangle_parallel"
+        self.problem.mesh()
+        parallel = self.heat.initial_mesh_info()
+
+        # area constraints are kept in all subdomains
+        self.assertTrue(parallel["elements"] >= 0.5 * serial["elements"])
+
+class TestMeshCache(Agros2DTestCase):
+    def setUp(self):
+        # model
+        self.problem = agros2d.problem(clear = True)
+        self.problem.coordinate_type = "planar"
+        self.problem.mesh_type = "triangle"
+
+        # disable view
+        agros2d.view.mesh.disable()
+        agros2d.view.post2d.disable()
+
+        self.mesh_cache = agros2d.options.mesh_cache
+        agros2d.options.mesh_cache = True
+
+        # fields
+        self.heat = agros2d.field("heat")
+        self.heat.analysis_type = "steadystate"
+        self.heat.number_of_refinements = 1
+        self.heat.polynomial_order = 2
+        self.heat.solver = "linear"
+
+        self.heat.add_boundary("T left", "heat_temperature", {"heat_temperature" : 0})
+        self.heat.add_boundary("T right", "heat_temperature", {"heat_temperature" : 1})
+        self.heat.add_boundary("Neumann", "heat_heat_flux", {"heat_heat_flux" : 0, "heat_convection_heat_transfer_coefficient" : 0, "heat_convection_external_temperature" : 0})
+
+        self.heat.add_material("Material", {"heat_volume_heat" : 0, "heat_conductivity" : 1, "heat_density" : 0, "heat_velocity_x" : 0, "heat_velocity_y" : 0, "heat_specific_heat" : 0, "heat_velocity_angular" : 0})
+
+        # geometry
+        geometry = agros2d.geometry
+        geometry.add_edge(0, 0, 1, 0, boundaries = {"heat" : "Neumann"})
+        geometry.add_edge(1, 0, 1, 1, boundaries = {"heat" : "T right"})
+        geometry.add_edge(1, 1, 0, 1, boundaries = {"heat" : "Neumann"})
+        geometry.add_edge(0, 1, 0, 0, boundaries = {"heat" : "T left"})
+        geometry.add_edge(0.5, 0, 0.5, 1, angle = 30)
+        geometry.add_label(0.25, 0.5, materials = {"heat" : "Material"}, area = 0.005)
+        geometry.add_label(0.75, 0.5, materials = {"heat" : "Material"}, area = 0.002)
+
+    def tearDown(self):
+        agros2d.options.mesh_cache = self.mesh_cache
+
+    def test_material_change(self):
+        self.problem.mesh()
+        info = self.problem.mesh_cache_info()
+        mesh = self.heat.initial_mesh_info()
+
+        # material values do not change the mesh
+        self.heat.modify_material("Material", {"heat_conductivity" : 10})
+        self.problem.mesh()
+        self.assertEqual(self.problem.mesh_cache_info()["hits"], info["hits"] + 1)
+        self.assertEqual(self.problem.mesh_cache_info()["misses"], info["misses"])
+        self.assertEqual(self.heat.initial_mesh_info(), mesh)
+
+        # solution on cached mesh (curved edge and boundary markers)
+        self.problem.solve()
+        self.value_test("Temperature", self.heat.local_values(0.1, 0.5)["T"], 0.1, 1e-3)
+        self.value_test("Temperature", self.heat.local_values(0.9, 0.2)["T"], 0.9, 1e-3)
+
+    def test_geometry_change(self):
+        import random
+
+        self.problem.mesh()
+        info = self.problem.mesh_cache_info()
+
+        # area constraint is a part of the key (random value is not in the cache)
+        agros2d.geometry.modify_label(1, area = 0.001 * (1.0 + random.random()), materials = {"heat" : "Material"})
+        self.problem.mesh()
+        self.assertEqual(self.problem.mesh_cache_info()["hits"], info["hits"])
+        self.assertEqual(self.problem.mesh_cache_info()["misses"], info["misses"] + 1)
+
+    def test_disabled(self):
+        self.problem.mesh()
+        mesh = self.heat.initial_mesh_info()
+
+        agros2d.options.mesh_cache = False
+        info = self.problem.mesh_cache_info()
+        self.problem.mesh()
+        self.assertEqual(self.problem.mesh_cache_info(), info)
+        self.assertEqual(self.heat.initial_mesh_info(), mesh)
+
 if __name__ == '__main__':        
     import unittest as ut
 
     suite = ut.TestSuite()
     result = Agros2DTestResult()
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestMeshGenerator))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestMeshGeneratorParallel))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestMeshCache))
     suite.run(result)
     
\ No newline at end of file
@@ -204,6 +204,8 @@ class TestHeatNonlinPlanar(Agros2DTestCase):
         self.value_test("Heat flux", surface["f"], 96464.56418)
         
 class BenchmarkHeatTransientAxisymmetric(Agros2DTestCase):
+    error_estimator = "lower_order"
+
     def setUp(self):  
         # benchmark 
         #
@@ -219,6 +221,7 @@ class BenchmarkHeatTransientAxisymmetric(Agros2DTestCase):
         problem.time_step_method = "adaptive"
         problem.time_method_order = 3
         problem.time_method_tolerance = 1.0
+        problem.time_method_error_estimator = self.error_estimator
         problem.time_steps = 20
         problem.time_total = 190
 
@@ -258,6 +261,10 @@ class BenchmarkHeatTransientAxisymmetric(Agros2DTestCase):
         # point value
         point = self.heat.local_values(0.1, 0.3)
         self.value_test("Temperature", point["T"], 186.5, 0.0004) # permissible error 0.02 %
+
+class BenchmarkHeatTransientAxisymmetricEmbedded(BenchmarkHeatTransientAxisymmetric):
+    # time error estimated without the extra lower order solve
+    error_estimator = "embedded"
         
 class TestHeatTransientAxisymmetric(Agros2DTestCase):
     def setUp(self):  
@@ -363,4 +370,5 @@ if __name__ == '__main__':
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestHeatNonlinPlanar))
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestHeatTransientAxisymmetric))
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(BenchmarkHeatTransientAxisymmetric))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(BenchmarkHeatTransientAxisymmetricEmbedded))
     suite.run(result)
\ No newline at end of file
@@ -3,6 +3,7 @@ from test_suite.scenario import Agros2DTestCase
 from test_suite.scenario import Agros2DTestResult
 
 from math import sin, cos
+from multiprocessing import cpu_count
 
 class BenchmarkGeometryTransformation(Agros2DTestCase):
     def setUp(self):
@@ -26,10 +27,611 @@ class BenchmarkGeometryTransformation(Agros2DTestCase):
         for i in range(25):
             self.geometry.scale_selection(0, 0, 0.5)
             
+class BenchmarkGeometryBulkInsert(Agros2DTestCase):
+    def setUp(self):
+        self.problem = a2d.problem(clear = True)
+        self.geometry = a2d.geometry
+
+    def grid(self, edges):
+        # structured grid, inner nodes are shared by four edges
+        n = int((edges / 2.0)**0.5)
+        with self.geometry.transaction():
+            for i in range(n):
+                for j in range(n):
+                    self.geometry.add_edge(i, j, i + 1, j)
+                    self.geometry.add_edge(i, j, i, j + 1)
+
+        self.assertEqual(self.geometry.edges_count(), 2*n*n)
+        self.assertEqual(self.geometry.nodes_count(), (n + 1)**2 - 1)
+
+    def test_edges_10k(self):
+        self.grid(10000)
+
+    def test_edges_50k(self):
+        self.grid(50000)
+
+class BenchmarkGeometryBatch(Agros2DTestCase):
+    def setUp(self):
+        self.problem = a2d.problem(clear = True)
+        self.geometry = a2d.geometry
+
+        # structured grid, 2*n*n edges
+        n = int((20000 / 2.0)**0.5)
+        self.x1 = []
+        self.y1 = []
+        self.x2 = []
+        self.y2 = []
+        for i in range(n):
+            for j in range(n):
+                self.x1 += [i, i]
+                self.y1 += [j, j]
+                self.x2 += [i + 1, i]
+                self.y2 += [j, j + 1]
+
+        try:
+            import numpy as np
+            self.x1, self.y1, self.x2, self.y2 = [np.array(values, dtype = float) for values in
+                                                  [self.x1, self.y1, self.x2, self.y2]]
+        except ImportError:
+            pass
+
+    def add_single(self):
+        with self.geometry.transaction():
+            for i in range(len(self.x1)):
+                self.geometry.add_edge(self.x1[i], self.y1[i], self.x2[i], self.y2[i])
+
+    def add_batch(self):
+        self.geometry.add_edges(self.x1, self.y1, self.x2, self.y2)
+
+    def test_add_edges(self):
+        from time import time
+
+        start = time()
+        self.add_single()
+        time_single = time() - start
+
+        a2d.problem(clear = True)
+
+        start = time()
+        self.add_batch()
+        time_batch = time() - start
+
+        self.assertEqual(self.geometry.edges_count(), len(self.x1))
+        print("add {0} edges: single: {1:.3f} s, batch: {2:.3f} s (speedup {3:.1f})".format(
+            len(self.x1), time_single, time_batch, time_single / time_batch))
+
+    def test_modify_edges(self):
+        from time import time
+
+        self.add_batch()
+        indexes = range(0, self.geometry.edges_count(), 10)
+
+        start = time()
+        for index in indexes:
+            self.geometry.modify_edge(index, angle = 10)
+        time_single = time() - start
+
+        start = time()
+        self.geometry.modify_edges(indexes, angles = 20)
+        time_batch = time() - start
+
+        print("modify {0} edges: single: {1:.3f} s, batch: {2:.3f} s (speedup {3:.1f})".format(
+            len(indexes), time_single, time_batch, time_single / time_batch))
+
+class BenchmarkLargeGeometry(Agros2DTestCase):
+    def setUp(self):
+        import resource
+        import time
+
+        self.problem = a2d.problem(clear = True)
+        self.geometry = a2d.geometry
+
+        # structured grid with 100k edges
+        memory = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+        start = time.time()
+
+        n = int((100000 / 2.0)**0.5)
+        with self.geometry.transaction():
+            for i in range(n):
+                for j in range(n):
+                    self.geometry.add_edge(i, j, i + 1, j)
+                    self.geometry.add_edge(i, j, i, j + 1)
+
+        print("large geometry: {0} edges in {1:.3f} s, maximum resident set size +{2} kB".format(
+            self.geometry.edges_count(), time.time() - start,
+            resource.getrusage(resource.RUSAGE_SELF).ru_maxrss - memory))
+
+    def test_traversal(self):
+        import time
+
+        self.geometry.select_nodes()
+
+        start = time.time()
+        for i in range(5):
+            self.geometry.move_selection(1, 0)
+        print("large geometry: 5 moves of {0} nodes in {1:.3f} s".format(
+            self.geometry.nodes_count(), time.time() - start))
+
+        self.assertEqual(self.geometry.edges_count(), 2 * int((100000 / 2.0)**0.5)**2)
+
+    def test_clear(self):
+        import time
+
+        start = time.time()
+        a2d.problem(clear = True)
+        print("large geometry: cleared in {0:.3f} s".format(time.time() - start))
+
+        self.assertEqual(self.geometry.nodes_count(), 0)
+        self.assertEqual(self.geometry.edges_count(), 0)
+
+class BenchmarkParametricGeometry(Agros2DTestCase):
+    def setUp(self):
+        import re
+        import tempfile
+        import __main__
+
+        self.problem = a2d.problem(clear = True)
+        self.geometry = a2d.geometry
+
+        # structured grid (about 5k nodes and 10k edges)
+        n = 70
+        with self.geometry.transaction():
+            for i in range(n):
+                for j in range(n):
+                    self.geometry.add_edge(i, j, i + 1, j)
+                    self.geometry.add_edge(i, j, i, j + 1)
+
+        self.file_name = tempfile.mktemp(suffix = ".a2d")
+        a2d.save_file(self.file_name)
+
+        # node coordinates depend on parameters (first node on "b", others on "a")
+        with open(self.file_name) as f:
+            content = f.read()
+
+        content = re.sub(r'valuex="([^"]*)"', r'valuex="\1 + a"', content)
+        content = content.replace(' + a"', ' + b"', 1)
+
+        with open(self.file_name, "w") as f:
+            f.write(content)
+
+        __main__.a = 0.0
+        __main__.b = 0.0
+        a2d.open_file(self.file_name)
+
+    def tearDown(self):
+        import os
+        os.remove(self.file_name)
+
+    def change_parameter(self, name, value):
+        import time
+        import __main__
+
+        evaluations = self.problem.value_cache_info()["evaluations"]
+        setattr(__main__, name, value)
+
+        # geometry is not modified, invalidation evaluates changed values only
+        start = time.time()
+        self.problem.refresh()
+        elapsed = time.time() - start
+
+        return self.problem.value_cache_info()["evaluations"] - evaluations, elapsed
+
+    def test_unchanged_parameters(self):
+        evaluations, elapsed = self.change_parameter("a", 0.0)
+        print("parametric geometry: {0} evaluations in {1:.3f} s".format(evaluations, elapsed))
+
+        self.assertEqual(evaluations, 0)
+        self.assertEqual(self.geometry.node_point(1), (1.0, 0.0))
+
+    def test_change_one_node_parameter(self):
+        evaluations, elapsed = self.change_parameter("b", -0.1)
+        print("parametric geometry: {0} evaluations in {1:.3f} s".format(evaluations, elapsed))
+
+        # only the node depending on "b" is evaluated
+        self.assertTrue(1 <= evaluations <= 2)
+        self.assertAlmostEqual(self.geometry.node_point(0)[0], -0.1)
+        self.assertAlmostEqual(self.geometry.node_point(1)[0], 1.0)
+
+    def test_change_all_nodes_parameter(self):
+        evaluations, elapsed = self.change_parameter("a", 0.1)
+        print("parametric geometry: {0} evaluations in {1:.3f} s".format(evaluations, elapsed))
+
+        # all nodes depending on "a" are evaluated in one batch
+        self.assertTrue(1 <= evaluations <= 2)
+        self.assertAlmostEqual(self.geometry.node_point(0)[0], 0.0)
+        self.assertAlmostEqual(self.geometry.node_point(1)[0], 1.1)
+        self.assertAlmostEqual(self.geometry.node_point(1)[1], 0.0)
+
+class BenchmarkAdaptivityThreads(Agros2DTestCase):
+    def setUp(self):
+        self.problem = a2d.problem(clear = True)
+        self.problem.coordinate_type = "planar"
+        self.problem.mesh_type = "triangle"
+        self.problem.frequency = 50000
+
+        a2d.view.mesh.disable()
+        a2d.view.post2d.disable()
+
+        self.magnetic = a2d.field("magnetic")
+        self.magnetic.analysis_type = "harmonic"
+        self.magnetic.matrix_solver = "mumps"
+        self.magnetic.polynomial_order = 1
+        self.magnetic.adaptivity_type = "hp-adaptivity"
+        self.magnetic.adaptivity_parameters['steps'] = 3
+        self.magnetic.adaptivity_parameters['tolerance'] = 0
+        self.magnetic.adaptivity_parameters['threshold'] = 0.6
+        self.magnetic.adaptivity_parameters['stopping_criterion'] = "singleelement"
+        self.magnetic.adaptivity_parameters['error_calculator'] = "h1"
+        self.magnetic.adaptivity_parameters['anisotropic_refinement'] = True
+        self.magnetic.adaptivity_parameters['order_increase'] = 1
+        self.magnetic.solver = "linear"
+
+        self.magnetic.add_boundary("Neumann", "magnetic_surface_current", {"magnetic_surface_current_real" : 0, "magnetic_surface_current_imag" : 0})
+        self.magnetic.add_boundary("A = 0", "magnetic_potential", {"magnetic_potential_real" : 0, "magnetic_potential_imag" : 0})
+
+        self.magnetic.add_material("Air", {"magnetic_permeability" : 1, "magnetic_conductivity" : 0, "magnetic_remanence" : 0, "magnetic_remanence_angle" : 0, "magnetic_velocity_x" : 0, "magnetic_velocity_y" : 0, "magnetic_velocity_angular" : 0, "magnetic_current_density_external_real" : 0, "magnetic_current_density_external_imag" : 0, "magnetic_total_current_prescribed" : 0, "magnetic_total_current_real" : 0, "magnetic_total_current_imag" : 0})
+        self.magnetic.add_material("Copper", {"magnetic_permeability" : 1, "magnetic_conductivity" : 57e6, "magnetic_remanence" : 0, "magnetic_remanence_angle" : 0, "magnetic_velocity_x" : 0, "magnetic_velocity_y" : 0, "magnetic_velocity_angular" : 0, "magnetic_current_density_external_real" : 0, "magnetic_current_density_external_imag" : 0, "magnetic_total_current_prescribed" : 1, "magnetic_total_current_real" : 0.25, "magnetic_total_current_imag" : 0})
+
+        geometry = a2d.geometry
+        geometry.add_edge(0, 0.002, 0, 0.000768, boundaries = {"magnetic" : "Neumann"})
+        geometry.add_edge(0, 0.000768, 0, 0, boundaries = {"magnetic" : "Neumann"})
+        geometry.add_edge(0, 0, 0.000768, 0, boundaries = {"magnetic" : "Neumann"})
+        geometry.add_edge(0.000768, 0, 0.002, 0, boundaries = {"magnetic" : "Neumann"})
+        geometry.add_edge(0.002, 0, 0, 0.002, angle = 90, boundaries = {"magnetic" : "A = 0"})
+        geometry.add_edge(0.000768, 0, 0.000576, 0.000192, angle = 90)
+        geometry.add_edge(0.000576, 0.000192, 0.000384, 0.000192)
+        geometry.add_edge(0.000192, 0.000384, 0.000384, 0.000192, angle = 90)
+        geometry.add_edge(0.000192, 0.000576, 0.000192, 0.000384)
+        geometry.add_edge(0.000192, 0.000576, 0, 0.000768, angle = 90)
+
+        geometry.add_label(0.000585418, 0.00126858, materials = {"magnetic" : "Air"})
+        geometry.add_label(0.000109549, 8.6116e-05, materials = {"magnetic" : "Copper"})
+
+        # refine initial mesh up to 50k elements
+        for refinements in range(8):
+            self.magnetic.number_of_refinements = refinements
+            self.problem.mesh()
+            if (self.magnetic.initial_mesh_info()['elements'] >= 50000):
+                break
+
+        self.threads = a2d.options.number_of_threads
+
+    def tearDown(self):
+        a2d.options.number_of_threads = self.threads
+
+    def solve(self, threads):
+        a2d.options.number_of_threads = threads
+        self.problem.clear_solution()
+        self.problem.solve()
+
+        info = self.magnetic.adaptivity_info()
+        # refinements of every adaptivity step
+        info['meshes'] = [self.magnetic.solution_mesh_info(adaptivity_step = step) for step in range(len(info['dofs']))]
+
+        return self.problem.elapsed_time(), info
+
+    def test_threads(self):
+        self.assertTrue(self.magnetic.initial_mesh_info()['elements'] >= 50000)
+
+        time_serial, info_serial = self.solve(1)
+        time_parallel, info_parallel = self.solve(cpu_count())
+
+        # element-wise error estimation, reduction in fixed order and refinement selection
+        # do not depend on the number of threads
+        self.assertEqual(info_serial['dofs'], info_parallel['dofs'])
+        self.assertEqual(info_serial['error'], info_parallel['error'])
+        self.assertEqual(info_serial['meshes'], info_parallel['meshes'])
+
+        print("adaptivity: 1 thread: {0} s, {1} threads: {2} s (speedup {3:.2f})".format(time_serial, cpu_count(), time_parallel,
+                                                                                           time_serial / time_parallel if time_parallel > 0 else 0.0))
+
+class BenchmarkParallelMeshing(Agros2DTestCase):
+    def setUp(self):
+        self.problem = a2d.problem(clear = True)
+        self.problem.coordinate_type = "planar"
+
+        a2d.view.mesh.disable()
+        a2d.view.post2d.disable()
+
+        self.heat = a2d.field("heat")
+        self.heat.number_of_refinements = 0
+        self.heat.add_boundary("Neumann", "heat_heat_flux", {"heat_heat_flux" : 0})
+        self.heat.add_material("Material", {"heat_conductivity" : 1})
+
+        self.threads = a2d.options.number_of_threads
+        self.mesh_cache = a2d.options.mesh_cache
+        a2d.options.mesh_cache = False
+
+    def tearDown(self):
+        a2d.options.number_of_threads = self.threads
+        a2d.options.mesh_cache = self.mesh_cache
+
+    def grid(self, n, area):
+        with a2d.geometry.transaction():
+            for i in range(n):
+                for j in range(n):
+                    a2d.geometry.add_edge(i, j, i + 1, j, boundaries = {"heat" : "Neumann"} if j == 0 else {})
+                    a2d.geometry.add_edge(i, j, i, j + 1, boundaries = {"heat" : "Neumann"} if i == 0 else {})
+                    if (j == n - 1):
+                        a2d.geometry.add_edge(i, j + 1, i + 1, j + 1, boundaries = {"heat" : "Neumann"})
+                    if (i == n - 1):
+                        a2d.geometry.add_edge(i + 1, j, i + 1, j + 1, boundaries = {"heat" : "Neumann"})
+
+                    a2d.geometry.add_label(i + 0.5, j + 0.5, materials = {"heat" : "Material"}, area = area)
+
+    def mesh(self, mesh_type, threads):
+        from time import time
+
+        self.problem.mesh_type = mesh_type
+        a2d.options.number_of_threads = threads
+
+        start = time()
+        self.problem.mesh()
+        return time() - start, self.heat.initial_mesh_info()['elements']
+
+    def scaling(self, n, area):
+        self.grid(n, area)
+
+        time_serial, elements_serial = self.mesh("triangle", 1)
+        time_one, elements_one = self.mesh("triangle_parallel", 1)
+        time_parallel, elements_parallel = self.mesh("triangle_parallel", cpu_count())
+
+        # subdomains are meshed independently, the result does not depend on the number of threads
+        self.assertEqual(elements_one, elements_parallel)
+
+        print("meshing {0} labels: serial: {1:.3f} s ({2} elements), subdomains: 1 thread: {3:.3f} s, {4} threads: {5:.3f} s ({6} elements)".format(
+            n*n, time_serial, elements_serial, time_one, cpu_count(), time_parallel, elements_parallel))
+
+    def test_labels_100(self):
+        self.scaling(10, 1e-3)
+
+    def test_labels_400(self):
+        self.scaling(20, 1e-3)
+
+class BenchmarkLoopDetection(Agros2DTestCase):
+    def setUp(self):
+        self.problem = a2d.problem(clear = True)
+        self.problem.coordinate_type = "planar"
+        self.problem.mesh_type = "triangle"
+
+        a2d.view.mesh.disable()
+        a2d.view.post2d.disable()
+
+        self.heat = a2d.field("heat")
+        self.heat.number_of_refinements = 0
+        self.heat.add_boundary("Neumann", "heat_heat_flux", {"heat_heat_flux" : 0})
+        self.heat.add_material("Material", {"heat_conductivity" : 1})
+
+        self.mesh_cache = a2d.options.mesh_cache
+        a2d.options.mesh_cache = False
+
+    def tearDown(self):
+        a2d.options.mesh_cache = self.mesh_cache
+
+    def scaling(self, edges):
+        from time import time
+
+        # structured grid, every cell is a loop with its own label
+        n = int((edges / 2.0)**0.5)
+        with a2d.geometry.transaction():
+            for i in range(n):
+                for j in range(n):
+                    a2d.geometry.add_edge(i, j, i + 1, j, boundaries = {"heat" : "Neumann"} if j == 0 else {})
+                    a2d.geometry.add_edge(i, j, i, j + 1, boundaries = {"heat" : "Neumann"} if i == 0 else {})
+                    if (j == n - 1):
+                        a2d.geometry.add_edge(i, j + 1, i + 1, j + 1, boundaries = {"heat" : "Neumann"})
+                    if (i == n - 1):
+                        a2d.geometry.add_edge(i + 1, j, i + 1, j + 1, boundaries = {"heat" : "Neumann"})
+
+                    a2d.geometry.add_label(i + 0.5, j + 0.5, materials = {"heat" : "Material"})
+
+        # loops are detected before the mesh is generated
+        start = time()
+        self.problem.mesh()
+        elapsed = time() - start
+
+        self.assertTrue(self.heat.initial_mesh_info()['elements'] >= 2*n*n)
+
+        print("loop detection and meshing: {0} edges, {1} labels in {2:.3f} s".format(
+            a2d.geometry.edges_count(), a2d.geometry.labels_count(), elapsed))
+
+    def test_edges_5k(self):
+        self.scaling(5000)
+
+    def test_edges_20k(self):
+        self.scaling(20000)
+
+    def test_edges_50k(self):
+        self.scaling(50000)
+
+class BenchmarkMeshPostProcessing(Agros2DTestCase):
+    def setUp(self):
+        self.problem = a2d.problem(clear = True)
+        self.problem.coordinate_type = "planar"
+        self.problem.mesh_type = "triangle"
+
+        a2d.view.mesh.disable()
+        a2d.view.post2d.disable()
+
+        self.heat = a2d.field("heat")
+        self.heat.number_of_refinements = 0
+        self.heat.add_boundary("Neumann", "heat_heat_flux", {"heat_heat_flux" : 0})
+        self.heat.add_material("Material", {"heat_conductivity" : 1})
+        self.heat.add_material("Material 2", {"heat_conductivity" : 2})
+
+        self.threads = a2d.options.number_of_threads
+        self.mesh_cache = a2d.options.mesh_cache
+        a2d.options.mesh_cache = False
+
+    def tearDown(self):
+        a2d.options.number_of_threads = self.threads
+        a2d.options.mesh_cache = self.mesh_cache
+
+    def geometry(self, area):
+        # curved edges (nodes are projected to arcs) and two materials (subdomain meshes)
+        with a2d.geometry.transaction():
+            a2d.geometry.add_circle(0, 0, 1, boundaries = {"heat" : "Neumann"})
+            a2d.geometry.add_circle(0, 0, 0.5)
+            a2d.geometry.add_circle(0.2, -0.2, 0.1, boundaries = {"heat" : "Neumann"})
+
+            a2d.geometry.add_label(0.75, 0, materials = {"heat" : "Material"}, area = area)
+            a2d.geometry.add_label(0, 0, materials = {"heat" : "Material 2"}, area = area)
+            a2d.geometry.add_label(0.2, -0.2, materials = {"heat" : "none"})
+
+    def mesh(self, threads):
+        import json
+
+        a2d.options.number_of_threads = threads
+        self.problem.mesh()
+
+        # mesh generator phases
+        phases = dict()
+        for phase in json.loads(self.problem.profile("json"))["phases"]:
+            phases[phase["path"]] = phase["total_ms"] / 1e3
+
+        total = phases["mesh/mesh generator"]
+        post = phases.get("mesh/mesh generator/post-processing", 0.0)
+
+        return total - post, post, self.heat.initial_mesh_info()
+
+    def test_post_processing(self):
+        self.geometry(1e-5)
+
+        meshing_serial, post_serial, info_serial = self.mesh(1)
+        meshing_parallel, post_parallel, info_parallel = self.mesh(cpu_count())
+
+        # post-processing does not change the mesh
+        self.assertEqual(info_serial, info_parallel)
+        self.assertTrue(post_serial > 0.0)
+
+        print("mesh with {0} elements: meshing: {1:.3f} s, post-processing: 1 thread: {2:.3f} s, {3} threads: {4:.3f} s".format(
+            info_serial["elements"], meshing_serial, post_serial, cpu_count(), post_parallel))
+
+class BenchmarkParticleTracingForces(Agros2DTestCase):
+    def setUp(self):
+        self.problem = a2d.problem(clear = True)
+        self.problem.coordinate_type = "planar"
+        self.problem.mesh_type = "triangle"
+
+        a2d.view.mesh.disable()
+        a2d.view.post2d.disable()
+
+        electrostatic = a2d.field("electrostatic")
+        electrostatic.number_of_refinements = 2
+        electrostatic.polynomial_order = 2
+        electrostatic.add_boundary("Voltage", "electrostatic_potential", {"electrostatic_potential" : 1e3})
+        electrostatic.add_boundary("Ground", "electrostatic_potential", {"electrostatic_potential" : 0})
+        electrostatic.add_boundary("Neumann", "electrostatic_surface_charge_density", {"electrostatic_surface_charge_density" : 0})
+        electrostatic.add_material("Air", {"electrostatic_permittivity" : 1, "electrostatic_charge_density" : 0})
+
+        a2d.geometry.add_edge(0, 0, 1, 0, boundaries = {"electrostatic" : "Ground"})
+        a2d.geometry.add_edge(1, 0, 1, 1, boundaries = {"electrostatic" : "Neumann"})
+        a2d.geometry.add_edge(1, 1, 0, 1, boundaries = {"electrostatic" : "Voltage"})
+        a2d.geometry.add_edge(0, 1, 0, 0, boundaries = {"electrostatic" : "Neumann"})
+        a2d.geometry.add_label(0.5, 0.5, materials = {"electrostatic" : "Air"})
+
+        self.problem.solve()
+
+    def test_forces_per_second(self):
+        import time
+
+        particles = 20
+
+        tracing = a2d.particle_tracing
+        tracing.mass = 9.109e-31
+        tracing.charge = -1.602e-19
+        tracing.number_of_particles = particles
+        tracing.maximum_number_of_steps = 500
+        tracing.reflect_on_boundary = True
+
+        start = time.time()
+        tracing.solve([[0.05 + 0.9 * i / particles, 0.1] for i in range(particles)],
+                      [[1e5, 0]] * particles)
+        elapsed = time.time() - start
+
+        forces = tracing.force_evaluations()
+        self.assertTrue(forces > 0)
+
+        print("particle tracing: {0} force evaluations in {1:.3f} s ({2:.0f} forces/s)".format(
+            forces, elapsed, forces / elapsed))
+
+class BenchmarkIntegralsBatch(Agros2DTestCase):
+    def setUp(self):
+        self.problem = a2d.problem(clear = True)
+        self.problem.coordinate_type = "planar"
+        self.problem.mesh_type = "triangle"
+
+        a2d.view.mesh.disable()
+        a2d.view.post2d.disable()
+
+        self.heat = a2d.field("heat")
+        self.heat.number_of_refinements = 1
+        self.heat.polynomial_order = 2
+        self.heat.add_boundary("Temperature", "heat_temperature", {"heat_temperature" : 0})
+        self.heat.add_boundary("Neumann", "heat_heat_flux", {"heat_heat_flux" : 0})
+        self.heat.add_material("Material", {"heat_conductivity" : 1, "heat_volume_heat" : 1e3})
+
+        # structured grid, every cell has its own label
+        self.n = 10
+        with a2d.geometry.transaction():
+            for i in range(self.n):
+                for j in range(self.n):
+                    a2d.geometry.add_edge(i, j, i + 1, j, boundaries = {"heat" : "Neumann"} if j == 0 else {})
+                    a2d.geometry.add_edge(i, j, i, j + 1, boundaries = {"heat" : "Temperature"} if i == 0 else {})
+                    if (j == self.n - 1):
+                        a2d.geometry.add_edge(i, j + 1, i + 1, j + 1, boundaries = {"heat" : "Neumann"})
+                    if (i == self.n - 1):
+                        a2d.geometry.add_edge(i + 1, j, i + 1, j + 1, boundaries = {"heat" : "Temperature"})
+
+                    a2d.geometry.add_label(i + 0.5, j + 0.5, materials = {"heat" : "Material"})
+
+        self.problem.solve()
+
+    def compare(self, name, single, batch, regions):
+        from time import time
+
+        start = time()
+        values_single = [single(region) for region in regions]
+        time_single = time() - start
+
+        start = time()
+        values_batch = batch(regions)
+        time_batch = time() - start
+
+        for i in range(len(regions)):
+            for key in values_single[i]:
+                self.assertAlmostEqual(values_batch[i][key], values_single[i][key], 8)
+
+        print("{0} integrals over {1} regions: single: {2:.3f} s, batch: {3:.3f} s (speedup {4:.1f})".format(
+            name, len(regions), time_single, time_batch, time_single / time_batch))
+
+    def test_volume_integrals(self):
+        # rows and columns of cells
+        regions = [range(i * self.n, (i + 1) * self.n) for i in range(self.n)] + \
+                  [range(i, self.n * self.n, self.n) for i in range(self.n)]
+        self.compare("volume", self.heat.volume_integrals, self.heat.volume_integrals_batch, regions)
+
+    def test_surface_integrals(self):
+        # groups of consecutive edges
+        edges = a2d.geometry.edges_count()
+        size = edges // 20
+        regions = [range(i * size, (i + 1) * size) for i in range(20)]
+        self.compare("surface", self.heat.surface_integrals, self.heat.surface_integrals_batch, regions)
+
 if __name__ == '__main__':        
     import unittest as ut
     
     suite = ut.TestSuite()
     result = Agros2DTestResult()
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(BenchmarkGeometryTransformation))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(BenchmarkGeometryBulkInsert))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(BenchmarkGeometryBatch))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(BenchmarkLargeGeometry))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(BenchmarkParametricGeometry))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(BenchmarkAdaptivityThreads))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(BenchmarkParallelMeshing))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(BenchmarkLoopDetection))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(BenchmarkMeshPostProcessing))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(BenchmarkParticleTracingForces))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(BenchmarkIntegralsBatch))
     suite.run(result)
\ No newline at end of file
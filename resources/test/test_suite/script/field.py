@@ -364,6 +364,16 @@ class TestFieldMatrixSolver(Agros2DTestCase):
         with self.assertRaises(IndexError):
             self.field.matrix_solver_parameters['iterations'] = 1.1e4
 
+    """ preconditioner reuse """
+    def test_reuse_preconditioner(self):
+        self.assertEqual(self.field.matrix_solver_parameters['reuse_preconditioner'], False)
+        self.field.matrix_solver_parameters['reuse_preconditioner'] = True
+        self.assertEqual(self.field.matrix_solver_parameters['reuse_preconditioner'], True)
+
+    def test_amg_numeric_refresh(self):
+        self.field.matrix_solver_parameters['amg_numeric_refresh'] = True
+        self.assertEqual(self.field.matrix_solver_parameters['amg_numeric_refresh'], True)
+
 class TestFieldAdaptivity(Agros2DTestCase):
     def setUp(self):
         self.problem = a2d.problem(clear = True)
@@ -452,6 +462,16 @@ class TestFieldAdaptivity(Agros2DTestCase):
         self.field.adaptivity_parameters['finer_reference_solution'] = True
         self.assertEqual(self.field.adaptivity_parameters['finer_reference_solution'], True)
 
+    """ reference_retention """
+    def test_reference_retention(self):
+        for retention in ['none', 'last', 'all']:
+            self.field.adaptivity_parameters['reference_retention'] = retention
+            self.assertEqual(self.field.adaptivity_parameters['reference_retention'], retention)
+
+    def test_set_wrong_reference_retention(self):
+        with self.assertRaises(ValueError):
+            self.field.adaptivity_parameters['reference_retention'] = 'wrong_retention'
+
     """ transient_redone_steps """
     def test_transient_redone_steps(self):
         self.field.adaptivity_parameters['transient_redone_steps'] = 10
@@ -580,6 +600,140 @@ class TestFieldIntegrals(Agros2DTestCase):
         with self.assertRaises(RuntimeError):
             self.field.volume_integrals()
 
+    """ batched integrals """
+    def test_surface_integrals_batch(self):
+        self.problem.solve()
+        edges = [[8,9,10,11,16,17,18], [0], [0,1,2], [12,13,14,15], [2,2,3], []]
+
+        integrals = self.field.surface_integrals_batch(edges)
+        self.assertEqual(len(integrals), len(edges))
+        for i in range(len(edges)):
+            single = self.field.surface_integrals(edges[i])
+            for key in single:
+                self.assertAlmostEqual(integrals[i][key], single[key], 8)
+
+        self.assertAlmostEqual(integrals[0]['l'], self.surface, 5)
+
+    def test_surface_integrals_batch_on_nonexistent_edge(self):
+        self.problem.solve()
+        with self.assertRaises(IndexError):
+            self.field.surface_integrals_batch([[0], [99]])
+
+    def test_volume_integrals_batch(self):
+        self.problem.solve()
+        labels = [[1], [0], [0,1], [0,0,1], []]
+
+        integrals = self.field.volume_integrals_batch(labels)
+        self.assertEqual(len(integrals), len(labels))
+        for i in range(len(labels)):
+            single = self.field.volume_integrals(labels[i])
+            for key in single:
+                self.assertAlmostEqual(integrals[i][key], single[key], 8)
+
+        self.assertAlmostEqual(integrals[0]['V'], self.volume, 5)
+
+    def test_volume_integrals_batch_on_none_label(self):
+        self.problem.solve()
+        with self.assertRaises(IndexError):
+            self.field.volume_integrals_batch([[1], [2]])
+
+    def test_integrals_batch_without_solution(self):
+        with self.assertRaises(RuntimeError):
+            self.field.surface_integrals_batch([[0]])
+
+        with self.assertRaises(RuntimeError):
+            self.field.volume_integrals_batch([[0]])
+
+class TestFieldArrays(Agros2DTestCase):
+    def setUp(self):
+        self.problem = a2d.problem(clear = True)
+        self.field = a2d.field("magnetic")
+        self.field.number_of_refinements = 0
+        self.field.polynomial_order = 2
+
+        self.B = 0.75
+        self.field.add_boundary("A", "magnetic_potential",
+                                {"magnetic_potential_real" : { "expression" : "{0}*x".format(self.B)}})
+        self.field.add_material("Air", {"magnetic_permeability" : 1})
+
+        geometry = a2d.geometry
+        geometry.add_rect(0, 0, 1, 1, boundaries = {"magnetic" : "A"})
+        geometry.add_label(0.5, 0.5, area = 0.05, materials = {"magnetic" : "Air"})
+
+    def test_solution_vector(self):
+        self.problem.solve()
+        vector = self.field.solution_vector()
+        self.assertEqual(len(vector), self.field.solution_mesh_info()['dofs'])
+
+        # solution A = B*x is linear - coefficients of vertex functions are nodal values
+        # in interior vertices, coefficients of higher order functions vanish
+        vertices, triangles = self.field.solution_mesh_arrays()
+        nodal = sorted([self.B * vertex[0] for vertex in vertices
+                        if (1e-10 < vertex[0] < 1 - 1e-10) and (1e-10 < vertex[1] < 1 - 1e-10)])
+        coefficients = sorted([value for value in vector if abs(value) > 1e-8])
+
+        self.assertEqual(len(coefficients), len(nodal))
+        for i in range(len(nodal)):
+            self.assertAlmostEqual(coefficients[i], nodal[i], 6)
+
+    def test_solution_vector_without_solution(self):
+        with self.assertRaises(RuntimeError):
+            self.field.solution_vector()
+
+    def test_initial_mesh_arrays(self):
+        self.problem.mesh()
+        vertices, triangles = self.field.initial_mesh_arrays()
+        info = self.field.initial_mesh_info()
+
+        self.assertEqual(len(vertices), info['nodes'])
+        self.assertEqual(len(triangles), info['elements'])
+
+        self.assertEqual(vertices.shape, (info['nodes'], 2))
+        self.assertEqual(triangles.shape, (info['elements'], 3))
+
+    def test_initial_mesh_arrays_numpy(self):
+        try:
+            import numpy as np
+        except ImportError:
+            return
+
+        self.problem.mesh()
+        vertices, triangles = self.field.initial_mesh_arrays()
+
+        self.assertAlmostEqual(vertices[:, 0].min(), 0)
+        self.assertAlmostEqual(vertices[:, 1].max(), 1)
+        self.assertTrue(np.all(triangles >= 0))
+        self.assertTrue(np.all(triangles < len(vertices)))
+
+    def test_solution_mesh_arrays(self):
+        self.problem.solve()
+        vertices, triangles = self.field.solution_mesh_arrays()
+        info = self.field.solution_mesh_info()
+
+        self.assertEqual(len(vertices), info['nodes'])
+        self.assertEqual(len(triangles), info['elements'])
+
+    def test_linearized_values(self):
+        try:
+            import numpy as np
+        except ImportError:
+            return
+
+        self.problem.solve()
+        vertices, values = self.field.linearized_values("magnetic_potential_real")
+
+        self.assertEqual(len(vertices), len(values))
+        self.assertEqual(len(values) % 3, 0)
+        self.assertTrue(np.allclose(values, self.B * vertices[:, 0], atol = 1e-3))
+
+    def test_linearized_values_with_wrong_variable(self):
+        self.problem.solve()
+        with self.assertRaises(ValueError):
+            self.field.linearized_values("wrong_variable")
+
+        with self.assertRaises(ValueError):
+            self.field.linearized_values("magnetic_potential_real", "wrong_component")
+
 class TestFieldAdaptivityInfo(Agros2DTestCase):
     def setUp(self):
         self.problem = a2d.problem(clear = True)
@@ -637,6 +791,24 @@ class TestFieldAdaptivityInfo(Agros2DTestCase):
         reference_dofs = self.field.adaptivity_info(solution_type="reference")['dofs']
         self.assertGreater(sum(reference_dofs), sum(normal_dofs))
 
+    def test_adaptivity_info_with_reference_retention(self):
+        self.field.adaptivity_parameters['reference_retention'] = "all"
+        self.problem.solve()
+        normal_all = self.field.adaptivity_info(solution_type="normal")
+        reference_all = self.field.adaptivity_info(solution_type="reference")
+        value_all = self.field.local_values(0.1, 0.3)['V']
+
+        self.field.adaptivity_parameters['reference_retention'] = "last"
+        self.problem.solve()
+        self.assertEqual(self.field.adaptivity_info(solution_type="normal"), normal_all)
+        self.assertEqual(self.field.adaptivity_info(solution_type="reference")['dofs'], reference_all['dofs'][-1:])
+        self.assertAlmostEqual(self.field.local_values(0.1, 0.3)['V'], value_all)
+
+        self.field.adaptivity_parameters['reference_retention'] = "none"
+        self.problem.solve()
+        self.assertEqual(self.field.adaptivity_info(solution_type="normal"), normal_all)
+        self.assertAlmostEqual(self.field.local_values(0.1, 0.3)['V'], value_all)
+
     def test_adaptivity_info_with_nonexisted_time_step(self):
         self.problem.solve()
         with self.assertRaises(IndexError):
@@ -848,6 +1020,7 @@ if __name__ == '__main__':
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestFieldAdaptivity))
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestFieldLocalValues))
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestFieldIntegrals))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestFieldArrays))
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestFieldAdaptivityInfo))
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestFieldAdaptivityInfoTransient))
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestFieldSolverInfo))
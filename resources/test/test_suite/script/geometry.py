@@ -188,6 +188,287 @@ class TestGeometryTransformations(Agros2DTestCase):
         self.problem.solve()
         self.assertAlmostEqual(self.electrostatic.volume_integrals([0])['S'], (self.a * scale) * (self.b * scale))
         
+class TestGeometryTransaction(Agros2DTestCase):
+    def setUp(self):
+        self.problem = a2d.problem(clear = True)
+        self.geometry = a2d.geometry
+
+    def test_commit(self):
+        with self.geometry.transaction():
+            for i in range(10):
+                self.assertEqual(self.geometry.add_edge(i, 0, i + 1, 0), i)
+            self.assertEqual(self.geometry.add_node(1e-3, 1.0), 11)
+
+        self.assertEqual(self.geometry.nodes_count(), 12)
+        self.assertEqual(self.geometry.edges_count(), 10)
+
+    def test_existing_node_and_edge(self):
+        self.geometry.add_edge(0, 0, 1, 0)
+
+        with self.geometry.transaction():
+            self.assertEqual(self.geometry.add_edge(1, 0, 1, 1), 1)
+
+            with self.assertRaises(RuntimeError):
+                self.geometry.add_node(1, 1)
+            with self.assertRaises(RuntimeError):
+                self.geometry.add_edge(0, 0, 1, 0)
+            with self.assertRaises(RuntimeError):
+                self.geometry.add_edge_by_nodes(1, 2)
+
+        self.assertEqual(self.geometry.nodes_count(), 3)
+        self.assertEqual(self.geometry.edges_count(), 2)
+
+    def test_rollback(self):
+        self.geometry.add_edge(0, 0, 1, 0)
+
+        with self.assertRaises(ValueError):
+            with self.geometry.transaction():
+                self.geometry.add_edge(1, 0, 1, 1)
+                self.geometry.add_label(0.5, 0.5)
+                raise ValueError
+
+        self.assertEqual(self.geometry.nodes_count(), 2)
+        self.assertEqual(self.geometry.edges_count(), 1)
+        self.assertEqual(self.geometry.labels_count(), 0)
+
+    def test_wrong_transaction(self):
+        with self.assertRaises(RuntimeError):
+            self.geometry.commit_transaction()
+        with self.assertRaises(RuntimeError):
+            self.geometry.rollback_transaction()
+
+        self.geometry.begin_transaction()
+        with self.assertRaises(RuntimeError):
+            self.geometry.begin_transaction()
+        self.geometry.commit_transaction()
+
+    def test_solve(self):
+        electrostatic = a2d.field("electrostatic")
+        electrostatic.add_boundary("Source", "electrostatic_potential", {"electrostatic_potential" : 10})
+        electrostatic.add_boundary("Ground", "electrostatic_potential", {"electrostatic_potential" : 0})
+        electrostatic.add_material("Dielectricum", {"electrostatic_permittivity" : 3, "electrostatic_charge_density" : 0})
+
+        with self.geometry.transaction():
+            self.geometry.add_rect(0, 0, 1, 1, boundaries = {"electrostatic" : "Source"})
+            self.geometry.add_rect(1, 0, 1, 1, boundaries = {"electrostatic" : "Ground"},
+                                   materials = {"electrostatic" : "Dielectricum"})
+            self.geometry.add_label(0.5, 0.5, materials = {"electrostatic" : "Dielectricum"})
+
+        # shared edge is added only once
+        self.assertEqual(self.geometry.nodes_count(), 6)
+        self.assertEqual(self.geometry.edges_count(), 7)
+
+        self.problem.solve()
+        self.assertAlmostEqual(electrostatic.volume_integrals()['S'], 2.0)
+
+class TestGeometryBatch(Agros2DTestCase):
+    def setUp(self):
+        self.problem = a2d.problem(clear = True)
+        self.geometry = a2d.geometry
+
+        self.electrostatic = a2d.field("electrostatic")
+        self.electrostatic.add_boundary("Source", "electrostatic_potential", {"electrostatic_potential" : 10})
+        self.electrostatic.add_boundary("Ground", "electrostatic_potential", {"electrostatic_potential" : 0})
+        self.electrostatic.add_boundary("Neumann", "electrostatic_surface_charge_density", {"electrostatic_surface_charge_density" : 0})
+        self.electrostatic.add_material("Dielectricum", {"electrostatic_permittivity" : 3, "electrostatic_charge_density" : 0})
+
+        self.boundaries = [{"electrostatic" : "Neumann"}, {"electrostatic" : "Ground"},
+                           {"electrostatic" : "Neumann"}, {"electrostatic" : "Source"}]
+
+    def test_add_nodes(self):
+        self.assertEqual(self.geometry.add_nodes([0, 1, 2], [0, 0, 0]), [0, 1, 2])
+        self.assertEqual(self.geometry.nodes_count(), 3)
+
+    def test_add_nodes_numpy(self):
+        try:
+            import numpy as np
+        except ImportError:
+            return
+
+        x = np.linspace(0, 1, 11)
+        self.assertEqual(self.geometry.add_nodes(x, np.zeros(11)), range(11))
+
+    def test_add_existing_node(self):
+        self.geometry.add_node(1, 0)
+
+        # batch is rolled back
+        with self.assertRaises(RuntimeError):
+            self.geometry.add_nodes([0, 1, 2], [0, 0, 0])
+        self.assertEqual(self.geometry.nodes_count(), 1)
+
+    def test_add_edges(self):
+        self.assertEqual(self.geometry.add_edges([0, 1, 1, 0], [0, 0, 1, 1], [1, 1, 0, 0], [0, 1, 1, 0],
+                                                 angles = [0, 90, 0, 0], segments = 4,
+                                                 boundaries = {"electrostatic" : "Source"}), [0, 1, 2, 3])
+
+        # nodes are shared
+        self.assertEqual(self.geometry.nodes_count(), 4)
+        self.assertEqual(self.geometry.edges_count(), 4)
+
+    def test_add_edges_wrong_parameters(self):
+        with self.assertRaises(ValueError):
+            self.geometry.add_edges([0, 1], [0, 0], [1, 2], [0])
+        with self.assertRaises(ValueError):
+            self.geometry.add_edges([0, 1], [0, 0], [1, 2], [0, 0], angles = [0, 0, 0])
+        with self.assertRaises(IndexError):
+            self.geometry.add_edges([0, 1], [0, 0], [1, 2], [0, 0], angles = [0, 100])
+        with self.assertRaises(ValueError):
+            self.geometry.add_edges([0, 1], [0, 0], [1, 2], [0, 0], boundaries = {"electrostatic" : "Unknown"})
+
+        self.assertEqual(self.geometry.nodes_count(), 0)
+        self.assertEqual(self.geometry.edges_count(), 0)
+
+    def test_add_existing_edge(self):
+        self.geometry.add_edge(1, 0, 2, 0)
+
+        with self.assertRaises(RuntimeError):
+            self.geometry.add_edges([0, 1], [0, 0], [1, 2], [0, 0])
+        self.assertEqual(self.geometry.nodes_count(), 2)
+        self.assertEqual(self.geometry.edges_count(), 1)
+
+    def test_add_edges_by_nodes(self):
+        self.geometry.add_nodes([0, 1, 1, 0], [0, 0, 1, 1])
+        self.assertEqual(self.geometry.add_edges_by_nodes([0, 1, 2, 3], [1, 2, 3, 0]), [0, 1, 2, 3])
+
+        with self.assertRaises(IndexError):
+            self.geometry.add_edges_by_nodes([0], [4])
+        with self.assertRaises(RuntimeError):
+            self.geometry.add_edges_by_nodes([0], [0])
+        self.assertEqual(self.geometry.edges_count(), 4)
+
+    def test_add_labels(self):
+        self.assertEqual(self.geometry.add_labels([0.5, 1.5], [0.5, 0.5], areas = [0.1, 0.2]), [0, 1])
+
+        with self.assertRaises(IndexError):
+            self.geometry.add_labels([2.5], [0.5], areas = -1)
+        with self.assertRaises(RuntimeError):
+            self.geometry.add_labels([2.5, 0.5], [0.5, 0.5])
+        self.assertEqual(self.geometry.labels_count(), 2)
+
+    def test_modify(self):
+        self.geometry.add_edges([0, 1, 1, 0], [0, 0, 1, 1], [1, 1, 0, 0], [0, 1, 1, 0])
+        self.geometry.add_labels([0.5], [0.5])
+
+        with self.assertRaises(IndexError):
+            self.geometry.modify_edges([0, 4])
+        with self.assertRaises(IndexError):
+            self.geometry.modify_labels([1])
+
+        with self.geometry.transaction():
+            self.geometry.modify_edges([0, 1, 2, 3], boundaries = self.boundaries)
+            self.geometry.modify_labels([0], materials = {"electrostatic" : "Dielectricum"})
+
+        self.problem.solve()
+        self.assertAlmostEqual(self.electrostatic.volume_integrals()['S'], 1.0)
+
+    def test_solve(self):
+        with self.geometry.transaction():
+            self.geometry.add_edges([0, 1, 1, 0], [0, 0, 1, 1], [1, 1, 0, 0], [0, 1, 1, 0],
+                                    boundaries = self.boundaries)
+            self.geometry.add_labels([0.5], [0.5], materials = {"electrostatic" : "Dielectricum"})
+
+        self.problem.solve()
+        self.assertAlmostEqual(self.electrostatic.volume_integrals()['S'], 1.0)
+
+class TestGeometryCheck(Agros2DTestCase):
+    def setUp(self):
+        self.problem = a2d.problem(clear = True)
+
+        self.electrostatic = a2d.field("electrostatic")
+        self.electrostatic.add_boundary("Source", "electrostatic_potential", {"electrostatic_potential" : 10})
+        self.electrostatic.add_material("Dielectricum", {"electrostatic_permittivity" : 3})
+
+        # square (nodes 0 - 3, edges 0 - 3)
+        self.geometry = a2d.geometry
+        self.geometry.add_edges([0, 1, 1, 0], [0, 0, 1, 1], [1, 1, 0, 0], [0, 1, 1, 0],
+                                boundaries = {"electrostatic" : "Source"})
+        self.geometry.add_label(0.1, 0.5, materials = {"electrostatic" : "Dielectricum"})
+
+    def test_check(self):
+        result = self.geometry.check()
+        self.assertEqual(result["lying_nodes"], [])
+        self.assertEqual(result["end_nodes"], [])
+        self.assertEqual(result["crossings"], [])
+
+        self.problem.mesh()
+
+    def test_check_crossings(self):
+        # overlapping square (nodes 4 - 7, edges 4 - 7), edges 1 and 4, 2 and 7 cross
+        self.geometry.add_edges([0.5, 1.5, 1.5, 0.5], [0.5, 0.5, 1.5, 1.5], [1.5, 1.5, 0.5, 0.5], [0.5, 1.5, 1.5, 0.5],
+                                boundaries = {"electrostatic" : "Source"})
+
+        result = self.geometry.check()
+        self.assertEqual(result["crossings"], [1, 2, 4, 7])
+        self.assertEqual(result["end_nodes"], [])
+        self.assertEqual(result["lying_nodes"], [])
+
+        # crossings are found also without invalidation of geometry in scripts
+        with self.assertRaises(RuntimeError):
+            self.problem.mesh()
+
+    def test_check_lying_node(self):
+        # node on the edge 0
+        self.geometry.add_node(0.5, 0.0)
+        # edge with one end node on the edge 2
+        self.geometry.add_edge(0.5, 0.9, 0.5, 1.0, boundaries = {"electrostatic" : "Source"})
+
+        result = self.geometry.check()
+        self.assertEqual(result["lying_nodes"], [4, 6])
+        self.assertEqual(result["end_nodes"], [5, 6])
+        self.assertEqual(result["crossings"], [])
+
+class TestGeometryDXF(Agros2DTestCase):
+    def setUp(self):
+        import tempfile
+
+        self.problem = a2d.problem(clear = True)
+        self.geometry = a2d.geometry
+        self.file_name = tempfile.mktemp(suffix = ".dxf")
+
+    def tearDown(self):
+        import os
+        if os.path.exists(self.file_name):
+            os.remove(self.file_name)
+
+    def write_dxf(self, lines):
+        with open(self.file_name, "w") as f:
+            f.write("0\nSECTION\n2\nENTITIES\n")
+            for x1, y1, x2, y2 in lines:
+                f.write("0\nLINE\n8\n0\n10\n{0}\n20\n{1}\n30\n0.0\n11\n{2}\n21\n{3}\n31\n0.0\n".format(repr(x1), repr(y1), repr(x2), repr(y2)))
+            f.write("0\nENDSEC\n0\nEOF\n")
+
+    def test_import_dxf(self):
+        self.write_dxf([[0.0, 0.0, 1.0, 0.0], [1.0, 0.0, 1.0, 1.0],
+                        [1.0, 1.0, 0.0, 1.0], [0.0, 1.0, 0.0, 0.0]])
+        self.geometry.import_dxf(self.file_name)
+
+        self.assertEqual(self.geometry.nodes_count(), 4)
+        self.assertEqual(self.geometry.edges_count(), 4)
+
+    def test_import_dxf_healing(self):
+        self.write_dxf([# collinear segments
+                        [0.0, 0.0, 0.5, 0.0], [0.5, 0.0, 1.0, 0.0],
+                        # near-coincident endpoint
+                        [1.0 + 1e-9, 1e-9, 1.0, 1.0],
+                        [1.0, 1.0, 0.0, 1.0],
+                        # duplicate (reversed) edge
+                        [0.0, 1.0, 1.0, 1.0],
+                        [0.0, 1.0, 0.0, 0.0],
+                        # zero-length edge
+                        [0.3, 0.3, 0.3, 0.3]])
+        self.geometry.import_dxf(self.file_name)
+
+        self.assertEqual(self.geometry.nodes_count(), 4)
+        self.assertEqual(self.geometry.edges_count(), 4)
+
+        result = self.geometry.check()
+        self.assertEqual(result["end_nodes"], [])
+        self.assertEqual(result["crossings"], [])
+
+    def test_import_nonexisting_dxf(self):
+        with self.assertRaises(RuntimeError):
+            self.geometry.import_dxf(self.file_name)
+
 if __name__ == '__main__':        
     import unittest as ut
     
@@ -195,4 +476,8 @@ if __name__ == '__main__':
     result = Agros2DTestResult()
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestGeometry))
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestGeometryTransformations))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestGeometryTransaction))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestGeometryBatch))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestGeometryCheck))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestGeometryDXF))
     suite.run(result)
\ No newline at end of file
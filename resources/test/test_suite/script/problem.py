@@ -19,7 +19,7 @@ class TestProblem(Agros2DTestCase):
     """ mesh_type """
     def test_mesh_type(self):
         for type in ['triangle', 'triangle_quad_fine_division',
-                     'triangle_quad_rough_division', 'triangle_quad_join',
+                     'triangle_quad_rough_division', 'triangle_quad_join', 'triangle_parallel',
                      'gmsh_triangle', 'gmsh_quad', 'gmsh_quad_delaunay']:
             self.problem.mesh_type = type
             self.assertEqual(self.problem.mesh_type, type)
@@ -84,6 +84,49 @@ class TestProblemTime(Agros2DTestCase):
         with self.assertRaises(IndexError):
             self.problem.time_method_order = -1e-3
 
+    """ time_method_error_estimator """
+    def test_time_method_error_estimator(self):
+        for estimator in ['lower_order', 'embedded']:
+            self.problem.time_method_error_estimator = estimator
+            self.assertEqual(self.problem.time_method_error_estimator, estimator)
+
+    def test_set_wrong_time_method_error_estimator(self):
+        with self.assertRaises(ValueError):
+            self.problem.time_method_error_estimator = 'wrong_estimator'
+
+    def test_time_method_error_estimator_solve(self):
+        import json
+
+        lengths = {}
+        solves = {}
+        for estimator in ['lower_order', 'embedded']:
+            self.problem.time_step_method = "adaptive"
+            self.problem.time_method_order = 2
+            self.problem.time_method_tolerance = 1e-3
+            self.problem.time_method_error_estimator = estimator
+            self.problem.solve()
+
+            lengths[estimator] = self.problem.time_steps_length()
+            self.assertAlmostEqual(sum(lengths[estimator]), self.problem.time_total, 5)
+
+            # linear solves (time steps and lower order estimates)
+            phases = json.loads(self.problem.profile("json"))["phases"]
+            solves[estimator] = sum([phase["count"] for phase in phases if phase["name"] == "solve"])
+
+        # similar step sequences (the same initial step, comparable number and range of steps)
+        steps_lower_order = len(lengths['lower_order'])
+        steps_embedded = len(lengths['embedded'])
+        self.assertAlmostEqual(lengths['embedded'][0], lengths['lower_order'][0], 8)
+        self.assertLessEqual(steps_embedded, 2 * steps_lower_order)
+        self.assertLessEqual(steps_lower_order, 2 * steps_embedded)
+        self.assertLessEqual(max(lengths['embedded']), 2 * max(lengths['lower_order']))
+        self.assertLessEqual(max(lengths['lower_order']), 2 * max(lengths['embedded']))
+
+        # embedded estimator needs no extra solve (except for start-up steps), about half the cost per step
+        # (refused steps are solved again with both estimators)
+        self.assertGreaterEqual(solves['lower_order'], 2 * steps_lower_order - 3)
+        self.assertLess(float(solves['embedded']) / steps_embedded, 0.75 * float(solves['lower_order']) / steps_lower_order)
+
     """ time_total """
     def test_time_total(self):
         self.problem.time_total = 300
@@ -171,6 +214,146 @@ class TestProblemSolution(Agros2DTestCase):
         self.problem.clear()
         self.assertEqual(a2d.geometry.nodes_count(), 0)
 
+class TestProblemValueCache(Agros2DTestCase):
+    def setUp(self):
+        self.problem = a2d.problem(clear = True)
+        self.current = a2d.field('current')
+        self.current.add_boundary("Source", "current_potential", {"current_potential" : { "expression" : "10*y" }})
+        self.current.add_boundary("Ground", "current_potential", {"current_potential" : 0})
+        self.current.add_boundary("Neumann", "current_inward_current_flow", {"current_inward_current_flow" : 0})
+        self.current.add_material("Copper", {"current_conductivity" : 33e6})
+
+        a2d.geometry.add_edge(0, 0, 1, 0, boundaries = {'current' : 'Neumann'})
+        a2d.geometry.add_edge(1, 0, 1, 1, boundaries = {'current' : 'Ground'})
+        a2d.geometry.add_edge(1, 1, 0, 1, boundaries = {'current' : 'Neumann'})
+        a2d.geometry.add_edge(0, 1, 0, 0, boundaries = {'current' : 'Source'})
+        a2d.geometry.add_label(0.5, 0.5, materials = {'current' : 'Copper'})
+
+    """ value_cache_info """
+    def test_value_cache(self):
+        self.problem.solve()
+        value = self.current.local_values(0.25, 0.75)["V"]
+        info = self.problem.value_cache_info()
+
+        # repeated assembly evaluates expression at the same points
+        self.problem.clear_solution()
+        self.problem.solve()
+        self.assertGreater(self.problem.value_cache_info()["hits"], info["hits"])
+        self.value_test("Potential", self.current.local_values(0.25, 0.75)["V"], value)
+
+    def test_value_cache_expression_change(self):
+        self.problem.solve()
+        value = self.current.local_values(0.25, 0.75)["V"]
+
+        # cached values of previous expression are not used
+        self.current.modify_boundary("Source", parameters = {"current_potential" : { "expression" : "20*y" }})
+        self.problem.solve()
+        self.value_test("Potential", self.current.local_values(0.25, 0.75)["V"], 2.0 * value)
+
+    def test_value_cache_parameter_change(self):
+        import __main__
+
+        __main__.p = 10.0
+        self.current.modify_boundary("Source", parameters = {"current_potential" : { "expression" : "p*y" }})
+        self.problem.solve()
+        value = self.current.local_values(0.25, 0.75)["V"]
+
+        # cached values of previous parameter are not used
+        __main__.p = 20.0
+        self.problem.solve()
+        self.value_test("Potential", self.current.local_values(0.25, 0.75)["V"], 2.0 * value)
+
+class TestProblemProfile(Agros2DTestCase):
+    def setUp(self):
+        self.problem = a2d.problem(clear = True)
+        self.current = a2d.field('current')
+        self.current.add_boundary("Source", "current_potential", {"current_potential" : 10})
+        self.current.add_boundary("Ground", "current_potential", {"current_potential" : 0})
+        self.current.add_material("Copper", {"current_conductivity" : 33e6})
+
+        a2d.geometry.add_edge(0, 0, 1, 0)
+        a2d.geometry.add_edge(1, 0, 1, 1, boundaries = {'current' : 'Ground'})
+        a2d.geometry.add_edge(1, 1, 0, 1)
+        a2d.geometry.add_edge(0, 1, 0, 0, boundaries = {'current' : 'Source'})
+        a2d.geometry.add_label(0.5, 0.5, materials = {'current' : 'Copper'})
+
+    def test_chrome_trace(self):
+        import json
+
+        self.problem.solve()
+        events = json.loads(self.problem.profile("chrome"))["traceEvents"]
+
+        def inside(inner, outer):
+            return outer["tid"] == inner["tid"] and outer["ts"] <= inner["ts"] \
+                and inner["ts"] + inner["dur"] <= outer["ts"] + outer["dur"]
+
+        # problem solve > step > linear solve and store solution
+        solve = [event for event in events if event["name"] == "solve"]
+        steps = [event for event in events if event["name"] == "step"]
+        stores = [event for event in events if event["name"] == "store solution"]
+        self.assertEqual(len(steps), 1)
+        self.assertEqual(len(stores), 1)
+        self.assertTrue(any([inside(steps[0], event) for event in solve]))
+        self.assertTrue(any([inside(event, steps[0]) for event in solve if event is not steps[0]]))
+        self.assertTrue(inside(stores[0], steps[0]))
+
+    def test_json_paths(self):
+        import json
+
+        self.problem.solve()
+        paths = [phase["path"] for phase in json.loads(self.problem.profile("json"))["phases"]]
+        for path in ["solve", "solve/step", "solve/step/solve", "solve/step/store solution"]:
+            self.assertTrue(path in paths, "Phase '{0}' is missing.".format(path))
+
+    def test_stored_profile(self):
+        self.problem.solve()
+        profile = self.current.profile_info()
+
+        # profile of the step is stored with run time details
+        self.assertTrue("solve/step/solve" in profile)
+        self.assertGreaterEqual(profile["solve/step/solve"], 0.0)
+        self.assertTrue(all([path.startswith("solve/step/") for path in profile.keys()]))
+
+class TestProblemTimeFunctions(Agros2DTestCase):
+    def setUp(self):
+        self.problem = a2d.problem(clear = True)
+        self.problem.time_step_method = "fixed"
+        self.problem.time_method_order = 1
+        self.problem.time_total = 4
+        self.problem.time_steps = 4
+
+        self.heat = a2d.field('heat')
+        self.heat.analysis_type = 'transient'
+        self.heat.transient_initial_condition = 293.15
+        self.heat.add_boundary("Dirichlet", "heat_temperature", {"heat_temperature" : { "expression" : "293.15 + 10*time" }})
+        self.heat.add_boundary("Neumann", "heat_heat_flux", {"heat_heat_flux" : 0})
+        self.heat.add_material("Copper", {"heat_conductivity" : 200, "heat_density" : 8700, "heat_specific_heat" : 385})
+
+        a2d.geometry.add_edge(0, 0, 1, 0, boundaries = {'heat' : 'Neumann'})
+        a2d.geometry.add_edge(1, 0, 1, 1, boundaries = {'heat' : 'Neumann'})
+        a2d.geometry.add_edge(1, 1, 0, 1, boundaries = {'heat' : 'Neumann'})
+        a2d.geometry.add_edge(0, 1, 0, 0, boundaries = {'heat' : 'Dirichlet'})
+        a2d.geometry.add_label(0.5, 0.5, materials = {'heat' : 'Copper'})
+
+    def boundary_temperature(self, step):
+        return self.heat.local_values(0, 0.5, time_step = step)["T"]
+
+    def test_time_steps_order(self):
+        self.problem.solve()
+        times = self.problem.time_steps_total()
+
+        # backward and repeated queries evaluate time functions at the queried time
+        for step in [4, 1, 1, 3]:
+            self.value_test("Temperature", self.boundary_temperature(step), 293.15 + 10 * times[step])
+
+    def test_modified_boundary(self):
+        self.problem.solve()
+        self.value_test("Temperature", self.boundary_temperature(4), 333.15)
+
+        self.heat.modify_boundary("Dirichlet", parameters = {"heat_temperature" : { "expression" : "293.15 + 20*time" }})
+        self.problem.solve()
+        self.value_test("Temperature", self.boundary_temperature(4), 373.15)
+
 if __name__ == '__main__':        
     import unittest as ut
     
@@ -179,4 +362,7 @@ if __name__ == '__main__':
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestProblem))
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestProblemTime))
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestProblemSolution))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestProblemValueCache))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestProblemProfile))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestProblemTimeFunctions))
     suite.run(result)
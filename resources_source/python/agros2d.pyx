@@ -77,6 +77,46 @@ cdef vector[double] list_to_double_vector(list):
 
     return double_vector
 
+cdef vector[double] array_to_double_vector(array):
+    # one-dimensional arrays of doubles (NumPy arrays) are read through the buffer protocol
+    cdef double[:] view
+    cdef vector[double] double_vector
+    cdef int i
+
+    try:
+        view = array
+    except (TypeError, ValueError):
+        return list_to_double_vector(array)
+
+    double_vector.reserve(view.shape[0])
+    for i in range(view.shape[0]):
+        double_vector.push_back(view[i])
+
+    return double_vector
+
+# parameter of batched operations is None (default value), number (one value for all items) or array
+cdef vector[double] parameter_to_double_vector(parameter):
+    cdef vector[double] double_vector
+    if (parameter is None):
+        return double_vector
+
+    if (not hasattr(parameter, '__iter__')):
+        double_vector.push_back(parameter)
+        return double_vector
+
+    return array_to_double_vector(parameter)
+
+cdef vector[int] parameter_to_int_vector(parameter):
+    cdef vector[int] int_vector
+    if (parameter is None):
+        return int_vector
+
+    if (not hasattr(parameter, '__iter__')):
+        int_vector.push_back(parameter)
+        return int_vector
+
+    return list_to_int_vector(parameter)
+
 cdef object double_vector_to_list(vector[double] vector):
     out = list()
     for i in range(vector.size()):
@@ -84,6 +124,13 @@ cdef object double_vector_to_list(vector[double] vector):
 
     return out
 
+cdef object int_vector_to_list(vector[int] vector):
+    out = list()
+    for i in range(vector.size()):
+        out.append(vector[i])
+
+    return out
+
 cdef map[string, int] dictionary_to_int_map(dictionary):
     cdef map[string, int] int_map
     cdef pair[string, int] row
@@ -104,6 +151,105 @@ cdef map[string, string] dictionary_to_string_map(dictionary):
 
     return string_map
 
+# parameter of batched operations is None, dictionary (used for all items) or list of dictionaries
+cdef vector[map[string, string]] parameter_to_string_map_vector(parameter):
+    cdef vector[map[string, string]] string_map_vector
+    if (parameter is None):
+        return string_map_vector
+
+    if (isinstance(parameter, dict)):
+        string_map_vector.push_back(dictionary_to_string_map(parameter))
+    else:
+        for dictionary in parameter:
+            string_map_vector.push_back(dictionary_to_string_map(dictionary))
+
+    return string_map_vector
+
+# arrays (data are filled by the library and exported through the buffer protocol without copying)
+cdef class __DoubleArray__:
+    cdef vector[double] data
+    cdef Py_ssize_t columns
+    cdef Py_ssize_t shape[2]
+    cdef Py_ssize_t strides[2]
+
+    def __cinit__(self, columns = 1):
+        self.columns = columns
+
+    def __len__(self):
+        return <Py_ssize_t>self.data.size() // self.columns
+
+    def __getbuffer__(self, Py_buffer *buffer, int flags):
+        cdef Py_ssize_t itemsize = sizeof(double)
+
+        self.shape[0] = <Py_ssize_t>self.data.size() // self.columns
+        self.shape[1] = self.columns
+        self.strides[0] = self.columns * itemsize
+        self.strides[1] = itemsize
+
+        if self.data.empty():
+            buffer.buf = NULL
+        else:
+            buffer.buf = <char *>&(self.data[0])
+        buffer.format = 'd'
+        buffer.internal = NULL
+        buffer.itemsize = itemsize
+        buffer.len = self.data.size() * itemsize
+        buffer.ndim = 1 if self.columns == 1 else 2
+        buffer.obj = self
+        buffer.readonly = 0
+        buffer.shape = self.shape
+        buffer.strides = self.strides
+        buffer.suboffsets = NULL
+
+    def __releasebuffer__(self, Py_buffer *buffer):
+        pass
+
+cdef class __IntArray__:
+    cdef vector[int] data
+    cdef Py_ssize_t columns
+    cdef Py_ssize_t shape[2]
+    cdef Py_ssize_t strides[2]
+
+    def __cinit__(self, columns = 1):
+        self.columns = columns
+
+    def __len__(self):
+        return <Py_ssize_t>self.data.size() // self.columns
+
+    def __getbuffer__(self, Py_buffer *buffer, int flags):
+        cdef Py_ssize_t itemsize = sizeof(int)
+
+        self.shape[0] = <Py_ssize_t>self.data.size() // self.columns
+        self.shape[1] = self.columns
+        self.strides[0] = self.columns * itemsize
+        self.strides[1] = itemsize
+
+        if self.data.empty():
+            buffer.buf = NULL
+        else:
+            buffer.buf = <char *>&(self.data[0])
+        buffer.format = 'i'
+        buffer.internal = NULL
+        buffer.itemsize = itemsize
+        buffer.len = self.data.size() * itemsize
+        buffer.ndim = 1 if self.columns == 1 else 2
+        buffer.obj = self
+        buffer.readonly = 0
+        buffer.shape = self.shape
+        buffer.strides = self.strides
+        buffer.suboffsets = NULL
+
+    def __releasebuffer__(self, Py_buffer *buffer):
+        pass
+
+# array keeps its data alive, NumPy array (or memoryview if NumPy is not available) refers to it
+cdef object array_view(array):
+    try:
+        import numpy
+        return numpy.asarray(array)
+    except ImportError:
+        return memoryview(array)
+
 # wrappers
 include "pyproblem.pxi"
 include "pyfield.pxi"
@@ -129,6 +275,9 @@ cdef extern from "../../agros2d-library/pythonlab/pythonengine_agros.h":
         int getCacheSize()
         void setCacheSize(int size) except +
 
+        bool getMeshCache()
+        void setMeshCache(bool meshCache)
+
         bool getSaveMatrixRHS()
         void setSaveMatrixRHS(bool save)
 
@@ -180,6 +329,12 @@ cdef class __Options__:
         def __set__(self, size):
             self.thisptr.setCacheSize(size)
 
+    property mesh_cache:
+        def __get__(self):
+            return self.thisptr.getMeshCache()
+        def __set__(self, mesh_cache):
+            self.thisptr.setMeshCache(mesh_cache)
+
     property save_matrix_and_rhs:
         def __get__(self):
             return self.thisptr.getSaveMatrixRHS()
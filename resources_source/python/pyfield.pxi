@@ -45,6 +45,9 @@ cdef extern from "../../agros2d-library/pythonlab/pyfield.h":
         string getAdaptivityErrorCalculator()
         void setAdaptivityErrorCalculator(string &calculator) except +
 
+        string getAdaptivityReferenceRetention()
+        void setAdaptivityReferenceRetention(string &retention) except +
+
         double getInitialCondition()
         void setInitialCondition(double initialCondition) except +
 
@@ -80,13 +83,32 @@ cdef extern from "../../agros2d-library/pythonlab/pyfield.h":
         void volumeIntegrals(vector[int], int timeStep, int adaptivityStep,
                              string &solutionType, map[string, double] &results) except +
 
+        void surfaceIntegrals(vector[vector[int]] &edges, int timeStep, int adaptivityStep,
+                              string &solutionType, vector[map[string, double]] &results) except +
+        void volumeIntegrals(vector[vector[int]] &labels, int timeStep, int adaptivityStep,
+                             string &solutionType, vector[map[string, double]] &results) except +
+
         void initialMeshInfo(map[string , int] &info) except +
         void solutionMeshInfo(int timeStep, int adaptivityStep, string &solutionType, map[string , int] &info) except +
 
+        void solutionVector(int timeStep, int adaptivityStep, string &solutionType, vector[double] &values) except +
+        void initialMeshArrays(vector[double] &vertices, vector[int] &triangles) except +
+        void solutionMeshArrays(int timeStep, int adaptivityStep, string &solutionType,
+                                vector[double] &vertices, vector[int] &triangles) except +
+        void linearizedValues(string &variable, string &component,
+                              int timeStep, int adaptivityStep, string &solutionType,
+                              vector[double] &vertices, vector[double] &values) except +
+
         void solverInfo(int timeStep, int adaptivityStep, string &solutionType,
                         vector[double] &solution_change, vector[double] &residual,
                         vector[double] &dampingCoeff, int &jacobianCalculations) except +
 
+        void linearSolverInfo(int timeStep, int adaptivityStep, string &solutionType,
+                              int &iterations, int &innerIterations, double &residual) except +
+
+        void profileInfo(int timeStep, int adaptivityStep, string &solutionType,
+                         map[string, double] &profile) except +
+
         void adaptivityInfo(int timeStep, string &solutionType, vector[double] &error, vector[int] &dofs) except +
 
         string filenameMatrix(int timeStep, int adaptivityStep) except +
@@ -310,7 +332,12 @@ cdef class __Field__:
         return {'tolerance' : self.thisptr.getDoubleParameter(string('LinearSolverIterToleranceAbsolute')),
                 'iterations' : self.thisptr.getIntParameter(string('LinearSolverIterIters')),
                 'method' : self.thisptr.getLinearSolverMethod().c_str(),
-                'preconditioner' : self.thisptr.getLinearSolverPreconditioner().c_str()}
+                'preconditioner' : self.thisptr.getLinearSolverPreconditioner().c_str(),
+                'reuse_preconditioner' : self.thisptr.getBoolParameter(string('LinearSolverReusePreconditioner')),
+                'mixed_precision' : self.thisptr.getBoolParameter(string('LinearSolverIterMixedPrecision')),
+                'mixed_precision_inner_tolerance' : self.thisptr.getDoubleParameter(string('LinearSolverIterMixedPrecisionInnerTolerance')),
+                'mixed_precision_outer_tolerance' : self.thisptr.getDoubleParameter(string('LinearSolverIterMixedPrecisionOuterTolerance')),
+                'amg_numeric_refresh' : self.thisptr.getBoolParameter(string('LinearSolverAMGNumericRefresh'))}
 
     def __set_matrix_solver_parameters__(self, parameters):
         # tolerance
@@ -325,6 +352,17 @@ cdef class __Field__:
         self.thisptr.setLinearSolverMethod(string(parameters['method']))
         self.thisptr.setLinearSolverPreconditioner(string(parameters['preconditioner']))
 
+        # preconditioner reuse
+        self.thisptr.setParameter(string('LinearSolverReusePreconditioner'), <bool>parameters['reuse_preconditioner'])
+        self.thisptr.setParameter(string('LinearSolverAMGNumericRefresh'), <bool>parameters['amg_numeric_refresh'])
+
+        # mixed precision
+        self.thisptr.setParameter(string('LinearSolverIterMixedPrecision'), <bool>parameters['mixed_precision'])
+        value_in_range(parameters['mixed_precision_inner_tolerance'], 0.0, 1.0, 'mixed_precision_inner_tolerance')
+        self.thisptr.setParameter(string('LinearSolverIterMixedPrecisionInnerTolerance'), <double>parameters['mixed_precision_inner_tolerance'])
+        value_in_range(parameters['mixed_precision_outer_tolerance'], 0.0, 1.0, 'mixed_precision_outer_tolerance')
+        self.thisptr.setParameter(string('LinearSolverIterMixedPrecisionOuterTolerance'), <double>parameters['mixed_precision_outer_tolerance'])
+
     # refinements
     property number_of_refinements:
         def __get__(self):
@@ -360,6 +398,7 @@ cdef class __Field__:
                 'order_increase' : self.thisptr.getIntParameter(string('AdaptivityOrderIncrease')),
                 'space_refinement' : self.thisptr.getBoolParameter(string('AdaptivitySpaceRefinement')),
                 'finer_reference_solution' : self.thisptr.getBoolParameter(string('AdaptivityFinerReference')),
+                'reference_retention' : self.thisptr.getAdaptivityReferenceRetention().c_str(),
                 'transient_back_steps' : self.thisptr.getIntParameter(string('AdaptivityTransientBackSteps')),
                 'transient_redone_steps' : self.thisptr.getIntParameter(string('AdaptivityTransientRedoneEach'))}
 
@@ -384,6 +423,9 @@ cdef class __Field__:
         self.thisptr.setParameter(string('AdaptivityUseAniso'), <bool>parameters['anisotropic_refinement'])
         self.thisptr.setParameter(string('AdaptivityFinerReference'), <bool>parameters['finer_reference_solution'])
 
+        # retention of reference solutions
+        self.thisptr.setAdaptivityReferenceRetention(string(parameters['reference_retention']))
+
         # space refinement, order increase
         self.thisptr.setParameter(string('AdaptivitySpaceRefinement'), <bool>parameters['space_refinement'])
         value_in_range(parameters['order_increase'], 1, 10, 'order_increase')
@@ -586,6 +628,77 @@ cdef class __Field__:
 
         return out
 
+    # batched integrals
+    def surface_integrals_batch(self, edges, time_step = None, adaptivity_step = None, solution_type = "normal"):
+        """Compute surface integrals on several sets of edges at once and return list of dictionaries with results.
+
+        surface_integrals_batch(edges, time_step = None, adaptivity_step = None, solution_type = "normal")
+
+        All sets are evaluated in one pass through the mesh, selection of edges is not changed.
+
+        Keyword arguments:
+        edges -- list of lists of edges (empty list means all edges)
+        time_step -- time step (default is None - use last time step)
+        adaptivity_step -- adaptivity step (default is None - use adaptive step)
+        solution_type -- solution type (default is "normal")
+        """
+        cdef vector[vector[int]] edges_vector
+        for edges_set in edges:
+            edges_vector.push_back(list_to_int_vector(edges_set))
+
+        cdef vector[map[string, double]] results
+
+        self.thisptr.surfaceIntegrals(edges_vector,
+                                      int(-1 if time_step is None else time_step),
+                                      int(-1 if adaptivity_step is None else adaptivity_step),
+                                      string(solution_type), results)
+
+        out = list()
+        for i in range(results.size()):
+            values = dict()
+            it = results[i].begin()
+            while it != results[i].end():
+                values[deref(it).first.c_str()] = deref(it).second
+                incr(it)
+            out.append(values)
+
+        return out
+
+    def volume_integrals_batch(self, labels, time_step = None, adaptivity_step = None, solution_type = "normal"):
+        """Compute volume integrals on several sets of labels at once and return list of dictionaries with results.
+
+        volume_integrals_batch(labels, time_step = None, adaptivity_step = None, solution_type = "normal")
+
+        All sets are evaluated in one pass through the mesh, selection of labels is not changed.
+
+        Keyword arguments:
+        labels -- list of lists of labels (empty list means all labels)
+        time_step -- time step (default is None - use last time step)
+        adaptivity_step -- adaptivity step (default is None - use adaptive step)
+        solution_type -- solution type (default is "normal")
+        """
+        cdef vector[vector[int]] labels_vector
+        for labels_set in labels:
+            labels_vector.push_back(list_to_int_vector(labels_set))
+
+        cdef vector[map[string, double]] results
+
+        self.thisptr.volumeIntegrals(labels_vector,
+                                     int(-1 if time_step is None else time_step),
+                                     int(-1 if adaptivity_step is None else adaptivity_step),
+                                     string(solution_type), results)
+
+        out = list()
+        for i in range(results.size()):
+            values = dict()
+            it = results[i].begin()
+            while it != results[i].end():
+                values[deref(it).first.c_str()] = deref(it).second
+                incr(it)
+            out.append(values)
+
+        return out
+
     # mesh info
     def initial_mesh_info(self):
         """Return dictionary with initial mesh info."""
@@ -624,6 +737,84 @@ cdef class __Field__:
 
         return info
 
+    # arrays
+    def solution_vector(self, time_step = None, adaptivity_step = None, solution_type = "normal"):
+        """Return array with coefficients of the solution (degrees of freedom).
+
+        solution_vector(time_step = None, adaptivity_step = None, solution_type = "normal")
+
+        Array refers to data owned by Agros2D (NumPy array if NumPy is available, otherwise memoryview).
+
+        Keyword arguments:
+        time_step -- time step (default is None - use last time step)
+        adaptivity_step -- adaptivity step (default is None - use adaptive step)
+        solution_type -- solution type (default is "normal")
+        """
+        cdef __DoubleArray__ values = __DoubleArray__()
+
+        self.thisptr.solutionVector(int(-1 if time_step is None else time_step),
+                                    int(-1 if adaptivity_step is None else adaptivity_step),
+                                    string(solution_type), values.data)
+
+        return array_view(values)
+
+    def initial_mesh_arrays(self):
+        """Return tuple of arrays with vertices (n x 2) and triangles (m x 3) of initial mesh.
+
+        Quadrilaterals are split into two triangles.
+        """
+        cdef __DoubleArray__ vertices = __DoubleArray__(2)
+        cdef __IntArray__ triangles = __IntArray__(3)
+
+        self.thisptr.initialMeshArrays(vertices.data, triangles.data)
+
+        return array_view(vertices), array_view(triangles)
+
+    def solution_mesh_arrays(self, time_step = None, adaptivity_step = None, solution_type = "normal"):
+        """Return tuple of arrays with vertices (n x 2) and triangles (m x 3) of solution mesh.
+
+        solution_mesh_arrays(time_step = None, adaptivity_step = None, solution_type = "normal")
+
+        Quadrilaterals are split into two triangles.
+
+        Keyword arguments:
+        time_step -- time step (default is None - use last time step)
+        adaptivity_step -- adaptivity step (default is None - use adaptive step)
+        solution_type -- solution type (default is "normal")
+        """
+        cdef __DoubleArray__ vertices = __DoubleArray__(2)
+        cdef __IntArray__ triangles = __IntArray__(3)
+
+        self.thisptr.solutionMeshArrays(int(-1 if time_step is None else time_step),
+                                        int(-1 if adaptivity_step is None else adaptivity_step),
+                                        string(solution_type), vertices.data, triangles.data)
+
+        return array_view(vertices), array_view(triangles)
+
+    def linearized_values(self, variable, component = "scalar", time_step = None, adaptivity_step = None, solution_type = "normal"):
+        """Return tuple of arrays with vertices (3m x 2) and values (3m) of linearized scalar field.
+
+        linearized_values(variable, component = "scalar", time_step = None, adaptivity_step = None, solution_type = "normal")
+
+        Every three consecutive vertices form one triangle of the linearized field.
+
+        Keyword arguments:
+        variable -- physical field variable
+        component -- component of variable (default is "scalar")
+        time_step -- time step (default is None - use last time step)
+        adaptivity_step -- adaptivity step (default is None - use adaptive step)
+        solution_type -- solution type (default is "normal")
+        """
+        cdef __DoubleArray__ vertices = __DoubleArray__(2)
+        cdef __DoubleArray__ values = __DoubleArray__()
+
+        self.thisptr.linearizedValues(string(variable), string(component),
+                                      int(-1 if time_step is None else time_step),
+                                      int(-1 if adaptivity_step is None else adaptivity_step),
+                                      string(solution_type), vertices.data, values.data)
+
+        return array_view(vertices), array_view(values)
+
     # solver info
     def solver_info(self, time_step = None, adaptivity_step = None, solution_type = 'normal'):
         """Return dictionary with solver info.
@@ -659,6 +850,55 @@ cdef class __Field__:
 
         return {'solution_change' : solution_change, 'residual' : residual, 'damping' : damping, 'jacobian_calculations' : jacobian_calculations}
 
+    # linear solver info
+    def linear_solver_info(self, time_step = None, adaptivity_step = None, solution_type = 'normal'):
+        """Return dictionary with iterative linear solver info.
+
+        linear_solver_info(time_step = None, adaptivity_step = None, solution_type = "normal")
+
+        Keyword arguments:
+        time_step -- time step (default is None - use last time step)
+        adaptivity_step -- adaptivity step (default is None - use adaptive step)
+        solution_type -- solution type (default is "normal")
+        """
+        cdef int iterations
+        cdef int inner_iterations
+        cdef double residual
+        iterations = 0
+        inner_iterations = 0
+        residual = 0.0
+        self.thisptr.linearSolverInfo(int(-1 if time_step is None else time_step),
+                                      int(-1 if adaptivity_step is None else adaptivity_step),
+                                      string(solution_type),
+                                      iterations, inner_iterations, residual)
+
+        return {'iterations' : iterations, 'inner_iterations' : inner_iterations, 'residual' : residual}
+
+    # profile info
+    def profile_info(self, time_step = None, adaptivity_step = None, solution_type = 'normal'):
+        """Return dictionary with time (ms) spent in each phase of the stored solution step.
+
+        profile_info(time_step = None, adaptivity_step = None, solution_type = "normal")
+
+        Keyword arguments:
+        time_step -- time step (default is None - use last time step)
+        adaptivity_step -- adaptivity step (default is None - use adaptive step)
+        solution_type -- solution type (default is "normal")
+        """
+        profile = dict()
+        cdef map[string, double] profile_map
+        self.thisptr.profileInfo(int(-1 if time_step is None else time_step),
+                                 int(-1 if adaptivity_step is None else adaptivity_step),
+                                 string(solution_type),
+                                 profile_map)
+
+        it = profile_map.begin()
+        while it != profile_map.end():
+            profile[deref(it).first.c_str()] = deref(it).second
+            incr(it)
+
+        return profile
+
     # adaptivity info
     def adaptivity_info(self, time_step = None, solution_type = 'normal'):
         """Return dictionary with adaptivity process info.
@@ -12,10 +12,24 @@ cdef extern from "../../agros2d-library/pythonlab/pygeometry.h":
         void modifyEdge(int index, double angle, int segments, int curvilinear, map[string, int] &refinements, map[string, string] &boundaries) except +
         void modifyLabel(int index, double area, map[string, int] &refinements, map[string, int] &orders, map[string, string] &materials) except +
 
+        vector[int] addNodes(vector[double] &x, vector[double] &y) except +
+        vector[int] addEdges(vector[double] &x1, vector[double] &y1, vector[double] &x2, vector[double] &y2, vector[double] &angles, vector[int] &segments, vector[int] &curvilinear, vector[map[string, string]] &boundaries) except +
+        vector[int] addEdgesByNodes(vector[int] &nodeStartIndices, vector[int] &nodeEndIndices, vector[double] &angles, vector[int] &segments, vector[int] &curvilinear, vector[map[string, string]] &boundaries) except +
+        vector[int] addLabels(vector[double] &x, vector[double] &y, vector[double] &areas, vector[map[string, string]] &materials) except +
+
+        void modifyEdges(vector[int] &indices, vector[double] &angles, vector[int] &segments, vector[int] &curvilinear, vector[map[string, string]] &boundaries) except +
+        void modifyLabels(vector[int] &indices, vector[double] &areas, vector[map[string, string]] &materials) except +
+
+        void beginTransaction() except +
+        void commitTransaction() except +
+        void rollbackTransaction() except +
+
         int nodesCount()
         int edgesCount()
         int labelsCount()
 
+        void nodePoint(int index, double &x, double &y) except +
+
         void removeNodes(vector[int] &nodes) except +
         void removeEdges(vector[int] &edges) except +
         void removeLabels(vector[int] &labels) except +
@@ -35,8 +49,26 @@ cdef extern from "../../agros2d-library/pythonlab/pygeometry.h":
         void scaleSelection(double x, double y, double scale, bool copy, bool withMarkers)
         void removeSelection()
 
+        void check(vector[int] &lyingNodes, vector[int] &endNodes, vector[int] &crossings) except +
+
+        void importDXF(string filename) except +
         void exportVTK(string filename)
 
+class __GeometryTransaction__(object):
+    def __init__(self, geometry):
+        self.geometry = geometry
+
+    def __enter__(self):
+        self.geometry.begin_transaction()
+        return self.geometry
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        if (exc_type is None):
+            self.geometry.commit_transaction()
+        else:
+            self.geometry.rollback_transaction()
+        return False
+
 cdef class __Geometry__:
     cdef PyGeometry *thisptr
 
@@ -184,6 +216,133 @@ cdef class __Geometry__:
 
         self.thisptr.removeLabels(labels_vector)
 
+    def add_nodes(self, x, y):
+        """Add new nodes according to arrays of coordinates and return list of their indexes.
+
+        Nodes are added in one transaction, no node is added if any of them is invalid.
+
+        add_nodes(x, y)
+
+        Keyword arguments:
+        x -- array (NumPy array or list) of x or r coordinates of nodes
+        y -- array of y or z coordinates of nodes
+        """
+        cdef vector[double] x_vector = array_to_double_vector(x)
+        cdef vector[double] y_vector = array_to_double_vector(y)
+
+        return int_vector_to_list(self.thisptr.addNodes(x_vector, y_vector))
+
+    def add_edges(self, x1, y1, x2, y2, angles = None, segments = None, curvilinear = None, boundaries = None):
+        """Add new edges according to arrays of coordinates and return list of their indexes.
+
+        Edges are added in one transaction, no edge is added if any of them is invalid.
+        Parameters are arrays with value for each edge, one value used for all edges or None (default value).
+
+        add_edges(x1, y1, x2, y2, angles = None, segments = None, curvilinear = None, boundaries = None)
+
+        Keyword arguments:
+        x1 -- array (NumPy array or list) of x or r coordinates of start nodes
+        y1 -- array of y or z coordinates of start nodes
+        x2 -- array of x or r coordinates of end nodes
+        y2 -- array of y or z coordinates of end nodes
+        angles -- angles of arcs (default None - 0.0)
+        segments -- number of segments of arcs (default None - 3)
+        curvilinear -- curvilinear edges (default None - True)
+        boundaries -- boundary conditions {'field' : 'boundary name'} or list of them (default None - no boundary condition)
+        """
+        cdef vector[double] x1_vector = array_to_double_vector(x1)
+        cdef vector[double] y1_vector = array_to_double_vector(y1)
+        cdef vector[double] x2_vector = array_to_double_vector(x2)
+        cdef vector[double] y2_vector = array_to_double_vector(y2)
+        cdef vector[double] angles_vector = parameter_to_double_vector(angles)
+        cdef vector[int] segments_vector = parameter_to_int_vector(segments)
+        cdef vector[int] curvilinear_vector = parameter_to_int_vector(curvilinear)
+        cdef vector[map[string, string]] boundaries_vector = parameter_to_string_map_vector(boundaries)
+
+        return int_vector_to_list(self.thisptr.addEdges(x1_vector, y1_vector, x2_vector, y2_vector,
+                                                        angles_vector, segments_vector, curvilinear_vector, boundaries_vector))
+
+    def add_edges_by_nodes(self, start_node_indexes, end_node_indexes, angles = None, segments = None, curvilinear = None, boundaries = None):
+        """Add new edges according to arrays of indexes of start and end nodes and return list of their indexes.
+
+        Edges are added in one transaction, no edge is added if any of them is invalid.
+
+        add_edges_by_nodes(start_node_indexes, end_node_indexes, angles = None, segments = None, curvilinear = None, boundaries = None)
+
+        Keyword arguments:
+        start_node_indexes -- array (NumPy array or list) of indexes of start nodes
+        end_node_indexes -- array of indexes of end nodes
+        angles -- angles of arcs (default None - 0.0)
+        segments -- number of segments of arcs (default None - 3)
+        curvilinear -- curvilinear edges (default None - True)
+        boundaries -- boundary conditions {'field' : 'boundary name'} or list of them (default None - no boundary condition)
+        """
+        cdef vector[int] start_vector = list_to_int_vector(start_node_indexes)
+        cdef vector[int] end_vector = list_to_int_vector(end_node_indexes)
+        cdef vector[double] angles_vector = parameter_to_double_vector(angles)
+        cdef vector[int] segments_vector = parameter_to_int_vector(segments)
+        cdef vector[int] curvilinear_vector = parameter_to_int_vector(curvilinear)
+        cdef vector[map[string, string]] boundaries_vector = parameter_to_string_map_vector(boundaries)
+
+        return int_vector_to_list(self.thisptr.addEdgesByNodes(start_vector, end_vector,
+                                                               angles_vector, segments_vector, curvilinear_vector, boundaries_vector))
+
+    def modify_edges(self, indexes, angles = None, segments = None, curvilinear = None, boundaries = None):
+        """Modify parameters of existing edges, geometry is invalidated only once.
+
+        modify_edges(indexes, angles = None, segments = None, curvilinear = None, boundaries = None)
+
+        Keyword arguments:
+        indexes -- array (NumPy array or list) of edge indexes
+        angles -- angles of arcs (default None - 0.0)
+        segments -- number of segments of arcs (default None - 3)
+        curvilinear -- curvilinear edges (default None - True)
+        boundaries -- boundary conditions {'field' : 'boundary name'} or list of them (default None - unchanged)
+        """
+        cdef vector[int] indexes_vector = list_to_int_vector(indexes)
+        cdef vector[double] angles_vector = parameter_to_double_vector(angles)
+        cdef vector[int] segments_vector = parameter_to_int_vector(segments)
+        cdef vector[int] curvilinear_vector = parameter_to_int_vector(curvilinear)
+        cdef vector[map[string, string]] boundaries_vector = parameter_to_string_map_vector(boundaries)
+
+        self.thisptr.modifyEdges(indexes_vector, angles_vector, segments_vector, curvilinear_vector, boundaries_vector)
+
+    def add_labels(self, x, y, areas = None, materials = None):
+        """Add new labels according to arrays of coordinates and return list of their indexes.
+
+        Labels are added in one transaction, no label is added if any of them is invalid.
+
+        add_labels(x, y, areas = None, materials = None)
+
+        Keyword arguments:
+        x -- array (NumPy array or list) of x or r coordinates of labels
+        y -- array of y or z coordinates of labels
+        areas -- cross sections of elements (default None - 0.0)
+        materials -- materials {'field' : 'material name'} or list of them (default None - no material)
+        """
+        cdef vector[double] x_vector = array_to_double_vector(x)
+        cdef vector[double] y_vector = array_to_double_vector(y)
+        cdef vector[double] areas_vector = parameter_to_double_vector(areas)
+        cdef vector[map[string, string]] materials_vector = parameter_to_string_map_vector(materials)
+
+        return int_vector_to_list(self.thisptr.addLabels(x_vector, y_vector, areas_vector, materials_vector))
+
+    def modify_labels(self, indexes, areas = None, materials = None):
+        """Modify parameters of existing labels, geometry is invalidated only once.
+
+        modify_labels(indexes, areas = None, materials = None)
+
+        Keyword arguments:
+        indexes -- array (NumPy array or list) of label indexes
+        areas -- cross sections of elements (default None - 0.0)
+        materials -- materials {'field' : 'material name'} or list of them (default None - unchanged)
+        """
+        cdef vector[int] indexes_vector = list_to_int_vector(indexes)
+        cdef vector[double] areas_vector = parameter_to_double_vector(areas)
+        cdef vector[map[string, string]] materials_vector = parameter_to_string_map_vector(materials)
+
+        self.thisptr.modifyLabels(indexes_vector, areas_vector, materials_vector)
+
     def add_rect(self, x0, y0, width, height, boundaries = {}, materials = None):
         """Add rect by start point (lower left node), width and height.
 
@@ -244,6 +403,32 @@ cdef class __Geometry__:
         if (materials != None):
             self.add_label((x0)+(radius/2.0), y0, materials=materials)
 
+    def begin_transaction(self):
+        """Start bulk insert of geometry.
+
+        Nodes and edges are found by hashed lookup and the solution is cleared only once
+        in commit_transaction(). Geometry must not be moved, rotated or scaled during the transaction.
+        """
+        self.thisptr.beginTransaction()
+
+    def commit_transaction(self):
+        """Finish bulk insert of geometry."""
+        self.thisptr.commitTransaction()
+
+    def rollback_transaction(self):
+        """Finish bulk insert of geometry and remove nodes, edges and labels added in the transaction."""
+        self.thisptr.rollbackTransaction()
+
+    def transaction(self):
+        """Return context manager for bulk insert of geometry.
+
+        Transaction is committed at the end of block or rolled back if an exception is raised.
+
+        with geometry.transaction():
+            geometry.add_edge(0, 0, 1, 0)
+        """
+        return __GeometryTransaction__(self)
+
     def nodes_count(self):
         """Return count of existing nodes."""
         return self.thisptr.nodesCount()
@@ -256,6 +441,20 @@ cdef class __Geometry__:
         """Return count of existing labels."""
         return self.thisptr.labelsCount()
 
+    def node_point(self, index):
+        """Return tuple with coordinates of node (evaluated values of parametric coordinates).
+
+        node_point(index)
+
+        Keyword arguments:
+        index -- node index
+        """
+        cdef double x = 0.0
+        cdef double y = 0.0
+        self.thisptr.nodePoint(index, x, y)
+
+        return x, y
+
     def select_nodes(self, nodes = []):
         """Select nodes according to their indexes.
 
@@ -374,6 +573,21 @@ cdef class __Geometry__:
         """Unselect all objects (nodes, edges or labels)."""
         self.thisptr.selectNone()
 
+    def check(self):
+        """Check geometry and return dictionary with indices of nodes lying on edges ("lying_nodes"),
+        nodes connected to one edge only ("end_nodes") and crossing edges ("crossings")."""
+        cdef vector[int] lying_nodes
+        cdef vector[int] end_nodes
+        cdef vector[int] crossings
+        self.thisptr.check(lying_nodes, end_nodes, crossings)
+
+        return {"lying_nodes" : lying_nodes, "end_nodes" : end_nodes, "crossings" : crossings}
+
+    def import_dxf(self, filename):
+        """Import geometry from DXF file (near-coincident endpoints are snapped,
+        zero-length and duplicate edges removed and collinear edges merged)."""
+        self.thisptr.importDXF(filename)
+
     def export_vtk(self, filename):
         """Export geometry in VTK format."""
         self.thisptr.exportVTK(filename)
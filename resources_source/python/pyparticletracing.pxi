@@ -71,6 +71,8 @@ cdef extern from "../../agros2d-library/pythonlab/pyparticletracing.h":
         void velocities(vector[vector[double]] &vx, vector[vector[double]] &vy, vector[vector[double]] &vz)
         void times(vector[vector[double]] &t)
 
+        int forceEvaluations()
+
 cdef class __ParticleTracing__:
     cdef PyParticleTracing *thisptr
 
@@ -138,6 +140,9 @@ cdef class __ParticleTracing__:
 
         return out
 
+    def force_evaluations(self):
+        return self.thisptr.forceEvaluations()
+
     property number_of_particles:
         def __get__(self):
             return self.thisptr.getNumberOfParticles()
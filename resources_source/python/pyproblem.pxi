@@ -24,6 +24,9 @@ cdef extern from "../../agros2d-library/pythonlab/pyproblem.h":
         double getTimeMethodTolerance()
         void setTimeMethodTolerance(double timeMethodTolerance) except +
 
+        string getTimeMethodErrorEstimator()
+        void setTimeMethodErrorEstimator(string &timeErrorEstimator) except +
+
         double getTimeTotal()
         void setTimeTotal(double timeTotal) except +
 
@@ -39,9 +42,16 @@ cdef extern from "../../agros2d-library/pythonlab/pyproblem.h":
         void mesh() except +
         void solve() except +
 
+        void meshCacheInfo(map[string, int] &info)
+        void valueCacheInfo(map[string, int] &info)
+        void referenceSpaceCacheInfo(map[string, int] &info)
+
         double timeElapsed() except +
         void timeStepsLength(vector[double] &steps) except +
 
+        string profile(string &format) except +
+        void saveProfile(string &fileName, string &format) except +
+
 cdef class __Problem__:
     cdef PyProblem *thisptr
     cdef object time_callback
@@ -101,6 +111,12 @@ cdef class __Problem__:
         def __set__(self, time_method_tolerance):
             self.thisptr.setTimeMethodTolerance(time_method_tolerance)
 
+    property time_method_error_estimator:
+        def __get__(self):
+            return self.thisptr.getTimeMethodErrorEstimator().c_str()
+        def __set__(self, time_method_error_estimator):
+            self.thisptr.setTimeMethodErrorEstimator(string(time_method_error_estimator))
+
     property time_total:
         def __get__(self):
             return self.thisptr.getTimeTotal()
@@ -152,6 +168,45 @@ cdef class __Problem__:
         """Area discretization."""
         self.thisptr.mesh()
 
+    def mesh_cache_info(self):
+        """Return dictionary with mesh cache statistics (hits and misses)."""
+        info = dict()
+        cdef map[string, int] info_map
+
+        self.thisptr.meshCacheInfo(info_map)
+        it = info_map.begin()
+        while it != info_map.end():
+            info[deref(it).first.c_str()] = deref(it).second
+            incr(it)
+
+        return info
+
+    def value_cache_info(self):
+        """Return dictionary with statistics of cache of coordinate and time dependent values (hits and misses) and number of evaluations of expressions."""
+        info = dict()
+        cdef map[string, int] info_map
+
+        self.thisptr.valueCacheInfo(info_map)
+        it = info_map.begin()
+        while it != info_map.end():
+            info[deref(it).first.c_str()] = deref(it).second
+            incr(it)
+
+        return info
+
+    def reference_space_cache_info(self):
+        """Return dictionary with statistics of reuse of reference meshes in adaptivity (hits and misses)."""
+        info = dict()
+        cdef map[string, int] info_map
+
+        self.thisptr.referenceSpaceCacheInfo(info_map)
+        it = info_map.begin()
+        while it != info_map.end():
+            info[deref(it).first.c_str()] = deref(it).second
+            incr(it)
+
+        return info
+
     def solve(self):
         """Solve problem."""
         self.thisptr.solve()
@@ -180,6 +235,27 @@ cdef class __Problem__:
 
         return time
 
+    def profile(self, format = "json"):
+        """Return performance profile of the last mesh generation or solution.
+
+        profile(format = "json")
+
+        Keyword arguments:
+        format -- "json" (summary of phases) or "chrome" (Chrome trace events) (default is "json")
+        """
+        return self.thisptr.profile(string(format)).c_str()
+
+    def save_profile(self, filename, format = "json"):
+        """Save performance profile of the last mesh generation or solution.
+
+        save_profile(filename, format = "json")
+
+        Keyword arguments:
+        filename -- file name
+        format -- "json" (summary of phases) or "chrome" (Chrome trace events) (default is "json")
+        """
+        self.thisptr.saveProfile(string(filename), string(format))
+
 __problem__ = __Problem__()
 def problem(clear = False):
     if (clear):
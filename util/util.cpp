@@ -346,6 +346,28 @@ QString cacheProblemDir()
     return str;
 }
 
+QString meshCacheDir()
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+    static QString str = QString("%1/mesh").
+            arg(QStandardPaths::writableLocation(QStandardPaths::CacheLocation));
+#else
+#ifdef Q_WS_WIN
+    static QString str = QString("%1/agros2d/mesh").
+            arg(QDir::temp().absolutePath());
+#else
+    static QString str = QString("%1/mesh").
+            arg(QDesktopServices::storageLocation(QDesktopServices::CacheLocation));
+#endif
+#endif
+
+    QDir dir(str);
+    if (!dir.exists())
+        dir.mkpath(str);
+
+    return str;
+}
+
 QString userDataDir()
 {
 #if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
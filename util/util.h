@@ -148,6 +148,9 @@ AGROS_UTIL_API QString externalFunctions();
 AGROS_UTIL_API QString tempProblemDir();
 AGROS_UTIL_API QString cacheProblemDir();
 
+// get mesh cache dir (shared by all instances)
+AGROS_UTIL_API QString meshCacheDir();
+
 // get user dir
 AGROS_UTIL_API QString userDataDir();
 